@@ -0,0 +1,149 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Helpers shared by the benchmarks: a monotonic nanosecond clock and a log-linear
+ * (HDR style) histogram used to report latency percentiles.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace common {
+
+    inline uint64_t now_ns() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /**
+     * @brief Returns the smallest delta observed between two consecutive reads of the clock. It is
+     * subtracted from every sample so that the histogram reports the cost of the measured call
+     * only.
+     */
+    inline uint64_t clock_overhead_ns() noexcept
+    {
+        uint64_t overhead{UINT64_MAX};
+        for (size_t i{0}; i < 10000; ++i)
+        {
+            const uint64_t start{now_ns()};
+            const uint64_t stop{now_ns()};
+            overhead = std::min(overhead, stop - start);
+        }
+        return overhead;
+    }
+
+    /**
+     * @brief Histogram with logarithmic buckets each split in `s_sub_buckets` linear sub-buckets,
+     * in the style of HdrHistogram. Values below `2 * s_sub_buckets` are recorded exactly, any
+     * other value with a relative error lower than `1 / s_sub_buckets`.
+     */
+    class latency_histogram final
+    {
+      private:
+        static constexpr unsigned s_sub_bits{6};
+        static constexpr uint64_t s_sub_buckets{1ULL << s_sub_bits};
+        static constexpr size_t s_bucket_count{2 * s_sub_buckets +
+                                               (63 - s_sub_bits) * s_sub_buckets};
+
+      public:
+        latency_histogram() : m_counts(s_bucket_count, 0) {}
+
+        void record(uint64_t value) noexcept
+        {
+            ++m_counts[index_of(value)];
+            ++m_total;
+            m_max = std::max(m_max, value);
+        }
+
+        /**
+         * @brief Returns the value below which `percentile` percent of the recorded samples fall.
+         * @param percentile a number in the range [0, 100].
+         */
+        uint64_t value_at(double percentile) const noexcept
+        {
+            if (m_total == 0)
+                return 0;
+
+            uint64_t rank{static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(m_total))};
+            rank = std::max<uint64_t>(1, std::min(rank, m_total));
+
+            uint64_t seen{0};
+            for (size_t i{0}; i < s_bucket_count; ++i)
+            {
+                seen += m_counts[i];
+                if (seen >= rank)
+                    return std::min(highest_of(i), m_max);
+            }
+            return m_max;
+        }
+
+        uint64_t max() const noexcept { return m_max; }
+        uint64_t total() const noexcept { return m_total; }
+
+      private:
+        static size_t index_of(uint64_t value) noexcept
+        {
+            if (value < 2 * s_sub_buckets)
+                return static_cast<size_t>(value);
+
+            unsigned magnitude{s_sub_bits + 1};
+            while (magnitude < 63 && (value >> (magnitude + 1)) != 0)
+                ++magnitude;
+
+            const unsigned shift{magnitude - s_sub_bits};
+            const uint64_t sub{(value >> shift) - s_sub_buckets};
+            return static_cast<size_t>(2 * s_sub_buckets +
+                                       (magnitude - s_sub_bits - 1) * s_sub_buckets + sub);
+        }
+
+        static uint64_t highest_of(size_t index) noexcept
+        {
+            if (index < 2 * s_sub_buckets)
+                return index;
+
+            const size_t linear{index - 2 * s_sub_buckets};
+            const unsigned shift{static_cast<unsigned>(linear / s_sub_buckets) + 1};
+            const uint64_t sub{s_sub_buckets + linear % s_sub_buckets};
+            return ((sub + 1) << shift) - 1;
+        }
+
+      private:
+        std::vector<uint64_t> m_counts;
+        uint64_t m_total{0};
+        uint64_t m_max{0};
+    };
+
+} // namespace common
@@ -0,0 +1,201 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Latency benchmark for small messages. Every call to hashkitcxx::hash() and
+ * hashkitcxx::hash_printable() is timed individually and recorded in a histogram, then
+ * p50, p99 and p99.9 are printed for each algorithm and message size. With messages this
+ * short the fixed cost of each call (context setup, padding and the wrappers in
+ * hash_utils.hpp) dominates, and it is hidden by any throughput measure.
+ *
+ * usage: latency [iterations]
+ */
+
+#include "common.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+#include <vector>
+
+namespace {
+
+    constexpr size_t s_message_sizes[]{16, 32, 64, 128, 256};
+
+    volatile unsigned char g_sink{0};
+
+    void print_header()
+    {
+        std::printf("%-12s %-18s %6s %8s %8s %8s %8s   (ns)\n",
+                    "algorithm",
+                    "function",
+                    "size",
+                    "p50",
+                    "p99",
+                    "p99.9",
+                    "max");
+    }
+
+    void print_row(const char * algorithm,
+                   const char * function,
+                   size_t size,
+                   const common::latency_histogram & histogram)
+    {
+        std::printf("%-12s %-18s %6zu %8llu %8llu %8llu %8llu\n",
+                    algorithm,
+                    function,
+                    size,
+                    static_cast<unsigned long long>(histogram.value_at(50.0)),
+                    static_cast<unsigned long long>(histogram.value_at(99.0)),
+                    static_cast<unsigned long long>(histogram.value_at(99.9)),
+                    static_cast<unsigned long long>(histogram.max()));
+    }
+
+    template<class TCall>
+    common::latency_histogram measure(TCall call, size_t iterations, uint64_t overhead)
+    {
+        common::latency_histogram histogram;
+
+        for (size_t i{0}; i < iterations / 10; ++i)
+            call();
+
+        for (size_t i{0}; i < iterations; ++i)
+        {
+            const uint64_t start{common::now_ns()};
+            call();
+            const uint64_t stop{common::now_ns()};
+            const uint64_t elapsed{stop - start};
+            histogram.record(elapsed > overhead ? elapsed - overhead : 0);
+        }
+
+        return histogram;
+    }
+
+    template<class THash>
+    void run(const char * algorithm, size_t iterations, uint64_t overhead)
+    {
+        std::vector<unsigned char> message(s_message_sizes[sizeof(s_message_sizes) /
+                                                           sizeof(s_message_sizes[0]) - 1]);
+        for (size_t i{0}; i < message.size(); ++i)
+            message[i] = static_cast<unsigned char>(i * 131 + 7);
+
+        for (size_t size : s_message_sizes)
+        {
+            unsigned char digest[THash::s_digest_size]{};
+            print_row(algorithm,
+                      "hash",
+                      size,
+                      measure(
+                          [&]() {
+                              hashkitcxx::hash<THash>(message.data(), size, digest);
+                              g_sink = g_sink ^ digest[0];
+                          },
+                          iterations,
+                          overhead));
+
+            char digest_printable[2 * THash::s_digest_size + 1]{};
+            print_row(algorithm,
+                      "hash_printable",
+                      size,
+                      measure(
+                          [&]() {
+                              hashkitcxx::hash_printable<THash>(
+                                  message.data(), size, digest_printable);
+                              g_sink = g_sink ^ static_cast<unsigned char>(digest_printable[0]);
+                          },
+                          iterations,
+                          overhead));
+
+            print_row(algorithm,
+                      "hash_printable_arr",
+                      size,
+                      measure(
+                          [&]() {
+                              const typename THash::digest_printable_t digest_array{
+                                  hashkitcxx::hash_printable_array<THash>(message.data(), size)};
+                              g_sink = g_sink ^ static_cast<unsigned char>(digest_array[0]);
+                          },
+                          iterations,
+                          overhead));
+
+#if defined(HASHLIBCXX_STD_STRING)
+            print_row(algorithm,
+                      "hash_printable_str",
+                      size,
+                      measure(
+                          [&]() {
+                              const std::string digest_string{
+                                  hashkitcxx::hash_printable<THash>(message.data(), size)};
+                              g_sink = g_sink ^ static_cast<unsigned char>(digest_string[0]);
+                          },
+                          iterations,
+                          overhead));
+#endif
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    using namespace hashkitcxx::sha2;
+
+    size_t iterations{100000};
+    if (argc > 1)
+        iterations = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+
+    if (iterations == 0)
+    {
+        std::fprintf(stderr, "error: invalid number of iterations\nusage: latency [iterations]\n");
+        return -1;
+    }
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+    const char * mode{"header-only"};
+#else
+    const char * mode{"library"};
+#endif
+
+    const uint64_t overhead{common::clock_overhead_ns()};
+    std::printf("mode: %s, iterations: %zu, clock overhead: %llu ns (subtracted)\n",
+                mode,
+                iterations,
+                static_cast<unsigned long long>(overhead));
+    std::printf("hash_printable_arr and hash_printable_str are the overloads returning "
+                "std::array and std::string\n\n");
+
+    print_header();
+    run<sha224>("sha224", iterations, overhead);
+    run<sha256>("sha256", iterations, overhead);
+    run<sha384>("sha384", iterations, overhead);
+    run<sha512>("sha512", iterations, overhead);
+    run<sha512_224>("sha512_224", iterations, overhead);
+    run<sha512_256>("sha512_256", iterations, overhead);
+}
@@ -0,0 +1,117 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Throughput benchmark. Each algorithm hashes messages of a few sizes, from one block to a
+ * megabyte, and the best of several runs is reported in MB/s. Together with the latency
+ * benchmark it is the training workload of the profile guided build (see
+ * tools/dev/pgo_unix.sh), so it exercises the multi-block path of the transforms.
+ *
+ * usage: throughput [megabytes]
+ */
+
+#include "common.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+#include <vector>
+
+namespace {
+
+    constexpr size_t s_message_sizes[]{64, 1024, 64 * 1024, 1024 * 1024};
+    constexpr size_t s_runs{5};
+
+    volatile unsigned char g_sink{0};
+
+    template<class THash>
+    void run(const char * algorithm, size_t megabytes)
+    {
+        std::vector<unsigned char> message(s_message_sizes[sizeof(s_message_sizes) /
+                                                           sizeof(s_message_sizes[0]) - 1]);
+        for (size_t i{0}; i < message.size(); ++i)
+            message[i] = static_cast<unsigned char>(i * 131 + 7);
+
+        for (size_t size : s_message_sizes)
+        {
+            const size_t calls{(megabytes * 1024 * 1024 + size - 1) / size};
+            unsigned char digest[THash::s_digest_size]{};
+
+            uint64_t best{UINT64_MAX};
+            for (size_t run{0}; run < s_runs; ++run)
+            {
+                const uint64_t start{common::now_ns()};
+                for (size_t i{0}; i < calls; ++i)
+                {
+                    hashkitcxx::hash<THash>(message.data(), size, digest);
+                    g_sink = g_sink ^ digest[0];
+                }
+                const uint64_t elapsed{common::now_ns() - start};
+                best = elapsed < best ? elapsed : best;
+            }
+
+            const double seconds{static_cast<double>(best) / 1e9};
+            const double mb{static_cast<double>(calls * size) / (1024.0 * 1024.0)};
+            std::printf("%-12s %8zu %10.1f\n", algorithm, size, seconds > 0 ? mb / seconds : 0.0);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    using namespace hashkitcxx::sha2;
+
+    size_t megabytes{64};
+    if (argc > 1)
+        megabytes = static_cast<size_t>(std::strtoull(argv[1], nullptr, 10));
+
+    if (megabytes == 0)
+    {
+        std::fprintf(stderr, "error: invalid number of megabytes\nusage: throughput [megabytes]\n");
+        return -1;
+    }
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+    const char * mode{"header-only"};
+#else
+    const char * mode{"library"};
+#endif
+
+    std::printf("mode: %s, megabytes per size: %zu, best of %zu runs\n\n", mode, megabytes, s_runs);
+
+    std::printf("%-12s %8s %10s\n", "algorithm", "size", "MB/s");
+    run<sha224>("sha224", megabytes);
+    run<sha256>("sha256", megabytes);
+    run<sha384>("sha384", megabytes);
+    run<sha512>("sha512", megabytes);
+    run<sha512_224>("sha512_224", megabytes);
+    run<sha512_256>("sha512_256", megabytes);
+}
@@ -0,0 +1,13 @@
+function(set_interprocedural_optimization)
+
+    # Link time optimization
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT result OUTPUT output LANGUAGES CXX)
+    if(result)
+        set_target_properties(${PROJECT_NAME} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+    else()
+        message(WARNING "Compiler ${CMAKE_CXX_COMPILER_ID} does not support link time optimization: ${output}")
+    endif()
+    set(HASHLIBCXX_LTO_SUPPORTED ${result} PARENT_SCOPE)
+
+endfunction(set_interprocedural_optimization)
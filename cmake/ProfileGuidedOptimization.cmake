@@ -0,0 +1,44 @@
+function(set_profile_guided_optimization)
+
+    # Profile guided optimization, in two stages: GENERATE builds an instrumented library which
+    # writes the profiles in HASHLIBCXX_PGO_DIR while running a training workload, USE builds the
+    # library optimized with those profiles. Both stages must use the same build directory because
+    # gcc names the profiles after the object files.
+    if("${HASHLIBCXX_PGO}" STREQUAL "OFF")
+        return()
+    endif()
+
+    if(NOT "${HASHLIBCXX_PGO}" STREQUAL "GENERATE" AND NOT "${HASHLIBCXX_PGO}" STREQUAL "USE")
+        message(FATAL_ERROR "HASHLIBCXX_PGO must be one of OFF, GENERATE or USE")
+    endif()
+
+    file(TO_CMAKE_PATH "${HASHLIBCXX_PGO_DIR}" pgo_dir)
+
+    if("${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+        if("${HASHLIBCXX_PGO}" STREQUAL "GENERATE")
+            target_compile_options(${PROJECT_NAME} PRIVATE "-fprofile-generate=${pgo_dir}")
+            target_link_libraries(${PROJECT_NAME} PUBLIC "-fprofile-generate=${pgo_dir}")
+        elseif("${HASHLIBCXX_PGO}" STREQUAL "USE")
+            target_compile_options(${PROJECT_NAME}
+                PRIVATE "-fprofile-use=${pgo_dir}"
+                PRIVATE "-fprofile-correction"
+                PRIVATE "-Wno-missing-profile")
+        endif()
+    elseif("${CMAKE_CXX_COMPILER_ID}" MATCHES "Clang")
+        if("${HASHLIBCXX_PGO}" STREQUAL "GENERATE")
+            target_compile_options(${PROJECT_NAME} PRIVATE "-fprofile-instr-generate=${pgo_dir}/${PROJECT_NAME}-%p.profraw")
+            target_link_libraries(${PROJECT_NAME} PUBLIC "-fprofile-instr-generate")
+        elseif("${HASHLIBCXX_PGO}" STREQUAL "USE")
+            # the .profraw files must be merged first: llvm-profdata merge -output=<dir>/hashkitcxx.profdata <dir>/*.profraw
+            target_compile_options(${PROJECT_NAME}
+                PRIVATE "-fprofile-instr-use=${pgo_dir}/${PROJECT_NAME}.profdata"
+                PRIVATE "-Wno-profile-instr-out-of-date"
+                PRIVATE "-Wno-profile-instr-unprofiled")
+        endif()
+    #elseif ("${CMAKE_CXX_COMPILER_ID}" STREQUAL "MSVC")
+    else()
+        message(WARNING "Compiler ${CMAKE_CXX_COMPILER_ID} not found in CMake configuration. Profile guided optimization will not be used.")
+        return()
+    endif()
+
+endfunction(set_profile_guided_optimization)
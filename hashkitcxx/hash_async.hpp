@@ -0,0 +1,255 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_parallel.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+// This header requires C++20 (coroutines), see the option HASHLIBCXX_COROUTINES.
+
+namespace hashkitcxx {
+
+    constexpr size_t s_async_inline_size{1 << 16}; /**< Smallest input hashed on the executor */
+
+    /**
+     * @brief The awaitable returned by async_hash(): hashes the message on the calling thread when
+     * it is shorter than the inline size, otherwise suspends the coroutine, hashes the message on
+     * the executor and resumes the coroutine on the thread of the executor that hashed it.
+     * The message must stay valid until the co_await returns.
+     */
+    template<class THash, class TExecutor>
+    class hash_awaitable final
+    {
+      public:
+        using digest_t = typename THash::digest_t;
+
+        hash_awaitable(TExecutor & executor,
+                       const unsigned char * message,
+                       size_t len,
+                       size_t inline_size) noexcept
+            : m_executor{executor}, m_message{message}, m_len{len}, m_inline_size{inline_size}
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return m_len < m_inline_size;
+        }
+
+        void await_suspend(std::coroutine_handle<> continuation)
+        {
+            m_executor.execute([this, continuation]() {
+                THash().hash(m_message, m_len, m_digest.data());
+                continuation.resume();
+            });
+        }
+
+        digest_t await_resume() noexcept
+        {
+            if (await_ready())
+                THash().hash(m_message, m_len, m_digest.data());
+            return m_digest;
+        }
+
+      private:
+        TExecutor & m_executor;
+        const unsigned char * m_message;
+        size_t m_len;
+        size_t m_inline_size;
+        digest_t m_digest;
+    };
+
+    /**
+     * @brief Hashes a message without blocking the calling coroutine when the message is large:
+     * `auto digest = co_await async_hash<sha2::sha256>(executor, message, len);`
+     * @tparam THash one of the sha2 classes (e.g. `sha256`).
+     * @tparam TExecutor an object with the function `execute(std::function<void()>)`, see
+     * thread_pool.
+     * @param executor hashes the messages whose length is at least inline_size.
+     * @param message the message, valid until the co_await returns.
+     * @param len the length of the message expressed in bytes.
+     * @param inline_size the messages shorter than this are hashed on the calling thread,
+     * without suspending the coroutine.
+     * @return the awaitable returning the digest.
+     */
+    template<class THash, class TExecutor>
+    hash_awaitable<THash, TExecutor> async_hash(TExecutor & executor,
+                                                const unsigned char * message,
+                                                size_t len,
+                                                size_t inline_size = s_async_inline_size) noexcept
+    {
+        return {executor, message, len, inline_size};
+    }
+
+    /**
+     * @brief Hashes a message on the pool of the library when it is large, see the overload
+     * taking an executor.
+     */
+    template<class THash>
+    hash_awaitable<THash, thread_pool> async_hash(const unsigned char * message,
+                                                  size_t len) noexcept
+    {
+        return {default_thread_pool(), message, len, s_async_inline_size};
+    }
+
+    /**
+     * @brief Hashes a buffer on the pool of the library when it is large:
+     * `auto digest = co_await async_hash<sha2::sha256>(buffer);`
+     */
+    template<class THash>
+    hash_awaitable<THash, thread_pool> async_hash(std::span<const unsigned char> buffer) noexcept
+    {
+        return {default_thread_pool(), buffer.data(), buffer.size(), s_async_inline_size};
+    }
+
+    /**
+     * @brief A hash computed in parts, as the chunks of a message arrive (e.g. from network
+     * reads), whose large chunks are hashed on an executor:
+     *
+     *     async_context<sha2::sha256> context;
+     *     while (...)
+     *         co_await context.update(chunk, len);
+     *     auto digest = context.complete();
+     *
+     * Each update must be awaited before the next call, the chunk staying valid until then.
+     * complete() only compresses the last one or two blocks and never suspends.
+     */
+    template<class THash, class TExecutor = thread_pool>
+    class async_context final
+    {
+      public:
+        using digest_t = typename THash::digest_t;
+
+        /**
+         * @brief The awaitable returned by update().
+         */
+        class update_awaitable final
+        {
+          public:
+            update_awaitable(async_context & context,
+                             const unsigned char * chunk,
+                             size_t len) noexcept
+                : m_context{context}, m_chunk{chunk}, m_len{len}
+            {}
+
+            bool await_ready() const noexcept
+            {
+                return m_len < m_context.m_inline_size;
+            }
+
+            void await_suspend(std::coroutine_handle<> continuation)
+            {
+                m_context.m_executor.execute([this, continuation]() {
+                    m_context.m_hash.update(m_chunk, m_len);
+                    continuation.resume();
+                });
+            }
+
+            void await_resume() noexcept
+            {
+                if (await_ready())
+                    m_context.m_hash.update(m_chunk, m_len);
+            }
+
+          private:
+            async_context & m_context;
+            const unsigned char * m_chunk;
+            size_t m_len;
+        };
+
+        /**
+         * @brief Uses the pool of the library.
+         */
+        async_context() noexcept
+            requires std::is_same_v<TExecutor, thread_pool>
+            : m_executor{default_thread_pool()}
+        {
+            m_hash.init();
+        }
+
+        /**
+         * @param executor hashes the chunks whose length is at least inline_size.
+         * @param inline_size the chunks shorter than this are hashed on the calling thread.
+         */
+        explicit async_context(TExecutor & executor,
+                               size_t inline_size = s_async_inline_size) noexcept
+            : m_executor{executor}, m_inline_size{inline_size}
+        {
+            m_hash.init();
+        }
+
+        async_context(const async_context &) = delete;
+        async_context & operator=(const async_context &) = delete;
+
+        /**
+         * @brief Restarts the computation.
+         */
+        void init() noexcept
+        {
+            m_hash.init();
+        }
+
+        /**
+         * @brief Adds a chunk of the message.
+         * @return the awaitable, suspending the coroutine when the chunk is hashed on the executor.
+         */
+        update_awaitable update(const unsigned char * chunk, size_t len) noexcept
+        {
+            return {*this, chunk, len};
+        }
+
+        /**
+         * @brief Adds a chunk of the message, see the overload taking a pointer.
+         */
+        update_awaitable update(std::span<const unsigned char> chunk) noexcept
+        {
+            return {*this, chunk.data(), chunk.size()};
+        }
+
+        /**
+         * @brief Completes the computation, the context then needs init() to hash a new message.
+         */
+        digest_t complete() noexcept
+        {
+            digest_t digest;
+            m_hash.complete(digest.data());
+            return digest;
+        }
+
+      private:
+        TExecutor & m_executor;                    /**< Hashes the large chunks */
+        size_t m_inline_size{s_async_inline_size}; /**< Smallest chunk hashed on the executor */
+        THash m_hash;                              /**< The hash computed */
+    };
+
+} // namespace hashkitcxx
@@ -0,0 +1,1179 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: The BLAKE2 Cryptographic Hash and Message Authentication Code (MAC)
+ * Category of Standard: Informational (RFC 7693)
+ * Date Published: November 2015
+ * Author(s): Markku-Juhani O. Saarinen, Jean-Philippe Aumasson
+ * Resource link: https://www.rfc-editor.org/rfc/rfc7693
+ *
+ * BLAKE2bp and BLAKE2sp: https://www.blake2.net/blake2.pdf
+ */
+
+#include "hash_blake2.hpp"
+#include <cstring>
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(HASHLIBCXX_ASSERT)
+#    undef HASHLIBCXX_ASSERT
+#endif
+#if defined(HASHLIBCXX_STD_ASSERT)
+#    include <cassert>
+#    define HASHLIBCXX_ASSERT assert
+#else
+#    define HASHLIBCXX_ASSERT(x)
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define HASHLIBCXX_BLAKE2_SIMD
+#    include <immintrin.h>
+#endif
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wunused-macros"
+#endif
+
+// A round of the compression function on the state v and the message m, G being the function
+// applied to the columns and then to the diagonals
+#if defined(BLAKE2_ROUND)
+#    undef BLAKE2_ROUND
+#endif
+#define BLAKE2_ROUND(G, r)                                                                         \
+    {                                                                                              \
+        G(v, 0, 4, 8, 12, m[s_sigma[r][0]], m[s_sigma[r][1]]);                                     \
+        G(v, 1, 5, 9, 13, m[s_sigma[r][2]], m[s_sigma[r][3]]);                                     \
+        G(v, 2, 6, 10, 14, m[s_sigma[r][4]], m[s_sigma[r][5]]);                                    \
+        G(v, 3, 7, 11, 15, m[s_sigma[r][6]], m[s_sigma[r][7]]);                                    \
+        G(v, 0, 5, 10, 15, m[s_sigma[r][8]], m[s_sigma[r][9]]);                                    \
+        G(v, 1, 6, 11, 12, m[s_sigma[r][10]], m[s_sigma[r][11]]);                                  \
+        G(v, 2, 7, 8, 13, m[s_sigma[r][12]], m[s_sigma[r][13]]);                                   \
+        G(v, 3, 4, 9, 14, m[s_sigma[r][14]], m[s_sigma[r][15]]);                                   \
+    }
+
+#if defined(BLAKE2_ROUNDS_10)
+#    undef BLAKE2_ROUNDS_10
+#endif
+#if defined(BLAKE2_ROUNDS_12)
+#    undef BLAKE2_ROUNDS_12
+#endif
+#if defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
+#    define BLAKE2_ROUNDS_10(ROUND)                                                                \
+        ROUND(0) ROUND(1) ROUND(2) ROUND(3) ROUND(4) ROUND(5) ROUND(6) ROUND(7) ROUND(8) ROUND(9)
+#    define BLAKE2_ROUNDS_12(ROUND) BLAKE2_ROUNDS_10(ROUND) ROUND(10) ROUND(11)
+#else
+#    define BLAKE2_ROUNDS_10(ROUND)                                                                \
+        for (size_t r{0}; r < 10; ++r)                                                             \
+            ROUND(r)
+#    define BLAKE2_ROUNDS_12(ROUND)                                                                \
+        for (size_t r{0}; r < 12; ++r)                                                             \
+            ROUND(r)
+#endif
+
+#if defined(BLAKE2_ROUND_PORTABLE)
+#    undef BLAKE2_ROUND_PORTABLE
+#endif
+#define BLAKE2_ROUND_PORTABLE(r) BLAKE2_ROUND(g, r)
+
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#endif
+
+namespace hashkitcxx {
+    namespace blake2_impl {
+
+        constexpr uint64_t s_iv64[8]{0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+                                     0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+                                     0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+        constexpr uint32_t s_iv32[8]{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+        /**
+         * @brief The order of the message words in each round: BLAKE2b has 12 rounds, the last 2
+         * repeating the first 2.
+         */
+        constexpr uint8_t s_sigma[12][16]{
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+            {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+            {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+            {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+            {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+            {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+            {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+            {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+            {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+            {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+            {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+        /**
+         * @brief The parameters that differ between BLAKE2b and BLAKE2s.
+         */
+        template<typename TWord>
+        struct traits;
+
+        template<>
+        struct traits<uint64_t>
+        {
+            static constexpr size_t s_block_size{128};
+            static constexpr size_t s_rounds{12};
+            static constexpr unsigned s_r1{32}, s_r2{24}, s_r3{16}, s_r4{63};
+            static constexpr size_t s_node_depth{16}; /**< Position in the parameter block */
+            static const uint64_t * iv() noexcept { return s_iv64; }
+        };
+
+        template<>
+        struct traits<uint32_t>
+        {
+            static constexpr size_t s_block_size{64};
+            static constexpr size_t s_rounds{10};
+            static constexpr unsigned s_r1{16}, s_r2{12}, s_r3{8}, s_r4{7};
+            static constexpr size_t s_node_depth{14}; /**< Position in the parameter block */
+            static const uint32_t * iv() noexcept { return s_iv32; }
+        };
+
+        template<typename TWord>
+        TWord load(const unsigned char * bytes) noexcept;
+
+        template<>
+        HASHLIBCXX_INLINE uint32_t load<uint32_t>(const unsigned char * bytes) noexcept
+        {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                   (static_cast<uint32_t>(bytes[2]) << 16) |
+                   (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+
+        template<>
+        HASHLIBCXX_INLINE uint64_t load<uint64_t>(const unsigned char * bytes) noexcept
+        {
+            return static_cast<uint64_t>(load<uint32_t>(bytes)) |
+                   (static_cast<uint64_t>(load<uint32_t>(bytes + 4)) << 32);
+        }
+
+        /**
+         * @brief The high word of the 2-word counter: 0 for BLAKE2b, whose counter is limited to
+         * 64 bits. The shift is split in two, a shift by the width of the type being undefined.
+         */
+        template<typename TWord>
+        HASHLIBCXX_INLINE TWord counter_high(uint64_t counter) noexcept
+        {
+            return static_cast<TWord>((counter >> 16) >> (8 * sizeof(TWord) - 16));
+        }
+
+        // ------------------------------------------------------------------
+        // --- compression function -----------------------------------------
+
+        template<typename TWord>
+        HASHLIBCXX_INLINE TWord rotr(TWord word, unsigned count) noexcept
+        {
+            return static_cast<TWord>((word >> count) | (word << (8 * sizeof(TWord) - count)));
+        }
+
+        template<typename TWord>
+        HASHLIBCXX_INLINE void
+        g(TWord (&v)[16], size_t a, size_t b, size_t c, size_t d, TWord x, TWord y) noexcept
+        {
+            v[a] = v[a] + v[b] + x;
+            v[d] = rotr(static_cast<TWord>(v[d] ^ v[a]), traits<TWord>::s_r1);
+            v[c] = v[c] + v[d];
+            v[b] = rotr(static_cast<TWord>(v[b] ^ v[c]), traits<TWord>::s_r2);
+            v[a] = v[a] + v[b] + y;
+            v[d] = rotr(static_cast<TWord>(v[d] ^ v[a]), traits<TWord>::s_r3);
+            v[c] = v[c] + v[d];
+            v[b] = rotr(static_cast<TWord>(v[b] ^ v[c]), traits<TWord>::s_r4);
+        }
+
+        HASHLIBCXX_INLINE void rounds(uint64_t (&v)[16], const uint64_t (&m)[16]) noexcept
+        {
+            BLAKE2_ROUNDS_12(BLAKE2_ROUND_PORTABLE)
+        }
+
+        HASHLIBCXX_INLINE void rounds(uint32_t (&v)[16], const uint32_t (&m)[16]) noexcept
+        {
+            BLAKE2_ROUNDS_10(BLAKE2_ROUND_PORTABLE)
+        }
+
+        /**
+         * @brief Compresses consecutive blocks.
+         * @param counter the counter of the first block, the bytes compressed including the
+         * block; it grows by a block for each of the following ones.
+         * @param f0 the finalization flag, all ones for the last block of the message.
+         * @param f1 the flag of the last node of a level of the tree.
+         */
+        template<typename TWord>
+        HASHLIBCXX_INLINE void compress_portable(TWord * h,
+                                                 const unsigned char * blocks,
+                                                 size_t block_nb,
+                                                 uint64_t counter,
+                                                 TWord f0,
+                                                 TWord f1) noexcept
+        {
+            const TWord * iv{traits<TWord>::iv()};
+            for (size_t n{0}; n < block_nb; ++n)
+            {
+                const unsigned char * block{blocks + n * traits<TWord>::s_block_size};
+                TWord m[16];
+                for (size_t i{0}; i < 16; ++i)
+                    m[i] = load<TWord>(block + i * sizeof(TWord));
+
+                TWord v[16];
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    v[i] = h[i];
+                    v[i + 8] = iv[i];
+                }
+                v[12] ^= static_cast<TWord>(counter);
+                v[13] ^= counter_high<TWord>(counter);
+                v[14] ^= f0;
+                v[15] ^= f1;
+
+                rounds(v, m);
+                for (size_t i{0}; i < 8; ++i)
+                    h[i] ^= v[i] ^ v[i + 8];
+
+                counter += traits<TWord>::s_block_size;
+            }
+        }
+
+#if defined(HASHLIBCXX_BLAKE2_SIMD)
+        // ------------------------------------------------------------------
+        // --- single message kernels ---------------------------------------
+        //
+        // The 4x4 state is kept in 4 registers, a row each: the 4 G functions of a step run
+        // together, and the rows are rotated between the column and the diagonal steps. The
+        // 64-bit words of BLAKE2b fill an AVX2 register, the 32-bit words of BLAKE2s an SSE one.
+
+        __attribute__((target("avx2"), always_inline)) inline void
+        g_rows_avx2(__m256i & a,
+                    __m256i & b,
+                    __m256i & c,
+                    __m256i & d,
+                    const __m256i & x,
+                    const __m256i & y) noexcept
+        {
+            const __m256i rotr24{_mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8,
+                                                  9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14,
+                                                  15, 8, 9, 10)};
+            const __m256i rotr16{_mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15,
+                                                  8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13,
+                                                  14, 15, 8, 9)};
+
+            a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+            d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));
+            c = _mm256_add_epi64(c, d);
+            b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rotr24);
+            a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+            d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotr16);
+            c = _mm256_add_epi64(c, d);
+            b = _mm256_xor_si256(b, c);
+            b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+        }
+
+        __attribute__((target("avx2"), always_inline)) inline __m256i
+        words_avx2(const uint64_t (&m)[16],
+                   uint8_t i0,
+                   uint8_t i1,
+                   uint8_t i2,
+                   uint8_t i3) noexcept
+        {
+            return _mm256_setr_epi64x(static_cast<long long>(m[i0]),
+                                      static_cast<long long>(m[i1]),
+                                      static_cast<long long>(m[i2]),
+                                      static_cast<long long>(m[i3]));
+        }
+
+        __attribute__((target("avx2"), always_inline)) inline void
+        round_avx2(__m256i & a,
+                   __m256i & b,
+                   __m256i & c,
+                   __m256i & d,
+                   const uint64_t (&m)[16],
+                   const uint8_t (&s)[16]) noexcept
+        {
+            g_rows_avx2(a, b, c, d, words_avx2(m, s[0], s[2], s[4], s[6]),
+                        words_avx2(m, s[1], s[3], s[5], s[7]));
+
+            // the diagonals become the columns
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+            g_rows_avx2(a, b, c, d, words_avx2(m, s[8], s[10], s[12], s[14]),
+                        words_avx2(m, s[9], s[11], s[13], s[15]));
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+#    if defined(BLAKE2B_ROUND_AVX2)
+#        undef BLAKE2B_ROUND_AVX2
+#    endif
+#    define BLAKE2B_ROUND_AVX2(r) round_avx2(a, b, c, d, m, s_sigma[r]);
+
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+        compress_avx2(uint64_t * h,
+                      const unsigned char * blocks,
+                      size_t block_nb,
+                      uint64_t counter,
+                      uint64_t f0,
+                      uint64_t f1) noexcept
+        {
+            const __m256i iv0{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s_iv64))};
+            const __m256i iv1{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s_iv64 + 4))};
+            __m256i h0{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h))};
+            __m256i h1{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + 4))};
+
+            for (size_t n{0}; n < block_nb; ++n, counter += 128)
+            {
+                uint64_t m[16];
+                for (size_t i{0}; i < 16; ++i)
+                    m[i] = load<uint64_t>(blocks + n * 128 + i * 8);
+
+                __m256i a{h0};
+                __m256i b{h1};
+                __m256i c{iv0};
+                __m256i d{_mm256_xor_si256(
+                    iv1,
+                    _mm256_setr_epi64x(static_cast<long long>(counter),
+                                       0,
+                                       static_cast<long long>(f0),
+                                       static_cast<long long>(f1)))};
+                BLAKE2_ROUNDS_12(BLAKE2B_ROUND_AVX2)
+                h0 = _mm256_xor_si256(h0, _mm256_xor_si256(a, c));
+                h1 = _mm256_xor_si256(h1, _mm256_xor_si256(b, d));
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(h), h0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(h + 4), h1);
+        }
+
+        __attribute__((target("sse4.1"), always_inline)) inline void
+        g_rows_sse41(__m128i & a,
+                     __m128i & b,
+                     __m128i & c,
+                     __m128i & d,
+                     const __m128i & x,
+                     const __m128i & y) noexcept
+        {
+            const __m128i rotr16{
+                _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)};
+            const __m128i rotr8{
+                _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12)};
+
+            a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+            d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotr16);
+            c = _mm_add_epi32(c, d);
+            b = _mm_xor_si128(b, c);
+            b = _mm_xor_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+            a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+            d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotr8);
+            c = _mm_add_epi32(c, d);
+            b = _mm_xor_si128(b, c);
+            b = _mm_xor_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+        }
+
+        __attribute__((target("sse4.1"), always_inline)) inline __m128i
+        words_sse41(const uint32_t (&m)[16],
+                    uint8_t i0,
+                    uint8_t i1,
+                    uint8_t i2,
+                    uint8_t i3) noexcept
+        {
+            return _mm_setr_epi32(static_cast<int>(m[i0]),
+                                  static_cast<int>(m[i1]),
+                                  static_cast<int>(m[i2]),
+                                  static_cast<int>(m[i3]));
+        }
+
+        __attribute__((target("sse4.1"), always_inline)) inline void
+        round_sse41(__m128i & a,
+                    __m128i & b,
+                    __m128i & c,
+                    __m128i & d,
+                    const uint32_t (&m)[16],
+                    const uint8_t (&s)[16]) noexcept
+        {
+            g_rows_sse41(a, b, c, d, words_sse41(m, s[0], s[2], s[4], s[6]),
+                         words_sse41(m, s[1], s[3], s[5], s[7]));
+
+            // the diagonals become the columns
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1));
+            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3));
+            g_rows_sse41(a, b, c, d, words_sse41(m, s[8], s[10], s[12], s[14]),
+                         words_sse41(m, s[9], s[11], s[13], s[15]));
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3));
+            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+#    if defined(BLAKE2S_ROUND_SSE41)
+#        undef BLAKE2S_ROUND_SSE41
+#    endif
+#    define BLAKE2S_ROUND_SSE41(r) round_sse41(a, b, c, d, m, s_sigma[r]);
+
+        __attribute__((target("sse4.1"))) HASHLIBCXX_INLINE void
+        compress_sse41(uint32_t * h,
+                       const unsigned char * blocks,
+                       size_t block_nb,
+                       uint64_t counter,
+                       uint32_t f0,
+                       uint32_t f1) noexcept
+        {
+            const __m128i iv0{_mm_loadu_si128(reinterpret_cast<const __m128i *>(s_iv32))};
+            const __m128i iv1{_mm_loadu_si128(reinterpret_cast<const __m128i *>(s_iv32 + 4))};
+            __m128i h0{_mm_loadu_si128(reinterpret_cast<const __m128i *>(h))};
+            __m128i h1{_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + 4))};
+
+            for (size_t n{0}; n < block_nb; ++n, counter += 64)
+            {
+                uint32_t m[16];
+                for (size_t i{0}; i < 16; ++i)
+                    m[i] = load<uint32_t>(blocks + n * 64 + i * 4);
+
+                __m128i a{h0};
+                __m128i b{h1};
+                __m128i c{iv0};
+                __m128i d{_mm_xor_si128(iv1,
+                                        _mm_setr_epi32(static_cast<int>(counter),
+                                                       static_cast<int>(counter >> 32),
+                                                       static_cast<int>(f0),
+                                                       static_cast<int>(f1)))};
+                BLAKE2_ROUNDS_10(BLAKE2S_ROUND_SSE41)
+                h0 = _mm_xor_si128(h0, _mm_xor_si128(a, c));
+                h1 = _mm_xor_si128(h1, _mm_xor_si128(b, d));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(h), h0);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(h + 4), h1);
+        }
+
+        // ------------------------------------------------------------------
+        // --- multi-lane kernels -------------------------------------------
+        //
+        // The leaves of blake2bp and blake2sp are compressed together, the lane i of each vector
+        // belonging to the leaf i: 4 64-bit or 8 32-bit lanes fill an AVX2 register. As in
+        // hash_blake3.cpp the kernel is written with the vector extensions of the compiler and
+        // the vectors are passed by reference, a vector wider than the default target must not
+        // cross a call.
+
+        typedef uint64_t vec4x64_t __attribute__((vector_size(32)));
+        typedef uint32_t vec8x32_t __attribute__((vector_size(32)));
+
+        template<typename TWord, class TVec>
+        __attribute__((always_inline)) inline void rotr_lanes(TVec & word, unsigned count) noexcept
+        {
+            word = (word >> count) | (word << (8 * sizeof(TWord) - count));
+        }
+
+        template<typename TWord, class TVec>
+        __attribute__((always_inline)) inline void g_lanes(TVec (&v)[16],
+                                                           size_t a,
+                                                           size_t b,
+                                                           size_t c,
+                                                           size_t d,
+                                                           const TVec & x,
+                                                           const TVec & y) noexcept
+        {
+            v[a] += v[b] + x;
+            v[d] ^= v[a];
+            rotr_lanes<TWord>(v[d], traits<TWord>::s_r1);
+            v[c] += v[d];
+            v[b] ^= v[c];
+            rotr_lanes<TWord>(v[b], traits<TWord>::s_r2);
+            v[a] += v[b] + y;
+            v[d] ^= v[a];
+            rotr_lanes<TWord>(v[d], traits<TWord>::s_r3);
+            v[c] += v[d];
+            v[b] ^= v[c];
+            rotr_lanes<TWord>(v[b], traits<TWord>::s_r4);
+        }
+
+#    if defined(BLAKE2B_ROUND_LANES)
+#        undef BLAKE2B_ROUND_LANES
+#    endif
+#    define BLAKE2B_ROUND_LANES(r) BLAKE2_ROUND(g_lanes<uint64_t>, r)
+#    if defined(BLAKE2S_ROUND_LANES)
+#        undef BLAKE2S_ROUND_LANES
+#    endif
+#    define BLAKE2S_ROUND_LANES(r) BLAKE2_ROUND(g_lanes<uint32_t>, r)
+
+        __attribute__((always_inline)) inline void rounds_lanes(vec4x64_t (&v)[16],
+                                                                const vec4x64_t (&m)[16]) noexcept
+        {
+            BLAKE2_ROUNDS_12(BLAKE2B_ROUND_LANES)
+        }
+
+        __attribute__((always_inline)) inline void rounds_lanes(vec8x32_t (&v)[16],
+                                                                const vec8x32_t (&m)[16]) noexcept
+        {
+            BLAKE2_ROUNDS_10(BLAKE2S_ROUND_LANES)
+        }
+
+        /**
+         * @brief Compresses consecutive groups of N blocks, the block i of each group belonging
+         * to the leaf i. No block is the last of its leaf.
+         * @param counter the counter of the first group, the bytes compressed by each leaf
+         * including its block.
+         */
+        template<typename TWord, class TVec, size_t N>
+        __attribute__((always_inline)) inline void compress_lanes(TWord (&h)[8][N],
+                                                                  const unsigned char * groups,
+                                                                  size_t group_nb,
+                                                                  uint64_t counter) noexcept
+        {
+            static_assert(sizeof(TVec) == N * sizeof(TWord), "a lane per leaf");
+            constexpr size_t block_size{traits<TWord>::s_block_size};
+            const TWord * iv{traits<TWord>::iv()};
+
+            TVec hv[8];
+            std::memcpy(hv, h, sizeof(hv));
+
+            for (size_t n{0}; n < group_nb; ++n, counter += block_size)
+            {
+                TWord words[16][N];
+                for (size_t lane{0}; lane < N; ++lane)
+                {
+                    const unsigned char * block{groups + (n * N + lane) * block_size};
+                    for (size_t i{0}; i < 16; ++i)
+                        words[i][lane] = load<TWord>(block + i * sizeof(TWord));
+                }
+                TVec m[16];
+                std::memcpy(m, words, sizeof(m));
+
+                TVec v[16]{hv[0],
+                           hv[1],
+                           hv[2],
+                           hv[3],
+                           hv[4],
+                           hv[5],
+                           hv[6],
+                           hv[7],
+                           TVec{} + iv[0],
+                           TVec{} + iv[1],
+                           TVec{} + iv[2],
+                           TVec{} + iv[3],
+                           TVec{} + static_cast<TWord>(iv[4] ^ static_cast<TWord>(counter)),
+                           TVec{} + static_cast<TWord>(iv[5] ^ counter_high<TWord>(counter)),
+                           TVec{} + iv[6],
+                           TVec{} + iv[7]};
+                rounds_lanes(v, m);
+                for (size_t i{0}; i < 8; ++i)
+                    hv[i] ^= v[i] ^ v[i + 8];
+            }
+
+            std::memcpy(h, hv, sizeof(hv));
+        }
+
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+        compress_4_avx2(uint64_t (&h)[8][4],
+                        const unsigned char * groups,
+                        size_t group_nb,
+                        uint64_t counter) noexcept
+        {
+            compress_lanes<uint64_t, vec4x64_t, 4>(h, groups, group_nb, counter);
+        }
+
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+        compress_8_avx2(uint32_t (&h)[8][8],
+                        const unsigned char * groups,
+                        size_t group_nb,
+                        uint64_t counter) noexcept
+        {
+            compress_lanes<uint32_t, vec8x32_t, 8>(h, groups, group_nb, counter);
+        }
+
+        HASHLIBCXX_INLINE bool has_avx2() noexcept
+        {
+            static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+            return avx2;
+        }
+
+        HASHLIBCXX_INLINE bool has_sse41() noexcept
+        {
+            static const bool sse41{__builtin_cpu_supports("sse4.1") != 0};
+            return sse41;
+        }
+#endif
+
+        HASHLIBCXX_INLINE void compress(uint64_t * h,
+                                        const unsigned char * blocks,
+                                        size_t block_nb,
+                                        uint64_t counter,
+                                        uint64_t f0,
+                                        uint64_t f1) noexcept
+        {
+#if defined(HASHLIBCXX_BLAKE2_SIMD)
+            if (has_avx2())
+                return compress_avx2(h, blocks, block_nb, counter, f0, f1);
+#endif
+            compress_portable(h, blocks, block_nb, counter, f0, f1);
+        }
+
+        HASHLIBCXX_INLINE void compress(uint32_t * h,
+                                        const unsigned char * blocks,
+                                        size_t block_nb,
+                                        uint64_t counter,
+                                        uint32_t f0,
+                                        uint32_t f1) noexcept
+        {
+#if defined(HASHLIBCXX_BLAKE2_SIMD)
+            if (has_sse41())
+                return compress_sse41(h, blocks, block_nb, counter, f0, f1);
+#endif
+            compress_portable(h, blocks, block_nb, counter, f0, f1);
+        }
+
+        /**
+         * @brief Compresses the leaves one at a time, when the processor has no AVX2.
+         */
+        template<typename TWord, size_t N>
+        HASHLIBCXX_INLINE void compress_leaves_portable(TWord (&h)[8][N],
+                                                        const unsigned char * groups,
+                                                        size_t group_nb,
+                                                        uint64_t counter) noexcept
+        {
+            constexpr size_t block_size{traits<TWord>::s_block_size};
+            for (size_t lane{0}; lane < N; ++lane)
+            {
+                TWord leaf[8];
+                for (size_t i{0}; i < 8; ++i)
+                    leaf[i] = h[i][lane];
+                for (size_t n{0}; n < group_nb; ++n)
+                {
+                    compress(leaf, groups + (n * N + lane) * block_size, 1,
+                             counter + n * block_size, 0, 0);
+                }
+                for (size_t i{0}; i < 8; ++i)
+                    h[i][lane] = leaf[i];
+            }
+        }
+
+        HASHLIBCXX_INLINE void compress_leaves(uint64_t (&h)[8][4],
+                                               const unsigned char * groups,
+                                               size_t group_nb,
+                                               uint64_t counter) noexcept
+        {
+#if defined(HASHLIBCXX_BLAKE2_SIMD)
+            if (has_avx2())
+                return compress_4_avx2(h, groups, group_nb, counter);
+#endif
+            compress_leaves_portable(h, groups, group_nb, counter);
+        }
+
+        HASHLIBCXX_INLINE void compress_leaves(uint32_t (&h)[8][8],
+                                               const unsigned char * groups,
+                                               size_t group_nb,
+                                               uint64_t counter) noexcept
+        {
+#if defined(HASHLIBCXX_BLAKE2_SIMD)
+            if (has_avx2())
+                return compress_8_avx2(h, groups, group_nb, counter);
+#endif
+            compress_leaves_portable(h, groups, group_nb, counter);
+        }
+
+        // ------------------------------------------------------------------
+        // --- nodes --------------------------------------------------------
+
+        /**
+         * @brief The initial hash value: the IV xored with the parameter block, whose leaf length
+         * and salt and personalization are 0.
+         */
+        template<typename TWord>
+        HASHLIBCXX_INLINE void init_param(TWord (&h)[8],
+                                          size_t digest_size,
+                                          size_t key_size,
+                                          size_t fanout,
+                                          size_t depth,
+                                          size_t node_offset,
+                                          size_t node_depth,
+                                          size_t inner_size) noexcept
+        {
+            unsigned char param[8 * sizeof(TWord)]{};
+            param[0] = static_cast<unsigned char>(digest_size);
+            param[1] = static_cast<unsigned char>(key_size);
+            param[2] = static_cast<unsigned char>(fanout);
+            param[3] = static_cast<unsigned char>(depth);
+            param[8] = static_cast<unsigned char>(node_offset);
+            param[traits<TWord>::s_node_depth] = static_cast<unsigned char>(node_depth);
+            param[traits<TWord>::s_node_depth + 1] = static_cast<unsigned char>(inner_size);
+
+            const TWord * iv{traits<TWord>::iv()};
+            for (size_t i{0}; i < 8; ++i)
+                h[i] = iv[i] ^ load<TWord>(param + i * sizeof(TWord));
+        }
+
+        template<typename TWord>
+        HASHLIBCXX_INLINE void init(state_t<TWord> & state,
+                                    const unsigned char * key,
+                                    size_t key_size,
+                                    size_t digest_size) noexcept
+        {
+            HASHLIBCXX_ASSERT(digest_size > 0 && digest_size <= 8 * sizeof(TWord));
+            HASHLIBCXX_ASSERT(key_size <= 8 * sizeof(TWord) && (key || key_size == 0));
+
+            init_param(state.h, digest_size, key_size, 1, 1, 0, 0, 0);
+            state.counter = 0;
+            state.len = 0;
+            state.digest_size = digest_size;
+            state.key_size = key_size;
+            if (key_size > 0)
+            {
+                // the key, padded to a block, is the first block of the message
+                std::memset(state.block, 0, sizeof(state.block));
+                std::memcpy(state.block, key, key_size);
+                state.len = sizeof(state.block);
+            }
+        }
+
+        /**
+         * @brief Adds a part of the message, keeping the last block of the message until
+         * complete(), which compresses it differently.
+         */
+        template<typename TWord>
+        HASHLIBCXX_INLINE void
+        update(state_t<TWord> & state, const unsigned char * message, size_t len) noexcept
+        {
+            constexpr size_t block_size{traits<TWord>::s_block_size};
+
+            if (len > block_size - state.len)
+            {
+                const size_t fill{block_size - state.len};
+                std::memcpy(state.block + state.len, message, fill);
+                state.counter += block_size;
+                compress(state.h, state.block, 1, state.counter, 0, 0);
+                state.len = 0;
+                message += fill;
+                len -= fill;
+
+                const size_t block_nb{(len - 1) / block_size};
+                compress(state.h, message, block_nb, state.counter + block_size, 0, 0);
+                state.counter += block_nb * block_size;
+                message += block_nb * block_size;
+                len -= block_nb * block_size;
+            }
+
+            std::memcpy(state.block + state.len, message, len);
+            state.len += len;
+        }
+
+        /**
+         * @brief Compresses the last block and writes the hash, `TWord` little-endian words.
+         * @param last_node whether the node is the last of its level of the tree.
+         */
+        template<typename TWord>
+        HASHLIBCXX_INLINE void complete(const state_t<TWord> & state,
+                                        unsigned char * digest,
+                                        bool last_node) noexcept
+        {
+            TWord h[8];
+            std::memcpy(h, state.h, sizeof(h));
+            unsigned char block[traits<TWord>::s_block_size]{};
+            std::memcpy(block, state.block, state.len);
+            compress(h, block, 1, state.counter + state.len, static_cast<TWord>(~TWord{0}),
+                     last_node ? static_cast<TWord>(~TWord{0}) : TWord{0});
+
+            for (size_t i{0}; i < state.digest_size; ++i)
+                digest[i] = static_cast<unsigned char>(h[i / sizeof(TWord)] >>
+                                                       (8 * (i % sizeof(TWord))));
+        }
+
+        template<typename TWord>
+        HASHLIBCXX_INLINE uint64_t processed_size(const state_t<TWord> & state) noexcept
+        {
+            const uint64_t key_block{state.key_size > 0 ? traits<TWord>::s_block_size : 0};
+            return state.counter + state.len - key_block;
+        }
+
+        // ------------------------------------------------------------------
+        // --- trees --------------------------------------------------------
+
+        template<typename TWord, size_t N>
+        HASHLIBCXX_INLINE void init(tree_t<TWord, N> & tree,
+                                    const unsigned char * key,
+                                    size_t key_size,
+                                    size_t digest_size) noexcept
+        {
+            HASHLIBCXX_ASSERT(digest_size > 0 && digest_size <= 8 * sizeof(TWord));
+            HASHLIBCXX_ASSERT(key_size <= 8 * sizeof(TWord) && (key || key_size == 0));
+
+            constexpr size_t block_size{traits<TWord>::s_block_size};
+            for (size_t lane{0}; lane < N; ++lane)
+            {
+                TWord h[8];
+                init_param(h, digest_size, key_size, N, 2, lane, 0, 8 * sizeof(TWord));
+                for (size_t i{0}; i < 8; ++i)
+                    tree.h[i][lane] = h[i];
+            }
+            tree.counter = 0;
+            tree.len = 0;
+            tree.digest_size = digest_size;
+            tree.key_size = key_size;
+            if (key_size > 0)
+            {
+                // each leaf starts with the key, padded to a block
+                std::memset(tree.buffer, 0, N * block_size);
+                for (size_t lane{0}; lane < N; ++lane)
+                    std::memcpy(tree.buffer + lane * block_size, key, key_size);
+                tree.len = N * block_size;
+            }
+        }
+
+        /**
+         * @brief Adds a part of the message. A group of N blocks, a block per leaf, is compressed
+         * when followed by another whole group: no block of the group is the last of its leaf.
+         */
+        template<typename TWord, size_t N>
+        HASHLIBCXX_INLINE void
+        update(tree_t<TWord, N> & tree, const unsigned char * message, size_t len) noexcept
+        {
+            constexpr size_t group_size{N * traits<TWord>::s_block_size};
+
+            while (tree.len > 0 && tree.len + len >= 2 * group_size)
+            {
+                if (tree.len < group_size)
+                {
+                    const size_t fill{group_size - tree.len};
+                    std::memcpy(tree.buffer + tree.len, message, fill);
+                    tree.len = group_size;
+                    message += fill;
+                    len -= fill;
+                }
+                compress_leaves(tree.h, tree.buffer, 1, tree.counter + traits<TWord>::s_block_size);
+                tree.counter += traits<TWord>::s_block_size;
+                tree.len -= group_size;
+                std::memmove(tree.buffer, tree.buffer + group_size, tree.len);
+            }
+
+            if (tree.len == 0 && len >= 2 * group_size)
+            {
+                const size_t group_nb{len / group_size - 1};
+                compress_leaves(tree.h, message, group_nb,
+                                tree.counter + traits<TWord>::s_block_size);
+                tree.counter += group_nb * traits<TWord>::s_block_size;
+                message += group_nb * group_size;
+                len -= group_nb * group_size;
+            }
+
+            std::memcpy(tree.buffer + tree.len, message, len);
+            tree.len += len;
+        }
+
+        /**
+         * @brief Completes the leaves with their blocks in the buffer, then hashes their hashes
+         * in the root.
+         */
+        template<typename TWord, size_t N>
+        HASHLIBCXX_INLINE void complete(const tree_t<TWord, N> & tree,
+                                        unsigned char * digest) noexcept
+        {
+            constexpr size_t block_size{traits<TWord>::s_block_size};
+            constexpr size_t group_size{N * block_size};
+            constexpr size_t inner_size{8 * sizeof(TWord)};
+
+            unsigned char leaves[N * inner_size];
+            for (size_t lane{0}; lane < N; ++lane)
+            {
+                state_t<TWord> leaf;
+                for (size_t i{0}; i < 8; ++i)
+                    leaf.h[i] = tree.h[i][lane];
+                leaf.counter = tree.counter;
+                leaf.digest_size = inner_size;
+                for (size_t offset{lane * block_size}; offset < tree.len; offset += group_size)
+                {
+                    const size_t rem{tree.len - offset};
+                    update(leaf, tree.buffer + offset, rem < block_size ? rem : block_size);
+                }
+                complete(leaf, leaves + lane * inner_size, lane + 1 == N);
+            }
+
+            state_t<TWord> root;
+            init_param(root.h, tree.digest_size, tree.key_size, N, 2, 0, 1, inner_size);
+            root.digest_size = tree.digest_size;
+            update(root, leaves, sizeof(leaves));
+            complete(root, digest, true);
+        }
+
+        template<typename TWord, size_t N>
+        HASHLIBCXX_INLINE uint64_t processed_size(const tree_t<TWord, N> & tree) noexcept
+        {
+            const uint64_t key_blocks{tree.key_size > 0 ? N * traits<TWord>::s_block_size : 0};
+            return N * tree.counter + tree.len - key_blocks;
+        }
+
+        /**
+         * @brief Writes the `size` bytes of a hash in hex, followed by \0.
+         */
+        HASHLIBCXX_INLINE void to_printable(const unsigned char * digest,
+                                            size_t size,
+                                            char * digest_printable) noexcept
+        {
+            static constexpr char digits[]{"0123456789abcdef"};
+            for (size_t i{0}; i < size; ++i)
+            {
+                digest_printable[2 * i] = digits[digest[i] >> 4];
+                digest_printable[2 * i + 1] = digits[digest[i] & 0x0f];
+            }
+            digest_printable[2 * size] = '\0';
+        }
+
+    } // namespace blake2_impl
+
+    // ------------------------------------------------------------------
+    // --- blake2b ------------------------------------------------------
+
+    HASHLIBCXX_INLINE void blake2b::hash_printable(const unsigned char * message,
+                                                 size_t len,
+                                                 char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        blake2_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void blake2b::init(size_t digest_size) noexcept
+    {
+        blake2_impl::init(m_state, nullptr, 0, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2b::init_keyed(const unsigned char * key,
+                                             size_t key_len,
+                                             size_t digest_size) noexcept
+    {
+        HASHLIBCXX_ASSERT(key_len > 0);
+
+        blake2_impl::init(m_state, key, key_len, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2b::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        blake2_impl::update(m_state, message, len);
+    }
+
+    HASHLIBCXX_INLINE void blake2b::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        blake2_impl::complete(m_state, digest, false);
+    }
+
+    HASHLIBCXX_INLINE size_t blake2b::digest_size() const noexcept
+    {
+        return m_state.digest_size;
+    }
+
+    HASHLIBCXX_INLINE uint64_t blake2b::processed_size() const noexcept
+    {
+        return blake2_impl::processed_size(m_state);
+    }
+
+    // ------------------------------------------------------------------
+    // --- blake2s ------------------------------------------------------
+
+    HASHLIBCXX_INLINE void blake2s::hash_printable(const unsigned char * message,
+                                                 size_t len,
+                                                 char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        blake2_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void blake2s::init(size_t digest_size) noexcept
+    {
+        blake2_impl::init(m_state, nullptr, 0, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2s::init_keyed(const unsigned char * key,
+                                             size_t key_len,
+                                             size_t digest_size) noexcept
+    {
+        HASHLIBCXX_ASSERT(key_len > 0);
+
+        blake2_impl::init(m_state, key, key_len, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2s::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        blake2_impl::update(m_state, message, len);
+    }
+
+    HASHLIBCXX_INLINE void blake2s::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        blake2_impl::complete(m_state, digest, false);
+    }
+
+    HASHLIBCXX_INLINE size_t blake2s::digest_size() const noexcept
+    {
+        return m_state.digest_size;
+    }
+
+    HASHLIBCXX_INLINE uint64_t blake2s::processed_size() const noexcept
+    {
+        return blake2_impl::processed_size(m_state);
+    }
+
+    // ------------------------------------------------------------------
+    // --- blake2bp -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void blake2bp::hash_printable(const unsigned char * message,
+                                                  size_t len,
+                                                  char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        blake2_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void blake2bp::init(size_t digest_size) noexcept
+    {
+        blake2_impl::init(m_tree, nullptr, 0, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2bp::init_keyed(const unsigned char * key,
+                                              size_t key_len,
+                                              size_t digest_size) noexcept
+    {
+        HASHLIBCXX_ASSERT(key_len > 0);
+
+        blake2_impl::init(m_tree, key, key_len, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2bp::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        blake2_impl::update(m_tree, message, len);
+    }
+
+    HASHLIBCXX_INLINE void blake2bp::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        blake2_impl::complete(m_tree, digest);
+    }
+
+    HASHLIBCXX_INLINE size_t blake2bp::digest_size() const noexcept
+    {
+        return m_tree.digest_size;
+    }
+
+    HASHLIBCXX_INLINE uint64_t blake2bp::processed_size() const noexcept
+    {
+        return blake2_impl::processed_size(m_tree);
+    }
+
+    // ------------------------------------------------------------------
+    // --- blake2sp -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void blake2sp::hash_printable(const unsigned char * message,
+                                                  size_t len,
+                                                  char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        blake2_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void blake2sp::init(size_t digest_size) noexcept
+    {
+        blake2_impl::init(m_tree, nullptr, 0, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2sp::init_keyed(const unsigned char * key,
+                                              size_t key_len,
+                                              size_t digest_size) noexcept
+    {
+        HASHLIBCXX_ASSERT(key_len > 0);
+
+        blake2_impl::init(m_tree, key, key_len, digest_size);
+    }
+
+    HASHLIBCXX_INLINE void blake2sp::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        blake2_impl::update(m_tree, message, len);
+    }
+
+    HASHLIBCXX_INLINE void blake2sp::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        blake2_impl::complete(m_tree, digest);
+    }
+
+    HASHLIBCXX_INLINE size_t blake2sp::digest_size() const noexcept
+    {
+        return m_tree.digest_size;
+    }
+
+    HASHLIBCXX_INLINE uint64_t blake2sp::processed_size() const noexcept
+    {
+        return blake2_impl::processed_size(m_tree);
+    }
+
+} // namespace hashkitcxx
+
+// in header-only mode this file is included by hash_blake2.hpp: do not leak the macros to the user
+#undef HASHLIBCXX_BLAKE2_SIMD
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_INLINE
+#undef BLAKE2_ROUND
+#undef BLAKE2_ROUNDS_10
+#undef BLAKE2_ROUNDS_12
+#undef BLAKE2_ROUND_PORTABLE
+#undef BLAKE2B_ROUND_AVX2
+#undef BLAKE2S_ROUND_SSE41
+#undef BLAKE2B_ROUND_LANES
+#undef BLAKE2S_ROUND_LANES
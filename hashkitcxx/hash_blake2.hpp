@@ -0,0 +1,1076 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: The BLAKE2 Cryptographic Hash and Message Authentication Code (MAC)
+ * Category of Standard: Informational (RFC 7693)
+ * Date Published: November 2015
+ * Author(s): Markku-Juhani O. Saarinen, Jean-Philippe Aumasson
+ * Resource link: https://www.rfc-editor.org/rfc/rfc7693
+ *
+ * BLAKE2bp and BLAKE2sp: https://www.blake2.net/blake2.pdf
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#if defined(HASHLIBCXX_STD_STRING)
+#    include <string>
+#endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
+
+// The algorithm does not depend on sha2, so this header does not include hash_sha2.hpp
+#if defined(HASHLIBCXX_DLL)
+#    undef HASHLIBCXX_DLL
+#endif
+#if defined(hashlibcxx_library_EXPORTS)
+#    define HASHLIBCXX_DLL __declspec(dllexport)
+#else
+#    define HASHLIBCXX_DLL
+#endif
+
+namespace hashkitcxx {
+    namespace blake2_impl {
+
+        /**
+         * @brief The state of a BLAKE2b (TWord = uint64_t) or BLAKE2s (TWord = uint32_t) hash.
+         */
+        template<typename TWord>
+        struct state_t
+        {
+            TWord h[8]{};                              /**< Hash value */
+            uint64_t counter{0};                       /**< Bytes compressed */
+            unsigned char block[16 * sizeof(TWord)]{}; /**< The bytes not compressed yet */
+            size_t len{0};                             /**< Length of block */
+            size_t digest_size{0};                     /**< Size of the hash */
+            size_t key_size{0};                        /**< Size of the key, 0 if none */
+        };
+
+        /**
+         * @brief The state of a BLAKE2bp or BLAKE2sp hash: the leaves compressed so far, all by the
+         * same number of blocks, and the message not compressed yet. The buffer is compressed
+         * only when each leaf has a block after it, since the last block of a leaf is compressed
+         * differently.
+         */
+        template<typename TWord, size_t N>
+        struct tree_t
+        {
+            TWord h[8][N]{};                                    /**< Hash values, a lane per leaf */
+            uint64_t counter{0};                                /**< Bytes compressed by a leaf */
+            unsigned char buffer[2 * N * 16 * sizeof(TWord)]{}; /**< The bytes not compressed yet */
+            size_t len{0};                                      /**< Length of buffer */
+            size_t digest_size{0};                              /**< Size of the hash */
+            size_t key_size{0};                                 /**< Size of the key, 0 if none */
+        };
+
+    } // namespace blake2_impl
+
+    // ------------------------------------------------------------------
+    // --- blake2b ------------------------------------------------------
+
+    /**
+     * @brief BLAKE2b, optimized for 64-bit platforms, with hashes of up to 64 bytes and an optional
+     * key. The blocks are compressed by an AVX2 kernel when the processor supports it.
+     */
+    class HASHLIBCXX_DLL blake2b final
+    {
+      public:
+        static constexpr size_t s_block_size{128}; /**< Size expressed in byte of a block */
+        static constexpr size_t s_key_size{64};    /**< Maximum size expressed in byte of the key */
+        static constexpr size_t s_digest_size{
+            512 / 8}; /**< Size expressed in byte of the default hash, see init() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        blake2b() = default;
+        ~blake2b() {}
+        blake2b(blake2b &&) = default;
+        blake2b(const blake2b &) = default;
+        blake2b & operator=(blake2b &&) = default;
+        blake2b & operator=(const blake2b &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`:
+         * a shorter hash is not a prefix of the longer ones.
+         */
+        void init(size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Starts a new keyed hash computation, a MAC or a PRF.
+         * @param key pointer to the memory location containing the key.
+         * @param key_len the length of `key` expressed in bytes, from 1 to `s_key_size`.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`.
+         */
+        void init_keyed(const unsigned char * key,
+                        size_t key_len,
+                        size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the digest_size() bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the size expressed in bytes of the hash, chosen by init().
+         */
+        size_t digest_size() const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        blake2_impl::state_t<uint64_t> m_state; /**< The hash being computed */
+    };
+
+    // ------------------------------------------------------------------
+    // --- blake2s ------------------------------------------------------
+
+    /**
+     * @brief BLAKE2s, optimized for 8 to 32-bit platforms, with hashes of up to 32 bytes and an
+     * optional key. The blocks are compressed by an SSE4.1 kernel when the processor supports it.
+     */
+    class HASHLIBCXX_DLL blake2s final
+    {
+      public:
+        static constexpr size_t s_block_size{64}; /**< Size expressed in byte of a block */
+        static constexpr size_t s_key_size{32};   /**< Maximum size expressed in byte of the key */
+        static constexpr size_t s_digest_size{
+            256 / 8}; /**< Size expressed in byte of the default hash, see init() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        blake2s() = default;
+        ~blake2s() {}
+        blake2s(blake2s &&) = default;
+        blake2s(const blake2s &) = default;
+        blake2s & operator=(blake2s &&) = default;
+        blake2s & operator=(const blake2s &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`:
+         * a shorter hash is not a prefix of the longer ones.
+         */
+        void init(size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Starts a new keyed hash computation, a MAC or a PRF.
+         * @param key pointer to the memory location containing the key.
+         * @param key_len the length of `key` expressed in bytes, from 1 to `s_key_size`.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`.
+         */
+        void init_keyed(const unsigned char * key,
+                        size_t key_len,
+                        size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the digest_size() bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the size expressed in bytes of the hash, chosen by init().
+         */
+        size_t digest_size() const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        blake2_impl::state_t<uint32_t> m_state; /**< The hash being computed */
+    };
+
+    // ------------------------------------------------------------------
+    // --- blake2bp -----------------------------------------------------
+
+    /**
+     * @brief BLAKE2bp, the 4-way parallel variant of BLAKE2b: the blocks of the message are dealt
+     * in turn to 4 leaves, whose hashes are hashed by the root. With AVX2 the 4 leaves are
+     * compressed together, a 64-bit lane each, so a single message uses the whole vector width.
+     * The result differs from blake2b.
+     */
+    class HASHLIBCXX_DLL blake2bp final
+    {
+      public:
+        static constexpr size_t s_block_size{128}; /**< Size expressed in byte of a block */
+        static constexpr size_t s_key_size{64};    /**< Maximum size expressed in byte of the key */
+        static constexpr size_t s_degree{4};       /**< Leaves hashed in parallel */
+        static constexpr size_t s_digest_size{
+            512 / 8}; /**< Size expressed in byte of the default hash, see init() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        blake2bp() = default;
+        ~blake2bp() {}
+        blake2bp(blake2bp &&) = default;
+        blake2bp(const blake2bp &) = default;
+        blake2bp & operator=(blake2bp &&) = default;
+        blake2bp & operator=(const blake2bp &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`:
+         * a shorter hash is not a prefix of the longer ones.
+         */
+        void init(size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Starts a new keyed hash computation, a MAC or a PRF.
+         * @param key pointer to the memory location containing the key.
+         * @param key_len the length of `key` expressed in bytes, from 1 to `s_key_size`.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`.
+         */
+        void init_keyed(const unsigned char * key,
+                        size_t key_len,
+                        size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the digest_size() bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the size expressed in bytes of the hash, chosen by init().
+         */
+        size_t digest_size() const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        blake2_impl::tree_t<uint64_t, s_degree> m_tree; /**< The leaves and the buffered message */
+    };
+
+    // ------------------------------------------------------------------
+    // --- blake2sp -----------------------------------------------------
+
+    /**
+     * @brief BLAKE2sp, the 8-way parallel variant of BLAKE2s: the blocks of the message are dealt
+     * in turn to 8 leaves, whose hashes are hashed by the root. With AVX2 the 8 leaves are
+     * compressed together, a 32-bit lane each, so a single message uses the whole vector width.
+     * The result differs from blake2s.
+     */
+    class HASHLIBCXX_DLL blake2sp final
+    {
+      public:
+        static constexpr size_t s_block_size{64}; /**< Size expressed in byte of a block */
+        static constexpr size_t s_key_size{32};   /**< Maximum size expressed in byte of the key */
+        static constexpr size_t s_degree{8};      /**< Leaves hashed in parallel */
+        static constexpr size_t s_digest_size{
+            256 / 8}; /**< Size expressed in byte of the default hash, see init() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        blake2sp() = default;
+        ~blake2sp() {}
+        blake2sp(blake2sp &&) = default;
+        blake2sp(const blake2sp &) = default;
+        blake2sp & operator=(blake2sp &&) = default;
+        blake2sp & operator=(const blake2sp &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`:
+         * a shorter hash is not a prefix of the longer ones.
+         */
+        void init(size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Starts a new keyed hash computation, a MAC or a PRF.
+         * @param key pointer to the memory location containing the key.
+         * @param key_len the length of `key` expressed in bytes, from 1 to `s_key_size`.
+         * @param digest_size the size expressed in bytes of the hash, from 1 to `s_digest_size`.
+         */
+        void init_keyed(const unsigned char * key,
+                        size_t key_len,
+                        size_t digest_size = s_digest_size) noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the digest_size() bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the size expressed in bytes of the hash, chosen by init().
+         */
+        size_t digest_size() const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        blake2_impl::tree_t<uint32_t, s_degree> m_tree; /**< The leaves and the buffered message */
+    };
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_blake2.cpp"
+#endif
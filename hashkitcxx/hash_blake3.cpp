@@ -0,0 +1,976 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * BLAKE3: one function, fast everywhere
+ * Author(s): Jack O'Connor, Jean-Philippe Aumasson, Samuel Neves, Zooko Wilcox-O'Hearn
+ * Resource link: https://github.com/BLAKE3-team/BLAKE3-specs
+ */
+
+#include "hash_blake3.hpp"
+#include <cstring>
+#include <thread>
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(HASHLIBCXX_ASSERT)
+#    undef HASHLIBCXX_ASSERT
+#endif
+#if defined(HASHLIBCXX_STD_ASSERT)
+#    include <cassert>
+#    define HASHLIBCXX_ASSERT assert
+#else
+#    define HASHLIBCXX_ASSERT(x)
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define HASHLIBCXX_BLAKE3_SIMD
+#endif
+
+namespace hashkitcxx {
+    namespace blake3_impl {
+
+        constexpr uint32_t s_iv[8]{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+        /**
+         * @brief The order of the message words in each round.
+         */
+        constexpr uint8_t s_schedule[7][16]{
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+            {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+            {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+            {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+            {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+            {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+            {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13}};
+
+        enum flag : uint8_t
+        {
+            chunk_start = 1 << 0,
+            chunk_end = 1 << 1,
+            parent = 1 << 2,
+            root = 1 << 3,
+            keyed_hash = 1 << 4,
+            derive_key_context = 1 << 5,
+            derive_key_material = 1 << 6
+        };
+
+        constexpr size_t s_out_size{32};            /**< Size of a chaining value */
+        constexpr size_t s_max_simd_degree{16};     /**< Most inputs hashed together */
+        constexpr size_t s_min_parallel_size{1 << 17}; /**< Smallest subtree split on threads */
+
+        HASHLIBCXX_INLINE uint32_t load32(const unsigned char * bytes) noexcept
+        {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                   (static_cast<uint32_t>(bytes[2]) << 16) |
+                   (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+
+        HASHLIBCXX_INLINE void store32(unsigned char * bytes, uint32_t word) noexcept
+        {
+            bytes[0] = static_cast<unsigned char>(word);
+            bytes[1] = static_cast<unsigned char>(word >> 8);
+            bytes[2] = static_cast<unsigned char>(word >> 16);
+            bytes[3] = static_cast<unsigned char>(word >> 24);
+        }
+
+        HASHLIBCXX_INLINE void load_key(uint32_t (&key)[8], const unsigned char * bytes) noexcept
+        {
+            for (size_t i{0}; i < 8; ++i)
+                key[i] = load32(bytes + 4 * i);
+        }
+
+        // ------------------------------------------------------------------
+        // --- compression function -----------------------------------------
+
+        HASHLIBCXX_INLINE uint32_t rotr32(uint32_t word, unsigned count) noexcept
+        {
+            return (word >> count) | (word << (32 - count));
+        }
+
+        HASHLIBCXX_INLINE void
+        g(uint32_t * state, size_t a, size_t b, size_t c, size_t d, uint32_t x, uint32_t y) noexcept
+        {
+            state[a] = state[a] + state[b] + x;
+            state[d] = rotr32(state[d] ^ state[a], 16);
+            state[c] = state[c] + state[d];
+            state[b] = rotr32(state[b] ^ state[c], 12);
+            state[a] = state[a] + state[b] + y;
+            state[d] = rotr32(state[d] ^ state[a], 8);
+            state[c] = state[c] + state[d];
+            state[b] = rotr32(state[b] ^ state[c], 7);
+        }
+
+        HASHLIBCXX_INLINE void compress_pre(uint32_t (&state)[16],
+                                            const uint32_t * cv,
+                                            const unsigned char * block,
+                                            uint8_t block_len,
+                                            uint64_t counter,
+                                            uint8_t flags) noexcept
+        {
+            uint32_t m[16];
+            for (size_t i{0}; i < 16; ++i)
+                m[i] = load32(block + 4 * i);
+
+            for (size_t i{0}; i < 8; ++i)
+                state[i] = cv[i];
+            for (size_t i{0}; i < 4; ++i)
+                state[8 + i] = s_iv[i];
+            state[12] = static_cast<uint32_t>(counter);
+            state[13] = static_cast<uint32_t>(counter >> 32);
+            state[14] = block_len;
+            state[15] = flags;
+
+            for (size_t r{0}; r < 7; ++r)
+            {
+                const uint8_t * s{s_schedule[r]};
+                g(state, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+                g(state, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+                g(state, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+                g(state, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+                g(state, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+                g(state, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+                g(state, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+                g(state, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+            }
+        }
+
+        HASHLIBCXX_INLINE void compress_in_place(uint32_t * cv,
+                                                 const unsigned char * block,
+                                                 uint8_t block_len,
+                                                 uint64_t counter,
+                                                 uint8_t flags) noexcept
+        {
+            uint32_t state[16];
+            compress_pre(state, cv, block, block_len, counter, flags);
+            for (size_t i{0}; i < 8; ++i)
+                cv[i] = state[i] ^ state[i + 8];
+        }
+
+        /**
+         * @brief The 64 bytes of output of a compression, for the root node.
+         */
+        HASHLIBCXX_INLINE void compress_xof(const uint32_t * cv,
+                                            const unsigned char * block,
+                                            uint8_t block_len,
+                                            uint64_t counter,
+                                            uint8_t flags,
+                                            unsigned char * out) noexcept
+        {
+            uint32_t state[16];
+            compress_pre(state, cv, block, block_len, counter, flags);
+            for (size_t i{0}; i < 8; ++i)
+            {
+                store32(out + 4 * i, state[i] ^ state[i + 8]);
+                store32(out + 32 + 4 * i, state[i + 8] ^ cv[i]);
+            }
+        }
+
+        /**
+         * @brief The chaining value of an input of `blocks` whole blocks.
+         */
+        HASHLIBCXX_INLINE void hash_one(const unsigned char * input,
+                                        size_t blocks,
+                                        const uint32_t * key,
+                                        uint64_t counter,
+                                        uint8_t flags,
+                                        uint8_t flags_start,
+                                        uint8_t flags_end,
+                                        unsigned char * out) noexcept
+        {
+            uint32_t cv[8];
+            std::memcpy(cv, key, sizeof(cv));
+            uint8_t block_flags{static_cast<uint8_t>(flags | flags_start)};
+            for (size_t b{0}; b < blocks; ++b)
+            {
+                if (b + 1 == blocks)
+                    block_flags = static_cast<uint8_t>(block_flags | flags_end);
+                compress_in_place(cv, input + b * 64, 64, counter, block_flags);
+                block_flags = flags;
+            }
+            for (size_t i{0}; i < 8; ++i)
+                store32(out + 4 * i, cv[i]);
+        }
+
+#if defined(HASHLIBCXX_BLAKE3_SIMD)
+        // ------------------------------------------------------------------
+        // --- multi-lane kernels -------------------------------------------
+        //
+        // The inputs are hashed N at a time, the lane i of each vector belonging to the input i.
+        // The kernel is written once with the vector extensions of the compiler and inlined in
+        // a function per instruction set, which generates the SSE4.1, AVX2 or AVX-512 code. The
+        // vectors are passed by reference: a vector wider than the default target must not
+        // cross a call.
+
+        typedef uint32_t vec4_t __attribute__((vector_size(16)));
+        typedef uint32_t vec8_t __attribute__((vector_size(32)));
+        typedef uint32_t vec16_t __attribute__((vector_size(64)));
+
+        template<class TVec>
+        __attribute__((always_inline)) inline void rotr_lanes(TVec & word, unsigned count) noexcept
+        {
+            word = (word >> count) | (word << (32 - count));
+        }
+
+        template<class TVec>
+        __attribute__((always_inline)) inline void g_lanes(TVec (&v)[16],
+                                                           size_t a,
+                                                           size_t b,
+                                                           size_t c,
+                                                           size_t d,
+                                                           const TVec & x,
+                                                           const TVec & y) noexcept
+        {
+            v[a] += v[b] + x;
+            v[d] ^= v[a];
+            rotr_lanes(v[d], 16);
+            v[c] += v[d];
+            v[b] ^= v[c];
+            rotr_lanes(v[b], 12);
+            v[a] += v[b] + y;
+            v[d] ^= v[a];
+            rotr_lanes(v[d], 8);
+            v[c] += v[d];
+            v[b] ^= v[c];
+            rotr_lanes(v[b], 7);
+        }
+
+        template<class TVec, size_t N>
+        __attribute__((always_inline)) inline void hash_lanes(const unsigned char * const * inputs,
+                                                              size_t blocks,
+                                                              const uint32_t * key,
+                                                              uint64_t counter,
+                                                              bool increment_counter,
+                                                              uint8_t flags,
+                                                              uint8_t flags_start,
+                                                              uint8_t flags_end,
+                                                              unsigned char * out) noexcept
+        {
+            static_assert(sizeof(TVec) == N * sizeof(uint32_t), "a lane per input");
+
+            TVec h[8];
+            for (size_t i{0}; i < 8; ++i)
+                h[i] = TVec{} + key[i];
+
+            uint32_t counters[2][N];
+            for (size_t lane{0}; lane < N; ++lane)
+            {
+                const uint64_t lane_counter{counter + (increment_counter ? lane : 0)};
+                counters[0][lane] = static_cast<uint32_t>(lane_counter);
+                counters[1][lane] = static_cast<uint32_t>(lane_counter >> 32);
+            }
+            TVec counter_low;
+            TVec counter_high;
+            std::memcpy(&counter_low, counters[0], sizeof(TVec));
+            std::memcpy(&counter_high, counters[1], sizeof(TVec));
+
+            uint8_t block_flags{static_cast<uint8_t>(flags | flags_start)};
+            for (size_t b{0}; b < blocks; ++b)
+            {
+                if (b + 1 == blocks)
+                    block_flags = static_cast<uint8_t>(block_flags | flags_end);
+
+                uint32_t words[16][N];
+                for (size_t lane{0}; lane < N; ++lane)
+                {
+                    const unsigned char * block{inputs[lane] + b * 64};
+                    for (size_t t{0}; t < 16; ++t)
+                        words[t][lane] = load32(block + 4 * t);
+                }
+                TVec m[16];
+                std::memcpy(m, words, sizeof(m));
+
+                TVec v[16]{h[0],
+                           h[1],
+                           h[2],
+                           h[3],
+                           h[4],
+                           h[5],
+                           h[6],
+                           h[7],
+                           TVec{} + s_iv[0],
+                           TVec{} + s_iv[1],
+                           TVec{} + s_iv[2],
+                           TVec{} + s_iv[3],
+                           counter_low,
+                           counter_high,
+                           TVec{} + 64U,
+                           TVec{} + static_cast<uint32_t>(block_flags)};
+                for (size_t r{0}; r < 7; ++r)
+                {
+                    const uint8_t * s{s_schedule[r]};
+                    g_lanes(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+                    g_lanes(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+                    g_lanes(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+                    g_lanes(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+                    g_lanes(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+                    g_lanes(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+                    g_lanes(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+                    g_lanes(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+                }
+                for (size_t i{0}; i < 8; ++i)
+                    h[i] = v[i] ^ v[i + 8];
+
+                block_flags = flags;
+            }
+
+            uint32_t cvs[8][N];
+            std::memcpy(cvs, h, sizeof(cvs));
+            for (size_t lane{0}; lane < N; ++lane)
+            {
+                for (size_t i{0}; i < 8; ++i)
+                    store32(out + lane * s_out_size + 4 * i, cvs[i][lane]);
+            }
+        }
+
+        __attribute__((target("sse4.1"))) HASHLIBCXX_INLINE void
+        hash_4_sse41(const unsigned char * const * inputs,
+                     size_t blocks,
+                     const uint32_t * key,
+                     uint64_t counter,
+                     bool increment_counter,
+                     uint8_t flags,
+                     uint8_t flags_start,
+                     uint8_t flags_end,
+                     unsigned char * out) noexcept
+        {
+            hash_lanes<vec4_t, 4>(inputs, blocks, key, counter, increment_counter, flags,
+                                  flags_start, flags_end, out);
+        }
+
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+        hash_8_avx2(const unsigned char * const * inputs,
+                    size_t blocks,
+                    const uint32_t * key,
+                    uint64_t counter,
+                    bool increment_counter,
+                    uint8_t flags,
+                    uint8_t flags_start,
+                    uint8_t flags_end,
+                    unsigned char * out) noexcept
+        {
+            hash_lanes<vec8_t, 8>(inputs, blocks, key, counter, increment_counter, flags,
+                                  flags_start, flags_end, out);
+        }
+
+        __attribute__((target("avx512f"))) HASHLIBCXX_INLINE void
+        hash_16_avx512(const unsigned char * const * inputs,
+                       size_t blocks,
+                       const uint32_t * key,
+                       uint64_t counter,
+                       bool increment_counter,
+                       uint8_t flags,
+                       uint8_t flags_start,
+                       uint8_t flags_end,
+                       unsigned char * out) noexcept
+        {
+            hash_lanes<vec16_t, 16>(inputs, blocks, key, counter, increment_counter, flags,
+                                    flags_start, flags_end, out);
+        }
+
+#endif
+
+        /**
+         * @brief Inputs hashed together by the kernel chosen for the processor: 16 with AVX-512,
+         * 8 with AVX2, 4 with SSE4.1, otherwise 1.
+         */
+        HASHLIBCXX_INLINE size_t simd_degree() noexcept
+        {
+#if defined(HASHLIBCXX_BLAKE3_SIMD)
+            static const size_t degree{__builtin_cpu_supports("avx512f") ? 16U
+                                       : __builtin_cpu_supports("avx2")  ? 8U
+                                       : __builtin_cpu_supports("sse4.1") ? 4U
+                                                                          : 1U};
+            return degree;
+#else
+            return 1;
+#endif
+        }
+
+        /**
+         * @brief Computes the chaining values of `num_inputs` inputs of `blocks` whole blocks, as
+         * many at a time as the kernel allows.
+         * @param increment_counter whether the input i uses the counter `counter + i` (chunks) or
+         * `counter` (parents).
+         * @param flags_start the flags added to the first block of each input.
+         * @param flags_end the flags added to the last block of each input.
+         * @param out receives the `s_out_size` bytes of each chaining value.
+         */
+        HASHLIBCXX_INLINE void hash_many(const unsigned char * const * inputs,
+                                         size_t num_inputs,
+                                         size_t blocks,
+                                         const uint32_t * key,
+                                         uint64_t counter,
+                                         bool increment_counter,
+                                         uint8_t flags,
+                                         uint8_t flags_start,
+                                         uint8_t flags_end,
+                                         unsigned char * out) noexcept
+        {
+            const size_t step{increment_counter ? 1U : 0U};
+#if defined(HASHLIBCXX_BLAKE3_SIMD)
+            const size_t degree{simd_degree()};
+            for (; degree >= 16 && num_inputs >= 16; num_inputs -= 16)
+            {
+                hash_16_avx512(inputs, blocks, key, counter, increment_counter, flags,
+                               flags_start, flags_end, out);
+                inputs += 16;
+                counter += 16 * step;
+                out += 16 * s_out_size;
+            }
+            for (; degree >= 8 && num_inputs >= 8; num_inputs -= 8)
+            {
+                hash_8_avx2(inputs, blocks, key, counter, increment_counter, flags, flags_start,
+                            flags_end, out);
+                inputs += 8;
+                counter += 8 * step;
+                out += 8 * s_out_size;
+            }
+            for (; degree >= 4 && num_inputs >= 4; num_inputs -= 4)
+            {
+                hash_4_sse41(inputs, blocks, key, counter, increment_counter, flags, flags_start,
+                             flags_end, out);
+                inputs += 4;
+                counter += 4 * step;
+                out += 4 * s_out_size;
+            }
+#endif
+            for (; num_inputs > 0; --num_inputs)
+            {
+                hash_one(*inputs, blocks, key, counter, flags, flags_start, flags_end, out);
+                ++inputs;
+                counter += step;
+                out += s_out_size;
+            }
+        }
+
+        // ------------------------------------------------------------------
+        // --- chunks and parents -------------------------------------------
+
+        /**
+         * @brief A node whose chaining value or root output is not computed yet.
+         */
+        struct output_t
+        {
+            uint32_t cv[8];
+            unsigned char block[64];
+            uint8_t block_len;
+            uint64_t counter;
+            uint8_t flags;
+        };
+
+        HASHLIBCXX_INLINE void output_chaining_value(const output_t & output,
+                                                     unsigned char * cv) noexcept
+        {
+            uint32_t words[8];
+            std::memcpy(words, output.cv, sizeof(words));
+            compress_in_place(words, output.block, output.block_len, output.counter, output.flags);
+            for (size_t i{0}; i < 8; ++i)
+                store32(cv + 4 * i, words[i]);
+        }
+
+        HASHLIBCXX_INLINE void output_root_bytes(const output_t & output,
+                                                 uint64_t offset,
+                                                 unsigned char * out,
+                                                 size_t len) noexcept
+        {
+            uint64_t counter{offset / 64};
+            size_t skip{static_cast<size_t>(offset % 64)};
+            unsigned char block[64];
+            while (len > 0)
+            {
+                compress_xof(output.cv, output.block, output.block_len, counter++,
+                             static_cast<uint8_t>(output.flags | root), block);
+                const size_t size{64 - skip < len ? 64 - skip : len};
+                std::memcpy(out, block + skip, size);
+                out += size;
+                len -= size;
+                skip = 0;
+            }
+        }
+
+        HASHLIBCXX_INLINE output_t parent_output(const unsigned char * block,
+                                                 const uint32_t * key,
+                                                 uint8_t flags) noexcept
+        {
+            output_t output;
+            std::memcpy(output.cv, key, sizeof(output.cv));
+            std::memcpy(output.block, block, 64);
+            output.block_len = 64;
+            output.counter = 0;
+            output.flags = static_cast<uint8_t>(flags | parent);
+            return output;
+        }
+
+        HASHLIBCXX_INLINE void
+        chunk_reset(chunk_t & chunk, const uint32_t * key, uint64_t counter, uint8_t flags) noexcept
+        {
+            std::memcpy(chunk.cv, key, sizeof(chunk.cv));
+            chunk.counter = counter;
+            std::memset(chunk.block, 0, sizeof(chunk.block));
+            chunk.block_len = 0;
+            chunk.blocks_compressed = 0;
+            chunk.flags = flags;
+        }
+
+        HASHLIBCXX_INLINE size_t chunk_len(const chunk_t & chunk) noexcept
+        {
+            return 64 * static_cast<size_t>(chunk.blocks_compressed) + chunk.block_len;
+        }
+
+        HASHLIBCXX_INLINE uint8_t chunk_flags(const chunk_t & chunk) noexcept
+        {
+            return static_cast<uint8_t>(chunk.flags |
+                                        (chunk.blocks_compressed == 0 ? chunk_start : 0));
+        }
+
+        HASHLIBCXX_INLINE void
+        chunk_update(chunk_t & chunk, const unsigned char * input, size_t len) noexcept
+        {
+            // the last block of the chunk stays in the buffer, it needs the flag chunk_end
+            while (len > 0)
+            {
+                if (chunk.block_len == 64)
+                {
+                    compress_in_place(chunk.cv, chunk.block, 64, chunk.counter, chunk_flags(chunk));
+                    ++chunk.blocks_compressed;
+                    chunk.block_len = 0;
+                    std::memset(chunk.block, 0, sizeof(chunk.block));
+                }
+                if (chunk.block_len == 0)
+                {
+                    for (; len > 64; input += 64, len -= 64)
+                    {
+                        compress_in_place(chunk.cv, input, 64, chunk.counter, chunk_flags(chunk));
+                        ++chunk.blocks_compressed;
+                    }
+                }
+
+                const size_t size{64U - chunk.block_len < len ? 64U - chunk.block_len : len};
+                std::memcpy(chunk.block + chunk.block_len, input, size);
+                chunk.block_len = static_cast<uint8_t>(chunk.block_len + size);
+                input += size;
+                len -= size;
+            }
+        }
+
+        HASHLIBCXX_INLINE output_t chunk_output(const chunk_t & chunk) noexcept
+        {
+            output_t output;
+            std::memcpy(output.cv, chunk.cv, sizeof(output.cv));
+            std::memcpy(output.block, chunk.block, sizeof(output.block));
+            output.block_len = chunk.block_len;
+            output.counter = chunk.counter;
+            output.flags = static_cast<uint8_t>(chunk_flags(chunk) | chunk_end);
+            return output;
+        }
+
+        // ------------------------------------------------------------------
+        // --- subtrees -----------------------------------------------------
+
+        HASHLIBCXX_INLINE uint64_t round_down_to_power_of_2(uint64_t x) noexcept
+        {
+            uint64_t power{1};
+            while (power <= x / 2)
+                power <<= 1;
+            return power;
+        }
+
+        /**
+         * @brief The length of the left subtree of an input of more than one chunk: the largest
+         * power of 2 chunks leaving at least one byte to the right.
+         */
+        HASHLIBCXX_INLINE size_t left_subtree_len(size_t len) noexcept
+        {
+            const uint64_t full_chunks{(len - 1) / blake3::s_chunk_size};
+            return static_cast<size_t>(round_down_to_power_of_2(full_chunks)) *
+                   blake3::s_chunk_size;
+        }
+
+        /**
+         * @brief The chaining values of the chunks of an input of at most simd_degree() chunks.
+         * @return the number of chaining values.
+         */
+        HASHLIBCXX_INLINE size_t compress_chunks(const unsigned char * input,
+                                                 size_t len,
+                                                 const uint32_t * key,
+                                                 uint64_t chunk_counter,
+                                                 uint8_t flags,
+                                                 unsigned char * out) noexcept
+        {
+            const unsigned char * chunks[s_max_simd_degree];
+            size_t count{0};
+            for (; len - count * blake3::s_chunk_size >= blake3::s_chunk_size; ++count)
+                chunks[count] = input + count * blake3::s_chunk_size;
+            hash_many(chunks, count, blake3::s_chunk_size / 64, key, chunk_counter, true, flags,
+                      chunk_start, chunk_end, out);
+
+            // the last chunk, when partial
+            const size_t position{count * blake3::s_chunk_size};
+            if (len == position)
+                return count;
+            chunk_t chunk;
+            chunk_reset(chunk, key, chunk_counter + count, flags);
+            chunk_update(chunk, input + position, len - position);
+            output_chaining_value(chunk_output(chunk), out + count * s_out_size);
+            return count + 1;
+        }
+
+        /**
+         * @brief The chaining values of the parents of pairs of chaining values, an odd last one
+         * being copied.
+         * @return the number of chaining values.
+         */
+        HASHLIBCXX_INLINE size_t compress_parents(const unsigned char * cvs,
+                                                  size_t count,
+                                                  const uint32_t * key,
+                                                  uint8_t flags,
+                                                  unsigned char * out) noexcept
+        {
+            const unsigned char * parents[s_max_simd_degree];
+            size_t parent_count{0};
+            for (; count - 2 * parent_count >= 2; ++parent_count)
+                parents[parent_count] = cvs + 2 * parent_count * s_out_size;
+            hash_many(parents, parent_count, 1, key, 0, false, static_cast<uint8_t>(flags | parent),
+                      0, 0, out);
+
+            if (count == 2 * parent_count)
+                return parent_count;
+            std::memcpy(out + parent_count * s_out_size, cvs + 2 * parent_count * s_out_size,
+                        s_out_size);
+            return parent_count + 1;
+        }
+
+        /**
+         * @brief The chaining values of the nodes of a subtree, at the level where they fit in
+         * the kernel: up to simd_degree() of them, and at least 2 when the input has more than
+         * one chunk. The two halves of a large subtree are hashed on two threads.
+         * @return the number of chaining values.
+         */
+        HASHLIBCXX_INLINE size_t compress_subtree_wide(const unsigned char * input,
+                                                       size_t len,
+                                                       const uint32_t * key,
+                                                       uint64_t chunk_counter,
+                                                       uint8_t flags,
+                                                       unsigned char * out,
+                                                       unsigned threads)
+        {
+            size_t degree{simd_degree()};
+            if (len <= degree * blake3::s_chunk_size)
+                return compress_chunks(input, len, key, chunk_counter, flags, out);
+
+            const size_t left_len{left_subtree_len(len)};
+            const uint64_t right_counter{chunk_counter + left_len / blake3::s_chunk_size};
+
+            // the left subtree is complete and gives `degree` chaining values, followed by the
+            // ones of the right subtree
+            if (left_len > blake3::s_chunk_size && degree == 1)
+                degree = 2;
+            unsigned char cvs[2 * s_max_simd_degree * s_out_size];
+            size_t left_count{0};
+            size_t right_count{0};
+            if (threads > 1 && len >= s_min_parallel_size)
+            {
+                std::thread left([&]() {
+                    left_count = compress_subtree_wide(input, left_len, key, chunk_counter, flags,
+                                                       cvs, threads / 2);
+                });
+                right_count = compress_subtree_wide(input + left_len, len - left_len, key,
+                                                    right_counter, flags,
+                                                    cvs + degree * s_out_size,
+                                                    threads - threads / 2);
+                left.join();
+            }
+            else
+            {
+                left_count = compress_subtree_wide(input, left_len, key, chunk_counter, flags, cvs,
+                                                   1);
+                right_count = compress_subtree_wide(input + left_len, len - left_len, key,
+                                                    right_counter, flags,
+                                                    cvs + degree * s_out_size, 1);
+            }
+
+            // a single chaining value on the left means one chunk per side, the two values are
+            // the children of the node
+            if (left_count == 1)
+            {
+                std::memcpy(out, cvs, 2 * s_out_size);
+                return 2;
+            }
+            return compress_parents(cvs, left_count + right_count, key, flags, out);
+        }
+
+        /**
+         * @brief The two chaining values of the children of the root of a subtree of more than
+         * one chunk.
+         */
+        HASHLIBCXX_INLINE void compress_subtree_to_parent_node(const unsigned char * input,
+                                                               size_t len,
+                                                               const uint32_t * key,
+                                                               uint64_t chunk_counter,
+                                                               uint8_t flags,
+                                                               unsigned char * out,
+                                                               unsigned threads)
+        {
+            unsigned char cvs[s_max_simd_degree * s_out_size];
+            size_t count{
+                compress_subtree_wide(input, len, key, chunk_counter, flags, cvs, threads)};
+
+            unsigned char parents[s_max_simd_degree / 2 * s_out_size];
+            while (count > 2)
+            {
+                count = compress_parents(cvs, count, key, flags, parents);
+                std::memcpy(cvs, parents, count * s_out_size);
+            }
+            std::memcpy(out, cvs, 2 * s_out_size);
+        }
+
+    } // namespace blake3_impl
+
+    // ------------------------------------------------------------------
+    // --- blake3 -------------------------------------------------------
+
+    HASHLIBCXX_INLINE void blake3::hash_printable(const unsigned char * message,
+                                                  size_t len,
+                                                  char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        static constexpr char digits[]{"0123456789abcdef"};
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        for (size_t i{0}; i < s_digest_size; ++i)
+        {
+            digest_printable[2 * i] = digits[digest[i] >> 4];
+            digest_printable[2 * i + 1] = digits[digest[i] & 0x0f];
+        }
+        digest_printable[2 * s_digest_size] = '\0';
+    }
+
+    HASHLIBCXX_INLINE void blake3::reset(const uint32_t * key, uint8_t flags) noexcept
+    {
+        std::memcpy(m_key, key, sizeof(m_key));
+        m_flags = flags;
+        blake3_impl::chunk_reset(m_chunk, m_key, 0, m_flags);
+        m_cv_stack_len = 0;
+    }
+
+    HASHLIBCXX_INLINE void blake3::init() noexcept
+    {
+        reset(blake3_impl::s_iv, 0);
+    }
+
+    HASHLIBCXX_INLINE void blake3::init_keyed(const unsigned char * key) noexcept
+    {
+        HASHLIBCXX_ASSERT(key);
+
+        uint32_t words[8];
+        blake3_impl::load_key(words, key);
+        reset(words, blake3_impl::keyed_hash);
+    }
+
+    HASHLIBCXX_INLINE void blake3::init_derive_key(const char * context, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(context);
+
+        blake3 context_hash;
+        context_hash.reset(blake3_impl::s_iv, blake3_impl::derive_key_context);
+        context_hash.update(reinterpret_cast<const unsigned char *>(context), len);
+        unsigned char context_key[s_key_size];
+        context_hash.complete(context_key);
+
+        uint32_t words[8];
+        blake3_impl::load_key(words, context_key);
+        reset(words, blake3_impl::derive_key_material);
+    }
+
+    HASHLIBCXX_INLINE void blake3::merge_cv_stack(uint64_t total_chunks) noexcept
+    {
+        // the stack holds a chaining value per bit set in the number of chunks: the complete
+        // subtrees, merged as soon as a later chunk proves they are not the root
+        size_t post_merge_len{0};
+        for (; total_chunks != 0; total_chunks &= total_chunks - 1)
+            ++post_merge_len;
+        while (m_cv_stack_len > post_merge_len)
+        {
+            unsigned char * parent_node{m_cv_stack + (m_cv_stack_len - 2) * 32};
+            blake3_impl::output_chaining_value(
+                blake3_impl::parent_output(parent_node, m_key, m_flags), parent_node);
+            --m_cv_stack_len;
+        }
+    }
+
+    HASHLIBCXX_INLINE void blake3::push_cv(const unsigned char * cv,
+                                           uint64_t chunk_counter) noexcept
+    {
+        merge_cv_stack(chunk_counter);
+        std::memcpy(m_cv_stack + m_cv_stack_len * 32, cv, 32);
+        ++m_cv_stack_len;
+    }
+
+    HASHLIBCXX_INLINE void blake3::update(const unsigned char * message, size_t len) noexcept
+    {
+        append(message, len, 1);
+    }
+
+    HASHLIBCXX_INLINE void blake3::update_parallel(const unsigned char * message,
+                                                   size_t len,
+                                                   unsigned threads)
+    {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        append(message, len, threads > 0 ? threads : 1);
+    }
+
+    HASHLIBCXX_INLINE void blake3::append(const unsigned char * message,
+                                          size_t len,
+                                          unsigned threads)
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        if (len == 0)
+            return;
+
+        // completes the chunk started by a previous call
+        if (blake3_impl::chunk_len(m_chunk) > 0)
+        {
+            const size_t missing{s_chunk_size - blake3_impl::chunk_len(m_chunk)};
+            const size_t size{missing < len ? missing : len};
+            blake3_impl::chunk_update(m_chunk, message, size);
+            message += size;
+            len -= size;
+            if (len == 0)
+                return;
+
+            unsigned char cv[32];
+            blake3_impl::output_chaining_value(blake3_impl::chunk_output(m_chunk), cv);
+            push_cv(cv, m_chunk.counter);
+            blake3_impl::chunk_reset(m_chunk, m_key, m_chunk.counter + 1, m_flags);
+        }
+
+        // the largest subtrees aligned with the chunks hashed so far, keeping the last chunk in
+        // m_chunk: it could be the root
+        while (len > s_chunk_size)
+        {
+            uint64_t subtree_len{blake3_impl::round_down_to_power_of_2(len)};
+            const uint64_t count_so_far{m_chunk.counter * s_chunk_size};
+            while (((subtree_len - 1) & count_so_far) != 0)
+                subtree_len /= 2;
+            const uint64_t subtree_chunks{subtree_len / s_chunk_size};
+
+            if (subtree_len <= s_chunk_size)
+            {
+                blake3_impl::chunk_t chunk;
+                blake3_impl::chunk_reset(chunk, m_key, m_chunk.counter, m_flags);
+                blake3_impl::chunk_update(chunk, message, static_cast<size_t>(subtree_len));
+                unsigned char cv[32];
+                blake3_impl::output_chaining_value(blake3_impl::chunk_output(chunk), cv);
+                push_cv(cv, chunk.counter);
+            }
+            else
+            {
+                unsigned char cv_pair[64];
+                blake3_impl::compress_subtree_to_parent_node(message,
+                                                             static_cast<size_t>(subtree_len),
+                                                             m_key,
+                                                             m_chunk.counter,
+                                                             m_flags,
+                                                             cv_pair,
+                                                             threads);
+                push_cv(cv_pair, m_chunk.counter);
+                push_cv(cv_pair + 32, m_chunk.counter + subtree_chunks / 2);
+            }
+            m_chunk.counter += subtree_chunks;
+            message += subtree_len;
+            len -= static_cast<size_t>(subtree_len);
+        }
+
+        if (len > 0)
+        {
+            blake3_impl::chunk_update(m_chunk, message, len);
+            merge_cv_stack(m_chunk.counter);
+        }
+    }
+
+    HASHLIBCXX_INLINE void blake3::complete(unsigned char * digest) const noexcept
+    {
+        complete(digest, s_digest_size, 0);
+    }
+
+    HASHLIBCXX_INLINE void blake3::complete(unsigned char * output,
+                                            size_t len,
+                                            uint64_t offset) const noexcept
+    {
+        HASHLIBCXX_ASSERT(output || len == 0);
+
+        if (len == 0)
+            return;
+
+        // the root is the chunk, or the parent of the subtrees on the stack and of the chunk
+        size_t remaining{m_cv_stack_len};
+        blake3_impl::output_t node;
+        if (blake3_impl::chunk_len(m_chunk) > 0 || remaining == 0)
+        {
+            node = blake3_impl::chunk_output(m_chunk);
+        }
+        else
+        {
+            remaining -= 2;
+            node = blake3_impl::parent_output(m_cv_stack + remaining * 32, m_key, m_flags);
+        }
+        while (remaining > 0)
+        {
+            --remaining;
+            unsigned char block[64];
+            std::memcpy(block, m_cv_stack + remaining * 32, 32);
+            blake3_impl::output_chaining_value(node, block + 32);
+            node = blake3_impl::parent_output(block, m_key, m_flags);
+        }
+        blake3_impl::output_root_bytes(node, offset, output, len);
+    }
+
+    HASHLIBCXX_INLINE uint64_t blake3::processed_size() const noexcept
+    {
+        return m_chunk.counter * s_chunk_size + blake3_impl::chunk_len(m_chunk);
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_BLAKE3_SIMD
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_INLINE
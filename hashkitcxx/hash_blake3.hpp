@@ -0,0 +1,355 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * BLAKE3: one function, fast everywhere
+ * Author(s): Jack O'Connor, Jean-Philippe Aumasson, Samuel Neves, Zooko Wilcox-O'Hearn
+ * Resource link: https://github.com/BLAKE3-team/BLAKE3-specs
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#if defined(HASHLIBCXX_STD_STRING)
+#    include <string>
+#endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
+
+// The algorithm does not depend on sha2, so this header does not include hash_sha2.hpp
+#if defined(HASHLIBCXX_DLL)
+#    undef HASHLIBCXX_DLL
+#endif
+#if defined(hashlibcxx_library_EXPORTS)
+#    define HASHLIBCXX_DLL __declspec(dllexport)
+#else
+#    define HASHLIBCXX_DLL
+#endif
+
+namespace hashkitcxx {
+    namespace blake3_impl {
+
+        /**
+         * @brief The state of a chunk (a leaf of the tree) being hashed.
+         */
+        struct chunk_t
+        {
+            uint32_t cv[8]{};             /**< Chaining value of the blocks compressed */
+            uint64_t counter{0};          /**< Index of the chunk in the message */
+            unsigned char block[64]{};    /**< The bytes not compressed yet */
+            uint8_t block_len{0};         /**< Length of block */
+            uint8_t blocks_compressed{0}; /**< Blocks of the chunk compressed */
+            uint8_t flags{0};             /**< Flags of the mode */
+        };
+
+    } // namespace blake3_impl
+
+    // ------------------------------------------------------------------
+    // --- blake3 -------------------------------------------------------
+
+    /**
+     * @brief BLAKE3, in its three modes: hash, keyed hash and key derivation, with an output of
+     * any length.
+     *
+     * The message is split in chunks of 1 KB, the leaves of a binary tree. The chunks are hashed
+     * several at a time by the SSE4.1, AVX2 or AVX-512 kernel chosen at runtime, and
+     * update_parallel() hashes the large inputs on several threads.
+     */
+    class HASHLIBCXX_DLL blake3 final
+    {
+      public:
+        static constexpr size_t s_block_size{64};   /**< Size expressed in byte of a block */
+        static constexpr size_t s_chunk_size{1024}; /**< Size expressed in byte of a leaf */
+        static constexpr size_t s_key_size{32};     /**< Size expressed in byte of the key */
+        static constexpr size_t s_digest_size{
+            256 / 8}; /**< Size expressed in byte of the default hash, see complete() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        blake3() = default;
+        ~blake3() {}
+        blake3(blake3 &&) = default;
+        blake3(const blake3 &) = default;
+        blake3 & operator=(blake3 &&) = default;
+        blake3 & operator=(const blake3 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Starts a new keyed hash computation, a MAC or a PRF.
+         * @param key pointer to the memory location containing the `s_key_size` bytes of the key.
+         */
+        void init_keyed(const unsigned char * key) noexcept;
+
+        /**
+         * @brief Starts a new key derivation: the message given to update() is the key material,
+         * and the output of complete() the derived key.
+         * @param context the context string, hardcoded, globally unique and application-specific
+         * (e.g. "example.com 2019-12-25 16:18:03 session tokens v1").
+         * @param len the length of `context` expressed in bytes.
+         */
+        void init_derive_key(const char * context, size_t len) noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Same as update(), hashing the subtrees of a large part on several threads.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         * @param threads the maximum number of threads, 0 for the number of cores.
+         */
+        void update_parallel(const unsigned char * message, size_t len, unsigned threads = 0);
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the `s_digest_size` bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Completes the hash computation with an output of any length (extendable output):
+         * the shorter outputs are prefixes of the longer ones.
+         * @param output pointer to the memory location to store the output.
+         * @param len the length of `output` expressed in bytes.
+         * @param offset the position in the output stream of the first byte written, to read a
+         * long output in parts.
+         */
+        void complete(unsigned char * output, size_t len, uint64_t offset = 0) const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        static constexpr size_t s_max_depth{54}; /**< Height of a tree of 2^64 bytes */
+
+        void reset(const uint32_t * key, uint8_t flags) noexcept;
+        void append(const unsigned char * message, size_t len, unsigned threads);
+        void push_cv(const unsigned char * cv, uint64_t chunk_counter) noexcept;
+        void merge_cv_stack(uint64_t total_chunks) noexcept;
+
+      private:
+        uint32_t m_key[8]{};                                /**< Key, or the IV when unkeyed */
+        uint8_t m_flags{0};                                 /**< Flags of the mode */
+        blake3_impl::chunk_t m_chunk;                       /**< The chunk being hashed */
+        unsigned char m_cv_stack[(s_max_depth + 1) * 32]{}; /**< Chaining values of subtrees */
+        uint8_t m_cv_stack_len{0};                          /**< Chaining values in the stack */
+    };
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_blake3.cpp"
+#endif
@@ -0,0 +1,306 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Name: FastCDC: a Fast and Efficient Content-Defined Chunking Approach for Data
+ *   Deduplication
+ * Author(s): Wen Xia, Yukun Zhou, Hong Jiang, Dan Feng, Yu Hua, Yuchong Hu, Yucheng
+ *   Zhang, Qing Liu
+ * Date Published: USENIX ATC 2016
+ * Resource link: https://www.usenix.org/conference/atc16/technical-sessions/presentation/xia
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hashkitcxx {
+    namespace cdc {
+
+        /**
+         * @brief Gear table: 256 random 64 bits values, the splitmix64 sequence started from 0.
+         * Changing it moves every chunk boundary.
+         */
+        static constexpr std::array<uint64_t, 256> gear =
+            {0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL, 0x06c45d188009454fULL,
+             0xf88bb8a8724c81ecULL, 0x1b39896a51a8749bULL, 0x53cb9f0c747ea2eaULL,
+             0x2c829abe1f4532e1ULL, 0xc584133ac916ab3cULL, 0x3ee5789041c98ac3ULL,
+             0xf3b8488c368cb0a6ULL, 0x657eecdd3cb13d09ULL, 0xc2d326e0055bdef6ULL,
+             0x8621a03fe0bbdb7bULL, 0x8e1f7555983aa92fULL, 0xb54e0f1600cc4d19ULL,
+             0x84bb3f97971d80abULL, 0x7d29825c75521255ULL, 0xc3cf17102b7f7f86ULL,
+             0x3466e9a083914f64ULL, 0xd81a8d2b5a4485acULL, 0xdb01602b100b9ed7ULL,
+             0xa9038a921825f10dULL, 0xedf5f1d90dca2f6aULL, 0x54496ad67bd2634cULL,
+             0xdd7c01d4f5407269ULL, 0x935e82f1db4c4f7bULL, 0x69b82ebc92233300ULL,
+             0x40d29eb57de1d510ULL, 0xa2f09dabb45c6316ULL, 0xee521d7a0f4d3872ULL,
+             0xf16952ee72f3454fULL, 0x377d35dea8e40225ULL, 0x0c7de8064963bab0ULL,
+             0x05582d37111ac529ULL, 0xd254741f599dc6f7ULL, 0x69630f7593d108c3ULL,
+             0x417ef96181daa383ULL, 0x3c3c41a3b43343a1ULL, 0x6e19905dcbe531dfULL,
+             0x4fa9fa7324851729ULL, 0x84eb4454a792922aULL, 0x134f7096918175ceULL,
+             0x07dc930b302278a8ULL, 0x12c015a97019e937ULL, 0xcc06c31652ebf438ULL,
+             0xecee65630a691e37ULL, 0x3e84ecb1763e79adULL, 0x690ed476743aae49ULL,
+             0x774615d7b1a1f2e1ULL, 0x22b353f04f4f52daULL, 0xe3ddd86ba71a5eb1ULL,
+             0xdf268adeb6513356ULL, 0x2098eb73d4367d77ULL, 0x03d6845323ce3c71ULL,
+             0xc952c5620043c714ULL, 0x9b196bca844f1705ULL, 0x30260345dd9e0ec1ULL,
+             0xcf448a5882bb9698ULL, 0xf4a578dccbc87656ULL, 0xbfdeaed9a17b3c8fULL,
+             0xed79402d1d5c5d7bULL, 0x55f070ab1cbbf170ULL, 0x3e00a34929a88f1dULL,
+             0xe255b237b8bb18fbULL, 0x2a7b67af6c6ad50eULL, 0x466d5e7f3e46f143ULL,
+             0x42375cb399a4fc72ULL, 0x8c8a1f148a8bb259ULL, 0x32fcab5daed5bdfcULL,
+             0x9e60398c8d8553c0ULL, 0xee89cceb8c4064c0ULL, 0xdb0215941d86a66fULL,
+             0x5ccde78203c367a8ULL, 0xf1bcbc6a1ec11786ULL, 0xef054fceee954551ULL,
+             0xdf82012d0555c6dfULL, 0x292566ff72403c08ULL, 0xc4dd302a1bfa1137ULL,
+             0xd85f219db5c554e1ULL, 0x6a27ff807441bcd2ULL, 0x96a573e9b48216e8ULL,
+             0x46a9fdac40bf0048ULL, 0x3dd12464a0ee15b4ULL, 0x451e521296a7eea1ULL,
+             0x56e4398a98f8a0fdULL, 0x7b7dc2160e3335a7ULL, 0xc679ee0bebcb1ccaULL,
+             0x928d6f2d7453424eULL, 0x1b38994205234c6dULL, 0x8086d193a6f2b568ULL,
+             0x21c6e26639ac2c65ULL, 0xd9dccac414d23c6fULL, 0x91cd642057e00235ULL,
+             0x77fc607dc6589373ULL, 0x05b8abe26dd3aee7ULL, 0x12f6436ac376cc66ULL,
+             0x64952424897b2307ULL, 0xee8c2baf6343e5c3ULL, 0xdc4c613d9eba2304ULL,
+             0x3505b7796bd1a506ULL, 0x8176daf800a05f50ULL, 0x8bd8ff7a0385cdbcULL,
+             0x1a764a3cd78101daULL, 0xbe4d15bf6ca266acULL, 0xa85e1f38bb2dc749ULL,
+             0x56759a968493cd8cULL, 0xf3a9bce7336bd182ULL, 0x365b15013741519bULL,
+             0x1f7a44a6b109ac94ULL, 0x3521d628813cb177ULL, 0x6a77afab0f7c9370ULL,
+             0x179642d8cde95015ULL, 0x5ef102a8fb354461ULL, 0xf51c504764ed82f2ULL,
+             0xc58427f041ce6808ULL, 0xfad8fc45c9643c37ULL, 0xcf8682f9a70fa9c0ULL,
+             0x7e1b3b75a4005729ULL, 0x992dd867927b52d8ULL, 0x7fbd5db142f6791fULL,
+             0x370595aacab4adaeULL, 0xb1392dbdc5ab61d6ULL, 0x9fea7dfc79d452d9ULL,
+             0x40b12b120085641cULL, 0xa192afe3157c85d0ULL, 0xc847729f4e08f3a3ULL,
+             0x6f1384a306c41fc2ULL, 0x12d05c4045a39c19ULL, 0x9899202fd20f0841ULL,
+             0xe9c7191857e774b8ULL, 0x4eead809af5b0cc3ULL, 0xe809acafa23864a4ULL,
+             0x4da1edaba1d0f7bdULL, 0x846eb9673349f8e4ULL, 0x87bae55b86039fe8ULL,
+             0x7f367b8bd953eff2ULL, 0x3884700f650d04e1ULL, 0xbfe4b2ab46980cadULL,
+             0xc5fc89075299106cULL, 0x37b2fa361adea7cdULL, 0x7d75d813f04895b4ULL,
+             0x702f5b393f62c0e0ULL, 0x0a3fc775f4ecf37fULL, 0xe4b23787a352437fULL,
+             0xf83fa245c34d6363ULL, 0xb99bcf040786cf50ULL, 0x38b6ea0a0e6c9d8aULL,
+             0x093fdc76776e37e1ULL, 0x1a75e6f76ba7eee8ULL, 0x442cdcfee9660c62ULL,
+             0x22d58d35116b5e0bULL, 0x87d4a5180f6a3645ULL, 0x589fb216bd82131bULL,
+             0x91d031cad319aec0ULL, 0xabecf76a553d320bULL, 0xb8686cb347612dcfULL,
+             0xfcab66337c0a77f5ULL, 0xac318214381ec437ULL, 0x6eb7f0fca24494aeULL,
+             0xcf42861dcdc895a9ULL, 0x4abad7a1586d7a91ULL, 0xc21b318dc2f49745ULL,
+             0xd49474dc2acbd1f0ULL, 0xb1d4873747c1c8e1ULL, 0x5434dc8c7d015bf6ULL,
+             0xe1c486287511b6a9ULL, 0xa8616df62e89a193ULL, 0x31ce6319498d8347ULL,
+             0xafd0b486123d6faaULL, 0xe6495f5d102301ebULL, 0x0dc51ced17a43c52ULL,
+             0x8bcbcde81355ef2dULL, 0x2412af73fdee7cfcULL, 0xc8d589e486e29eedULL,
+             0x23390e8664517f89ULL, 0x251ade58e8a6849dULL, 0xf8555dbd2e8f9cb0ULL,
+             0xcb417c3eef54f7c3ULL, 0x8028f8e1aac3a919ULL, 0x10e31052acf748a0ULL,
+             0x2d886c073b1e1b78ULL, 0x972974d90df9faeeULL, 0xbc1b7b38796893baULL,
+             0x1958ed432070e652ULL, 0xca5f297197a12dccULL, 0xe025a27375704f28ULL,
+             0x418010a570a924fbULL, 0x9828e2941bfc419cULL, 0x4fbacd2f52b85c1fULL,
+             0x33dd5b756211cc67ULL, 0x23c8dfdd1db57ff0ULL, 0x32f81801a1a8e901ULL,
+             0x26884eac5ada36daULL, 0xcaa82f9bb42e37d4ULL, 0x19fb1a7491d6a7d1ULL,
+             0x5aa0243aa357f38eULL, 0xb31d917809e447f0ULL, 0x3f9c197225215be0ULL,
+             0xdc3c315a1e33c095ULL, 0x3dd399ad533e80acULL, 0x566f32cce8301d95ULL,
+             0xc880188083d9ba21ULL, 0xb9cc357f3b0e7d2eULL, 0x0237d2123a8a8d6cULL,
+             0xbf636e9aa7cbf6bdULL, 0xd7bd4284c4e2a6a7ULL, 0xda2ebb47d50577a9ULL,
+             0x90ba1c11b539087dULL, 0x44993d31552b4f57ULL, 0x32c2d6f80a8a8898ULL,
+             0x450583ed7fb54b19ULL, 0xec2b0b09e50ef3efULL, 0xd918a0b6e2efd65cULL,
+             0xe37a868d9785f572ULL, 0x7d1a6118f2b0f37aULL, 0x9e2e3cc13b343439ULL,
+             0xefd82c11212e37e8ULL, 0xaf89c05cd4fc75edULL, 0x55bc16bb9697108eULL,
+             0x6c4701fa5db69beeULL, 0x9237338441daf445ULL, 0x248cf0831e81a5fcULL,
+             0xacc13557e77de273ULL, 0x520970c25e06513aULL, 0x657329cb02987cabULL,
+             0xa9b0b3366a4e55a8ULL, 0xc4d06ca2f39acdd4ULL, 0x5dce37d68170cde1ULL,
+             0x5f1e44e77e1854c9ULL, 0x6883d452d55df899ULL, 0x05c5bd62f1067032ULL,
+             0xe680b683ce60fab0ULL, 0x5dc9da3f286d18b1ULL, 0x94b4bf3ab85ed6d8ULL,
+             0xce65f449e3acc5a3ULL, 0x34b0209642cea639ULL, 0xc14c3c771d904827ULL,
+             0x6addcee2bd9cdee5ULL, 0xe24eed137ffbb613ULL, 0x75dd58ef79963d1bULL,
+             0xfdb83ecf6cc24920ULL, 0x7a1d0057c57169fbULL, 0x339200f4feb62d07ULL,
+             0xd33f4d4ac88469f4ULL, 0x8226f234e68dfee4ULL, 0x320def4f2a105536ULL,
+             0x7786f3b13aefc159ULL, 0xb28225ac9df63ee2ULL, 0x781b9d0376cc6044ULL,
+             0x05bd0115226c6ab6ULL, 0xd302230207bdfdabULL, 0xdb898abd8e0d2933ULL,
+             0x9e79a397ba00b9ccULL, 0x89df84a5f0003ee8ULL, 0x011f04f2a75fb9beULL,
+             0x5a5832bb47bcf19eULL};
+
+        /**
+         * @brief Chunk sizes expressed in bytes. Only the last chunk of a stream can be smaller
+         * than `min_size`, no chunk is larger than `max_size`.
+         */
+        struct chunker_params
+        {
+            size_t min_size{2 * 1024};  /**< Minimum size, the bytes before are not even scanned */
+            size_t avg_size{8 * 1024};  /**< Expected size, rounded down to a power of 2 */
+            size_t max_size{64 * 1024}; /**< Maximum size */
+            unsigned normalization{2};  /**< Bits added (removed) to the mask before (after) avg */
+        };
+
+        /**
+         * @brief Content-defined chunker (FastCDC) splitting a stream in chunks whose boundaries
+         * depend on the content only, so that an insertion or a deletion moves the boundaries of
+         * the chunks around it but not of the others. Each chunk is hashed with THash as soon as
+         * its boundary is found, while its bytes are still in the cache: the input is read once
+         * from memory, for both the chunking and the hashing.
+         *
+         * The rolling fingerprint is the gear hash `fp = (fp << 1) + gear[byte]`, which depends on
+         * the last 64 bytes only; a boundary is found when its top bits are all 0. The mask has
+         * more bits before `avg_size` and fewer after it (normalized chunking), which narrows the
+         * distribution of the sizes around `avg_size`.
+         */
+        template<class THash>
+        class chunker final
+        {
+          public:
+            /**
+             * @brief A chunk of the stream and its hash.
+             */
+            struct chunk_t
+            {
+                uint64_t offset{0};                /**< Position of the chunk in the stream */
+                size_t size{0};                    /**< Size of the chunk expressed in bytes */
+                typename THash::digest_t digest{}; /**< Hash of the chunk */
+            };
+
+          public:
+            explicit chunker(const chunker_params & params = chunker_params{}) noexcept
+                : m_params{params}
+            {
+                unsigned bits{0};
+                while (bits < 62 && (size_t{2} << bits) <= m_params.avg_size)
+                    ++bits;
+
+                m_params.avg_size = size_t{1} << bits;
+                m_params.min_size = m_params.min_size < m_params.avg_size ? m_params.min_size
+                                                                          : m_params.avg_size;
+                m_params.max_size = m_params.max_size > m_params.avg_size ? m_params.max_size
+                                                                          : m_params.avg_size;
+
+                const unsigned normalization{m_params.normalization < bits ? m_params.normalization
+                                                                           : bits};
+                m_mask_small = top_bits(bits + normalization);
+                m_mask_large = top_bits(bits - normalization);
+
+                m_hash.init();
+            }
+
+            /**
+             * @brief Adds the given part of the stream: the chunks completed by it are passed to
+             * `on_chunk`, in order, while the last incomplete chunk is kept for the next call.
+             * @param data pointer to the memory location containing the part of the stream.
+             * @param len the length of `data` expressed in bytes.
+             * @param on_chunk callable invoked with a `const chunk_t &` for each completed chunk.
+             */
+            template<class TCallback>
+            void update(const unsigned char * data, size_t len, TCallback && on_chunk)
+            {
+                size_t start{0}; // first byte of data not given to the hash yet
+                size_t pos{0};
+                while (pos < len)
+                {
+                    if (!find_boundary(data, len, pos))
+                        break;
+
+                    m_hash.update(data + start, pos - start);
+                    start = pos;
+                    emit(on_chunk);
+                }
+                m_hash.update(data + start, len - start);
+            }
+
+            /**
+             * @brief Ends the stream, passing its last chunk (if any) to `on_chunk`. The chunker
+             * can then be used for a new stream.
+             * @param on_chunk callable invoked with a `const chunk_t &` for the last chunk.
+             */
+            template<class TCallback>
+            void complete(TCallback && on_chunk)
+            {
+                if (m_size > 0)
+                    emit(on_chunk);
+                m_offset = 0;
+            }
+
+          private:
+            static constexpr uint64_t top_bits(unsigned count) noexcept
+            {
+                return count == 0 ? 0 : ~uint64_t{0} << (64 - (count < 64 ? count : 64));
+            }
+
+            /**
+             * @brief Scans `data` from `pos`, moving `pos` after the bytes belonging to the current
+             * chunk.
+             * @return true if the current chunk ends at `pos`, false if it continues in the next
+             * part of the stream.
+             */
+            bool find_boundary(const unsigned char * data, size_t len, size_t & pos) noexcept
+            {
+                // the first bytes are skipped: no boundary can be there
+                if (m_size < m_params.min_size)
+                {
+                    const size_t skip{m_params.min_size - m_size < len - pos
+                                          ? m_params.min_size - m_size
+                                          : len - pos};
+                    m_size += skip;
+                    pos += skip;
+                    if (m_size < m_params.min_size)
+                        return false;
+                }
+
+                while (pos < len)
+                {
+                    if (m_size >= m_params.max_size)
+                        return true;
+
+                    m_fingerprint = (m_fingerprint << 1) + gear[data[pos]];
+                    ++pos;
+                    ++m_size;
+
+                    const uint64_t mask{m_size < m_params.avg_size ? m_mask_small : m_mask_large};
+                    if ((m_fingerprint & mask) == 0)
+                        return true;
+                }
+
+                return m_size >= m_params.max_size;
+            }
+
+            template<class TCallback>
+            void emit(TCallback & on_chunk)
+            {
+                chunk_t chunk;
+                chunk.offset = m_offset;
+                chunk.size = m_size;
+                m_hash.complete(chunk.digest.data());
+                on_chunk(chunk);
+
+                m_offset += m_size;
+                m_size = 0;
+                m_fingerprint = 0;
+                m_hash.init();
+            }
+
+          private:
+            THash m_hash;                /**< Hash of the current chunk */
+            chunker_params m_params;     /**< Chunk sizes */
+            uint64_t m_mask_small{0};    /**< Mask used before avg_size */
+            uint64_t m_mask_large{0};    /**< Mask used after avg_size */
+            uint64_t m_fingerprint{0};   /**< Gear hash of the last bytes */
+            uint64_t m_offset{0};        /**< Position of the current chunk in the stream */
+            size_t m_size{0};            /**< Bytes of the current chunk seen so far */
+        };
+
+    } // namespace cdc
+} // namespace hashkitcxx
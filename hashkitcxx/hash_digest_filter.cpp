@@ -0,0 +1,301 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_digest_filter.hpp"
+#include "hash_file.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(HASHLIBCXX_ASSERT)
+#    undef HASHLIBCXX_ASSERT
+#endif
+#if defined(HASHLIBCXX_STD_ASSERT)
+#    include <cassert>
+#    define HASHLIBCXX_ASSERT assert
+#else
+#    define HASHLIBCXX_ASSERT(x)
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <immintrin.h>
+#    define HASHLIBCXX_FILTER_AVX2
+#endif
+
+namespace hashkitcxx {
+    namespace digest_filter_format {
+
+        constexpr unsigned char s_magic[4]{'H', 'K', 'B', 'F'};
+        constexpr uint32_t s_version{1};
+        constexpr size_t s_prefetch_distance{8}; /**< Digests looked up ahead by the batches */
+
+        HASHLIBCXX_INLINE uint64_t load_le(const unsigned char * bytes, size_t len) noexcept
+        {
+            uint64_t value{0};
+            for (size_t i{0}; i < len; ++i)
+                value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            return value;
+        }
+
+        /**
+         * @brief Returns the 8 bit positions of the digest, 6 bits each from the bytes 8 to 13.
+         * The bit i of the word w of a block is the bit i % 8 of its byte 8 * w + i / 8.
+         */
+        HASHLIBCXX_INLINE uint64_t probes(const unsigned char * digest) noexcept
+        {
+            return load_le(digest + 8, 6);
+        }
+
+        HASHLIBCXX_INLINE bool contains_block(const unsigned char * block, uint64_t bits) noexcept
+        {
+            bool found{true};
+            for (size_t word{0}; word < 8; ++word, bits >>= 6)
+            {
+                const size_t bit{8 * 8 * word + static_cast<size_t>(bits & 63)};
+                found = found && (block[bit / 8] & (1U << (bit % 8))) != 0;
+            }
+            return found;
+        }
+
+#if defined(HASHLIBCXX_FILTER_AVX2)
+        HASHLIBCXX_INLINE bool has_avx2() noexcept
+        {
+            static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+            return avx2;
+        }
+
+        /**
+         * @brief Tests the 8 words of the block at once: the bits of the digest are shifted into
+         * 8 masks of 64 bits, then both halves of the block are tested against them.
+         */
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE size_t
+        contains_avx2(const unsigned char * blocks,
+                      uint64_t block_mask,
+                      const unsigned char * digests,
+                      size_t digest_size,
+                      size_t count,
+                      bool * results) noexcept
+        {
+            const __m256i low_shifts{_mm256_set_epi64x(18, 12, 6, 0)};
+            const __m256i high_shifts{_mm256_set_epi64x(42, 36, 30, 24)};
+            const __m256i six_bits{_mm256_set1_epi64x(63)};
+            const __m256i one{_mm256_set1_epi64x(1)};
+
+            size_t found{0};
+            for (size_t i{0}; i < count; ++i)
+            {
+                if (i + s_prefetch_distance < count)
+                {
+                    const unsigned char * next{digests + (i + s_prefetch_distance) * digest_size};
+                    _mm_prefetch(reinterpret_cast<const char *>(
+                                     blocks + (load_le(next, 8) & block_mask) * 64),
+                                 _MM_HINT_T0);
+                }
+
+                const unsigned char * digest{digests + i * digest_size};
+                const unsigned char * block{blocks + (load_le(digest, 8) & block_mask) * 64};
+                const __m256i bits{_mm256_set1_epi64x(static_cast<long long>(probes(digest)))};
+                const __m256i low_masks{_mm256_sllv_epi64(
+                    one, _mm256_and_si256(_mm256_srlv_epi64(bits, low_shifts), six_bits))};
+                const __m256i high_masks{_mm256_sllv_epi64(
+                    one, _mm256_and_si256(_mm256_srlv_epi64(bits, high_shifts), six_bits))};
+
+                const __m256i low{_mm256_load_si256(reinterpret_cast<const __m256i *>(block))};
+                const __m256i high{
+                    _mm256_load_si256(reinterpret_cast<const __m256i *>(block + 32))};
+                results[i] = _mm256_testc_si256(low, low_masks) != 0 &&
+                             _mm256_testc_si256(high, high_masks) != 0;
+                found += results[i] ? 1 : 0;
+            }
+            return found;
+        }
+#endif
+
+    } // namespace digest_filter_format
+
+    HASHLIBCXX_INLINE digest_filter::digest_filter(uint64_t count, unsigned bits_per_digest)
+    {
+        const uint64_t bits{count * bits_per_digest};
+        uint64_t block_count{1};
+        while (block_count * s_block_size * 8 < bits)
+            block_count *= 2;
+        reset(block_count);
+    }
+
+    HASHLIBCXX_INLINE void digest_filter::insert(const unsigned char * digest) noexcept
+    {
+        using namespace digest_filter_format;
+
+        HASHLIBCXX_ASSERT(!is_mapped());
+        HASHLIBCXX_ASSERT(digest);
+
+        // the blocks are owned by m_arena when the filter is not mapped
+        unsigned char * block{const_cast<unsigned char *>(m_blocks) +
+                              (load_le(digest, 8) & m_block_mask) * s_block_size};
+        uint64_t bits{probes(digest)};
+        for (size_t word{0}; word < 8; ++word, bits >>= 6)
+        {
+            const size_t bit{8 * 8 * word + static_cast<size_t>(bits & 63)};
+            block[bit / 8] = static_cast<unsigned char>(block[bit / 8] | (1U << (bit % 8)));
+        }
+    }
+
+    HASHLIBCXX_INLINE bool digest_filter::contains(const unsigned char * digest) const noexcept
+    {
+        using namespace digest_filter_format;
+
+        HASHLIBCXX_ASSERT(digest);
+
+        return contains_block(m_blocks + (load_le(digest, 8) & m_block_mask) * s_block_size,
+                              probes(digest));
+    }
+
+    HASHLIBCXX_INLINE size_t digest_filter::contains(const unsigned char * digests,
+                                                     size_t digest_size,
+                                                     size_t count,
+                                                     bool * results) const noexcept
+    {
+        using namespace digest_filter_format;
+
+        HASHLIBCXX_ASSERT(digest_size >= s_min_digest_size);
+
+#if defined(HASHLIBCXX_FILTER_AVX2)
+        if (has_avx2())
+            return contains_avx2(m_blocks, m_block_mask, digests, digest_size, count, results);
+#endif
+
+        size_t found{0};
+        for (size_t i{0}; i < count; ++i)
+        {
+#if defined(__GNUC__)
+            if (i + s_prefetch_distance < count)
+            {
+                const unsigned char * next{digests + (i + s_prefetch_distance) * digest_size};
+                __builtin_prefetch(m_blocks + (load_le(next, 8) & m_block_mask) * s_block_size);
+            }
+#endif
+            results[i] = contains(digests + i * digest_size);
+            found += results[i] ? 1 : 0;
+        }
+        return found;
+    }
+
+    HASHLIBCXX_INLINE bool digest_filter::save(const char * path) const
+    {
+        using namespace digest_filter_format;
+
+        unsigned char header[s_header_size]{};
+        std::memcpy(header, s_magic, sizeof(s_magic));
+        for (size_t i{0}; i < 4; ++i)
+            header[4 + i] = static_cast<unsigned char>(s_version >> (8 * (3 - i)));
+        for (size_t i{0}; i < 8; ++i)
+            header[8 + i] = static_cast<unsigned char>(block_count() >> (8 * (7 - i)));
+
+        const std::string temporary_path{std::string{path} + ".tmp"};
+
+        std::FILE * file{std::fopen(temporary_path.c_str(), "wb")};
+        if (file == nullptr)
+            return false;
+
+        const size_t blocks_size{static_cast<size_t>(block_count() * s_block_size)};
+        const bool written{std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                           std::fwrite(m_blocks, 1, blocks_size, file) == blocks_size};
+        if (std::fclose(file) != 0 || !written || !replace_file(temporary_path.c_str(), path))
+        {
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    HASHLIBCXX_INLINE bool digest_filter::open(const char * path)
+    {
+        using namespace digest_filter_format;
+
+        m_arena.reset();
+        m_blocks = nullptr;
+
+        bool valid{m_file.open(path, true) && m_file.size() >= s_header_size &&
+                   std::memcmp(m_file.data(), s_magic, sizeof(s_magic)) == 0};
+        if (valid)
+        {
+            const unsigned char * header{m_file.data()};
+            uint32_t version{0};
+            uint64_t block_count{0};
+            for (size_t i{0}; i < 4; ++i)
+                version = (version << 8) | header[4 + i];
+            for (size_t i{0}; i < 8; ++i)
+                block_count = (block_count << 8) | header[8 + i];
+
+            valid = version == s_version && block_count > 0 &&
+                    (block_count & (block_count - 1)) == 0 &&
+                    block_count <= (m_file.size() - s_header_size) / s_block_size &&
+                    m_file.size() - s_header_size == block_count * s_block_size;
+            if (valid)
+            {
+                m_blocks = header + s_header_size;
+                m_block_mask = block_count - 1;
+            }
+        }
+
+        if (!valid)
+        {
+            m_file.close();
+            reset(1);
+        }
+        return valid;
+    }
+
+    HASHLIBCXX_INLINE void digest_filter::reset(uint64_t block_count)
+    {
+        const size_t size{static_cast<size_t>(block_count * s_block_size)};
+        m_arena.reset(new unsigned char[size + s_block_size]());
+
+        unsigned char * blocks{m_arena.get()};
+        blocks += (s_block_size - reinterpret_cast<uintptr_t>(blocks) % s_block_size) %
+                  s_block_size;
+        m_blocks = blocks;
+        m_block_mask = block_count - 1;
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_FILTER_AVX2
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_INLINE
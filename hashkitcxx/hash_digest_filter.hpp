@@ -0,0 +1,168 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Split block Bloom filter
+ * Each key sets one bit in each of the words of a single block, so a lookup touches
+ * a single cache line and tests all its bits at once.
+ * Resource link: https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+ */
+
+#pragma once
+#include "hash_mapped_file.hpp"
+#include "hash_sha2.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Blocked Bloom filter over digests, to tell the digests that were never inserted
+     * without looking them up in a larger index.
+     *
+     * The digests are uniformly distributed already, so the filter takes its probes from their
+     * bits without hashing them again: the first 8 bytes select a block of 64 bytes, the next 6
+     * bytes select one bit in each of the 8 words of 64 bits of the block. A digest that was
+     * inserted is always found, one that was not is found with a small probability: below 0.5%
+     * with the default 12 bits per digest, less when the number of blocks, rounded up to a power
+     * of 2, leaves more bits.
+     *
+     * The filter is stored as the 64 bytes header of its file followed by the blocks, so that
+     * a saved filter can be mapped in memory with open() and queried right away.
+     */
+    class HASHLIBCXX_DLL digest_filter final
+    {
+      public:
+        static constexpr size_t s_block_size{64};      /**< Bytes of a block, a cache line */
+        static constexpr size_t s_min_digest_size{14}; /**< Bytes of the digest used */
+        static constexpr size_t s_header_size{64};     /**< Bytes before the first block */
+
+      public:
+        /**
+         * @brief Creates an empty filter sized for `count` digests.
+         * @param count the number of digests expected.
+         * @param bits_per_digest the bits of filter per digest expected, the more the fewer
+         * false positives.
+         */
+        explicit digest_filter(uint64_t count = 0, unsigned bits_per_digest = 12);
+
+        digest_filter(const digest_filter &) = delete;
+        digest_filter & operator=(const digest_filter &) = delete;
+
+        /**
+         * @brief Returns the number of blocks of the filter.
+         */
+        uint64_t block_count() const noexcept
+        {
+            return m_block_mask + 1;
+        }
+
+        /**
+         * @brief Returns whether the filter is a file mapped by open(), which cannot be modified.
+         */
+        bool is_mapped() const noexcept
+        {
+            return m_file.data() != nullptr;
+        }
+
+        /**
+         * @brief Adds a digest to the filter. The filter must not be mapped.
+         * @param digest pointer to the memory location containing at least s_min_digest_size
+         * bytes of the digest.
+         */
+        void insert(const unsigned char * digest) noexcept;
+
+        /**
+         * @brief Returns false if the digest was never inserted, true if it probably was.
+         * @param digest pointer to the memory location containing at least s_min_digest_size
+         * bytes of the digest.
+         */
+        bool contains(const unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Tests many digests, with AVX2 when the processor supports it, loading the
+         * blocks of the next digests ahead.
+         * @param digests pointer to the memory location containing the digests, one after the
+         * other.
+         * @param digest_size the size of each digest expressed in bytes, at least
+         * s_min_digest_size.
+         * @param count the number of digests.
+         * @param results receives the result of contains() for each digest.
+         * @return the number of digests probably inserted.
+         */
+        size_t contains(const unsigned char * digests,
+                        size_t digest_size,
+                        size_t count,
+                        bool * results) const noexcept;
+
+        template<size_t N>
+        void insert(const std::array<unsigned char, N> & digest) noexcept
+        {
+            static_assert(N >= s_min_digest_size, "the digest is too short");
+            insert(digest.data());
+        }
+
+        template<size_t N>
+        bool contains(const std::array<unsigned char, N> & digest) const noexcept
+        {
+            static_assert(N >= s_min_digest_size, "the digest is too short");
+            return contains(digest.data());
+        }
+
+        /**
+         * @brief Writes the filter to the given file, replacing it.
+         * @return true if the filter has been written.
+         */
+        bool save(const char * path) const;
+
+        /**
+         * @brief Maps a filter written by save() in memory, replacing the content of this one.
+         * @return false if the file cannot be mapped or is not a valid filter, then the filter is
+         * left empty.
+         */
+        bool open(const char * path);
+
+      private:
+        void reset(uint64_t block_count);
+
+      private:
+        std::unique_ptr<unsigned char[]> m_arena; /**< Memory of the blocks when not mapped */
+        mapped_file m_file;                       /**< Filter file when mapped */
+        const unsigned char * m_blocks{nullptr};  /**< First block, aligned to s_block_size */
+        uint64_t m_block_mask{0};                 /**< Number of blocks - 1 */
+    };
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_digest_filter.cpp"
+#endif
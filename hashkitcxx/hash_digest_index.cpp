@@ -0,0 +1,443 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_digest_index.hpp"
+#include "hash_file.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <queue>
+
+namespace hashkitcxx {
+    namespace digest_index_format {
+
+        constexpr unsigned char s_magic[4]{'H', 'K', 'D', 'I'};
+        constexpr uint32_t s_version{1};
+        constexpr size_t s_max_digest_size{64};
+        constexpr unsigned s_interpolation_steps{8}; /**< Then the search becomes binary */
+
+        HASHLIBCXX_INLINE uint64_t load_be(const unsigned char * bytes, size_t len) noexcept
+        {
+            uint64_t value{0};
+            for (size_t i{0}; i < len; ++i)
+                value = (value << 8) | bytes[i];
+            return value;
+        }
+
+        HASHLIBCXX_INLINE void store_be(uint64_t value, unsigned char * bytes, size_t len) noexcept
+        {
+            for (size_t i{0}; i < len; ++i)
+                bytes[len - 1 - i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+
+        /**
+         * @brief Returns the bytes 1 to 8 of the digest as an integer, the key of the
+         * interpolation among the digests sharing the first byte.
+         */
+        HASHLIBCXX_INLINE uint64_t interpolation_key(const unsigned char * digest,
+                                                     size_t digest_size) noexcept
+        {
+            const size_t len{std::min<size_t>(digest_size - 1, 8)};
+            return len == 0 ? 0 : load_be(digest + 1, len) << (8 * (8 - len));
+        }
+
+        /**
+         * @brief Writes the sorted entries of the index, dropping the duplicated digests, then
+         * the header and the fan-out table once the entries are counted.
+         */
+        class writer final
+        {
+          public:
+            writer(size_t digest_size, size_t payload_size) noexcept
+                : m_digest_size{digest_size}, m_entry_size{digest_size + payload_size}
+            {
+            }
+
+            ~writer()
+            {
+                if (m_file != nullptr)
+                    std::fclose(m_file);
+            }
+
+            writer(const writer &) = delete;
+            writer & operator=(const writer &) = delete;
+
+            bool open(const char * path) noexcept
+            {
+                m_file = std::fopen(path, "wb");
+                const unsigned char header[digest_index::s_header_size]{};
+                return m_file != nullptr &&
+                       std::fwrite(header, 1, sizeof(header), m_file) == sizeof(header);
+            }
+
+            bool write(const unsigned char * entry) noexcept
+            {
+                if (m_count > 0 && std::memcmp(entry, m_last.data(), m_digest_size) == 0)
+                    return true;
+
+                std::memcpy(m_last.data(), entry, m_digest_size);
+                ++m_fanout[entry[0]];
+                ++m_count;
+                return std::fwrite(entry, 1, m_entry_size, m_file) == m_entry_size;
+            }
+
+            bool close() noexcept
+            {
+                if (m_file == nullptr)
+                    return false;
+
+                unsigned char header[digest_index::s_header_size]{};
+                std::memcpy(header, s_magic, sizeof(s_magic));
+                store_be(s_version, header + 4, 4);
+                store_be(m_digest_size, header + 8, 4);
+                store_be(m_entry_size - m_digest_size, header + 12, 4);
+                store_be(m_count, header + 16, 8);
+
+                uint64_t total{0};
+                for (size_t i{0}; i < 256; ++i)
+                {
+                    total += m_fanout[i];
+                    store_be(total, header + 24 + 8 * i, 8);
+                }
+
+                const bool written{std::fseek(m_file, 0, SEEK_SET) == 0 &&
+                                   std::fwrite(header, 1, sizeof(header), m_file) ==
+                                       sizeof(header)};
+                const bool closed{std::fclose(m_file) == 0};
+                m_file = nullptr;
+                return written && closed;
+            }
+
+          private:
+            std::FILE * m_file{nullptr};
+            size_t m_digest_size;
+            size_t m_entry_size;
+            std::array<unsigned char, s_max_digest_size> m_last{};
+            uint64_t m_fanout[256]{};
+            uint64_t m_count{0};
+        };
+
+    } // namespace digest_index_format
+
+    HASHLIBCXX_INLINE bool digest_index::open(const char * path) noexcept
+    {
+        using namespace digest_index_format;
+
+        close();
+        if (!m_file.open(path, true))
+            return false;
+        const unsigned char * data{m_file.data()};
+        const uint64_t file_size{m_file.size()};
+
+        bool valid{file_size >= s_header_size && std::memcmp(data, s_magic, 4) == 0 &&
+                   load_be(data + 4, 4) == s_version};
+        if (valid)
+        {
+            m_digest_size = static_cast<size_t>(load_be(data + 8, 4));
+            m_payload_size = static_cast<size_t>(load_be(data + 12, 4));
+            m_entry_size = m_digest_size + m_payload_size;
+            m_count = load_be(data + 16, 8);
+            m_entries = data + s_header_size;
+
+            uint64_t previous{0};
+            for (size_t i{0}; i < 256; ++i)
+            {
+                m_fanout[i] = load_be(data + 24 + 8 * i, 8);
+                valid = valid && m_fanout[i] >= previous;
+                previous = m_fanout[i];
+            }
+
+            valid = valid && m_digest_size > 0 && m_digest_size <= s_max_digest_size &&
+                    m_fanout[255] == m_count &&
+                    m_count <= (file_size - s_header_size) / m_entry_size &&
+                    file_size - s_header_size == m_count * m_entry_size;
+        }
+
+        if (!valid)
+            close();
+        return valid;
+    }
+
+    HASHLIBCXX_INLINE void digest_index::close() noexcept
+    {
+        m_file.close();
+        m_entries = nullptr;
+        m_count = 0;
+        m_digest_size = 0;
+        m_payload_size = 0;
+        m_entry_size = 0;
+    }
+
+    HASHLIBCXX_INLINE uint64_t digest_index::search_start(const unsigned char * digest) const
+        noexcept
+    {
+        using namespace digest_index_format;
+
+        const uint64_t begin{digest[0] == 0 ? 0 : m_fanout[digest[0] - 1]};
+        const uint64_t end{m_fanout[digest[0]]};
+        const uint64_t key{interpolation_key(digest, m_digest_size)};
+        const long double fraction{static_cast<long double>(key) / 18446744073709551616.0L};
+        return begin + static_cast<uint64_t>(fraction * static_cast<long double>(end - begin));
+    }
+
+    HASHLIBCXX_INLINE const unsigned char * digest_index::find(const unsigned char * digest) const
+        noexcept
+    {
+        using namespace digest_index_format;
+
+        if (m_count == 0)
+            return nullptr;
+
+        // the digests in [low, high) share the first byte, their keys are in [low_key, high_key]
+        uint64_t low{digest[0] == 0 ? 0 : m_fanout[digest[0] - 1]};
+        uint64_t high{m_fanout[digest[0]]};
+        uint64_t low_key{0};
+        uint64_t high_key{UINT64_MAX};
+        const uint64_t key{interpolation_key(digest, m_digest_size)};
+
+        for (unsigned step{0}; low < high; ++step)
+        {
+            uint64_t position{low + (high - low) / 2};
+            if (step < s_interpolation_steps && key >= low_key && key <= high_key)
+            {
+                const long double fraction{static_cast<long double>(key - low_key) /
+                                           (static_cast<long double>(high_key - low_key) + 1)};
+                position = low + static_cast<uint64_t>(
+                                     fraction * static_cast<long double>(high - low));
+                position = std::min(position, high - 1);
+            }
+
+            const unsigned char * entry{m_entries + position * m_entry_size};
+            const int order{std::memcmp(entry, digest, m_digest_size)};
+            if (order == 0)
+                return entry + m_digest_size;
+
+            if (order < 0)
+            {
+                low = position + 1;
+                low_key = interpolation_key(entry, m_digest_size);
+            }
+            else
+            {
+                high = position;
+                high_key = interpolation_key(entry, m_digest_size);
+            }
+        }
+        return nullptr;
+    }
+
+    HASHLIBCXX_INLINE size_t digest_index::find(const unsigned char * digests,
+                                                size_t count,
+                                                const unsigned char ** payloads) const noexcept
+    {
+        constexpr size_t prefetch_distance{8};
+
+        size_t found{0};
+        for (size_t i{0}; i < count; ++i)
+        {
+#if defined(__GNUC__)
+            if (m_count > 0 && i + prefetch_distance < count)
+            {
+                const unsigned char * next{digests + (i + prefetch_distance) * m_digest_size};
+                __builtin_prefetch(m_entries + search_start(next) * m_entry_size);
+            }
+#endif
+            payloads[i] = find(digests + i * m_digest_size);
+            found += payloads[i] != nullptr ? 1 : 0;
+        }
+        return found;
+    }
+
+    HASHLIBCXX_INLINE digest_index_builder::digest_index_builder(const char * path,
+                                                                 size_t digest_size,
+                                                                 size_t payload_size,
+                                                                 size_t memory_limit)
+        : m_path{path},
+          m_digest_size{digest_size},
+          m_payload_size{payload_size},
+          m_entry_size{digest_size + payload_size},
+          m_memory_limit{std::max(memory_limit, digest_size + payload_size)},
+          m_failed{digest_size == 0 || digest_size > digest_index_format::s_max_digest_size}
+    {
+    }
+
+    HASHLIBCXX_INLINE digest_index_builder::~digest_index_builder()
+    {
+        for (size_t run{0}; run < m_runs; ++run)
+            std::remove(run_path(run).c_str());
+    }
+
+    HASHLIBCXX_INLINE bool digest_index_builder::add(const unsigned char * digest,
+                                                     const unsigned char * payload)
+    {
+        if (m_failed)
+            return false;
+
+        m_buffer.insert(m_buffer.end(), digest, digest + m_digest_size);
+        m_buffer.insert(m_buffer.end(), payload, payload + m_payload_size);
+        if (m_buffer.size() + m_entry_size > m_memory_limit)
+            m_failed = !write_run();
+        return !m_failed;
+    }
+
+    HASHLIBCXX_INLINE bool digest_index_builder::finish()
+    {
+        using namespace digest_index_format;
+
+        if (m_failed)
+            return false;
+
+        const std::string temporary_path{m_path + ".tmp"};
+        writer output{m_digest_size, m_payload_size};
+        bool written{output.open(temporary_path.c_str())};
+
+        if (m_runs == 0)
+        {
+            // everything fits in memory
+            for (const unsigned char * entry : sort_buffer())
+                written = written && output.write(entry);
+        }
+        else if (m_buffer.empty() || write_run())
+        {
+            // merges the runs, the equal digests in the order of the runs to keep the first one
+            struct run_t
+            {
+                std::FILE * file;
+                std::vector<unsigned char> entry;
+            };
+            std::vector<run_t> runs(m_runs);
+            const size_t digest_size{m_digest_size};
+            auto later = [&runs, digest_size](size_t left, size_t right) {
+                const int order{
+                    std::memcmp(runs[left].entry.data(), runs[right].entry.data(), digest_size)};
+                return order > 0 || (order == 0 && left > right);
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(later)> queue{later};
+
+            for (size_t run{0}; run < runs.size(); ++run)
+            {
+                runs[run].entry.resize(m_entry_size);
+                runs[run].file = std::fopen(run_path(run).c_str(), "rb");
+                written = written && runs[run].file != nullptr;
+                if (runs[run].file != nullptr &&
+                    std::fread(runs[run].entry.data(), 1, m_entry_size, runs[run].file) ==
+                        m_entry_size)
+                    queue.push(run);
+            }
+
+            while (written && !queue.empty())
+            {
+                const size_t run{queue.top()};
+                queue.pop();
+                written = output.write(runs[run].entry.data());
+                if (std::fread(runs[run].entry.data(), 1, m_entry_size, runs[run].file) ==
+                    m_entry_size)
+                    queue.push(run);
+            }
+
+            for (run_t & run : runs)
+            {
+                if (run.file != nullptr)
+                {
+                    written = written && std::ferror(run.file) == 0;
+                    std::fclose(run.file);
+                }
+            }
+        }
+        else
+            written = false;
+
+        written = output.close() && written;
+        for (size_t run{0}; run < m_runs; ++run)
+            std::remove(run_path(run).c_str());
+        m_runs = 0;
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+        m_failed = true;
+
+        if (!written || !replace_file(temporary_path.c_str(), m_path.c_str()))
+        {
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    HASHLIBCXX_INLINE bool digest_index_builder::write_run()
+    {
+        const std::string path{run_path(m_runs)};
+        std::FILE * file{std::fopen(path.c_str(), "wb")};
+        if (file == nullptr)
+            return false;
+        ++m_runs;
+
+        bool written{true};
+        for (const unsigned char * entry : sort_buffer())
+            written = written && std::fwrite(entry, 1, m_entry_size, file) == m_entry_size;
+        written = std::fclose(file) == 0 && written;
+        m_buffer.clear();
+        return written;
+    }
+
+    HASHLIBCXX_INLINE std::vector<const unsigned char *> digest_index_builder::sort_buffer() const
+    {
+        std::vector<const unsigned char *> entries;
+        entries.reserve(m_buffer.size() / m_entry_size);
+        for (size_t offset{0}; offset < m_buffer.size(); offset += m_entry_size)
+            entries.push_back(m_buffer.data() + offset);
+
+        // stable, so that the first of equal digests comes first
+        const size_t digest_size{m_digest_size};
+        std::stable_sort(entries.begin(),
+                         entries.end(),
+                         [digest_size](const unsigned char * left, const unsigned char * right) {
+                             return std::memcmp(left, right, digest_size) < 0;
+                         });
+        return entries;
+    }
+
+    HASHLIBCXX_INLINE std::string digest_index_builder::run_path(size_t run) const
+    {
+        return m_path + ".run" + std::to_string(run);
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,232 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Git pack index
+ * The fan-out table on the first byte of the keys comes from the index files of the
+ * git packs, where it bounds the search of an object name to the entries sharing its
+ * first byte.
+ * Resource link: https://git-scm.com/docs/pack-format
+ */
+
+#pragma once
+#include "hash_mapped_file.hpp"
+#include "hash_sha2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Read-only index file mapping digests to fixed-width payloads, e.g. the location of
+     * the objects of a content-addressed store.
+     *
+     * The file is mapped in memory, so opening it takes no load phase whatever its size. It
+     * contains, all integers in big endian:
+     * - a 24 bytes header: "HKDI", the version (uint32 1), the size of the digests and of the
+     *   payloads (uint32 each), the number of entries (uint64);
+     * - the fan-out table: 256 uint64, the entry i being the number of digests whose first byte
+     *   is lower than or equal to i;
+     * - the entries sorted by digest, each made of the digest followed by its payload.
+     *
+     * A lookup reads the range of the first byte from the fan-out table, then runs an
+     * interpolation search on the next 8 bytes, which takes a couple of steps since digests are
+     * uniformly distributed. It falls back to a binary search if the interpolation does not
+     * converge, so the worst case stays logarithmic.
+     */
+    class HASHLIBCXX_DLL digest_index final
+    {
+      public:
+        static constexpr size_t s_header_size{24 + 256 * 8}; /**< Offset of the first entry */
+
+      public:
+        digest_index() noexcept = default;
+
+        digest_index(const digest_index &) = delete;
+        digest_index & operator=(const digest_index &) = delete;
+
+        /**
+         * @brief Maps the given index file in memory, closing the previous one.
+         * @return false if the file cannot be mapped or is not a valid index.
+         */
+        bool open(const char * path) noexcept;
+
+        /**
+         * @brief Unmaps the index file.
+         */
+        void close() noexcept;
+
+        /**
+         * @brief Returns whether an index file is mapped.
+         */
+        bool is_open() const noexcept
+        {
+            return m_file.data() != nullptr;
+        }
+
+        /**
+         * @brief Returns the number of entries of the index.
+         */
+        uint64_t size() const noexcept
+        {
+            return m_count;
+        }
+
+        /**
+         * @brief Returns the size of the digests expressed in bytes.
+         */
+        size_t digest_size() const noexcept
+        {
+            return m_digest_size;
+        }
+
+        /**
+         * @brief Returns the size of the payloads expressed in bytes.
+         */
+        size_t payload_size() const noexcept
+        {
+            return m_payload_size;
+        }
+
+        /**
+         * @brief Returns the digest of the entry at `position`, in the sorted order.
+         */
+        const unsigned char * digest(uint64_t position) const noexcept
+        {
+            return m_entries + position * m_entry_size;
+        }
+
+        /**
+         * @brief Returns the payload of the entry at `position`, in the sorted order.
+         */
+        const unsigned char * payload(uint64_t position) const noexcept
+        {
+            return m_entries + position * m_entry_size + m_digest_size;
+        }
+
+        /**
+         * @brief Looks up the given digest.
+         * @param digest pointer to the memory location containing the `digest_size()` bytes of
+         * the digest.
+         * @return a pointer to the payload in the mapped file, or nullptr if the digest is not in
+         * the index. The pointer is valid until the index is closed.
+         */
+        const unsigned char * find(const unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Looks up many digests, loading the first position of the next lookups ahead.
+         * @param digests pointer to the memory location containing the digests, one after the
+         * other.
+         * @param count the number of digests.
+         * @param payloads receives the payload of each digest, nullptr if it is not in the index.
+         * @return the number of digests found.
+         */
+        size_t find(const unsigned char * digests,
+                    size_t count,
+                    const unsigned char ** payloads) const noexcept;
+
+      private:
+        uint64_t search_start(const unsigned char * digest) const noexcept;
+
+      private:
+        mapped_file m_file;                       /**< Index file */
+        const unsigned char * m_entries{nullptr}; /**< First entry in the mapped file */
+        uint64_t m_fanout[256]{};                 /**< Fan-out table */
+        uint64_t m_count{0};                      /**< Number of entries */
+        size_t m_digest_size{0};                  /**< Bytes of each digest */
+        size_t m_payload_size{0};                 /**< Bytes of each payload */
+        size_t m_entry_size{0};                   /**< Bytes of each entry */
+    };
+
+    /**
+     * @brief Writes a digest_index file from entries added in any order.
+     *
+     * The entries are kept in memory up to the given limit, then sorted and written to a run
+     * file next to the index. finish() merges the sorted runs into the index, so indexes larger
+     * than the memory can be built. When a digest is added several times, the index keeps the
+     * payload added first.
+     */
+    class HASHLIBCXX_DLL digest_index_builder final
+    {
+      public:
+        /**
+         * @param path the path of the index file to write.
+         * @param digest_size the size of the digests expressed in bytes, from 1 to 64.
+         * @param payload_size the size of the payloads expressed in bytes.
+         * @param memory_limit the memory used to sort the entries expressed in bytes.
+         */
+        digest_index_builder(const char * path,
+                             size_t digest_size,
+                             size_t payload_size,
+                             size_t memory_limit = 64 * 1024 * 1024);
+        ~digest_index_builder();
+
+        digest_index_builder(const digest_index_builder &) = delete;
+        digest_index_builder & operator=(const digest_index_builder &) = delete;
+
+        /**
+         * @brief Adds an entry to the index.
+         * @param digest pointer to the memory location containing the digest.
+         * @param payload pointer to the memory location containing the payload.
+         * @return false if a run could not be written, then finish() fails as well.
+         */
+        bool add(const unsigned char * digest, const unsigned char * payload);
+
+        /**
+         * @brief Sorts the entries and writes the index file, replacing any previous one. The
+         * builder cannot be used afterwards.
+         * @return true if the index has been written.
+         */
+        bool finish();
+
+      private:
+        bool write_run();
+        std::vector<const unsigned char *> sort_buffer() const;
+        std::string run_path(size_t run) const;
+
+      private:
+        std::string m_path;                  /**< Path of the index file */
+        size_t m_digest_size;                /**< Bytes of each digest */
+        size_t m_payload_size;               /**< Bytes of each payload */
+        size_t m_entry_size;                 /**< Bytes of each entry */
+        size_t m_memory_limit;               /**< Bytes of entries sorted in memory */
+        std::vector<unsigned char> m_buffer; /**< Entries not written to a run yet */
+        size_t m_runs{0};                    /**< Number of run files written */
+        bool m_failed{false};                /**< Whether a run could not be written */
+    };
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_digest_index.cpp"
+#endif
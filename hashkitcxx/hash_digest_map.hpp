@@ -0,0 +1,462 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define HASHLIBCXX_DIGEST_MAP_SSE2
+#endif
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Open-addressing map keyed by digests, e.g. from the digest of an object to the place
+     * where it is stored.
+     *
+     * The digests are uniformly distributed already, so they are not hashed again: their first
+     * 8 bytes select the group of slots where the search starts and give the 7-bit tag of the
+     * slot. The slots are probed 16 at a time as in a Swiss table, comparing the tags of a group
+     * of slots with a single SSE2 instruction when available, and the full digest only for the
+     * slots whose tag matches. The keys are kept as plain digests in their own array, without
+     * a stored hash or padding, and the values in another one.
+     *
+     * @tparam THash the hash algorithm producing the keys.
+     * @tparam V the type of the values, default constructible and copy assignable. The slots not
+     * in use hold a default constructed value.
+     */
+    template<class THash, class V>
+    class digest_map final
+    {
+      public:
+        using key_type = std::array<uint8_t, THash::s_digest_size>;
+        using mapped_type = V;
+
+      public:
+        /**
+         * @param count the number of elements that can be inserted without growing the map.
+         */
+        explicit digest_map(size_t count = 0)
+        {
+            reserve(count);
+        }
+
+        /**
+         * @brief Returns the number of elements in the map.
+         */
+        size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        /**
+         * @brief Returns whether the map contains no element.
+         */
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        /**
+         * @brief Returns the number of slots of the map.
+         */
+        size_t capacity() const noexcept
+        {
+            return m_control.size();
+        }
+
+        /**
+         * @brief Grows the map so that `count` elements fit without growing it again.
+         */
+        void reserve(size_t count)
+        {
+            size_t capacity{s_group_size};
+            while (max_load(capacity) < count)
+                capacity *= 2;
+            if (capacity > m_control.size())
+                rehash(capacity);
+        }
+
+        /**
+         * @brief Removes all the elements, keeping the capacity.
+         */
+        void clear()
+        {
+            std::memset(m_control.data(), s_empty, m_control.size());
+            for (V & value : m_values)
+                value = V{};
+            m_size = 0;
+            m_growth_left = max_load(m_control.size());
+        }
+
+        /**
+         * @brief Inserts an element, unless an element with the same key is already in the map.
+         * @return whether the element has been inserted.
+         */
+        bool insert(const key_type & key, const V & value)
+        {
+            bool inserted{false};
+            const size_t slot{find_or_prepare(key, inserted)};
+            if (inserted)
+                m_values[slot] = value;
+            return inserted;
+        }
+
+        /**
+         * @brief Returns the value of the given key, inserting a default constructed one if the
+         * key is not in the map.
+         */
+        V & operator[](const key_type & key)
+        {
+            bool inserted{false};
+            return m_values[find_or_prepare(key, inserted)];
+        }
+
+        /**
+         * @brief Returns a pointer to the value of the given key, or nullptr if it is not in the
+         * map. The pointer is valid until the map grows.
+         */
+        V * find(const key_type & key) noexcept
+        {
+            const size_t slot{find_slot(key)};
+            return slot == s_npos ? nullptr : &m_values[slot];
+        }
+
+        /**
+         * @brief Returns a pointer to the value of the given key, or nullptr if it is not in the
+         * map. The pointer is valid until the map grows.
+         */
+        const V * find(const key_type & key) const noexcept
+        {
+            const size_t slot{find_slot(key)};
+            return slot == s_npos ? nullptr : &m_values[slot];
+        }
+
+        /**
+         * @brief Returns whether the given key is in the map.
+         */
+        bool contains(const key_type & key) const noexcept
+        {
+            return find_slot(key) != s_npos;
+        }
+
+        /**
+         * @brief Removes the element with the given key.
+         * @return whether the key was in the map.
+         */
+        bool erase(const key_type & key)
+        {
+            const size_t slot{find_slot(key)};
+            if (slot == s_npos)
+                return false;
+
+            // a group that was never full does not stop any search, the slot can be reused
+            // as empty, otherwise it becomes a tombstone
+            const size_t group{slot & ~(s_group_size - 1)};
+            const bool was_full{match_empty(&m_control[group]) == 0};
+            m_control[slot] = was_full ? s_deleted : s_empty;
+            m_growth_left += was_full ? 0 : 1;
+            m_values[slot] = V{};
+            --m_size;
+            return true;
+        }
+
+        /**
+         * @brief Inserts many elements, looking up their groups ahead of the insertions. An
+         * element whose key is already in the map is not inserted.
+         * @param keys the keys of the elements.
+         * @param values the values of the elements, in the same order.
+         * @param count the number of elements.
+         * @return the number of elements inserted.
+         */
+        size_t insert(const key_type * keys, const V * values, size_t count)
+        {
+            reserve(m_size + count);
+
+            size_t inserted{0};
+            for (size_t i{0}; i < count; ++i)
+            {
+                if (i + s_prefetch_distance < count)
+                    prefetch(keys[i + s_prefetch_distance]);
+                inserted += insert(keys[i], values[i]) ? 1 : 0;
+            }
+            return inserted;
+        }
+
+        /**
+         * @brief Looks up many keys, loading their groups ahead of the lookups.
+         * @param keys the keys to look up.
+         * @param count the number of keys.
+         * @param values receives a pointer to the value of each key, nullptr if the key is not in
+         * the map.
+         * @return the number of keys found.
+         */
+        size_t find(const key_type * keys, size_t count, const V ** values) const noexcept
+        {
+            size_t found{0};
+            for (size_t i{0}; i < count; ++i)
+            {
+                if (i + s_prefetch_distance < count)
+                    prefetch(keys[i + s_prefetch_distance]);
+                values[i] = find(keys[i]);
+                found += values[i] != nullptr ? 1 : 0;
+            }
+            return found;
+        }
+
+        /**
+         * @brief Calls `f(key, value)` for each element of the map, in no particular order.
+         */
+        template<class F>
+        void for_each(F f) const
+        {
+            for (size_t slot{0}; slot < m_control.size(); ++slot)
+            {
+                if (is_full(m_control[slot]))
+                    f(m_keys[slot], m_values[slot]);
+            }
+        }
+
+      private:
+        static constexpr size_t s_group_size{16};
+        static constexpr size_t s_prefetch_distance{8}; /**< Keys looked up ahead by the bulk API */
+        static constexpr size_t s_npos{SIZE_MAX};
+        static constexpr uint8_t s_empty{0x80};   /**< Control byte of a slot never used */
+        static constexpr uint8_t s_deleted{0xfe}; /**< Control byte of a slot erased */
+
+        static_assert(THash::s_digest_size >= 8, "the keys need at least 8 bytes");
+
+        static constexpr size_t max_load(size_t capacity) noexcept
+        {
+            return capacity - capacity / 8;
+        }
+
+        static constexpr bool is_full(uint8_t control) noexcept
+        {
+            return (control & 0x80) == 0;
+        }
+
+        static uint64_t prefix(const key_type & key) noexcept
+        {
+            uint64_t h;
+            std::memcpy(&h, key.data(), sizeof(h));
+            return h;
+        }
+
+        static uint8_t tag(uint64_t h) noexcept
+        {
+            return static_cast<uint8_t>(h & 0x7f);
+        }
+
+        static unsigned lowest_bit(uint32_t mask) noexcept
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        /**
+         * @brief Returns a bit mask of the slots of the group whose control byte is `value`.
+         */
+        static uint32_t match(const uint8_t * group, uint8_t value) noexcept
+        {
+#if defined(HASHLIBCXX_DIGEST_MAP_SSE2)
+            const __m128i control{_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))};
+            const __m128i match{_mm_cmpeq_epi8(control, _mm_set1_epi8(static_cast<char>(value)))};
+            return static_cast<uint32_t>(_mm_movemask_epi8(match));
+#else
+            uint32_t mask{0};
+            for (size_t i{0}; i < s_group_size; ++i)
+                mask |= static_cast<uint32_t>(group[i] == value) << i;
+            return mask;
+#endif
+        }
+
+        static uint32_t match_empty(const uint8_t * group) noexcept
+        {
+            return match(group, s_empty);
+        }
+
+        /**
+         * @brief Returns a bit mask of the slots of the group that are empty or deleted.
+         */
+        static uint32_t match_available(const uint8_t * group) noexcept
+        {
+#if defined(HASHLIBCXX_DIGEST_MAP_SSE2)
+            const __m128i control{_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))};
+            return static_cast<uint32_t>(_mm_movemask_epi8(control));
+#else
+            uint32_t mask{0};
+            for (size_t i{0}; i < s_group_size; ++i)
+                mask |= static_cast<uint32_t>(group[i] >> 7) << i;
+            return mask;
+#endif
+        }
+
+        void prefetch(const key_type & key) const noexcept
+        {
+#if defined(__GNUC__)
+            const size_t group{static_cast<size_t>(prefix(key) >> 7) & m_group_mask};
+            __builtin_prefetch(&m_control[group * s_group_size]);
+#else
+            (void)key;
+#endif
+        }
+
+        size_t find_slot(const key_type & key) const noexcept
+        {
+            if (m_size == 0)
+                return s_npos;
+
+            const uint64_t h{prefix(key)};
+            size_t group{static_cast<size_t>(h >> 7) & m_group_mask};
+            for (size_t probe{1};; ++probe)
+            {
+                const uint8_t * control{&m_control[group * s_group_size]};
+                for (uint32_t mask{match(control, tag(h))}; mask != 0; mask &= mask - 1)
+                {
+                    const size_t slot{group * s_group_size + lowest_bit(mask)};
+                    if (m_keys[slot] == key)
+                        return slot;
+                }
+                if (match_empty(control) != 0)
+                    return s_npos;
+
+                // triangular probing visits every group once when their number is a power of 2
+                group = (group + probe) & m_group_mask;
+            }
+        }
+
+        /**
+         * @brief Returns the slot of the key, taking a new one if the key is not in the map.
+         */
+        size_t find_or_prepare(const key_type & key, bool & inserted)
+        {
+            const size_t found{find_slot(key)};
+            if (found != s_npos)
+                return found;
+
+            if (m_growth_left == 0)
+                rehash(m_size * 2 >= max_load(m_control.size()) ? m_control.size() * 2
+                                                                 : m_control.size());
+
+            const uint64_t h{prefix(key)};
+            size_t group{static_cast<size_t>(h >> 7) & m_group_mask};
+            for (size_t probe{1};; ++probe)
+            {
+                const uint32_t mask{match_available(&m_control[group * s_group_size])};
+                if (mask != 0)
+                {
+                    const size_t slot{group * s_group_size + lowest_bit(mask)};
+                    m_growth_left -= m_control[slot] == s_empty ? 1 : 0;
+                    m_control[slot] = tag(h);
+                    m_keys[slot] = key;
+                    ++m_size;
+                    inserted = true;
+                    return slot;
+                }
+                group = (group + probe) & m_group_mask;
+            }
+        }
+
+        /**
+         * @brief Moves the elements to `capacity` new slots, dropping the tombstones.
+         */
+        void rehash(size_t capacity)
+        {
+            std::vector<uint8_t> control(capacity, s_empty);
+            std::vector<key_type> keys(capacity);
+            std::vector<V> values(capacity);
+            const size_t group_mask{capacity / s_group_size - 1};
+
+            for (size_t slot{0}; slot < m_control.size(); ++slot)
+            {
+                if (!is_full(m_control[slot]))
+                    continue;
+
+                const uint64_t h{prefix(m_keys[slot])};
+                size_t group{static_cast<size_t>(h >> 7) & group_mask};
+                for (size_t probe{1};; ++probe)
+                {
+                    const uint32_t mask{match_available(&control[group * s_group_size])};
+                    if (mask != 0)
+                    {
+                        const size_t target{group * s_group_size + lowest_bit(mask)};
+                        control[target] = m_control[slot];
+                        keys[target] = m_keys[slot];
+                        values[target] = std::move(m_values[slot]);
+                        break;
+                    }
+                    group = (group + probe) & group_mask;
+                }
+            }
+
+            m_control.swap(control);
+            m_keys.swap(keys);
+            m_values.swap(values);
+            m_group_mask = group_mask;
+            m_growth_left = max_load(capacity) - m_size;
+        }
+
+      private:
+        std::vector<uint8_t> m_control; /**< Empty, deleted, or the tag of the key of each slot */
+        std::vector<key_type> m_keys;   /**< Key of each slot */
+        std::vector<V> m_values;        /**< Value of each slot */
+        size_t m_group_mask{0};         /**< Number of groups - 1 */
+        size_t m_size{0};               /**< Number of elements */
+        size_t m_growth_left{0};        /**< Empty slots that can be taken before a rehash */
+    };
+
+    template<class THash, class V>
+    constexpr size_t digest_map<THash, V>::s_group_size;
+    template<class THash, class V>
+    constexpr size_t digest_map<THash, V>::s_prefetch_distance;
+    template<class THash, class V>
+    constexpr size_t digest_map<THash, V>::s_npos;
+    template<class THash, class V>
+    constexpr uint8_t digest_map<THash, V>::s_empty;
+    template<class THash, class V>
+    constexpr uint8_t digest_map<THash, V>::s_deleted;
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_DIGEST_MAP_SSE2
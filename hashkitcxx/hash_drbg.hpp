@@ -0,0 +1,428 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * NIST SP 800-90A Rev. 1
+ * Recommendation for Random Number Generation Using Deterministic Random Bit
+ * Generators, section 10.1.1 (Hash_DRBG) and 10.3.1 (Hash_df).
+ * Resource link: https://csrc.nist.gov/pubs/sp/800/90/a/r1/final
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_core.hpp"
+#include "hash_sha2_lanes.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Hash_DRBG of NIST SP 800-90A, a deterministic random bit generator built on one of
+     * the sha2 algorithms.
+     *
+     * The generator does not collect entropy itself: the caller gives the entropy input when
+     * it instantiates and reseeds it. With the same inputs it always returns the same output,
+     * which is also what makes it useful to produce reproducible test data.
+     *
+     * Each request hashes V, V + 1, V + 2... The seed lengths of the standard (55 bytes, or 111
+     * bytes for sha-384 and sha-512) fill exactly one block once padded, so the counters are
+     * formatted as whole blocks and compressed from the initial hash value, several at a time:
+     * sha224 and sha256 compress 8 counters together with the multi-buffer kernel.
+     * @tparam THash one of the sha2 hash classes.
+     */
+    template<class THash>
+    class hash_drbg final
+    {
+      public:
+        static constexpr size_t s_output_size{THash::s_digest_size}; /**< outlen in bytes */
+        static constexpr size_t s_seed_size{
+            THash::s_digest_size >= 48 ? 888 / 8 : 440 / 8}; /**< seedlen in bytes */
+        static constexpr size_t s_security_strength{
+            THash::s_digest_size == 28 ? 192 / 8 : 256 / 8}; /**< Strength expressed in bytes */
+        static constexpr size_t s_max_request_size{(1 << 19) / 8}; /**< Bytes per generate() */
+        static constexpr uint64_t s_reseed_interval{uint64_t{1} << 48}; /**< Requests per seed */
+
+      public:
+        /**
+         * @brief Instantiates the generator, which can then be used until reseed is required.
+         * @param entropy the entropy input, at least s_security_strength bytes.
+         * @param entropy_len the length of `entropy` expressed in bytes.
+         * @param nonce the nonce, at least half of s_security_strength bytes.
+         * @param nonce_len the length of `nonce` expressed in bytes.
+         * @param personalization the optional personalization string.
+         * @param personalization_len the length of `personalization` expressed in bytes.
+         * @return false if the entropy input or the nonce are too short.
+         */
+        bool instantiate(const unsigned char * entropy,
+                         size_t entropy_len,
+                         const unsigned char * nonce,
+                         size_t nonce_len,
+                         const unsigned char * personalization = nullptr,
+                         size_t personalization_len = 0) noexcept
+        {
+            if (entropy_len < s_security_strength || nonce_len < s_security_strength / 2)
+                return false;
+
+            const part_t seed_material[]{
+                {entropy, entropy_len}, {nonce, nonce_len}, {personalization, personalization_len}};
+            hash_df(seed_material, 3, m_v);
+            update_c();
+            return true;
+        }
+
+        /**
+         * @brief Reseeds the generator with new entropy.
+         * @param entropy the entropy input, at least s_security_strength bytes.
+         * @param entropy_len the length of `entropy` expressed in bytes.
+         * @param additional the optional additional input.
+         * @param additional_len the length of `additional` expressed in bytes.
+         * @return false if the generator is not instantiated or the entropy input is too short.
+         */
+        bool reseed(const unsigned char * entropy,
+                    size_t entropy_len,
+                    const unsigned char * additional = nullptr,
+                    size_t additional_len = 0) noexcept
+        {
+            if (m_reseed_counter == 0 || entropy_len < s_security_strength)
+                return false;
+
+            const unsigned char prefix{0x01};
+            const part_t seed_material[]{{&prefix, 1},
+                                         {m_v, s_seed_size},
+                                         {entropy, entropy_len},
+                                         {additional, additional_len}};
+            unsigned char v[s_seed_size];
+            hash_df(seed_material, 4, v);
+            std::memcpy(m_v, v, s_seed_size);
+            update_c();
+            return true;
+        }
+
+        /**
+         * @brief Returns whether the generator must be reseeded before the next request.
+         */
+        bool reseed_required() const noexcept
+        {
+            return m_reseed_counter > s_reseed_interval;
+        }
+
+        /**
+         * @brief Returns the number of requests since the generator was last seeded, plus one.
+         * It is 0 until the generator is instantiated.
+         */
+        uint64_t reseed_counter() const noexcept
+        {
+            return m_reseed_counter;
+        }
+
+        /**
+         * @brief Generates pseudorandom bytes, a single request of the standard.
+         * @param output pointer to the memory location to store the bytes.
+         * @param len the number of bytes, at most s_max_request_size.
+         * @param additional the optional additional input.
+         * @param additional_len the length of `additional` expressed in bytes.
+         * @return false if the generator is not instantiated, must be reseeded, or `len` is too
+         * large.
+         */
+        bool generate(unsigned char * output,
+                      size_t len,
+                      const unsigned char * additional = nullptr,
+                      size_t additional_len = 0) noexcept
+        {
+            if (m_reseed_counter == 0 || reseed_required() || len > s_max_request_size)
+                return false;
+
+            if (additional_len > 0)
+            {
+                const unsigned char prefix{0x02};
+                const part_t input[]{
+                    {&prefix, 1}, {m_v, s_seed_size}, {additional, additional_len}};
+                unsigned char w[s_output_size];
+                hash(input, 3, w);
+                add(m_v, w, s_output_size);
+            }
+
+            hashgen(output, len);
+
+            const unsigned char prefix{0x03};
+            const part_t input[]{{&prefix, 1}, {m_v, s_seed_size}};
+            unsigned char h[s_output_size];
+            hash(input, 2, h);
+            add(m_v, h, s_output_size);
+            add(m_v, m_c, s_seed_size);
+
+            unsigned char counter[8];
+            for (size_t i{0}; i < 8; ++i)
+                counter[i] = static_cast<unsigned char>(m_reseed_counter >> (8 * (7 - i)));
+            add(m_v, counter, sizeof(counter));
+            ++m_reseed_counter;
+            return true;
+        }
+
+        /**
+         * @brief Fills a buffer of any size with pseudorandom bytes, in as many requests of
+         * s_max_request_size bytes as needed.
+         * @param output pointer to the memory location to store the bytes.
+         * @param len the number of bytes.
+         * @return false if the generator is not instantiated or must be reseeded before the
+         * buffer is full.
+         */
+        bool fill(unsigned char * output, size_t len) noexcept
+        {
+            while (len > 0)
+            {
+                const size_t request{len < s_max_request_size ? len : s_max_request_size};
+                if (!generate(output, request))
+                    return false;
+                output += request;
+                len -= request;
+            }
+            return true;
+        }
+
+      private:
+        using word_t = typename sha2::traits<THash>::word_t;
+
+        static constexpr size_t s_block_size{sha2::traits<THash>::s_block_size};
+        static constexpr size_t s_lanes{8}; /**< Counters formatted and compressed together */
+
+        static_assert(s_seed_size + 1 + 2 * sizeof(word_t) <= s_block_size,
+                      "a counter must fit in a single block");
+
+        struct part_t
+        {
+            const unsigned char * data;
+            size_t len;
+        };
+
+        /**
+         * @brief Adds the big endian number `x` to V, modulo 2^seedlen.
+         */
+        static void add(unsigned char * v, const unsigned char * x, size_t x_len) noexcept
+        {
+            unsigned carry{0};
+            for (size_t i{0}; i < s_seed_size; ++i)
+            {
+                carry += v[s_seed_size - 1 - i];
+                if (i < x_len)
+                    carry += x[x_len - 1 - i];
+                v[s_seed_size - 1 - i] = static_cast<unsigned char>(carry);
+                carry >>= 8;
+            }
+        }
+
+        /**
+         * @brief Hashes the concatenation of the given parts.
+         */
+        static void hash(const part_t * parts, size_t count, unsigned char * digest) noexcept
+        {
+            THash h;
+            h.init();
+            for (size_t i{0}; i < count; ++i)
+            {
+                if (parts[i].len > 0)
+                    h.update(parts[i].data, parts[i].len);
+            }
+            h.complete(digest);
+        }
+
+        /**
+         * @brief Hash_df: derives s_seed_size bytes from the concatenation of the given parts.
+         */
+        static void hash_df(const part_t * parts, size_t count, unsigned char * output) noexcept
+        {
+            const uint32_t bits{s_seed_size * 8};
+            unsigned char header[5]{1,
+                                    static_cast<unsigned char>(bits >> 24),
+                                    static_cast<unsigned char>(bits >> 16),
+                                    static_cast<unsigned char>(bits >> 8),
+                                    static_cast<unsigned char>(bits)};
+
+            for (size_t offset{0}; offset < s_seed_size; offset += s_output_size, ++header[0])
+            {
+                THash h;
+                h.init();
+                h.update(header, sizeof(header));
+                for (size_t i{0}; i < count; ++i)
+                {
+                    if (parts[i].len > 0)
+                        h.update(parts[i].data, parts[i].len);
+                }
+
+                unsigned char digest[s_output_size];
+                h.complete(digest);
+                const size_t len{s_seed_size - offset < s_output_size ? s_seed_size - offset
+                                                                      : s_output_size};
+                std::memcpy(output + offset, digest, len);
+            }
+        }
+
+        /**
+         * @brief Derives C from V and restarts the reseed counter.
+         */
+        void update_c() noexcept
+        {
+            const unsigned char prefix{0x00};
+            const part_t input[]{{&prefix, 1}, {m_v, s_seed_size}};
+            hash_df(input, 2, m_c);
+            m_reseed_counter = 1;
+        }
+
+        /**
+         * @brief Hashes `count` messages of a single padded block each, at most s_lanes.
+         */
+        static void hash_blocks(const unsigned char * blocks,
+                                size_t count,
+                                unsigned char * digests) noexcept
+        {
+            using lanes_t = std::integral_constant<bool, std::is_same<word_t, uint32_t>::value>;
+            hash_blocks(blocks, count, digests, lanes_t{});
+        }
+
+        /**
+         * @brief Hashes the blocks together with the multi-buffer sha-256 kernel. The lanes past
+         * the last block hash the first one again.
+         */
+        static void hash_blocks(const unsigned char * blocks,
+                                size_t count,
+                                unsigned char * digests,
+                                std::true_type /*lanes*/) noexcept
+        {
+            using sha2::lanes::s_sha256_lanes;
+            static_assert(s_lanes == s_sha256_lanes, "a counter per lane");
+
+            const unsigned char * block[s_sha256_lanes];
+            unsigned char * digest[s_sha256_lanes];
+            unsigned char unused[s_output_size];
+            for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+            {
+                const bool used{lane < count};
+                block[lane] = blocks + (used ? lane : 0) * s_block_size;
+                digest[lane] = used ? digests + lane * s_output_size : unused;
+            }
+
+            uint32_t h[8][s_sha256_lanes];
+            for (size_t i{0}; i < 8; ++i)
+            {
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                    h[i][lane] = sha2::traits<THash>::h0()[i];
+            }
+            uint32_t words[16][s_sha256_lanes];
+            sha2::lanes::sha256_load(words, block);
+            sha2::lanes::sha256_compress(h, words);
+            sha2::lanes::sha256_store(digest, s_output_size, h);
+        }
+
+        /**
+         * @brief Hashes the blocks one at a time with the compression function of THash.
+         */
+        static void hash_blocks(const unsigned char * blocks,
+                                size_t count,
+                                unsigned char * digests,
+                                std::false_type /*lanes*/) noexcept
+        {
+            for (size_t i{0}; i < count; ++i)
+            {
+                std::array<word_t, 8> h(sha2::traits<THash>::h0());
+                THash::compress(h.data(), blocks + i * s_block_size, 1);
+                for (size_t j{0}; j < s_output_size; ++j)
+                {
+                    const size_t shift{8 * (sizeof(word_t) - 1 - j % sizeof(word_t))};
+                    digests[i * s_output_size + j] =
+                        static_cast<unsigned char>(h[j / sizeof(word_t)] >> shift);
+                }
+            }
+        }
+
+        /**
+         * @brief Hashgen: returns the hashes of V, V + 1, V + 2... V itself is left unchanged.
+         */
+        void hashgen(unsigned char * output, size_t len) const noexcept
+        {
+            // each counter is a message of seedlen bytes: padded, it takes exactly one block
+            unsigned char blocks[s_lanes * s_block_size]{};
+            for (size_t lane{0}; lane < s_lanes; ++lane)
+            {
+                unsigned char * block{blocks + lane * s_block_size};
+                block[s_seed_size] = 0x80;
+                block[s_block_size - 2] = static_cast<unsigned char>((s_seed_size * 8) >> 8);
+                block[s_block_size - 1] = static_cast<unsigned char>(s_seed_size * 8);
+            }
+
+            unsigned char data[s_seed_size];
+            std::memcpy(data, m_v, s_seed_size);
+            const unsigned char one{1};
+
+            unsigned char digests[s_lanes * s_output_size];
+            while (len > 0)
+            {
+                const size_t needed{(len + s_output_size - 1) / s_output_size};
+                const size_t lanes{needed < s_lanes ? needed : s_lanes};
+                for (size_t lane{0}; lane < lanes; ++lane)
+                {
+                    std::memcpy(blocks + lane * s_block_size, data, s_seed_size);
+                    add(data, &one, 1);
+                }
+
+                hash_blocks(blocks, lanes, digests);
+
+                const size_t produced{lanes * s_output_size < len ? lanes * s_output_size : len};
+                std::memcpy(output, digests, produced);
+                output += produced;
+                len -= produced;
+            }
+        }
+
+      private:
+        unsigned char m_v[s_seed_size]{}; /**< V, the secret value updated by each request */
+        unsigned char m_c[s_seed_size]{}; /**< C, the constant of the current seed */
+        uint64_t m_reseed_counter{0};     /**< Requests since seeding plus one, 0 if unseeded */
+    };
+
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_output_size;
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_seed_size;
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_security_strength;
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_max_request_size;
+    template<class THash>
+    constexpr uint64_t hash_drbg<THash>::s_reseed_interval;
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_block_size;
+    template<class THash>
+    constexpr size_t hash_drbg<THash>::s_lanes;
+
+} // namespace hashkitcxx
@@ -0,0 +1,284 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_file.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#include <cstdio>
+#include <cstring>
+#if !defined(_WIN32)
+#    include <sys/types.h>
+#endif
+
+#if defined(HASHLIBCXX_LINUX_AF_ALG) && defined(__linux__)
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <linux/if_alg.h>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace hashkitcxx {
+    HASHLIBCXX_INLINE bool replace_file(const char * temporary_path, const char * path) noexcept
+    {
+        if (std::rename(temporary_path, path) == 0)
+            return true;
+        std::remove(path);
+        return std::rename(temporary_path, path) == 0;
+    }
+
+    namespace checkpoint {
+
+        HASHLIBCXX_INLINE bool save(const char * path,
+                                    const unsigned char * state,
+                                    size_t len) noexcept
+        {
+            char temporary_path[4096];
+            const size_t path_len{std::strlen(path)};
+            const bool use_temporary{path_len + 5 <= sizeof(temporary_path)};
+            if (use_temporary)
+            {
+                std::memcpy(temporary_path, path, path_len);
+                std::memcpy(temporary_path + path_len, ".tmp", 5);
+            }
+
+            const char * write_path{use_temporary ? temporary_path : path};
+            std::FILE * file{std::fopen(write_path, "wb")};
+            if (file == nullptr)
+                return false;
+
+            const bool written{std::fwrite(state, 1, len, file) == len};
+            if (std::fclose(file) != 0 || !written)
+            {
+                std::remove(write_path);
+                return false;
+            }
+
+            return !use_temporary || replace_file(temporary_path, path);
+        }
+
+        HASHLIBCXX_INLINE bool load(const char * path, unsigned char * state, size_t len) noexcept
+        {
+            std::FILE * file{std::fopen(path, "rb")};
+            if (file == nullptr)
+                return false;
+
+            unsigned char extra{0};
+            const bool read{std::fread(state, 1, len, file) == len &&
+                            std::fread(&extra, 1, 1, file) == 0};
+            std::fclose(file);
+            return read;
+        }
+
+        HASHLIBCXX_INLINE bool seek(std::FILE * file, uint64_t offset) noexcept
+        {
+#if defined(_WIN32)
+            if (_fseeki64(file, 0, SEEK_END) != 0)
+                return false;
+            const int64_t size{_ftelli64(file)};
+            return size >= 0 && static_cast<uint64_t>(size) >= offset &&
+                   _fseeki64(file, static_cast<int64_t>(offset), SEEK_SET) == 0;
+#else
+            if (::fseeko(file, 0, SEEK_END) != 0)
+                return false;
+            const off_t size{::ftello(file)};
+            return size >= 0 && static_cast<uint64_t>(size) >= offset &&
+                   ::fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+        }
+
+    } // namespace checkpoint
+
+    namespace afalg {
+
+#if defined(HASHLIBCXX_LINUX_AF_ALG) && defined(__linux__)
+
+        /**
+         * @brief Closes the owned file descriptor when destroyed.
+         */
+        class file_descriptor final
+        {
+          public:
+            explicit file_descriptor(int fd) noexcept : m_fd{fd} {}
+            ~file_descriptor()
+            {
+                if (m_fd >= 0)
+                    ::close(m_fd);
+            }
+            file_descriptor(const file_descriptor &) = delete;
+            file_descriptor & operator=(const file_descriptor &) = delete;
+
+            int get() const noexcept { return m_fd; }
+
+          private:
+            int m_fd; /**< The owned file descriptor, negative if none */
+        };
+
+        /**
+         * @brief Opens an AF_ALG socket bound to the given hash algorithm.
+         * @param name the name of the algorithm in the kernel crypto API.
+         * @param tfm the socket bound to the algorithm, owning the transformation.
+         * @return the operation socket where the data to hash is written, or -1 on error.
+         */
+        HASHLIBCXX_INLINE int open_socket(const char * name, file_descriptor & tfm) noexcept
+        {
+            if (tfm.get() < 0)
+                return -1;
+
+            sockaddr_alg address{};
+            address.salg_family = AF_ALG;
+            std::strncpy(reinterpret_cast<char *>(address.salg_type),
+                         "hash",
+                         sizeof(address.salg_type) - 1);
+            std::strncpy(reinterpret_cast<char *>(address.salg_name),
+                         name,
+                         sizeof(address.salg_name) - 1);
+
+            const sockaddr * generic_address{reinterpret_cast<const sockaddr *>(&address)};
+            if (::bind(tfm.get(), generic_address, sizeof(address)) != 0)
+                return -1;
+
+            return ::accept4(tfm.get(), nullptr, nullptr, SOCK_CLOEXEC);
+        }
+
+        /**
+         * @brief Moves `len` bytes from `from` to `to`, retrying when interrupted.
+         * @return the number of bytes moved, 0 at the end of `from`, -1 on error.
+         */
+        HASHLIBCXX_INLINE ssize_t splice_all(int from, loff_t * offset, int to, size_t len) noexcept
+        {
+            ssize_t moved{-1};
+            do
+            {
+                moved = ::splice(from, offset, to, nullptr, len, SPLICE_F_MOVE | SPLICE_F_MORE);
+            } while (moved < 0 && errno == EINTR);
+            return moved;
+        }
+
+        HASHLIBCXX_INLINE bool available(const char * name) noexcept
+        {
+            file_descriptor tfm{::socket(AF_ALG, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+            const file_descriptor op{open_socket(name, tfm)};
+            return op.get() >= 0;
+        }
+
+        HASHLIBCXX_INLINE bool hash_file(const char * name,
+                                         const char * path,
+                                         uint64_t min_size,
+                                         unsigned char * digest,
+                                         size_t digest_size) noexcept
+        {
+            const file_descriptor file{::open(path, O_RDONLY | O_CLOEXEC)};
+            if (file.get() < 0)
+                return false;
+
+            struct stat status;
+            if (::fstat(file.get(), &status) != 0 || !S_ISREG(status.st_mode))
+                return false;
+
+            const uint64_t size{static_cast<uint64_t>(status.st_size)};
+            if (size < min_size)
+                return false;
+
+            file_descriptor tfm{::socket(AF_ALG, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+            const file_descriptor op{open_socket(name, tfm)};
+            if (op.get() < 0)
+                return false;
+
+            // splice() needs a pipe at one end: the file pages are moved in the pipe and from the
+            // pipe to the socket. SPLICE_F_MORE keeps the hash open until the digest is read.
+            int pipe_fds[2]{-1, -1};
+            if (::pipe2(pipe_fds, O_CLOEXEC) != 0)
+                return false;
+            const file_descriptor pipe_read{pipe_fds[0]};
+            const file_descriptor pipe_write{pipe_fds[1]};
+
+            const int pipe_size{::fcntl(pipe_write.get(), F_SETPIPE_SZ, 1024 * 1024)};
+            const size_t chunk_size{pipe_size > 0 ? static_cast<size_t>(pipe_size) : 64 * 1024};
+
+            loff_t offset{0};
+            uint64_t remaining{size};
+            while (remaining > 0)
+            {
+                const size_t len{remaining < chunk_size ? static_cast<size_t>(remaining)
+                                                        : chunk_size};
+                ssize_t in_pipe{splice_all(file.get(), &offset, pipe_write.get(), len)};
+                if (in_pipe <= 0)
+                    return false; // error, or the file has been truncated meanwhile
+                remaining -= static_cast<uint64_t>(in_pipe);
+
+                while (in_pipe > 0)
+                {
+                    const ssize_t moved{splice_all(
+                        pipe_read.get(), nullptr, op.get(), static_cast<size_t>(in_pipe))};
+                    if (moved <= 0)
+                        return false;
+                    in_pipe -= moved;
+                }
+            }
+
+            ssize_t read{-1};
+            do
+            {
+                read = ::read(op.get(), digest, digest_size);
+            } while (read < 0 && errno == EINTR);
+
+            return read == static_cast<ssize_t>(digest_size);
+        }
+
+#else
+
+        HASHLIBCXX_INLINE bool available(const char *) noexcept
+        {
+            return false;
+        }
+
+        HASHLIBCXX_INLINE bool
+        hash_file(const char *, const char *, uint64_t, unsigned char *, size_t) noexcept
+        {
+            return false;
+        }
+
+#endif
+
+    } // namespace afalg
+} // namespace hashkitcxx
+
+// in header-only mode this file is included by hash_file.hpp: do not leak the macros to the user
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,268 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Linux kernel crypto API
+ * The AF_ALG "hash" sockets hash the data spliced into them from a file: the pages
+ * move from the page cache to the kernel implementation of the algorithm (possibly
+ * accelerated) without being copied in user space.
+ * Resource link: https://www.kernel.org/doc/html/latest/crypto/userspace-if.html
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Backend used by hash_file() to compute the hash. The library is used anyway whenever
+     * the kernel is not available or does not implement the algorithm.
+     */
+    enum class file_backend
+    {
+        automatic, /**< The kernel for files of at least `kernel_threshold` bytes */
+        library,   /**< The implementation of the library for any file */
+        kernel     /**< The kernel for any file */
+    };
+
+    /**
+     * @brief Options of hash_file().
+     */
+    struct hash_file_options
+    {
+        file_backend backend{file_backend::automatic};
+        uint64_t kernel_threshold{1024 * 1024}; /**< Minimum file size for the automatic backend */
+        uint64_t checkpoint_interval{0};        /**< Bytes between two checkpoints, 0 for none */
+        const char * checkpoint_path{nullptr};  /**< Sidecar file storing the last checkpoint */
+    };
+
+    /**
+     * @brief Renames a temporary file on top of `path`, replacing it also on the platforms where
+     * std::rename() does not replace an existing file. The files written by the library go
+     * through a temporary file first, so that an interruption while writing leaves the previous
+     * content of `path` intact.
+     * @return true if the file has been renamed.
+     */
+    HASHLIBCXX_DLL bool replace_file(const char * temporary_path, const char * path) noexcept;
+
+    namespace checkpoint {
+
+        /**
+         * @brief Writes a state saved by a hash class to the given file, replacing the previous one
+         * (through a temporary file renamed on top of it, when the platform allows it).
+         * @param path the path of the checkpoint file.
+         * @param state pointer to the memory location containing the state.
+         * @param len the length of `state` expressed in bytes.
+         * @return true if the state has been written.
+         */
+        HASHLIBCXX_DLL bool save(const char * path,
+                                 const unsigned char * state,
+                                 size_t len) noexcept;
+
+        /**
+         * @brief Reads a state written by save().
+         * @param path the path of the checkpoint file.
+         * @param state pointer to the memory location to store the state.
+         * @param len the length of the state expressed in bytes.
+         * @return true if the file exists and contains exactly `len` bytes.
+         */
+        HASHLIBCXX_DLL bool load(const char * path, unsigned char * state, size_t len) noexcept;
+
+        /**
+         * @brief Moves the position of the given file at `offset`, beyond 2 GB as well.
+         * @return false if the file is shorter than `offset` or the position cannot be moved.
+         */
+        HASHLIBCXX_DLL bool seek(std::FILE * file, uint64_t offset) noexcept;
+
+    } // namespace checkpoint
+
+    namespace afalg {
+
+        /**
+         * @brief Name of the algorithm in the kernel crypto API, or nullptr when the kernel does
+         * not implement it.
+         */
+        template<class THash>
+        struct algorithm
+        {
+            static constexpr const char * name() noexcept
+            {
+                return nullptr;
+            }
+        };
+
+        template<>
+        struct algorithm<sha2::sha224>
+        {
+            static constexpr const char * name() noexcept
+            {
+                return "sha224";
+            }
+        };
+
+        template<>
+        struct algorithm<sha2::sha256>
+        {
+            static constexpr const char * name() noexcept
+            {
+                return "sha256";
+            }
+        };
+
+        template<>
+        struct algorithm<sha2::sha384>
+        {
+            static constexpr const char * name() noexcept
+            {
+                return "sha384";
+            }
+        };
+
+        template<>
+        struct algorithm<sha2::sha512>
+        {
+            static constexpr const char * name() noexcept
+            {
+                return "sha512";
+            }
+        };
+
+        /**
+         * @brief Checks whether the kernel crypto API can compute the given algorithm. It is always
+         * false when the library is built without HASHLIBCXX_LINUX_AF_ALG or outside Linux.
+         * @param name the name of the algorithm in the kernel crypto API, e.g. "sha256".
+         * @return true if an AF_ALG hash socket for `name` can be opened.
+         */
+        HASHLIBCXX_DLL bool available(const char * name) noexcept;
+
+        /**
+         * @brief Returns the hash of the content of the given file, computed by the kernel.
+         * @param name the name of the algorithm in the kernel crypto API, e.g. "sha256".
+         * @param path the path of the file to hash.
+         * @param min_size the file is not hashed if it is smaller than this size in bytes.
+         * @param digest pointer to the memory location to store the hash of the file.
+         * @param digest_size the size of the hash of `name` expressed in bytes.
+         * @return true if the hash has been stored in `digest`, false if the kernel is not
+         * available, the file is smaller than `min_size` or any error occurred.
+         */
+        HASHLIBCXX_DLL bool hash_file(const char * name,
+                                      const char * path,
+                                      uint64_t min_size,
+                                      unsigned char * digest,
+                                      size_t digest_size) noexcept;
+
+    } // namespace afalg
+
+    /**
+     * @brief Returns the hash of the content of the given file. Depending on `options`, large files
+     * are hashed by the kernel crypto API (Linux only, with HASHLIBCXX_LINUX_AF_ALG), any other
+     * file or algorithm by the library.
+     *
+     * With `checkpoint_interval` and `checkpoint_path` set, the state of the library is saved in
+     * the checkpoint file every `checkpoint_interval` bytes, and the hash resumes from there when
+     * the function is called again after an interruption. The checkpoint file is removed once the
+     * hash is complete. The file must not change in between: only its size is checked.
+     * @param path the path of the file to hash.
+     * @param digest pointer to the memory location to store the hash of the file.
+     * @param options the backend to use and the checkpoints.
+     * @return true on success, false if the file cannot be opened or read.
+     */
+    template<class THash>
+    bool hash_file(const char * path,
+                   unsigned char * digest,
+                   const hash_file_options & options = hash_file_options{}) noexcept
+    {
+        const bool checkpoints{options.checkpoint_interval > 0 &&
+                               options.checkpoint_path != nullptr};
+
+        if (!checkpoints && options.backend != file_backend::library &&
+            afalg::algorithm<THash>::name() != nullptr)
+        {
+            const uint64_t min_size{
+                options.backend == file_backend::automatic ? options.kernel_threshold : 0};
+            if (afalg::hash_file(
+                    afalg::algorithm<THash>::name(), path, min_size, digest, THash::s_digest_size))
+                return true;
+        }
+
+        std::FILE * file{std::fopen(path, "rb")};
+        if (file == nullptr)
+            return false;
+
+        THash h;
+        h.init();
+
+        unsigned char state[THash::s_state_size];
+        if (checkpoints && checkpoint::load(options.checkpoint_path, state, sizeof(state)) &&
+            h.load(state, sizeof(state)) && !checkpoint::seek(file, h.processed_size()))
+        {
+            // the file is shorter than the checkpoint: it has been changed, start over
+            h.init();
+            if (!checkpoint::seek(file, 0))
+            {
+                std::fclose(file);
+                return false;
+            }
+        }
+        uint64_t next_checkpoint{h.processed_size() + options.checkpoint_interval};
+
+        unsigned char buffer[64 * 1024];
+        size_t len{0};
+        while ((len = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            h.update(buffer, len);
+
+            if (checkpoints && h.processed_size() >= next_checkpoint)
+            {
+                h.save(state);
+                checkpoint::save(options.checkpoint_path, state, sizeof(state));
+                next_checkpoint = h.processed_size() + options.checkpoint_interval;
+            }
+        }
+
+        const bool failed{std::ferror(file) != 0};
+        std::fclose(file);
+        if (failed)
+            return false;
+
+        h.complete(digest);
+        if (checkpoints)
+            std::remove(options.checkpoint_path);
+        return true;
+    }
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_file.cpp"
+#endif
@@ -0,0 +1,251 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_constexpr.hpp"
+#include "hash_sha2_core.hpp"
+#include "hash_sha2_lanes.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// This header requires C++14, as hash_sha2_constexpr.hpp: the padding is computed by the compiler.
+
+namespace hashkitcxx {
+    namespace fixed_batch_impl {
+
+        /**
+         * @brief The padded tail of a message: `rem` bytes of the message left at zero, the bit
+         * 1, zeros, and the length of the message in bits at the end.
+         */
+        template<size_t Size>
+        constexpr std::array<unsigned char, Size> padding_bytes(size_t rem, uint64_t len) noexcept
+        {
+            unsigned char bytes[Size]{};
+            bytes[rem] = 0x80;
+            for (size_t i{0}; i < 8; ++i)
+            {
+                bytes[Size - 1 - i] = static_cast<unsigned char>((len << 3) >> (8 * i));
+            }
+            return sha2::constexpr_impl::to_array(bytes, std::make_index_sequence<Size>{});
+        }
+
+        /**
+         * @brief The blocks of the messages of `Len` bytes: the full blocks read from the
+         * message, then one or two tail blocks, the same for every message besides the bytes of
+         * the message in the first one.
+         */
+        template<class THash, size_t Len>
+        struct padding
+        {
+            using word_t = typename sha2::traits<THash>::word_t;
+
+            static constexpr size_t s_block_size{sha2::traits<THash>::s_block_size};
+            static constexpr size_t s_full_blocks{Len / s_block_size}; /**< Read from the message */
+            static constexpr size_t s_rem{Len % s_block_size}; /**< Message bytes in the tail */
+            static constexpr size_t s_tail_blocks{
+                (s_rem + 1 + 2 * sizeof(word_t) + s_block_size - 1) /
+                s_block_size}; /**< Blocks after the full ones, the length takes 2 words */
+            static constexpr size_t s_constant_blocks{
+                s_tail_blocks - (s_rem > 0 ? 1 : 0)}; /**< Tail blocks without message bytes */
+
+            using tail_t = std::array<unsigned char, s_tail_blocks * s_block_size>;
+            static constexpr tail_t s_tail{padding_bytes<s_tail_blocks * s_block_size>(
+                s_rem, Len)}; /**< The tail blocks, with the message bytes at zero */
+        };
+
+        template<class THash, size_t Len>
+        constexpr size_t padding<THash, Len>::s_block_size;
+        template<class THash, size_t Len>
+        constexpr size_t padding<THash, Len>::s_full_blocks;
+        template<class THash, size_t Len>
+        constexpr size_t padding<THash, Len>::s_rem;
+        template<class THash, size_t Len>
+        constexpr size_t padding<THash, Len>::s_tail_blocks;
+        template<class THash, size_t Len>
+        constexpr size_t padding<THash, Len>::s_constant_blocks;
+        template<class THash, size_t Len>
+        constexpr typename padding<THash, Len>::tail_t padding<THash, Len>::s_tail;
+
+        /**
+         * @brief Hashes the keys one at a time with the compression function, without the
+         * buffering of update() and complete().
+         */
+        template<class THash, size_t Len>
+        void hash_batch(const unsigned char * keys,
+                        size_t count,
+                        unsigned char * digests,
+                        std::false_type /*lanes*/) noexcept
+        {
+            using pad = padding<THash, Len>;
+            using word_t = typename pad::word_t;
+
+            typename pad::tail_t tail{pad::s_tail};
+            for (size_t k{0}; k < count; ++k)
+            {
+                const unsigned char * key{keys + k * Len};
+                word_t h[8];
+                for (size_t i{0}; i < 8; ++i)
+                    h[i] = sha2::traits<THash>::h0()[i];
+
+                if (pad::s_full_blocks > 0)
+                    THash::compress(h, key, pad::s_full_blocks);
+                if (pad::s_rem > 0)
+                {
+                    std::memcpy(tail.data(), key + pad::s_full_blocks * pad::s_block_size,
+                                pad::s_rem);
+                }
+                THash::compress(h, tail.data(), pad::s_tail_blocks);
+
+                unsigned char * digest{digests + k * THash::s_digest_size};
+                for (size_t i{0}; i < THash::s_digest_size; ++i)
+                {
+                    const size_t shift{8 * (sizeof(word_t) - 1 - i % sizeof(word_t))};
+                    digest[i] = static_cast<unsigned char>(h[i / sizeof(word_t)] >> shift);
+                }
+            }
+        }
+
+        /**
+         * @brief Hashes the keys 8 at a time with the multi-buffer sha-256 kernel. All the lanes
+         * have the same number of blocks, and the words of the tail blocks without key bytes are
+         * computed once for all the lanes and batches.
+         */
+        template<class THash, size_t Len>
+        void hash_batch(const unsigned char * keys,
+                        size_t count,
+                        unsigned char * digests,
+                        std::true_type /*lanes*/) noexcept
+        {
+            using sha2::lanes::s_sha256_lanes;
+            using pad = padding<THash, Len>;
+            constexpr size_t block_size{pad::s_block_size};
+
+            uint32_t constant[2][16][s_sha256_lanes];
+            for (size_t b{0}; b < pad::s_constant_blocks; ++b)
+            {
+                const unsigned char * block{pad::s_tail.data() +
+                                            (pad::s_tail_blocks - pad::s_constant_blocks + b) *
+                                                block_size};
+                for (size_t t{0}; t < 16; ++t)
+                {
+                    const uint32_t word{(static_cast<uint32_t>(block[4 * t]) << 24) |
+                                        (static_cast<uint32_t>(block[4 * t + 1]) << 16) |
+                                        (static_cast<uint32_t>(block[4 * t + 2]) << 8) |
+                                        block[4 * t + 3]};
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                        constant[b][t][lane] = word;
+                }
+            }
+
+            // the first tail block of each lane: the padding is written once, the key bytes for
+            // each batch
+            unsigned char tails[s_sha256_lanes][block_size];
+            for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                std::memcpy(tails[lane], pad::s_tail.data(), block_size);
+            unsigned char unused[THash::s_digest_size];
+
+            for (size_t first{0}; first < count; first += s_sha256_lanes)
+            {
+                // the lanes past the last key hash the first key of the batch again
+                const unsigned char * key[s_sha256_lanes];
+                unsigned char * digest[s_sha256_lanes];
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    const bool used{first + lane < count};
+                    key[lane] = keys + (used ? first + lane : first) * Len;
+                    digest[lane] = used ? digests + (first + lane) * THash::s_digest_size : unused;
+                }
+
+                uint32_t h[8][s_sha256_lanes];
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                        h[i][lane] = sha2::traits<THash>::h0()[i];
+                }
+
+                uint32_t words[16][s_sha256_lanes];
+                const unsigned char * blocks[s_sha256_lanes];
+                for (size_t b{0}; b < pad::s_full_blocks; ++b)
+                {
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                        blocks[lane] = key[lane] + b * block_size;
+                    sha2::lanes::sha256_load(words, blocks);
+                    sha2::lanes::sha256_compress(h, words);
+                }
+                if (pad::s_rem > 0)
+                {
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                    {
+                        std::memcpy(tails[lane], key[lane] + pad::s_full_blocks * block_size,
+                                    pad::s_rem);
+                        blocks[lane] = tails[lane];
+                    }
+                    sha2::lanes::sha256_load(words, blocks);
+                    sha2::lanes::sha256_compress(h, words);
+                }
+                for (size_t b{0}; b < pad::s_constant_blocks; ++b)
+                    sha2::lanes::sha256_compress(h, constant[b]);
+
+                sha2::lanes::sha256_store(digest, THash::s_digest_size, h);
+            }
+        }
+
+    } // namespace fixed_batch_impl
+
+    /**
+     * @brief Hashes many keys of the same length, e.g. 32 bytes identifiers, stored one after the
+     * other. The padding of the keys is computed at compile time, and sha224 and sha256 hash the
+     * keys 8 at a time with the multi-buffer kernel: the lanes load their blocks together with
+     * SIMD shuffles and all finish at the same block. The other algorithms hash them one at a
+     * time with their compression function.
+     * @tparam THash one of the sha2 classes (e.g. `sha256`).
+     * @tparam Len the length of each key expressed in bytes.
+     * @param keys the keys, `count * Len` bytes.
+     * @param count the number of keys.
+     * @param digests receives the digests one after the other, `count * THash::s_digest_size`
+     * bytes.
+     */
+    template<class THash, size_t Len>
+    void hash_fixed_batch(const unsigned char * keys,
+                          size_t count,
+                          unsigned char * digests) noexcept
+    {
+        using lanes_t = std::integral_constant<
+            bool,
+            std::is_same<typename sha2::traits<THash>::word_t, uint32_t>::value>;
+        fixed_batch_impl::hash_batch<THash, Len>(keys, count, digests, lanes_t{});
+    }
+
+} // namespace hashkitcxx
@@ -0,0 +1,128 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_mapped_file.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace hashkitcxx {
+
+    HASHLIBCXX_INLINE mapped_file::~mapped_file()
+    {
+        close();
+    }
+
+    HASHLIBCXX_INLINE bool mapped_file::open(const char * path, bool random_access) noexcept
+    {
+        close();
+
+#if defined(_WIN32)
+        const DWORD flags{random_access ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL};
+        const HANDLE file{::CreateFileA(
+            path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr)};
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER file_size;
+        const bool sized{::GetFileSizeEx(file, &file_size) != 0 && file_size.QuadPart > 0};
+        const HANDLE mapping{
+            sized ? ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr};
+        ::CloseHandle(file);
+        if (mapping == nullptr)
+            return false;
+
+        void * data{::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+        ::CloseHandle(mapping);
+        if (data == nullptr)
+            return false;
+        m_size = static_cast<uint64_t>(file_size.QuadPart);
+#else
+        const int fd{::open(path, O_RDONLY)};
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        const bool sized{::fstat(fd, &status) == 0 && status.st_size > 0};
+        void * data{sized ? ::mmap(nullptr,
+                                   static_cast<size_t>(status.st_size),
+                                   PROT_READ,
+                                   MAP_SHARED,
+                                   fd,
+                                   0)
+                          : MAP_FAILED};
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return false;
+
+        // reading ahead would only pollute the page cache when the accesses jump across the file
+        if (random_access)
+            ::madvise(data, static_cast<size_t>(status.st_size), MADV_RANDOM);
+        m_size = static_cast<uint64_t>(status.st_size);
+#endif
+        m_data = static_cast<const unsigned char *>(data);
+        return true;
+    }
+
+    HASHLIBCXX_INLINE void mapped_file::close() noexcept
+    {
+        if (m_data == nullptr)
+            return;
+
+#if defined(_WIN32)
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<unsigned char *>(m_data), static_cast<size_t>(m_size));
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,88 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include <cstdint>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Read-only mapping of a whole file in memory, unmapped when destroyed.
+     */
+    class HASHLIBCXX_DLL mapped_file final
+    {
+      public:
+        mapped_file() noexcept = default;
+        ~mapped_file();
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file & operator=(const mapped_file &) = delete;
+
+        /**
+         * @brief Maps the given file, unmapping the previous one.
+         * @param path the path of the file.
+         * @param random_access whether the file is read in no particular order, so that the
+         * system does not read ahead.
+         * @return false if the file cannot be opened or mapped, or is empty.
+         */
+        bool open(const char * path, bool random_access) noexcept;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close() noexcept;
+
+        /**
+         * @brief Returns the content of the file, nullptr if no file is mapped.
+         */
+        const unsigned char * data() const noexcept
+        {
+            return m_data;
+        }
+
+        /**
+         * @brief Returns the size of the file expressed in bytes.
+         */
+        uint64_t size() const noexcept
+        {
+            return m_size;
+        }
+
+      private:
+        const unsigned char * m_data{nullptr}; /**< Mapped file */
+        uint64_t m_size{0};                    /**< Size of the mapped file */
+    };
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_mapped_file.cpp"
+#endif
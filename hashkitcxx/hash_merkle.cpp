@@ -0,0 +1,386 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_merkle.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(HASHLIBCXX_ASSERT)
+#    undef HASHLIBCXX_ASSERT
+#endif
+#if defined(HASHLIBCXX_STD_ASSERT)
+#    include <cassert>
+#    define HASHLIBCXX_ASSERT assert
+#else
+#    define HASHLIBCXX_ASSERT(x)
+#endif
+
+#include "hash_sha2_core.hpp"
+#include <cstring>
+#include <thread>
+
+namespace hashkitcxx {
+    namespace merkle {
+
+        /**
+         * @brief Returns the size of the left subtree of a tree of `size` leaves, the largest
+         * power of 2 lower than `size`, which is at least 2.
+         */
+        HASHLIBCXX_INLINE uint64_t split_size(uint64_t size) noexcept
+        {
+            uint64_t k{1};
+            while (k * 2 < size)
+                k *= 2;
+            return k;
+        }
+
+        HASHLIBCXX_INLINE digest_t leaf_hash(const unsigned char * data, size_t len) noexcept
+        {
+            const unsigned char prefix{0x00};
+            const unsigned char empty{0};
+
+            sha2::sha256 h;
+            h.init();
+            h.update(&prefix, 1);
+            h.update(len > 0 ? data : &empty, len);
+            digest_t digest;
+            h.complete(digest.data());
+            return digest;
+        }
+
+        HASHLIBCXX_INLINE digest_t node_hash(const digest_t & left, const digest_t & right) noexcept
+        {
+            // 0x01 || left || right, then the padding of 65 bytes: 0x80 and the length in bits
+            unsigned char blocks[2 * 64]{};
+            blocks[0] = 0x01;
+            std::memcpy(blocks + 1, left.data(), 32);
+            std::memcpy(blocks + 33, right.data(), 32);
+            blocks[65] = 0x80;
+            blocks[126] = (65 * 8) >> 8;
+            blocks[127] = (65 * 8) & 0xff;
+
+            std::array<uint32_t, 8> h{sha2::traits<sha2::sha256>::h0()};
+            sha2::sha256::compress(h.data(), blocks, 2);
+
+            digest_t digest;
+            for (size_t i{0}; i < digest.size(); ++i)
+                digest[i] = static_cast<unsigned char>(h[i / 4] >> (8 * (3 - i % 4)));
+            return digest;
+        }
+
+        HASHLIBCXX_INLINE void leaf_hashes(const unsigned char * const * leaves,
+                                           const size_t * sizes,
+                                           size_t count,
+                                           digest_t * hashes,
+                                           unsigned threads)
+        {
+            // below this number of leaves per thread, starting the threads costs more than it saves
+            constexpr size_t min_leaves_per_thread{1024};
+
+            if (threads == 0)
+                threads = std::thread::hardware_concurrency();
+            const size_t max_threads{count / min_leaves_per_thread};
+            const size_t thread_count{threads < max_threads ? threads : max_threads};
+
+            auto hash_range = [leaves, sizes, hashes](size_t begin, size_t end) {
+                for (size_t i{begin}; i < end; ++i)
+                    hashes[i] = leaf_hash(leaves[i], sizes[i]);
+            };
+
+            if (thread_count <= 1)
+            {
+                hash_range(0, count);
+                return;
+            }
+
+            // the calling thread hashes the last range
+            std::vector<std::thread> workers;
+            workers.reserve(thread_count - 1);
+            const size_t range{count / thread_count};
+            for (size_t t{0}; t + 1 < thread_count; ++t)
+                workers.emplace_back(hash_range, t * range, (t + 1) * range);
+            hash_range((thread_count - 1) * range, count);
+            for (std::thread & worker : workers)
+                worker.join();
+        }
+
+        HASHLIBCXX_INLINE bool verify_inclusion(uint64_t index,
+                                                uint64_t size,
+                                                const digest_t & leaf,
+                                                const digest_t * proof,
+                                                size_t proof_size,
+                                                const digest_t & root) noexcept
+        {
+            if (index >= size)
+                return false;
+
+            uint64_t fn{index};
+            uint64_t sn{size - 1};
+            digest_t r{leaf};
+            for (size_t i{0}; i < proof_size; ++i)
+            {
+                if (sn == 0)
+                    return false;
+
+                if ((fn & 1) != 0 || fn == sn)
+                {
+                    r = node_hash(proof[i], r);
+                    while ((fn & 1) == 0 && fn != 0)
+                    {
+                        fn >>= 1;
+                        sn >>= 1;
+                    }
+                }
+                else
+                    r = node_hash(r, proof[i]);
+                fn >>= 1;
+                sn >>= 1;
+            }
+            return sn == 0 && r == root;
+        }
+
+        HASHLIBCXX_INLINE bool verify_consistency(uint64_t first,
+                                                  uint64_t second,
+                                                  const digest_t & first_root,
+                                                  const digest_t & second_root,
+                                                  const digest_t * proof,
+                                                  size_t proof_size) noexcept
+        {
+            if (first == 0 || first > second)
+                return false;
+            if (first == second)
+                return proof_size == 0 && first_root == second_root;
+
+            // when the older tree is a perfect subtree of the newer one, its root starts the path
+            const bool perfect{(first & (first - 1)) == 0};
+            if (proof_size == 0)
+                return false;
+
+            uint64_t fn{first - 1};
+            uint64_t sn{second - 1};
+            while ((fn & 1) != 0)
+            {
+                fn >>= 1;
+                sn >>= 1;
+            }
+
+            digest_t fr{perfect ? first_root : proof[0]};
+            digest_t sr{fr};
+            for (size_t i{perfect ? 0U : 1U}; i < proof_size; ++i)
+            {
+                if (sn == 0)
+                    return false;
+
+                if ((fn & 1) != 0 || fn == sn)
+                {
+                    fr = node_hash(proof[i], fr);
+                    sr = node_hash(proof[i], sr);
+                    while ((fn & 1) == 0 && fn != 0)
+                    {
+                        fn >>= 1;
+                        sn >>= 1;
+                    }
+                }
+                else
+                    sr = node_hash(sr, proof[i]);
+                fn >>= 1;
+                sn >>= 1;
+            }
+            return sn == 0 && fr == first_root && sr == second_root;
+        }
+
+        HASHLIBCXX_INLINE void accumulator::append(const unsigned char * const * leaves,
+                                                   const size_t * sizes,
+                                                   size_t count,
+                                                   unsigned threads)
+        {
+            std::vector<digest_t> hashes(count);
+            leaf_hashes(leaves, sizes, count, hashes.data(), threads);
+            for (const digest_t & hash : hashes)
+                append_hash(hash);
+        }
+
+        HASHLIBCXX_INLINE void accumulator::append_hash(const digest_t & leaf) noexcept
+        {
+            // each trailing bit set in the size is a perfect subtree of the same size as the one
+            // being added, they merge like a binary carry
+            digest_t carry{leaf};
+            for (uint64_t size{m_size}; (size & 1) != 0; size >>= 1)
+                carry = node_hash(m_frontier[--m_frontier_size], carry);
+            m_frontier[m_frontier_size++] = carry;
+            ++m_size;
+        }
+
+        HASHLIBCXX_INLINE digest_t accumulator::root() const noexcept
+        {
+            if (m_frontier_size == 0)
+                return sha2::sha256{}.hash(reinterpret_cast<const unsigned char *>(""), 0);
+
+            digest_t root{m_frontier[m_frontier_size - 1]};
+            for (size_t i{m_frontier_size - 1}; i > 0; --i)
+                root = node_hash(m_frontier[i - 1], root);
+            return root;
+        }
+
+        HASHLIBCXX_INLINE void tree::append(const unsigned char * const * leaves,
+                                            const size_t * sizes,
+                                            size_t count,
+                                            unsigned threads)
+        {
+            std::vector<digest_t> hashes(count);
+            leaf_hashes(leaves, sizes, count, hashes.data(), threads);
+            for (const digest_t & hash : hashes)
+                append_hash(hash);
+        }
+
+        HASHLIBCXX_INLINE void tree::append_hash(const digest_t & leaf)
+        {
+            if (m_levels.empty())
+                m_levels.emplace_back();
+            m_levels[0].push_back(leaf);
+
+            // a subtree whose index is odd completes the one of the next level with its sibling
+            for (size_t level{0}; m_levels[level].size() % 2 == 0; ++level)
+            {
+                if (level + 1 == m_levels.size())
+                    m_levels.emplace_back();
+                const std::vector<digest_t> & nodes{m_levels[level]};
+                const digest_t parent{node_hash(nodes[nodes.size() - 2], nodes.back())};
+                m_levels[level + 1].push_back(parent);
+            }
+        }
+
+        HASHLIBCXX_INLINE digest_t tree::root(uint64_t size) const noexcept
+        {
+            HASHLIBCXX_ASSERT(size <= this->size());
+
+            if (size == 0)
+                return sha2::sha256{}.hash(reinterpret_cast<const unsigned char *>(""), 0);
+            return subtree_root(0, size);
+        }
+
+        HASHLIBCXX_INLINE digest_t tree::subtree_root(uint64_t begin, uint64_t end) const noexcept
+        {
+            // the left part of a split is a perfect subtree, aligned on its size
+            const uint64_t size{end - begin};
+            if ((size & (size - 1)) == 0)
+            {
+                size_t level{0};
+                while ((uint64_t{1} << level) < size)
+                    ++level;
+                return m_levels[level][static_cast<size_t>(begin >> level)];
+            }
+
+            const uint64_t k{split_size(size)};
+            return node_hash(subtree_root(begin, begin + k), subtree_root(begin + k, end));
+        }
+
+        HASHLIBCXX_INLINE std::vector<digest_t> tree::inclusion_proof(uint64_t index,
+                                                                      uint64_t size) const
+        {
+            HASHLIBCXX_ASSERT(index < size && size <= this->size());
+
+            std::vector<digest_t> proof;
+            add_inclusion_path(index, 0, size, proof);
+            return proof;
+        }
+
+        HASHLIBCXX_INLINE void tree::add_inclusion_path(uint64_t index,
+                                                        uint64_t begin,
+                                                        uint64_t end,
+                                                        std::vector<digest_t> & proof) const
+        {
+            // PATH(m, D[n]) of RFC 9162, the hashes of the siblings from the leaf to the root
+            if (end - begin <= 1)
+                return;
+
+            const uint64_t k{split_size(end - begin)};
+            if (index < begin + k)
+            {
+                add_inclusion_path(index, begin, begin + k, proof);
+                proof.push_back(subtree_root(begin + k, end));
+            }
+            else
+            {
+                add_inclusion_path(index, begin + k, end, proof);
+                proof.push_back(subtree_root(begin, begin + k));
+            }
+        }
+
+        HASHLIBCXX_INLINE std::vector<digest_t> tree::consistency_proof(uint64_t first,
+                                                                        uint64_t second) const
+        {
+            HASHLIBCXX_ASSERT(0 < first && first <= second && second <= size());
+
+            std::vector<digest_t> proof;
+            if (first < second)
+                add_consistency_path(first, 0, second, true, proof);
+            return proof;
+        }
+
+        HASHLIBCXX_INLINE void tree::add_consistency_path(uint64_t first,
+                                                          uint64_t begin,
+                                                          uint64_t end,
+                                                          bool complete,
+                                                          std::vector<digest_t> & proof) const
+        {
+            // SUBPROOF(m, D[n], b) of RFC 9162, `first` counted from `begin`
+            if (first == end - begin)
+            {
+                if (!complete)
+                    proof.push_back(subtree_root(begin, end));
+                return;
+            }
+
+            const uint64_t k{split_size(end - begin)};
+            if (first <= k)
+            {
+                add_consistency_path(first, begin, begin + k, complete, proof);
+                proof.push_back(subtree_root(begin + k, end));
+            }
+            else
+            {
+                add_consistency_path(first - k, begin + k, end, false, proof);
+                proof.push_back(subtree_root(begin, begin + k));
+            }
+        }
+
+    } // namespace merkle
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,265 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Certificate Transparency Version 2.0 (RFC 9162)
+ * Section 2.1 defines the Merkle tree hash of a log, the inclusion proofs of a leaf
+ * and the consistency proofs between two versions of a log, with the algorithms to
+ * verify them.
+ * Resource link: https://www.rfc-editor.org/rfc/rfc9162#section-2.1
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hashkitcxx {
+    namespace merkle {
+
+        using digest_t = sha2::sha256::digest_t;
+
+        /**
+         * @brief Returns the hash of a leaf of the tree: sha-256 of 0x00 followed by the data.
+         * @param data pointer to the memory location containing the content of the leaf.
+         * @param len the length of `data` expressed in bytes.
+         */
+        HASHLIBCXX_DLL digest_t leaf_hash(const unsigned char * data, size_t len) noexcept;
+
+        /**
+         * @brief Returns the hash of an inner node of the tree: sha-256 of 0x01 followed by the
+         * hashes of its children. The 65 bytes always take two blocks, which are compressed
+         * directly, without the buffering of update().
+         */
+        HASHLIBCXX_DLL digest_t node_hash(const digest_t & left, const digest_t & right) noexcept;
+
+        /**
+         * @brief Computes the hash of many leaves, on several threads when there are many.
+         * @param leaves the content of each leaf.
+         * @param sizes the length of each leaf expressed in bytes.
+         * @param count the number of leaves.
+         * @param hashes receives the hash of each leaf.
+         * @param threads the maximum number of threads, 0 for the number of cores.
+         */
+        HASHLIBCXX_DLL void leaf_hashes(const unsigned char * const * leaves,
+                                        const size_t * sizes,
+                                        size_t count,
+                                        digest_t * hashes,
+                                        unsigned threads = 0);
+
+        /**
+         * @brief Checks that a leaf is in the tree of `size` leaves with the given root.
+         * @param index the position of the leaf.
+         * @param size the number of leaves of the tree.
+         * @param leaf the hash of the leaf.
+         * @param proof the inclusion proof, as returned by tree::inclusion_proof().
+         * @param proof_size the number of hashes of `proof`.
+         * @param root the root of the tree.
+         */
+        HASHLIBCXX_DLL bool verify_inclusion(uint64_t index,
+                                             uint64_t size,
+                                             const digest_t & leaf,
+                                             const digest_t * proof,
+                                             size_t proof_size,
+                                             const digest_t & root) noexcept;
+
+        /**
+         * @brief Checks that the tree of `first` leaves is a prefix of the tree of `second` leaves,
+         * i.e. that the log has only been appended to.
+         * @param first the number of leaves of the older tree.
+         * @param second the number of leaves of the newer tree.
+         * @param first_root the root of the older tree.
+         * @param second_root the root of the newer tree.
+         * @param proof the consistency proof, as returned by tree::consistency_proof().
+         * @param proof_size the number of hashes of `proof`.
+         */
+        HASHLIBCXX_DLL bool verify_consistency(uint64_t first,
+                                               uint64_t second,
+                                               const digest_t & first_root,
+                                               const digest_t & second_root,
+                                               const digest_t * proof,
+                                               size_t proof_size) noexcept;
+
+        /**
+         * @brief Root of an append-only log, updated in O(log n) per leaf while keeping only the
+         * roots of the perfect subtrees covering the log (the compact range of [0, n)), one for
+         * each bit set in the number of leaves.
+         */
+        class HASHLIBCXX_DLL accumulator final
+        {
+          public:
+            /**
+             * @brief Appends a leaf to the log.
+             * @param data pointer to the memory location containing the content of the leaf.
+             * @param len the length of `data` expressed in bytes.
+             */
+            void append(const unsigned char * data, size_t len) noexcept
+            {
+                append_hash(leaf_hash(data, len));
+            }
+
+            /**
+             * @brief Appends many leaves, hashed on several threads when there are many.
+             * @param leaves the content of each leaf.
+             * @param sizes the length of each leaf expressed in bytes.
+             * @param count the number of leaves.
+             * @param threads the maximum number of threads, 0 for the number of cores.
+             */
+            void append(const unsigned char * const * leaves,
+                        const size_t * sizes,
+                        size_t count,
+                        unsigned threads = 0);
+
+            /**
+             * @brief Appends a leaf given its hash.
+             */
+            void append_hash(const digest_t & leaf) noexcept;
+
+            /**
+             * @brief Returns the number of leaves of the log.
+             */
+            uint64_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            /**
+             * @brief Returns the root of the log, the hash of the empty string when it is empty.
+             */
+            digest_t root() const noexcept;
+
+          private:
+            digest_t m_frontier[64]{}; /**< Roots of the perfect subtrees, the largest first */
+            size_t m_frontier_size{0};
+            uint64_t m_size{0};
+        };
+
+        /**
+         * @brief Append-only log keeping the hash of every perfect subtree, so that the root of
+         * any previous version and the proofs are computed in O(log n) hashes without reading
+         * the leaves again. It takes about two hashes per leaf.
+         */
+        class HASHLIBCXX_DLL tree final
+        {
+          public:
+            /**
+             * @brief Appends a leaf to the log.
+             * @param data pointer to the memory location containing the content of the leaf.
+             * @param len the length of `data` expressed in bytes.
+             */
+            void append(const unsigned char * data, size_t len)
+            {
+                append_hash(leaf_hash(data, len));
+            }
+
+            /**
+             * @brief Appends many leaves, hashed on several threads when there are many.
+             * @param leaves the content of each leaf.
+             * @param sizes the length of each leaf expressed in bytes.
+             * @param count the number of leaves.
+             * @param threads the maximum number of threads, 0 for the number of cores.
+             */
+            void append(const unsigned char * const * leaves,
+                        const size_t * sizes,
+                        size_t count,
+                        unsigned threads = 0);
+
+            /**
+             * @brief Appends a leaf given its hash.
+             */
+            void append_hash(const digest_t & leaf);
+
+            /**
+             * @brief Returns the number of leaves of the log.
+             */
+            uint64_t size() const noexcept
+            {
+                return m_levels.empty() ? 0 : m_levels[0].size();
+            }
+
+            /**
+             * @brief Returns the hash of the leaf at `index`.
+             */
+            const digest_t & leaf(uint64_t index) const noexcept
+            {
+                return m_levels[0][static_cast<size_t>(index)];
+            }
+
+            /**
+             * @brief Returns the root of the log when it had `size` leaves, at most size().
+             */
+            digest_t root(uint64_t size) const noexcept;
+
+            /**
+             * @brief Returns the root of the log.
+             */
+            digest_t root() const noexcept
+            {
+                return root(size());
+            }
+
+            /**
+             * @brief Returns the proof that the leaf at `index` is in the log of `size` leaves.
+             * @param index the position of the leaf, lower than `size`.
+             * @param size the number of leaves of the version of the log, at most size().
+             */
+            std::vector<digest_t> inclusion_proof(uint64_t index, uint64_t size) const;
+
+            /**
+             * @brief Returns the proof that the log of `first` leaves is a prefix of the log of
+             * `second` leaves.
+             * @param first the number of leaves of the older version, from 1 to `second`.
+             * @param second the number of leaves of the newer version, at most size().
+             */
+            std::vector<digest_t> consistency_proof(uint64_t first, uint64_t second) const;
+
+          private:
+            digest_t subtree_root(uint64_t begin, uint64_t end) const noexcept;
+            void add_inclusion_path(uint64_t index,
+                                    uint64_t begin,
+                                    uint64_t end,
+                                    std::vector<digest_t> & proof) const;
+            void add_consistency_path(uint64_t first,
+                                      uint64_t begin,
+                                      uint64_t end,
+                                      bool complete,
+                                      std::vector<digest_t> & proof) const;
+
+          private:
+            std::vector<std::vector<digest_t>> m_levels; /**< Roots of the subtrees of 2^level */
+        };
+
+    } // namespace merkle
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_merkle.cpp"
+#endif
@@ -0,0 +1,344 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_nonce_search.hpp"
+#include "hash_sha2_core.hpp"
+#include "hash_sha2_lanes.hpp"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+namespace hashkitcxx {
+    namespace nonce_search_impl {
+
+        using sha2::lanes::s_sha256_lanes;
+
+        constexpr uint64_t s_chunk_size{1 << 14}; /**< Nonces taken at once by a thread */
+        constexpr uint64_t s_none{UINT64_MAX};    /**< No nonce found */
+
+        /**
+         * @brief Everything about the search that does not depend on the nonce.
+         */
+        struct plan_t
+        {
+            uint32_t midstate[8];                 /**< Hash value after the constant blocks */
+            uint32_t vars[8];                     /**< Working variables after the first rounds */
+            unsigned first_round;                 /**< First round depending on the nonce */
+            std::vector<uint32_t> words;          /**< Words of the last blocks, nonce zeroed */
+            size_t nonce_position;                /**< Position of the nonce in the last blocks */
+            size_t nonce_size;                    /**< Bytes of the nonce */
+            bool little_endian;                   /**< Byte order of the nonce */
+            uint32_t target[8];                   /**< Target as big endian words */
+        };
+
+        HASHLIBCXX_INLINE unsigned char nonce_byte(uint64_t nonce,
+                                                   size_t i,
+                                                   size_t nonce_size,
+                                                   bool little_endian) noexcept
+        {
+            const size_t shift{8 * (little_endian ? i : nonce_size - 1 - i)};
+            return static_cast<unsigned char>(nonce >> shift);
+        }
+
+        HASHLIBCXX_INLINE uint64_t max_nonce(size_t nonce_size) noexcept
+        {
+            return nonce_size >= 8 ? UINT64_MAX : (uint64_t{1} << (8 * nonce_size)) - 1;
+        }
+
+        HASHLIBCXX_INLINE bool valid(const nonce_search_params & params) noexcept
+        {
+            return params.nonce_size >= 1 && params.nonce_size <= 8 &&
+                   params.nonce_offset <= params.len &&
+                   params.nonce_size <= params.len - params.nonce_offset &&
+                   params.message != nullptr;
+        }
+
+        HASHLIBCXX_INLINE void hash(const nonce_search_params & params,
+                                    uint64_t nonce,
+                                    unsigned char * digest) noexcept
+        {
+            unsigned char bytes[8];
+            for (size_t i{0}; i < params.nonce_size; ++i)
+                bytes[i] = nonce_byte(nonce, i, params.nonce_size, params.little_endian);
+
+            sha2::sha256 h;
+            h.init();
+            if (params.nonce_offset > 0)
+                h.update(params.message, params.nonce_offset);
+            h.update(bytes, params.nonce_size);
+            const size_t end{params.nonce_offset + params.nonce_size};
+            if (end < params.len)
+                h.update(params.message + end, params.len - end);
+            h.complete(digest);
+        }
+
+        HASHLIBCXX_INLINE void make_plan(const nonce_search_params & params, plan_t & plan)
+        {
+            // the message padded: the blocks from the one holding the nonce vary, not the others
+            const size_t first_block{params.nonce_offset / 64};
+            const size_t padded_len{(params.len + 8) / 64 * 64 + 64};
+            std::vector<unsigned char> padded(padded_len);
+            std::memcpy(padded.data(), params.message, params.len);
+            std::memset(padded.data() + params.nonce_offset, 0, params.nonce_size);
+            padded[params.len] = 0x80;
+            const uint64_t bits{static_cast<uint64_t>(params.len) * 8};
+            for (size_t i{0}; i < 8; ++i)
+                padded[padded_len - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+
+            std::memcpy(plan.midstate, sha2::sha256_h0.data(), sizeof(plan.midstate));
+            if (first_block > 0)
+                sha2::sha256::compress(plan.midstate, padded.data(), first_block);
+
+            plan.words.resize((padded_len - first_block * 64) / 4);
+            for (size_t i{0}; i < plan.words.size(); ++i)
+            {
+                const unsigned char * word{padded.data() + first_block * 64 + 4 * i};
+                plan.words[i] = (static_cast<uint32_t>(word[0]) << 24) |
+                                (static_cast<uint32_t>(word[1]) << 16) |
+                                (static_cast<uint32_t>(word[2]) << 8) | word[3];
+            }
+            plan.nonce_position = params.nonce_offset - first_block * 64;
+            plan.nonce_size = params.nonce_size;
+            plan.little_endian = params.little_endian;
+
+            // the rounds before the first word holding the nonce are the same for every nonce
+            plan.first_round = static_cast<unsigned>(plan.nonce_position / 4);
+            uint32_t a{plan.midstate[0]}, b{plan.midstate[1]}, c{plan.midstate[2]};
+            uint32_t d{plan.midstate[3]}, e{plan.midstate[4]}, f{plan.midstate[5]};
+            uint32_t g{plan.midstate[6]}, h{plan.midstate[7]};
+            for (unsigned t{0}; t < plan.first_round; ++t)
+            {
+                const uint32_t t1{h + sha2::sha256_f2(e) + sha2::ch(e, f, g) + sha2::sha256_k[t] +
+                                  plan.words[t]};
+                const uint32_t t2{sha2::sha256_f1(a) + sha2::maj(a, b, c)};
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            const uint32_t vars[8]{a, b, c, d, e, f, g, h};
+            std::memcpy(plan.vars, vars, sizeof(vars));
+
+            for (size_t i{0}; i < 8; ++i)
+            {
+                plan.target[i] = (static_cast<uint32_t>(params.target[4 * i]) << 24) |
+                                 (static_cast<uint32_t>(params.target[4 * i + 1]) << 16) |
+                                 (static_cast<uint32_t>(params.target[4 * i + 2]) << 8) |
+                                 params.target[4 * i + 3];
+            }
+        }
+
+        /**
+         * @brief Returns the lowest nonce of [begin, last] reaching the target, or s_none. The
+         * scan stops early once it passes `best`, the lowest nonce found by any thread. The last
+         * nonce is included, so that the range can end at UINT64_MAX without wrapping.
+         */
+        HASHLIBCXX_INLINE uint64_t scan(const plan_t & plan,
+                                        uint64_t begin,
+                                        uint64_t last,
+                                        const std::atomic<uint64_t> & best) noexcept
+        {
+            const size_t block_count{plan.words.size() / 16};
+
+            for (uint64_t batch{begin};; batch += s_sha256_lanes)
+            {
+                if (batch > best.load(std::memory_order_relaxed))
+                    return s_none;
+
+                uint32_t h[8][s_sha256_lanes];
+                for (size_t block{0}; block < block_count; ++block)
+                {
+                    uint32_t words[16][s_sha256_lanes];
+                    for (size_t t{0}; t < 16; ++t)
+                    {
+                        for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                            words[t][lane] = plan.words[16 * block + t];
+                    }
+
+                    // the last batch repeats nonces of the range in its unused lanes
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                    {
+                        const uint64_t nonce{lane <= last - batch ? batch + lane : batch};
+                        for (size_t i{0}; i < plan.nonce_size; ++i)
+                        {
+                            const size_t position{plan.nonce_position + i};
+                            if (position / 64 != block)
+                                continue;
+                            const uint32_t byte{
+                                nonce_byte(nonce, i, plan.nonce_size, plan.little_endian)};
+                            words[(position % 64) / 4][lane] |= byte << (8 * (3 - position % 4));
+                        }
+                    }
+
+                    if (block == 0)
+                    {
+                        uint32_t vars[8][s_sha256_lanes];
+                        for (size_t i{0}; i < 8; ++i)
+                        {
+                            for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                                vars[i][lane] = plan.vars[i];
+                        }
+                        sha2::lanes::sha256_rounds(vars, words, plan.first_round);
+                        for (size_t i{0}; i < 8; ++i)
+                        {
+                            for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                                h[i][lane] = plan.midstate[i] + vars[i][lane];
+                        }
+                    }
+                    else
+                        sha2::lanes::sha256_compress(h, words);
+                }
+
+                for (size_t lane{0}; lane < s_sha256_lanes && lane <= last - batch; ++lane)
+                {
+                    size_t i{0};
+                    while (i < 7 && h[i][lane] == plan.target[i])
+                        ++i;
+                    if (h[i][lane] <= plan.target[i])
+                        return batch + lane;
+                }
+
+                // this batch reached the last nonce: the next one would start past it
+                if (last - batch < s_sha256_lanes)
+                    return s_none;
+            }
+        }
+
+        /**
+         * @brief Takes chunks of nonces in increasing order until the range is exhausted or the
+         * chunks left start after the lowest nonce found.
+         */
+        HASHLIBCXX_INLINE void search(const plan_t & plan,
+                                      uint64_t first,
+                                      uint64_t last,
+                                      std::atomic<uint64_t> & next_chunk,
+                                      std::atomic<uint64_t> & best) noexcept
+        {
+            for (;;)
+            {
+                const uint64_t chunk{next_chunk.fetch_add(1, std::memory_order_relaxed)};
+                if (chunk > (last - first) / s_chunk_size)
+                    return;
+                const uint64_t begin{first + chunk * s_chunk_size};
+                if (begin > best.load(std::memory_order_relaxed))
+                    return;
+
+                const uint64_t chunk_last{last - begin < s_chunk_size ? last
+                                                                      : begin + s_chunk_size - 1};
+                const uint64_t found{scan(plan, begin, chunk_last, best)};
+                if (found == s_none)
+                    continue;
+
+                uint64_t current{best.load(std::memory_order_relaxed)};
+                while (found < current &&
+                       !best.compare_exchange_weak(current, found, std::memory_order_relaxed))
+                {
+                }
+                return;
+            }
+        }
+
+    } // namespace nonce_search_impl
+
+    HASHLIBCXX_INLINE bool find_nonce(const nonce_search_params & params,
+                                      uint64_t & nonce,
+                                      unsigned char * digest)
+    {
+        using namespace nonce_search_impl;
+
+        if (!valid(params) || params.count == 0 || params.first > max_nonce(params.nonce_size))
+            return false;
+
+        // the last nonce is included, so that the range can reach UINT64_MAX
+        const uint64_t max{max_nonce(params.nonce_size)};
+        const uint64_t last{params.count - 1 > max - params.first
+                                ? max
+                                : params.first + params.count - 1};
+
+        plan_t plan;
+        make_plan(params, plan);
+
+        std::atomic<uint64_t> next_chunk{0};
+        std::atomic<uint64_t> best{s_none};
+        const uint64_t chunks{(last - params.first) / s_chunk_size + 1};
+        unsigned threads{params.threads == 0 ? std::thread::hardware_concurrency()
+                                             : params.threads};
+        threads = static_cast<unsigned>(chunks < threads ? chunks : threads);
+
+        std::vector<std::thread> workers;
+        for (unsigned t{1}; t < threads; ++t)
+        {
+            workers.emplace_back(
+                [&]() { search(plan, params.first, last, next_chunk, best); });
+        }
+        search(plan, params.first, last, next_chunk, best);
+        for (std::thread & worker : workers)
+            worker.join();
+
+        // s_none is also a valid nonce when the range reaches it
+        const uint64_t found{best.load()};
+        if (found == s_none && !(last == s_none && check_nonce(params, s_none)))
+            return false;
+
+        nonce = found;
+        if (digest != nullptr)
+            hash(params, nonce, digest);
+        return true;
+    }
+
+    HASHLIBCXX_INLINE bool check_nonce(const nonce_search_params & params, uint64_t nonce) noexcept
+    {
+        using namespace nonce_search_impl;
+
+        if (!valid(params) || nonce > max_nonce(params.nonce_size))
+            return false;
+
+        unsigned char digest[sha2::sha256::s_digest_size];
+        hash(params, nonce, digest);
+        return std::memcmp(digest, params.target.data(), sizeof(digest)) <= 0;
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_INLINE
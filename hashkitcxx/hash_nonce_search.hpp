@@ -0,0 +1,85 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief A proof of work: the message whose sha-256 must not exceed the target once the nonce
+     * is written in it, and the nonces to try.
+     */
+    struct nonce_search_params
+    {
+        const unsigned char * message{nullptr}; /**< The message, the nonce bytes are ignored */
+        size_t len{0};                          /**< Length of the message expressed in bytes */
+        size_t nonce_offset{0};                 /**< Position of the nonce in the message */
+        size_t nonce_size{8};                   /**< Bytes of the nonce, from 1 to 8 */
+        bool little_endian{false};              /**< Byte order of the nonce in the message */
+        sha2::sha256::digest_t target{};        /**< Largest digest accepted, in big endian */
+        uint64_t first{0};                      /**< First nonce to try */
+        uint64_t count{0};                      /**< Number of nonces to try */
+        unsigned threads{1};                    /**< Threads searching, 0 for the number of cores */
+    };
+
+    /**
+     * @brief Searches the lowest nonce in [first, first + count) for which the sha-256 of the
+     * message is lower than or equal to the target, comparing the digests as big endian numbers.
+     *
+     * The blocks before the nonce are compressed once (the midstate), as are the rounds of the
+     * block containing the nonce that only depend on the words before it. Then the nonces are
+     * tried 8 at a time, one per lane of the vector registers, and the threads scan consecutive
+     * ranges of nonces, stopping as soon as the lowest nonce is known.
+     * @param params the message, the position of the nonce, the target and the nonces to try.
+     * @param nonce receives the nonce found.
+     * @param digest pointer to the memory location to store the digest of the message with the
+     * nonce found, or nullptr.
+     * @return false if no nonce of the range reaches the target, or the parameters are invalid:
+     * the nonce does not fit in the message or in `nonce_size` bytes.
+     */
+    HASHLIBCXX_DLL bool find_nonce(const nonce_search_params & params,
+                                   uint64_t & nonce,
+                                   unsigned char * digest = nullptr);
+
+    /**
+     * @brief Checks a nonce, as the server of a proof of work does: hashes the message with the
+     * nonce once. The range of `params` is ignored.
+     * @return true if the sha-256 of the message with `nonce` does not exceed the target.
+     */
+    HASHLIBCXX_DLL bool check_nonce(const nonce_search_params & params, uint64_t nonce) noexcept;
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_nonce_search.cpp"
+#endif
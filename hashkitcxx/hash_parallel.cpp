@@ -0,0 +1,163 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_parallel.hpp"
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+namespace hashkitcxx {
+    namespace parallel_impl {
+
+        /**
+         * @brief The pool and the index of the thread running, for the tasks submitted by tasks.
+         */
+        struct worker_t
+        {
+            const thread_pool * pool;
+            unsigned index;
+        };
+
+        HASHLIBCXX_INLINE worker_t & current_worker() noexcept
+        {
+            thread_local worker_t worker{nullptr, 0};
+            return worker;
+        }
+
+    } // namespace parallel_impl
+
+    HASHLIBCXX_INLINE thread_pool::thread_pool(unsigned threads)
+    {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+
+        m_queues.reset(new queue_t[threads]);
+        m_threads.reserve(threads);
+        for (unsigned i{0}; i < threads; ++i)
+            m_threads.emplace_back([this, i]() { run(i); });
+    }
+
+    HASHLIBCXX_INLINE thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread & thread : m_threads)
+            thread.join();
+    }
+
+    HASHLIBCXX_INLINE void thread_pool::execute(std::function<void()> task)
+    {
+        const parallel_impl::worker_t & worker{parallel_impl::current_worker()};
+        const unsigned index{worker.pool == this
+                                 ? worker.index
+                                 : m_next.fetch_add(1, std::memory_order_relaxed) %
+                                       concurrency()};
+        {
+            std::lock_guard<std::mutex> lock{m_queues[index].mutex};
+            m_queues[index].tasks.push_back(std::move(task));
+        }
+        {
+            // under the lock, so that a thread checking for tasks before waiting sees it
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_wake.notify_one();
+    }
+
+    HASHLIBCXX_INLINE bool thread_pool::pop(unsigned index, std::function<void()> & task) noexcept
+    {
+        // the own queue from the back, the last task submitted is the most likely in cache, then
+        // the others from the front
+        const unsigned threads{concurrency()};
+        for (unsigned i{0}; i < threads; ++i)
+        {
+            queue_t & queue{m_queues[(index + i) % threads]};
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    HASHLIBCXX_INLINE void thread_pool::run(unsigned index) noexcept
+    {
+        parallel_impl::current_worker() = {this, index};
+
+        std::function<void()> task;
+        for (;;)
+        {
+            if (pop(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_wake.wait(lock, [this]() {
+                return m_stop || m_pending.load(std::memory_order_relaxed) > 0;
+            });
+            if (m_stop && m_pending.load(std::memory_order_relaxed) == 0)
+                return;
+        }
+    }
+
+    HASHLIBCXX_INLINE thread_pool & default_thread_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,338 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_core.hpp"
+#include "hash_sha2_lanes.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief A pool of threads with work stealing: each thread takes the tasks of its own queue,
+     * the last submitted first, and when it is empty steals the oldest task of another queue.
+     * The tasks submitted by a task of the pool go to the queue of its thread.
+     *
+     * It is the executor used by parallel_hash() when none is given. An executor is any object
+     * with the two functions below: `execute(std::function<void()>)` runs the task on some
+     * thread, and `concurrency()` returns the number of tasks run at the same time.
+     */
+    class HASHLIBCXX_DLL thread_pool final
+    {
+      public:
+        /**
+         * @param threads the number of threads, 0 for the number of cores.
+         */
+        explicit thread_pool(unsigned threads = 0);
+
+        /**
+         * @brief Runs the tasks still queued, then stops the threads.
+         */
+        ~thread_pool();
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool & operator=(const thread_pool &) = delete;
+
+        /**
+         * @brief Queues a task. The task must not throw.
+         */
+        void execute(std::function<void()> task);
+
+        /**
+         * @brief Returns the number of threads.
+         */
+        unsigned concurrency() const noexcept
+        {
+            return static_cast<unsigned>(m_threads.size());
+        }
+
+      private:
+        struct queue_t
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void run(unsigned index) noexcept;
+        bool pop(unsigned index, std::function<void()> & task) noexcept;
+
+      private:
+        std::unique_ptr<queue_t[]> m_queues;  /**< The tasks of each thread */
+        std::vector<std::thread> m_threads;   /**< The threads */
+        std::mutex m_mutex;                   /**< Protects m_stop and the waits */
+        std::condition_variable m_wake;       /**< Signals a new task or the stop */
+        std::atomic<size_t> m_pending{0};     /**< Tasks queued and not taken yet */
+        std::atomic<unsigned> m_next{0};      /**< Queue of the next task from outside */
+        bool m_stop{false};                   /**< The threads must stop once idle */
+    };
+
+    /**
+     * @brief Returns the pool owned by the library, with a thread per core, started on first use.
+     */
+    HASHLIBCXX_DLL thread_pool & default_thread_pool();
+
+    namespace parallel_impl {
+
+        constexpr size_t s_message_cost{64};       /**< Bytes a hash costs besides its message */
+        constexpr size_t s_min_task_size{1 << 16}; /**< Smallest task, in bytes */
+        constexpr size_t s_tasks_per_thread{4};    /**< Tasks per thread, to balance the load */
+
+        /**
+         * @brief Hashes the messages one at a time.
+         */
+        template<class THash>
+        void hash_range(const unsigned char * const * messages,
+                        const size_t * sizes,
+                        size_t begin,
+                        size_t end,
+                        typename THash::digest_t * digests,
+                        std::false_type /*lanes*/) noexcept
+        {
+            THash h;
+            for (size_t i{begin}; i < end; ++i)
+                h.hash(messages[i], sizes[i], digests[i].data());
+        }
+
+        /**
+         * @brief Hashes the messages 8 at a time with the multi-buffer sha-256 kernel: each lane
+         * compresses the next block of its own message, and takes the next message of the range
+         * as soon as its message is done, so the messages can have any length.
+         */
+        template<class THash>
+        void hash_range(const unsigned char * const * messages,
+                        const size_t * sizes,
+                        size_t begin,
+                        size_t end,
+                        typename THash::digest_t * digests,
+                        std::true_type /*lanes*/) noexcept
+        {
+            using sha2::lanes::s_sha256_lanes;
+            constexpr size_t block_size{sha2::traits<THash>::s_block_size};
+
+            struct lane_t
+            {
+                size_t message{SIZE_MAX};              /**< Message hashed, SIZE_MAX if none */
+                size_t block{0};                       /**< Next block of the message */
+                size_t full_blocks{0};                 /**< Blocks read from the message */
+                size_t block_nb{0};                    /**< Blocks including the padding */
+                unsigned char padding[2 * block_size]; /**< The last blocks, padded */
+            };
+
+            lane_t lanes[s_sha256_lanes];
+            uint32_t h[8][s_sha256_lanes]{};
+            uint32_t words[16][s_sha256_lanes];
+            const unsigned char * blocks[s_sha256_lanes];
+            const unsigned char idle_block[block_size]{};
+            size_t next{begin};
+            size_t active{0};
+
+            for (;;)
+            {
+                for (size_t l{0}; l < s_sha256_lanes; ++l)
+                {
+                    lane_t & lane{lanes[l]};
+                    if (lane.message != SIZE_MAX || next == end)
+                        continue;
+
+                    // a new message: the bytes after its last full block are padded in the lane
+                    const size_t size{sizes[next]};
+                    lane.message = next++;
+                    lane.block = 0;
+                    lane.full_blocks = size / block_size;
+                    lane.block_nb = (size + 8) / block_size + 1;
+                    const size_t rem{size - lane.full_blocks * block_size};
+                    const size_t padded{(lane.block_nb - lane.full_blocks) * block_size};
+                    if (rem > 0)
+                        std::memcpy(lane.padding, messages[lane.message] + size - rem, rem);
+                    std::memset(lane.padding + rem, 0, padded - rem);
+                    lane.padding[rem] = 0x80;
+                    const uint64_t bits{static_cast<uint64_t>(size) << 3};
+                    for (size_t i{0}; i < 8; ++i)
+                        lane.padding[padded - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+                    for (size_t i{0}; i < 8; ++i)
+                        h[i][l] = sha2::traits<THash>::h0()[i];
+                    ++active;
+                }
+                if (active == 0)
+                    return;
+
+                for (size_t l{0}; l < s_sha256_lanes; ++l)
+                {
+                    const lane_t & lane{lanes[l]};
+                    if (lane.message == SIZE_MAX)
+                        blocks[l] = idle_block;
+                    else if (lane.block < lane.full_blocks)
+                        blocks[l] = messages[lane.message] + lane.block * block_size;
+                    else
+                        blocks[l] = lane.padding + (lane.block - lane.full_blocks) * block_size;
+                }
+
+                sha2::lanes::sha256_load(words, blocks);
+                sha2::lanes::sha256_compress(h, words);
+
+                for (size_t l{0}; l < s_sha256_lanes; ++l)
+                {
+                    lane_t & lane{lanes[l]};
+                    if (lane.message == SIZE_MAX || ++lane.block < lane.block_nb)
+                        continue;
+
+                    unsigned char * digest{digests[lane.message].data()};
+                    for (size_t i{0}; i < THash::s_digest_size; ++i)
+                        digest[i] = static_cast<unsigned char>(h[i / 4][l] >> (24 - 8 * (i % 4)));
+                    lane.message = SIZE_MAX;
+                    --active;
+                }
+            }
+        }
+
+        /**
+         * @brief Counts down the tasks of a call and wakes up the caller when all are done.
+         */
+        class latch final
+        {
+          public:
+            explicit latch(size_t count) noexcept : m_count{count} {}
+
+            void count_down() noexcept
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                if (--m_count == 0)
+                    m_done.notify_all();
+            }
+
+            void wait() noexcept
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_done.wait(lock, [this]() { return m_count == 0; });
+            }
+
+          private:
+            std::mutex m_mutex;
+            std::condition_variable m_done;
+            size_t m_count;
+        };
+
+    } // namespace parallel_impl
+
+    /**
+     * @brief Hashes many independent messages, the tasks running on the given executor.
+     *
+     * The messages are split in consecutive ranges of about the same number of bytes, a few per
+     * thread, rather than the same number of messages: a range with a large message has fewer
+     * messages, and the threads finishing first take the ranges left. sha224 and sha256 hash
+     * the messages of a range 8 at a time with the multi-buffer kernel, the other algorithms one
+     * at a time. The calling thread hashes the last range, then waits for the others: it must
+     * not be a thread of the executor, whose tasks could be waiting for it.
+     * @tparam THash one of the sha2 classes (e.g. `sha256`).
+     * @tparam TExecutor an object with the functions `execute(std::function<void()>)` and
+     * `concurrency()`, see thread_pool.
+     * @param executor runs the tasks.
+     * @param messages the messages.
+     * @param sizes the length of each message expressed in bytes.
+     * @param count the number of messages.
+     * @param digests receives the hash of each message.
+     */
+    template<class THash, class TExecutor>
+    void parallel_hash(TExecutor & executor,
+                       const unsigned char * const * messages,
+                       const size_t * sizes,
+                       size_t count,
+                       typename THash::digest_t * digests)
+    {
+        using namespace parallel_impl;
+        using lanes_t = std::integral_constant<
+            bool,
+            std::is_same<typename sha2::traits<THash>::word_t, uint32_t>::value>;
+
+        size_t total{0};
+        for (size_t i{0}; i < count; ++i)
+            total += sizes[i] + s_message_cost;
+        const size_t concurrency{executor.concurrency() > 0 ? executor.concurrency() : 1U};
+        const size_t task_size{total / (concurrency * s_tasks_per_thread) > s_min_task_size
+                                   ? total / (concurrency * s_tasks_per_thread)
+                                   : s_min_task_size};
+
+        // the first message of each range, the last range ends at count
+        std::vector<size_t> starts{0};
+        size_t bytes{0};
+        for (size_t i{0}; i < count; ++i)
+        {
+            if (bytes >= task_size)
+            {
+                starts.push_back(i);
+                bytes = 0;
+            }
+            bytes += sizes[i] + s_message_cost;
+        }
+
+        latch done{starts.size() - 1};
+        for (size_t r{0}; r + 1 < starts.size(); ++r)
+        {
+            const size_t begin{starts[r]};
+            const size_t end{starts[r + 1]};
+            executor.execute([messages, sizes, begin, end, digests, &done]() {
+                hash_range<THash>(messages, sizes, begin, end, digests, lanes_t{});
+                done.count_down();
+            });
+        }
+        hash_range<THash>(messages, sizes, starts.back(), count, digests, lanes_t{});
+        done.wait();
+    }
+
+    /**
+     * @brief Hashes many independent messages on the pool of the library, see the overload
+     * taking an executor.
+     */
+    template<class THash>
+    void parallel_hash(const unsigned char * const * messages,
+                       const size_t * sizes,
+                       size_t count,
+                       typename THash::digest_t * digests)
+    {
+        parallel_hash<THash>(default_thread_pool(), messages, sizes, count, digests);
+    }
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_parallel.cpp"
+#endif
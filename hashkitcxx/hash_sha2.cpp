@@ -46,8 +46,29 @@
  */
 
 #include "hash_sha2.hpp"
+#include "hash_sha2_core.hpp"
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <type_traits>
+#if defined(HASHLIBCXX_INSTRUMENTATION)
+#    include "hash_stats.hpp"
+#endif
+#if defined(HASHLIBCXX_USDT) && defined(__has_include)
+#    if __has_include(<sys/sdt.h>)
+#        include <sys/sdt.h>
+#        define HASHLIBCXX_USDT_PROBES
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
 
 #if defined(HASHLIBCXX_ASSERT)
 #    undef HASHLIBCXX_ASSERT
@@ -59,65 +80,36 @@
 #    define HASHLIBCXX_ASSERT(x)
 #endif
 
-#if defined(SHFR)
-#    undef SHFR
+// instrumentation counters, see hash_stats.hpp: compiled out unless HASHLIBCXX_INSTRUMENTATION
+#if defined(HASHLIBCXX_COUNT)
+#    undef HASHLIBCXX_COUNT
 #endif
-#define SHFR(x, n) ((x) >> (n))
-
-#if defined(ROTR)
-#    undef ROTR
-#endif
-#define ROTR(x, n) (((x) >> (n)) | ((x) << ((sizeof(x) << 3) - (n))))
-
-#if defined(CH)
-#    undef CH
+#if defined(HASHLIBCXX_TIME)
+#    undef HASHLIBCXX_TIME
 #endif
-#define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-
-#if defined(MAJ)
-#    undef MAJ
-#endif
-#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
-
-#if defined(SHA256_F1)
-#    undef SHA256_F1
-#endif
-#define SHA256_F1(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
-
-#if defined(SHA256_F2)
-#    undef SHA256_F2
-#endif
-#define SHA256_F2(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
-
-#if defined(SHA256_F3)
-#    undef SHA256_F3
-#endif
-#define SHA256_F3(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ SHFR(x, 3))
-
-#if defined(SHA256_F4)
-#    undef SHA256_F4
+#if defined(HASHLIBCXX_INSTRUMENTATION)
+#    define HASHLIBCXX_COUNT(counter, value) stats::add(stats::counter, value)
+#    define HASHLIBCXX_TIME(counter) const stats::scoped_timer timer(stats::counter)
+#else
+#    define HASHLIBCXX_COUNT(counter, value)
+#    define HASHLIBCXX_TIME(counter)
 #endif
-#define SHA256_F4(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ SHFR(x, 10))
 
-#if defined(SHA512_F1)
-#    undef SHA512_F1
+// static tracepoints (USDT) of the provider "hashkitcxx": compiled out unless HASHLIBCXX_USDT is
+// defined and <sys/sdt.h> is available. The first argument is the algorithm, see probe_algorithm.
+#if defined(HASHLIBCXX_PROBE1)
+#    undef HASHLIBCXX_PROBE1
 #endif
-#define SHA512_F1(x) (ROTR(x, 28) ^ ROTR(x, 34) ^ ROTR(x, 39))
-
-#if defined(SHA512_F2)
-#    undef SHA512_F2
+#if defined(HASHLIBCXX_PROBE2)
+#    undef HASHLIBCXX_PROBE2
 #endif
-#define SHA512_F2(x) (ROTR(x, 14) ^ ROTR(x, 18) ^ ROTR(x, 41))
-
-#if defined(SHA512_F3)
-#    undef SHA512_F3
-#endif
-#define SHA512_F3(x) (ROTR(x, 1) ^ ROTR(x, 8) ^ SHFR(x, 7))
-
-#if defined(SHA512_F4)
-#    undef SHA512_F4
+#if defined(HASHLIBCXX_USDT_PROBES)
+#    define HASHLIBCXX_PROBE1(name, a) DTRACE_PROBE1(hashkitcxx, name, a)
+#    define HASHLIBCXX_PROBE2(name, a, b) DTRACE_PROBE2(hashkitcxx, name, a, b)
+#else
+#    define HASHLIBCXX_PROBE1(name, a) static_cast<void>(a)
+#    define HASHLIBCXX_PROBE2(name, a, b) (static_cast<void>(a), static_cast<void>(b))
 #endif
-#define SHA512_F4(x) (ROTR(x, 19) ^ ROTR(x, 61) ^ SHFR(x, 6))
 
 #if defined(UNPACK32)
 #    undef UNPACK32
@@ -176,7 +168,7 @@
 #endif
 #define SHA256_SCR(i)                                                                              \
     {                                                                                              \
-        w[i] = SHA256_F4(w[(i)-2]) + w[(i)-7] + SHA256_F3(w[(i)-15]) + w[(i)-16];                  \
+        w[i] = sha256_f4(w[(i)-2]) + w[(i)-7] + sha256_f3(w[(i)-15]) + w[(i)-16];                  \
     }
 
 #if defined(SHA512_SCR)
@@ -184,7 +176,7 @@
 #endif
 #define SHA512_SCR(i)                                                                              \
     {                                                                                              \
-        w[i] = SHA512_F4(w[(i)-2]) + w[(i)-7] + SHA512_F3(w[(i)-15]) + w[(i)-16];                  \
+        w[i] = sha512_f4(w[(i)-2]) + w[(i)-7] + sha512_f3(w[(i)-15]) + w[(i)-16];                  \
     }
 
 #if defined(__clang__)
@@ -197,8 +189,8 @@
 #endif
 #define SHA256_EXP(a, b, c, d, e, f, g, h, j)                                                      \
     {                                                                                              \
-        t1 = wv[h] + SHA256_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) + sha256_k[j] + w[j];              \
-        t2 = SHA256_F1(wv[a]) + MAJ(wv[a], wv[b], wv[c]);                                          \
+        t1 = wv[h] + sha256_f2(wv[e]) + ch(wv[e], wv[f], wv[g]) + sha256_k[j] + w[j];              \
+        t2 = sha256_f1(wv[a]) + maj(wv[a], wv[b], wv[c]);                                          \
         wv[d] += t1;                                                                               \
         wv[h] = t1 + t2;                                                                           \
     }
@@ -208,8 +200,8 @@
 #endif
 #define SHA512_EXP(a, b, c, d, e, f, g, h, j)                                                      \
     {                                                                                              \
-        t1 = wv[h] + SHA512_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) + sha512_k[j] + w[j];              \
-        t2 = SHA512_F1(wv[a]) + MAJ(wv[a], wv[b], wv[c]);                                          \
+        t1 = wv[h] + sha512_f2(wv[e]) + ch(wv[e], wv[f], wv[g]) + sha512_k[j] + w[j];              \
+        t2 = sha512_f1(wv[a]) + maj(wv[a], wv[b], wv[c]);                                          \
         wv[d] += t1;                                                                               \
         wv[h] = t1 + t2;                                                                           \
     }
@@ -221,102 +213,6 @@
 namespace hashkitcxx {
     namespace sha2 {
 
-        static constexpr std::array<uint32_t, 8> sha224_h0 = {0xc1059ed8U,
-                                                              0x367cd507U,
-                                                              0x3070dd17U,
-                                                              0xf70e5939U,
-                                                              0xffc00b31U,
-                                                              0x68581511U,
-                                                              0x64f98fa7U,
-                                                              0xbefa4fa4U};
-
-        static constexpr std::array<uint32_t, 8> sha256_h0 = {0x6a09e667U,
-                                                              0xbb67ae85U,
-                                                              0x3c6ef372U,
-                                                              0xa54ff53aU,
-                                                              0x510e527fU,
-                                                              0x9b05688cU,
-                                                              0x1f83d9abU,
-                                                              0x5be0cd19U};
-
-        static constexpr std::array<uint64_t, 8> sha384_h0 = {0xcbbb9d5dc1059ed8ULL,
-                                                              0x629a292a367cd507ULL,
-                                                              0x9159015a3070dd17ULL,
-                                                              0x152fecd8f70e5939ULL,
-                                                              0x67332667ffc00b31ULL,
-                                                              0x8eb44a8768581511ULL,
-                                                              0xdb0c2e0d64f98fa7ULL,
-                                                              0x47b5481dbefa4fa4ULL};
-
-        static constexpr std::array<uint64_t, 8> sha512_h0 = {0x6a09e667f3bcc908ULL,
-                                                              0xbb67ae8584caa73bULL,
-                                                              0x3c6ef372fe94f82bULL,
-                                                              0xa54ff53a5f1d36f1ULL,
-                                                              0x510e527fade682d1ULL,
-                                                              0x9b05688c2b3e6c1fULL,
-                                                              0x1f83d9abfb41bd6bULL,
-                                                              0x5be0cd19137e2179ULL};
-
-        static constexpr std::array<uint64_t, 8> sha512_224_h0 = {0x8c3d37c819544da2ULL,
-                                                                  0x73e1996689dcd4d6ULL,
-                                                                  0x1dfab7ae32ff9c82ULL,
-                                                                  0x679dd514582f9fcfULL,
-                                                                  0x0f6d2b697bd44da8ULL,
-                                                                  0x77e36f7304c48942ULL,
-                                                                  0x3f9d85a86a1d36c8ULL,
-                                                                  0x1112e6ad91d692a1ULL};
-
-        static constexpr std::array<uint64_t, 8> sha512_256_h0 = {0x22312194fc2bf72cULL,
-                                                                  0x9f555fa3c84c64c2ULL,
-                                                                  0x2393b86b6f53b151ULL,
-                                                                  0x963877195940eabdULL,
-                                                                  0x96283ee2a88effe3ULL,
-                                                                  0xbe5e1e2553863992ULL,
-                                                                  0x2b0199fc2c85b8aaULL,
-                                                                  0x0eb72ddc81c52ca2ULL};
-
-        static constexpr std::array<uint32_t, 64> sha256_k =
-            {0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U,
-             0x923f82a4U, 0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U,
-             0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U,
-             0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
-             0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U,
-             0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U,
-             0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
-             0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
-             0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU,
-             0x5b9cca4fU, 0x682e6ff3U, 0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U,
-             0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U};
-
-        static const std::array<uint64_t, 80> sha512_k =
-            {0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
-             0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
-             0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
-             0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
-             0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
-             0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
-             0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
-             0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
-             0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
-             0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
-             0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
-             0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
-             0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
-             0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
-             0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
-             0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
-             0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
-             0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
-             0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
-             0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
-             0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
-             0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
-             0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
-             0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
-             0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
-             0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
-             0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
-
         template<class THash>
         void to_hex(THash & h,
                     const unsigned char * message,
@@ -339,12 +235,120 @@ namespace hashkitcxx {
             }
         }
 
+        // ------------------------------------------------------------------
+        // --- serialized state ---------------------------------------------
+        //
+        // Layout of the state written by save(), all the integers are big endian:
+        //   offset  0, 4 bytes: magic "HKCX"
+        //   offset  4, 1 byte:  version of the format
+        //   offset  5, 1 byte:  algorithm, see state_algorithm
+        //   offset  6, 2 bytes: reserved, 0
+        //   offset  8, 8 bytes: tot_len, the bytes already transformed (a multiple of the block)
+        //   offset 16, 8 bytes: len, the bytes waiting in the block (less than a block)
+        //   offset 24, 8 words: h, of 4 or 8 bytes each
+        //   then, a block:      the bytes waiting in the block, followed by 0s
+
+        static constexpr unsigned char state_magic[4]{'H', 'K', 'C', 'X'};
+        static constexpr unsigned char state_version{1};
+        static constexpr size_t state_header_size{24};
+
+        enum state_algorithm : unsigned char
+        {
+            state_sha224 = 1,
+            state_sha256 = 2,
+            state_sha384 = 3,
+            state_sha512 = 4,
+            state_sha512_224 = 5,
+            state_sha512_256 = 6
+        };
+
+        template<typename TContext>
+        void save_context(const TContext & ctx,
+                          state_algorithm algorithm,
+                          size_t block_size,
+                          unsigned char * state) noexcept
+        {
+            HASHLIBCXX_ASSERT(state);
+
+            std::memcpy(state, state_magic, sizeof(state_magic));
+            state[4] = state_version;
+            state[5] = algorithm;
+            state[6] = 0;
+            state[7] = 0;
+            UNPACK64(static_cast<uint64_t>(ctx.tot_len), state + 8);
+            UNPACK64(static_cast<uint64_t>(ctx.len), state + 16);
+
+            unsigned char * words{state + state_header_size};
+            for (size_t i{0}; i < 8; ++i)
+            {
+                const uint64_t word{ctx.h[i]};
+                for (size_t j{0}; j < sizeof(ctx.h[i]); ++j)
+                    *words++ = static_cast<uint8_t>(word >> (8 * (sizeof(ctx.h[i]) - 1 - j)));
+            }
+
+            std::memcpy(words, ctx.block, ctx.len);
+            std::memset(words + ctx.len, 0, block_size - ctx.len);
+        }
+
+        template<typename TContext>
+        bool load_context(TContext & ctx,
+                          state_algorithm algorithm,
+                          size_t block_size,
+                          const unsigned char * state,
+                          size_t len) noexcept
+        {
+            const size_t state_size{state_header_size + sizeof(ctx.h) + block_size};
+            if (state == nullptr || len != state_size)
+                return false;
+
+            if (std::memcmp(state, state_magic, sizeof(state_magic)) != 0 ||
+                state[4] != state_version || state[5] != algorithm)
+                return false;
+
+            uint64_t tot_len{0};
+            uint64_t pending_len{0};
+            PACK64(state + 8, &tot_len);
+            PACK64(state + 16, &pending_len);
+            if (pending_len >= block_size || tot_len % block_size != 0 ||
+                tot_len > static_cast<uint64_t>(SIZE_MAX))
+                return false;
+
+            using word_t = typename std::remove_reference<decltype(ctx.h[0])>::type;
+
+            const unsigned char * words{state + state_header_size};
+            for (size_t i{0}; i < 8; ++i)
+            {
+                uint64_t word{0};
+                for (size_t j{0}; j < sizeof(word_t); ++j)
+                    word = (word << 8) | *words++;
+                ctx.h[i] = static_cast<word_t>(word);
+            }
+
+            ctx.tot_len = static_cast<size_t>(tot_len);
+            ctx.len = static_cast<size_t>(pending_len);
+            std::memcpy(ctx.block, words, ctx.len);
+            return true;
+        }
+
+        /**
+         * @brief Hash value stored outside of a context, seen by the transforms as a context.
+         */
+        template<typename TWord>
+        struct hash_value_view
+        {
+            TWord * h;
+        };
+
         template<typename TContext>
         void sha256_transform(TContext & ctx,
                               const unsigned char * message,
-                              size_t block_nb) noexcept
+                              size_t block_nb,
+                              probe_algorithm algorithm) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_COUNT(sha256_blocks, block_nb);
+            HASHLIBCXX_TIME(sha256_nanoseconds);
+            HASHLIBCXX_PROBE2(transform, algorithm, block_nb);
 
             uint32_t w[64];
             uint32_t wv[8];
@@ -377,8 +381,8 @@ namespace hashkitcxx {
 
                 for (j = 0; j < 64; ++j)
                 {
-                    t1 = wv[7] + SHA256_F2(wv[4]) + CH(wv[4], wv[5], wv[6]) + sha256_k[j] + w[j];
-                    t2 = SHA256_F1(wv[0]) + MAJ(wv[0], wv[1], wv[2]);
+                    t1 = wv[7] + sha256_f2(wv[4]) + ch(wv[4], wv[5], wv[6]) + sha256_k[j] + w[j];
+                    t2 = sha256_f1(wv[0]) + maj(wv[0], wv[1], wv[2]);
                     wv[7] = wv[6];
                     wv[6] = wv[5];
                     wv[5] = wv[4];
@@ -549,9 +553,13 @@ namespace hashkitcxx {
         template<typename TContext>
         void sha512_transform(TContext & ctx,
                               const unsigned char * message,
-                              size_t block_nb) noexcept
+                              size_t block_nb,
+                              probe_algorithm algorithm) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_COUNT(sha512_blocks, block_nb);
+            HASHLIBCXX_TIME(sha512_nanoseconds);
+            HASHLIBCXX_PROBE2(transform, algorithm, block_nb);
 
             uint64_t w[80];
             uint64_t wv[8];
@@ -581,8 +589,8 @@ namespace hashkitcxx {
 
                 for (j = 0; j < 80; ++j)
                 {
-                    t1 = wv[7] + SHA512_F2(wv[4]) + CH(wv[4], wv[5], wv[6]) + sha512_k[j] + w[j];
-                    t2 = SHA512_F1(wv[0]) + MAJ(wv[0], wv[1], wv[2]);
+                    t1 = wv[7] + sha512_f2(wv[4]) + ch(wv[4], wv[5], wv[6]) + sha512_k[j] + w[j];
+                    t2 = sha512_f1(wv[0]) + maj(wv[0], wv[1], wv[2]);
                     wv[7] = wv[6];
                     wv[6] = wv[5];
                     wv[5] = wv[4];
@@ -726,15 +734,17 @@ namespace hashkitcxx {
         // ------------------------------------------------------------------
         // --- sha-256 ------------------------------------------------------
 
-        void sha256::hash_printable(const unsigned char * message,
-                                    size_t len,
-                                    char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha256::hash_printable(const unsigned char * message,
+                                                      size_t len,
+                                                      char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha256::init() noexcept
+        HASHLIBCXX_INLINE void sha256::init() noexcept
         {
+            HASHLIBCXX_PROBE1(init, probe_sha256);
+
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
             {
@@ -755,17 +765,21 @@ namespace hashkitcxx {
             m_ctx.tot_len = 0;
         }
 
-        void sha256::update(const unsigned char * message, size_t len) noexcept
+        HASHLIBCXX_INLINE void sha256::update(const unsigned char * message, size_t len) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_PROBE2(update, probe_sha256, len);
 
             size_t tmp_len{s_block_size - m_ctx.len};
             size_t rem_len{len < tmp_len ? len : tmp_len};
 
             std::memcpy(&m_ctx.block[m_ctx.len], message, rem_len);
+            HASHLIBCXX_COUNT(update_calls, 1);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             if (m_ctx.len + len < s_block_size)
             {
+                HASHLIBCXX_COUNT(partial_updates, 1);
                 m_ctx.len += len;
                 return;
             }
@@ -775,18 +789,19 @@ namespace hashkitcxx {
 
             const unsigned char * shifted_message{message + rem_len};
 
-            sha256_transform(m_ctx, m_ctx.block, 1);
-            sha256_transform(m_ctx, shifted_message, block_nb);
+            sha256_transform(m_ctx, m_ctx.block, 1, probe_sha256);
+            sha256_transform(m_ctx, shifted_message, block_nb, probe_sha256);
 
             rem_len = new_len % s_block_size;
 
             std::memcpy(m_ctx.block, &shifted_message[block_nb << 6], rem_len);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             m_ctx.len = rem_len;
             m_ctx.tot_len += (block_nb + 1) << 6;
         }
 
-        void sha256::complete(unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE void sha256::complete(unsigned char * digest) noexcept
         {
             HASHLIBCXX_ASSERT(digest);
 
@@ -800,7 +815,10 @@ namespace hashkitcxx {
             m_ctx.block[m_ctx.len] = 0x80;
             UNPACK64(len_b, m_ctx.block + pm_len - 8);
 
-            sha256_transform(m_ctx, m_ctx.block, block_nb);
+            sha256_transform(m_ctx, m_ctx.block, block_nb, probe_sha256);
+            HASHLIBCXX_COUNT(complete_calls, 1);
+            HASHLIBCXX_COUNT(two_block_paddings, block_nb - 1);
+            HASHLIBCXX_PROBE2(complete, probe_sha256, len_b >> 3);
 
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
@@ -819,21 +837,51 @@ namespace hashkitcxx {
 #endif
         }
 
+        HASHLIBCXX_INLINE void sha256::save(unsigned char * state) const noexcept
+        {
+            save_context(m_ctx, state_sha256, s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha256::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_ctx, state_sha256, s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha256::processed_size() const noexcept
+        {
+            return static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len);
+        }
+
+        HASHLIBCXX_INLINE void sha256::compress(uint32_t * h,
+                                                const unsigned char * blocks,
+                                                size_t block_nb) noexcept
+        {
+            hash_value_view<uint32_t> view{h};
+            sha256_transform(view, blocks, block_nb, probe_sha256);
+        }
+
         // ------------------------------------------------------------------
         // --- sha-512 ------------------------------------------------------
 
-        sha512::sha512() : m_h0{sha512_h0} {}
-        sha512::sha512(const std::array<uint64_t, 8> & h0) : m_h0{h0} {}
+        HASHLIBCXX_INLINE sha512::sha512() : m_h0{sha512_h0} {}
+        HASHLIBCXX_INLINE sha512::sha512(const std::array<uint64_t, 8> & h0) : m_h0{h0} {}
 
-        void sha512::hash_printable(const unsigned char * message,
-                                    size_t len,
-                                    char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha512::hash_printable(const unsigned char * message,
+                                                      size_t len,
+                                                      char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha512::init() noexcept
+        HASHLIBCXX_INLINE void sha512::init() noexcept
         {
+            init(probe_sha512);
+        }
+
+        HASHLIBCXX_INLINE void sha512::init(probe_algorithm probe) noexcept
+        {
+            HASHLIBCXX_PROBE1(init, probe);
+
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
             {
@@ -854,17 +902,28 @@ namespace hashkitcxx {
             m_ctx.tot_len = 0;
         }
 
-        void sha512::update(const unsigned char * message, size_t len) noexcept
+        HASHLIBCXX_INLINE void sha512::update(const unsigned char * message, size_t len) noexcept
+        {
+            update(message, len, probe_sha512);
+        }
+
+        HASHLIBCXX_INLINE void sha512::update(const unsigned char * message,
+                                              size_t len,
+                                              probe_algorithm probe) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_PROBE2(update, probe, len);
 
             size_t tmp_len{s_block_size - m_ctx.len};
             size_t rem_len{len < tmp_len ? len : tmp_len};
 
             std::memcpy(&m_ctx.block[m_ctx.len], message, rem_len);
+            HASHLIBCXX_COUNT(update_calls, 1);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             if (m_ctx.len + len < s_block_size)
             {
+                HASHLIBCXX_COUNT(partial_updates, 1);
                 m_ctx.len += len;
                 return;
             }
@@ -874,32 +933,23 @@ namespace hashkitcxx {
 
             const unsigned char * shifted_message{message + rem_len};
 
-            sha512_transform(m_ctx, m_ctx.block, 1);
-            sha512_transform(m_ctx, shifted_message, block_nb);
+            sha512_transform(m_ctx, m_ctx.block, 1, probe);
+            sha512_transform(m_ctx, shifted_message, block_nb, probe);
 
             rem_len = new_len % s_block_size;
 
             std::memcpy(m_ctx.block, &shifted_message[block_nb << 7], rem_len);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             m_ctx.len = rem_len;
             m_ctx.tot_len += (block_nb + 1) << 7;
         }
 
-        void sha512::complete(unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE void sha512::complete(unsigned char * digest) noexcept
         {
             HASHLIBCXX_ASSERT(digest);
 
-            size_t block_nb{
-                1U + static_cast<unsigned int>((s_block_size - 17U) < (m_ctx.len % s_block_size))};
-            uint64_t len_b{(static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len))
-                           << 3};
-            size_t pm_len{block_nb << 7};
-
-            std::memset(m_ctx.block + m_ctx.len, 0, pm_len - m_ctx.len);
-            m_ctx.block[m_ctx.len] = 0x80;
-            UNPACK64(len_b, m_ctx.block + pm_len - 8);
-
-            sha512_transform(m_ctx, m_ctx.block, block_nb);
+            pad(probe_sha512);
 
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
@@ -918,58 +968,201 @@ namespace hashkitcxx {
 #endif
         }
 
+        HASHLIBCXX_INLINE void sha512::pad(probe_algorithm probe) noexcept
+        {
+            size_t block_nb{
+                1U + static_cast<unsigned int>((s_block_size - 17U) < (m_ctx.len % s_block_size))};
+            uint64_t len_b{(static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len))
+                           << 3};
+            size_t pm_len{block_nb << 7};
+
+            std::memset(m_ctx.block + m_ctx.len, 0, pm_len - m_ctx.len);
+            m_ctx.block[m_ctx.len] = 0x80;
+            UNPACK64(len_b, m_ctx.block + pm_len - 8);
+
+            sha512_transform(m_ctx, m_ctx.block, block_nb, probe);
+            HASHLIBCXX_COUNT(complete_calls, 1);
+            HASHLIBCXX_COUNT(two_block_paddings, block_nb - 1);
+            HASHLIBCXX_PROBE2(complete, probe, len_b >> 3);
+        }
+
+        HASHLIBCXX_INLINE void sha512::complete_truncated(unsigned char * digest,
+                                                          size_t digest_size,
+                                                          probe_algorithm probe) noexcept
+        {
+            HASHLIBCXX_ASSERT(digest);
+            HASHLIBCXX_ASSERT(digest_size <= s_digest_size);
+
+            pad(probe);
+
+            // the digest is big endian: the last word may be written in part
+            for (size_t i{0}; i < digest_size; ++i)
+                digest[i] = static_cast<uint8_t>(m_ctx.h[i >> 3] >> (56 - 8 * (i & 7)));
+        }
+
+        HASHLIBCXX_INLINE void sha512::save(unsigned char * state) const noexcept
+        {
+            save_context(m_ctx, state_sha512, s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha512::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_ctx, state_sha512, s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha512::processed_size() const noexcept
+        {
+            return static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len);
+        }
+
+        HASHLIBCXX_INLINE void sha512::compress(uint64_t * h,
+                                                const unsigned char * blocks,
+                                                size_t block_nb) noexcept
+        {
+            compress(h, blocks, block_nb, probe_sha512);
+        }
+
+        HASHLIBCXX_INLINE void sha512::compress(uint64_t * h,
+                                                const unsigned char * blocks,
+                                                size_t block_nb,
+                                                probe_algorithm probe) noexcept
+        {
+            hash_value_view<uint64_t> view{h};
+            sha512_transform(view, blocks, block_nb, probe);
+        }
+
         // ------------------------------------------------------------------
         // --- sha-512/224 --------------------------------------------------
 
-        void sha512_224::hash_printable(const unsigned char * message,
-                                        size_t len,
-                                        char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha512_224::hash_printable(const unsigned char * message,
+                                                          size_t len,
+                                                          char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha512_224::hash(const unsigned char * message,
-                              size_t len,
-                              unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE sha512_224::sha512_224() : m_sha512{sha512_224_h0} {}
+
+        HASHLIBCXX_INLINE void sha512_224::hash(const unsigned char * message,
+                                                size_t len,
+                                                unsigned char * digest) noexcept
         {
-            unsigned char sha512_digest[sha512::s_digest_size];
-            sha512 h(sha512_224_h0);
-            h.hash(message, len, sha512_digest);
-            std::memcpy(digest, sha512_digest, s_digest_size);
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        HASHLIBCXX_INLINE void sha512_224::init() noexcept
+        {
+            m_sha512.init(probe_sha512_224);
+        }
+
+        HASHLIBCXX_INLINE void sha512_224::update(const unsigned char * message,
+                                                  size_t len) noexcept
+        {
+            m_sha512.update(message, len, probe_sha512_224);
+        }
+
+        HASHLIBCXX_INLINE void sha512_224::complete(unsigned char * digest) noexcept
+        {
+            m_sha512.complete_truncated(digest, s_digest_size, probe_sha512_224);
+        }
+
+        HASHLIBCXX_INLINE void sha512_224::save(unsigned char * state) const noexcept
+        {
+            save_context(m_sha512.m_ctx, state_sha512_224, sha512::s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha512_224::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_sha512.m_ctx, state_sha512_224, sha512::s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha512_224::processed_size() const noexcept
+        {
+            return m_sha512.processed_size();
+        }
+
+        HASHLIBCXX_INLINE void sha512_224::compress(uint64_t * h,
+                                                    const unsigned char * blocks,
+                                                    size_t block_nb) noexcept
+        {
+            sha512::compress(h, blocks, block_nb, probe_sha512_224);
         }
 
         // ------------------------------------------------------------------
         // --- sha-512/256 --------------------------------------------------
 
-        void sha512_256::hash_printable(const unsigned char * message,
-                                        size_t len,
-                                        char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha512_256::hash_printable(const unsigned char * message,
+                                                          size_t len,
+                                                          char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha512_256::hash(const unsigned char * message,
-                              size_t len,
-                              unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE sha512_256::sha512_256() : m_sha512{sha512_256_h0} {}
+
+        HASHLIBCXX_INLINE void sha512_256::hash(const unsigned char * message,
+                                                size_t len,
+                                                unsigned char * digest) noexcept
         {
-            unsigned char sha512_digest[sha512::s_digest_size];
-            sha512 h(sha512_256_h0);
-            h.hash(message, len, sha512_digest);
-            std::memcpy(digest, sha512_digest, s_digest_size);
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        HASHLIBCXX_INLINE void sha512_256::init() noexcept
+        {
+            m_sha512.init(probe_sha512_256);
+        }
+
+        HASHLIBCXX_INLINE void sha512_256::update(const unsigned char * message,
+                                                  size_t len) noexcept
+        {
+            m_sha512.update(message, len, probe_sha512_256);
+        }
+
+        HASHLIBCXX_INLINE void sha512_256::complete(unsigned char * digest) noexcept
+        {
+            m_sha512.complete_truncated(digest, s_digest_size, probe_sha512_256);
+        }
+
+        HASHLIBCXX_INLINE void sha512_256::save(unsigned char * state) const noexcept
+        {
+            save_context(m_sha512.m_ctx, state_sha512_256, sha512::s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha512_256::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_sha512.m_ctx, state_sha512_256, sha512::s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha512_256::processed_size() const noexcept
+        {
+            return m_sha512.processed_size();
+        }
+
+        HASHLIBCXX_INLINE void sha512_256::compress(uint64_t * h,
+                                                    const unsigned char * blocks,
+                                                    size_t block_nb) noexcept
+        {
+            sha512::compress(h, blocks, block_nb, probe_sha512_256);
         }
 
         // ------------------------------------------------------------------
         // --- sha-384 ------------------------------------------------------
 
-        void sha384::hash_printable(const unsigned char * message,
-                                    size_t len,
-                                    char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha384::hash_printable(const unsigned char * message,
+                                                      size_t len,
+                                                      char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha384::init() noexcept
+        HASHLIBCXX_INLINE void sha384::init() noexcept
         {
+            HASHLIBCXX_PROBE1(init, probe_sha384);
+
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
             {
@@ -990,17 +1183,21 @@ namespace hashkitcxx {
             m_ctx.tot_len = 0;
         }
 
-        void sha384::update(const unsigned char * message, size_t len) noexcept
+        HASHLIBCXX_INLINE void sha384::update(const unsigned char * message, size_t len) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_PROBE2(update, probe_sha384, len);
 
             size_t tmp_len{s_block_size - m_ctx.len};
             size_t rem_len{len < tmp_len ? len : tmp_len};
 
             std::memcpy(&m_ctx.block[m_ctx.len], message, rem_len);
+            HASHLIBCXX_COUNT(update_calls, 1);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             if (m_ctx.len + len < s_block_size)
             {
+                HASHLIBCXX_COUNT(partial_updates, 1);
                 m_ctx.len += len;
                 return;
             }
@@ -1010,18 +1207,19 @@ namespace hashkitcxx {
 
             const unsigned char * shifted_message{message + rem_len};
 
-            sha512_transform(m_ctx, m_ctx.block, 1);
-            sha512_transform(m_ctx, shifted_message, block_nb);
+            sha512_transform(m_ctx, m_ctx.block, 1, probe_sha384);
+            sha512_transform(m_ctx, shifted_message, block_nb, probe_sha384);
 
             rem_len = new_len % s_block_size;
 
             std::memcpy(m_ctx.block, &shifted_message[block_nb << 7], rem_len);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             m_ctx.len = rem_len;
             m_ctx.tot_len += (block_nb + 1) << 7;
         }
 
-        void sha384::complete(unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE void sha384::complete(unsigned char * digest) noexcept
         {
             HASHLIBCXX_ASSERT(digest);
 
@@ -1035,7 +1233,10 @@ namespace hashkitcxx {
             m_ctx.block[m_ctx.len] = 0x80;
             UNPACK64(len_b, m_ctx.block + pm_len - 8);
 
-            sha512_transform(m_ctx, m_ctx.block, block_nb);
+            sha512_transform(m_ctx, m_ctx.block, block_nb, probe_sha384);
+            HASHLIBCXX_COUNT(complete_calls, 1);
+            HASHLIBCXX_COUNT(two_block_paddings, block_nb - 1);
+            HASHLIBCXX_PROBE2(complete, probe_sha384, len_b >> 3);
 
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 6; ++i)
@@ -1052,18 +1253,43 @@ namespace hashkitcxx {
 #endif
         }
 
+        HASHLIBCXX_INLINE void sha384::save(unsigned char * state) const noexcept
+        {
+            save_context(m_ctx, state_sha384, s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha384::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_ctx, state_sha384, s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha384::processed_size() const noexcept
+        {
+            return static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len);
+        }
+
+        HASHLIBCXX_INLINE void sha384::compress(uint64_t * h,
+                                                const unsigned char * blocks,
+                                                size_t block_nb) noexcept
+        {
+            hash_value_view<uint64_t> view{h};
+            sha512_transform(view, blocks, block_nb, probe_sha384);
+        }
+
         // ------------------------------------------------------------------
         // --- sha-224 ------------------------------------------------------
 
-        void sha224::hash_printable(const unsigned char * message,
-                                    size_t len,
-                                    char * digest_printable) noexcept
+        HASHLIBCXX_INLINE void sha224::hash_printable(const unsigned char * message,
+                                                      size_t len,
+                                                      char * digest_printable) noexcept
         {
             to_hex(*this, message, len, digest_printable);
         }
 
-        void sha224::init() noexcept
+        HASHLIBCXX_INLINE void sha224::init() noexcept
         {
+            HASHLIBCXX_PROBE1(init, probe_sha224);
+
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 8; ++i)
             {
@@ -1084,17 +1310,21 @@ namespace hashkitcxx {
             m_ctx.tot_len = 0;
         }
 
-        void sha224::update(const unsigned char * message, size_t len) noexcept
+        HASHLIBCXX_INLINE void sha224::update(const unsigned char * message, size_t len) noexcept
         {
             HASHLIBCXX_ASSERT(message);
+            HASHLIBCXX_PROBE2(update, probe_sha224, len);
 
             size_t tmp_len{s_block_size - m_ctx.len};
             size_t rem_len{len < tmp_len ? len : tmp_len};
 
             std::memcpy(&m_ctx.block[m_ctx.len], message, rem_len);
+            HASHLIBCXX_COUNT(update_calls, 1);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             if (m_ctx.len + len < s_block_size)
             {
+                HASHLIBCXX_COUNT(partial_updates, 1);
                 m_ctx.len += len;
                 return;
             }
@@ -1104,18 +1334,19 @@ namespace hashkitcxx {
 
             const unsigned char * shifted_message{message + rem_len};
 
-            sha256_transform(m_ctx, m_ctx.block, 1);
-            sha256_transform(m_ctx, shifted_message, block_nb);
+            sha256_transform(m_ctx, m_ctx.block, 1, probe_sha224);
+            sha256_transform(m_ctx, shifted_message, block_nb, probe_sha224);
 
             rem_len = new_len % s_block_size;
 
             std::memcpy(m_ctx.block, &shifted_message[block_nb << 6], rem_len);
+            HASHLIBCXX_COUNT(staged_bytes, rem_len);
 
             m_ctx.len = rem_len;
             m_ctx.tot_len += (block_nb + 1) << 6;
         }
 
-        void sha224::complete(unsigned char * digest) noexcept
+        HASHLIBCXX_INLINE void sha224::complete(unsigned char * digest) noexcept
         {
             HASHLIBCXX_ASSERT(digest);
 
@@ -1129,7 +1360,10 @@ namespace hashkitcxx {
             m_ctx.block[m_ctx.len] = 0x80;
             UNPACK64(len_b, m_ctx.block + pm_len - 8);
 
-            sha256_transform(m_ctx, m_ctx.block, block_nb);
+            sha256_transform(m_ctx, m_ctx.block, block_nb, probe_sha224);
+            HASHLIBCXX_COUNT(complete_calls, 1);
+            HASHLIBCXX_COUNT(two_block_paddings, block_nb - 1);
+            HASHLIBCXX_PROBE2(complete, probe_sha224, len_b >> 3);
 
 #if !defined(HASHLIBCXX_USE_LOOPS_UNROLLING)
             for (uint8_t i{0}; i < 7; ++i)
@@ -1147,5 +1381,45 @@ namespace hashkitcxx {
 #endif
         }
 
+        HASHLIBCXX_INLINE void sha224::save(unsigned char * state) const noexcept
+        {
+            save_context(m_ctx, state_sha224, s_block_size, state);
+        }
+
+        HASHLIBCXX_INLINE bool sha224::load(const unsigned char * state, size_t len) noexcept
+        {
+            return load_context(m_ctx, state_sha224, s_block_size, state, len);
+        }
+
+        HASHLIBCXX_INLINE uint64_t sha224::processed_size() const noexcept
+        {
+            return static_cast<uint64_t>(m_ctx.tot_len) + static_cast<uint64_t>(m_ctx.len);
+        }
+
+        HASHLIBCXX_INLINE void sha224::compress(uint32_t * h,
+                                                const unsigned char * blocks,
+                                                size_t block_nb) noexcept
+        {
+            hash_value_view<uint32_t> view{h};
+            sha256_transform(view, blocks, block_nb, probe_sha224);
+        }
+
     } // namespace sha2
 } // namespace hashkitcxx
+
+// in header-only mode this file is included by hash_sha2.hpp: do not leak the macros to the user
+#undef HASHLIBCXX_INLINE
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_COUNT
+#undef HASHLIBCXX_TIME
+#undef HASHLIBCXX_USDT_PROBES
+#undef HASHLIBCXX_PROBE1
+#undef HASHLIBCXX_PROBE2
+#undef UNPACK32
+#undef PACK32
+#undef UNPACK64
+#undef PACK64
+#undef SHA256_SCR
+#undef SHA512_SCR
+#undef SHA256_EXP
+#undef SHA512_EXP
@@ -47,10 +47,14 @@
 
 #pragma once
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #if defined(HASHLIBCXX_STD_STRING)
 #    include <string>
 #endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
 
 #if defined(HASHLIBCXX_DLL)
 #    undef HASHLIBCXX_DLL
@@ -64,6 +68,21 @@
 namespace hashkitcxx {
     namespace sha2 {
 
+        /**
+         * @brief Ids of the algorithms, reported as first argument by the tracepoints (see
+         * HASHLIBCXX_USDT).
+         */
+        enum probe_algorithm : unsigned char
+        {
+            probe_sha224 = 1,
+            probe_sha256 = 2,
+            probe_sha384 = 3,
+            probe_sha512 = 4,
+            probe_sha512_224 = 5,
+            probe_sha512_256 = 6,
+            probe_sha512_t = 7
+        };
+
         // ------------------------------------------------------------------
         // --- sha-224 ------------------------------------------------------
 
@@ -77,6 +96,12 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 224 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                24 + 8 * 4 + s_block_size}; /**< Size expressed in byte of the saved state */
+
             struct ctx_t
             {
                 size_t tot_len{0};
@@ -94,6 +119,18 @@ namespace hashkitcxx {
             sha224 & operator=(const sha224 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -106,6 +143,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -119,6 +168,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -131,8 +181,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
 #endif
 
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -159,11 +286,60 @@ namespace hashkitcxx {
                 complete(digest);
             }
 
-          private:
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
             void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
             void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
             void complete(unsigned char * digest) noexcept;
 
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
+
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint32_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
           private:
             ctx_t m_ctx; /**< Stores temporary data while the hash is being computed */
         };
@@ -181,6 +357,12 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 256 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                24 + 8 * 4 + s_block_size}; /**< Size expressed in byte of the saved state */
+
             struct ctx_t
             {
                 size_t tot_len{0};
@@ -198,6 +380,18 @@ namespace hashkitcxx {
             sha256 & operator=(const sha256 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -210,6 +404,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -223,6 +429,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -235,8 +442,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
 #endif
 
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -263,11 +547,60 @@ namespace hashkitcxx {
                 complete(digest);
             }
 
-          private:
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
             void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
             void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
             void complete(unsigned char * digest) noexcept;
 
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
+
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint32_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
           private:
             ctx_t m_ctx; /**< Stores temporary data while the hash is being computed */
         };
@@ -285,6 +618,12 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 384 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                24 + 8 * 8 + s_block_size}; /**< Size expressed in byte of the saved state */
+
             struct ctx_t
             {
                 size_t tot_len{0};
@@ -302,6 +641,18 @@ namespace hashkitcxx {
             sha384 & operator=(const sha384 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -314,6 +665,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -327,6 +690,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -339,8 +703,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
 #endif
 
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -367,16 +808,65 @@ namespace hashkitcxx {
                 complete(digest);
             }
 
-          private:
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
             void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
             void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
             void complete(unsigned char * digest) noexcept;
 
-          private:
-            ctx_t m_ctx; /**< Stores temporary data while the hash is being computed */
-        };
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
 
-        // ------------------------------------------------------------------
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
+          private:
+            ctx_t m_ctx; /**< Stores temporary data while the hash is being computed */
+        };
+
+        // ------------------------------------------------------------------
         // --- sha-512 ------------------------------------------------------
 
         class HASHLIBCXX_DLL sha512 final
@@ -389,6 +879,12 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 512 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                24 + 8 * 8 + s_block_size}; /**< Size expressed in byte of the saved state */
+
             struct ctx_t
             {
                 size_t tot_len{0};
@@ -407,6 +903,18 @@ namespace hashkitcxx {
             sha512 & operator=(const sha512 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -419,6 +927,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -432,6 +952,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -444,8 +965,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
 #endif
 
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
+#endif
+
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -472,14 +1070,105 @@ namespace hashkitcxx {
                 complete(digest);
             }
 
-          private:
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
             void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
             void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
             void complete(unsigned char * digest) noexcept;
 
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
+
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
+          private:
+            /**
+             * @brief init(), the tracepoints reporting `probe`: the truncated variants run their
+             * computation through a sha512 and pass their own id.
+             */
+            void init(probe_algorithm probe) noexcept;
+
+            /**
+             * @brief update(), the tracepoints reporting `probe`.
+             */
+            void update(const unsigned char * message, size_t len, probe_algorithm probe) noexcept;
+
+            /**
+             * @brief compress(), the tracepoints reporting `probe`.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb,
+                                 probe_algorithm probe) noexcept;
+
+            /**
+             * @brief Pads the pending bytes with the length of the message and compresses them:
+             * the hash value is then the digest.
+             */
+            void pad(probe_algorithm probe) noexcept;
+
+            /**
+             * @brief Completes the hash computation writing only the first bytes of the digest, for
+             * the truncated variants.
+             * @param digest pointer to the memory location to store the truncated hash.
+             * @param digest_size the number of bytes to write, at most `s_digest_size`.
+             * @param probe the id reported by the tracepoints.
+             */
+            void complete_truncated(unsigned char * digest,
+                                    size_t digest_size,
+                                    probe_algorithm probe) noexcept;
+
           private:
             ctx_t m_ctx; /**< Stores temporary data while the hash is being computed */
             std::array<uint64_t, 8> m_h0; /* Stores the initial hash value h0 */
+
+            friend class sha512_224;
+            friend class sha512_256;
+            template<size_t T>
+            friend class sha512_t;
         };
 
         // ------------------------------------------------------------------
@@ -491,8 +1180,14 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 224 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                sha512::s_state_size}; /**< Size expressed in byte of the saved state */
+
           public:
-            sha512_224() = default;
+            sha512_224();
             ~sha512_224() {}
             sha512_224(sha512_224 &&) = default;
             sha512_224(const sha512_224 &) = default;
@@ -500,6 +1195,18 @@ namespace hashkitcxx {
             sha512_224 & operator=(const sha512_224 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -512,6 +1219,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -525,6 +1244,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -537,8 +1257,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
 #endif
 
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
+#endif
+
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -557,6 +1354,63 @@ namespace hashkitcxx {
              * @param digest pointer to the memory location to store the hash of `message`.
              */
             void hash(const unsigned char * message, size_t len, unsigned char * digest) noexcept;
+
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
+            void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
+            void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
+            void complete(unsigned char * digest) noexcept;
+
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
+
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
+          private:
+            sha512 m_sha512; /**< Computes the sha-512 hash, started from the sha-512/224 h0 */
         };
 
         // ------------------------------------------------------------------
@@ -568,8 +1422,14 @@ namespace hashkitcxx {
             static constexpr size_t s_digest_size{
                 256 / 8}; /**< Size expressed in byte of the resulting hash */
 
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+            static constexpr size_t s_state_size{
+                sha512::s_state_size}; /**< Size expressed in byte of the saved state */
+
           public:
-            sha512_256() = default;
+            sha512_256();
             ~sha512_256() {}
             sha512_256(sha512_256 &&) = default;
             sha512_256(const sha512_256 &) = default;
@@ -577,6 +1437,18 @@ namespace hashkitcxx {
             sha512_256 & operator=(const sha512_256 &) = default;
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(std::string_view message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size());
+            }
+#    else
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message the text to hash. This function takes a string in input so the message
@@ -589,6 +1461,18 @@ namespace hashkitcxx {
                                       message.size());
             }
 
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash. The string is not copied.
+             * @return a string containing the hash of `message` in hex.
+             */
+            inline std::string hash_printable(const std::string & message)
+            {
+                return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                      message.size());
+            }
+#    endif
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -602,6 +1486,7 @@ namespace hashkitcxx {
                 return std::string(digest_printable);
             }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
             /**
              * @brief Returns the hash of the given input.
              * @param message the text to hash. This function takes a string in input so the message
@@ -614,8 +1499,85 @@ namespace hashkitcxx {
                      message.size(),
                      digest);
             }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash. The string is not copied.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(const std::string & message, unsigned char * digest)
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                     message.size(),
+                     digest);
+            }
+#    endif
 #endif
 
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message the text to hash.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+            {
+                return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                            message.size());
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            inline void hash(std::string_view message, unsigned char * digest) noexcept
+            {
+                hash(reinterpret_cast<const unsigned char *>(message.data()),
+                     message.size(),
+                     digest);
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message the text to hash.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(std::string_view message) noexcept
+            {
+                return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                            message.size());
+            }
+#endif
+
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                           size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                digest_printable[2 * s_digest_size] = '\0';
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            inline digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
             /**
              * @brief Returns the hash of the given input in hex format.
              * @param message pointer to the memory location containing the byte-array to hash.
@@ -634,7 +1596,68 @@ namespace hashkitcxx {
              * @param digest pointer to the memory location to store the hash of `message`.
              */
             void hash(const unsigned char * message, size_t len, unsigned char * digest) noexcept;
+
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
+            void init() noexcept;
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
+            void update(const unsigned char * message, size_t len) noexcept;
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the hash.
+             */
+            void complete(unsigned char * digest) noexcept;
+
+            /**
+             * @brief Saves the state of the hash computation started by init(), so that it can be
+             * resumed by load() later, even in another process or on another machine. The format is
+             * versioned and does not depend on the endianness.
+             * @param state pointer to the memory location to store the `s_state_size` bytes of the
+             * state.
+             */
+            void save(unsigned char * state) const noexcept;
+
+            /**
+             * @brief Restores a state stored by save(), then the computation continues with
+             * update().
+             * @param state pointer to the memory location containing the state.
+             * @param len the length of `state` expressed in bytes.
+             * @return false if `state` is not a state of this algorithm, which is left unchanged.
+             */
+            bool load(const unsigned char * state, size_t len) noexcept;
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept;
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept;
+
+          private:
+            sha512 m_sha512; /**< Computes the sha-512 hash, started from the sha-512/256 h0 */
         };
 
     } // namespace sha2
 } // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_sha2.cpp"
+#endif
@@ -0,0 +1,297 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * The HashKitCXX namespace sha2 is based on original work from Olivier Gay
+ * Copyright: 2005, 2007 Olivier Gay <olivier.gay@a3.epfl.ch>
+ * License: 3-Clause BSD
+ * Description: "Fast software implementation in C of the FIPS 180-2 hash algorithms
+ *   SHA-224, SHA-256, SHA-384 and SHA-512"
+ * Resource link: https://github.com/ogay/sha2
+
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: Secure Hash Standard (SHS) (FIPS PUB 180-4)
+ * Category of Standard: Computer Security Standard, Cryptography
+ * Date Published: August 2015
+ * Author(s): National Institute of Standards and Technology
+ * Resource link: https://csrc.nist.gov/publications/detail/fips/180/4/final
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_core.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// This header requires C++14: the functions below are evaluated by the compiler using the
+// relaxed constexpr rules (loops and local arrays). The runtime library is still C++11.
+
+namespace hashkitcxx {
+    namespace sha2 {
+
+        namespace constexpr_impl {
+
+            // the same logical functions and round constants used by the runtime transforms,
+            // selected by word size
+            constexpr uint32_t f1(uint32_t x) noexcept { return sha256_f1(x); }
+            constexpr uint32_t f2(uint32_t x) noexcept { return sha256_f2(x); }
+            constexpr uint32_t f3(uint32_t x) noexcept { return sha256_f3(x); }
+            constexpr uint32_t f4(uint32_t x) noexcept { return sha256_f4(x); }
+            constexpr uint64_t f1(uint64_t x) noexcept { return sha512_f1(x); }
+            constexpr uint64_t f2(uint64_t x) noexcept { return sha512_f2(x); }
+            constexpr uint64_t f3(uint64_t x) noexcept { return sha512_f3(x); }
+            constexpr uint64_t f4(uint64_t x) noexcept { return sha512_f4(x); }
+            constexpr uint32_t k(uint32_t /*tag*/, size_t j) noexcept { return sha256_k[j]; }
+            constexpr uint64_t k(uint64_t /*tag*/, size_t j) noexcept { return sha512_k[j]; }
+
+            template<typename TWord, typename TByte>
+            constexpr TWord pack(const TByte * str) noexcept
+            {
+                TWord x{0};
+                for (size_t i{0}; i < sizeof(TWord); ++i)
+                {
+                    x = static_cast<TWord>((x << 8) | static_cast<uint8_t>(str[i]));
+                }
+                return x;
+            }
+
+            template<class THash, typename TByte>
+            constexpr void transform(typename traits<THash>::word_t * h,
+                                     const TByte * block) noexcept
+            {
+                using word_t = typename traits<THash>::word_t;
+
+                word_t w[traits<THash>::s_rounds]{};
+                word_t wv[8]{};
+
+                for (size_t j{0}; j < 16; ++j)
+                {
+                    w[j] = pack<word_t>(block + j * sizeof(word_t));
+                }
+
+                for (size_t j{16}; j < traits<THash>::s_rounds; ++j)
+                {
+                    w[j] = f4(w[j - 2]) + w[j - 7] + f3(w[j - 15]) + w[j - 16];
+                }
+
+                for (size_t j{0}; j < 8; ++j)
+                {
+                    wv[j] = h[j];
+                }
+
+                for (size_t j{0}; j < traits<THash>::s_rounds; ++j)
+                {
+                    const word_t t1{wv[7] + f2(wv[4]) + ch(wv[4], wv[5], wv[6]) + k(word_t{}, j) +
+                                    w[j]};
+                    const word_t t2{f1(wv[0]) + maj(wv[0], wv[1], wv[2])};
+                    wv[7] = wv[6];
+                    wv[6] = wv[5];
+                    wv[5] = wv[4];
+                    wv[4] = wv[3] + t1;
+                    wv[3] = wv[2];
+                    wv[2] = wv[1];
+                    wv[1] = wv[0];
+                    wv[0] = t1 + t2;
+                }
+
+                for (size_t j{0}; j < 8; ++j)
+                {
+                    h[j] += wv[j];
+                }
+            }
+
+            template<typename T, size_t N, size_t... TIndex>
+            constexpr std::array<T, N> to_array(const T (&values)[N],
+                                                std::index_sequence<TIndex...>) noexcept
+            {
+                return {{values[TIndex]...}};
+            }
+
+            // an empty std::array has no element to take the address of: hash() never reads
+            // the message when its length is 0, so a null pointer is enough
+            template<size_t N>
+            constexpr const uint8_t * data(const std::array<uint8_t, N> & message,
+                                           std::false_type /*empty*/) noexcept
+            {
+                return &message[0];
+            }
+
+            template<size_t N>
+            constexpr const uint8_t * data(const std::array<uint8_t, N> & /*message*/,
+                                           std::true_type /*empty*/) noexcept
+            {
+                return nullptr;
+            }
+
+            template<class THash, typename TByte>
+            constexpr std::array<uint8_t, THash::s_digest_size> hash(const TByte * message,
+                                                                     size_t len) noexcept
+            {
+                using word_t = typename traits<THash>::word_t;
+                constexpr size_t block_size{traits<THash>::s_block_size};
+
+                word_t h[8]{};
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    h[i] = traits<THash>::h0()[i];
+                }
+
+                const size_t block_nb{len / block_size};
+                for (size_t i{0}; i < block_nb; ++i)
+                {
+                    transform<THash>(h, message + i * block_size);
+                }
+
+                // padding: 0x80, zeroes and the length in bits written in the last bytes, the
+                // same layout the runtime complete() produces
+                uint8_t last[2 * block_size]{};
+                const size_t rem_len{len - block_nb * block_size};
+                for (size_t i{0}; i < rem_len; ++i)
+                {
+                    last[i] = static_cast<uint8_t>(message[block_nb * block_size + i]);
+                }
+                last[rem_len] = 0x80;
+
+                const size_t last_nb{rem_len + 1 + 2 * sizeof(word_t) > block_size ? 2U : 1U};
+                const uint64_t len_b{static_cast<uint64_t>(len) << 3};
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    last[last_nb * block_size - 1 - i] = static_cast<uint8_t>(len_b >> (i * 8));
+                }
+
+                for (size_t i{0}; i < last_nb; ++i)
+                {
+                    transform<THash>(h, last + i * block_size);
+                }
+
+                uint8_t digest[THash::s_digest_size]{};
+                for (size_t i{0}; i < THash::s_digest_size; ++i)
+                {
+                    const size_t shift{(sizeof(word_t) - 1 - i % sizeof(word_t)) * 8};
+                    digest[i] = static_cast<uint8_t>(h[i / sizeof(word_t)] >> shift);
+                }
+
+                return to_array(digest, std::make_index_sequence<THash::s_digest_size>{});
+            }
+
+            template<size_t N>
+            constexpr std::array<char, 2 * N + 1> to_hex(
+                const std::array<uint8_t, N> & digest) noexcept
+            {
+                constexpr char digits[]{"0123456789abcdef"};
+
+                char printable[2 * N + 1]{};
+                for (size_t i{0}; i < N; ++i)
+                {
+                    printable[2 * i] = digits[digest[i] >> 4];
+                    printable[2 * i + 1] = digits[digest[i] & 0x0f];
+                }
+
+                return to_array(printable, std::make_index_sequence<2 * N + 1>{});
+            }
+
+        } // namespace constexpr_impl
+
+        /**
+         * @brief Returns the hash of the given input, computed at compile time when the input is a
+         * constant expression.
+         * @tparam THash one of the sha2 classes (e.g. `sha256`).
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        template<class THash>
+        constexpr std::array<uint8_t, THash::s_digest_size> hash_constexpr(
+            const unsigned char * message,
+            size_t len) noexcept
+        {
+            return constexpr_impl::hash<THash>(message, len);
+        }
+
+        /**
+         * @brief Returns the hash of the given input, computed at compile time when the input is a
+         * constant expression.
+         * @tparam THash one of the sha2 classes (e.g. `sha256`).
+         * @param message pointer to the memory location containing the characters to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        template<class THash>
+        constexpr std::array<uint8_t, THash::s_digest_size> hash_constexpr(const char * message,
+                                                                           size_t len) noexcept
+        {
+            return constexpr_impl::hash<THash>(message, len);
+        }
+
+        /**
+         * @brief Returns the hash of a string literal, computed at compile time.
+         * @tparam THash one of the sha2 classes (e.g. `sha256`).
+         * @param message the string literal to hash. The terminating \0 is not hashed.
+         * @return an array containing the hash of `message`.
+         */
+        template<class THash, size_t N>
+        constexpr std::array<uint8_t, THash::s_digest_size> hash_constexpr(
+            const char (&message)[N]) noexcept
+        {
+            return constexpr_impl::hash<THash>(message, N - 1);
+        }
+
+        /**
+         * @brief Returns the hash of the given blob, computed at compile time.
+         * @tparam THash one of the sha2 classes (e.g. `sha256`).
+         * @param message the array of bytes to hash.
+         * @return an array containing the hash of `message`.
+         */
+        template<class THash, size_t N>
+        constexpr std::array<uint8_t, THash::s_digest_size> hash_constexpr(
+            const std::array<uint8_t, N> & message) noexcept
+        {
+            return constexpr_impl::hash<THash>(
+                constexpr_impl::data(message, std::integral_constant<bool, N == 0>{}), N);
+        }
+
+        /**
+         * @brief Returns the hash of a string literal in hex format, computed at compile time.
+         * @tparam THash one of the sha2 classes (e.g. `sha256`).
+         * @param message the string literal to hash. The terminating \0 is not hashed.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        template<class THash, size_t N>
+        constexpr std::array<char, 2 * THash::s_digest_size + 1> hash_printable_constexpr(
+            const char (&message)[N]) noexcept
+        {
+            return constexpr_impl::to_hex(constexpr_impl::hash<THash>(message, N - 1));
+        }
+
+    } // namespace sha2
+} // namespace hashkitcxx
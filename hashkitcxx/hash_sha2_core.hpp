@@ -0,0 +1,299 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * The HashKitCXX namespace sha2 is based on original work from Olivier Gay
+ * Copyright: 2005, 2007 Olivier Gay <olivier.gay@a3.epfl.ch>
+ * License: 3-Clause BSD
+ * Description: "Fast software implementation in C of the FIPS 180-2 hash algorithms
+ *   SHA-224, SHA-256, SHA-384 and SHA-512"
+ * Resource link: https://github.com/ogay/sha2
+
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: Secure Hash Standard (SHS) (FIPS PUB 180-4)
+ * Category of Standard: Computer Security Standard, Cryptography
+ * Date Published: August 2015
+ * Author(s): National Institute of Standards and Technology
+ * Resource link: https://csrc.nist.gov/publications/detail/fips/180/4/final
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hashkitcxx {
+    namespace sha2 {
+
+        // ------------------------------------------------------------------
+        // --- initial hash values and round constants ----------------------
+
+        static constexpr std::array<uint32_t, 8> sha224_h0 = {0xc1059ed8U,
+                                                              0x367cd507U,
+                                                              0x3070dd17U,
+                                                              0xf70e5939U,
+                                                              0xffc00b31U,
+                                                              0x68581511U,
+                                                              0x64f98fa7U,
+                                                              0xbefa4fa4U};
+
+        static constexpr std::array<uint32_t, 8> sha256_h0 = {0x6a09e667U,
+                                                              0xbb67ae85U,
+                                                              0x3c6ef372U,
+                                                              0xa54ff53aU,
+                                                              0x510e527fU,
+                                                              0x9b05688cU,
+                                                              0x1f83d9abU,
+                                                              0x5be0cd19U};
+
+        static constexpr std::array<uint64_t, 8> sha384_h0 = {0xcbbb9d5dc1059ed8ULL,
+                                                              0x629a292a367cd507ULL,
+                                                              0x9159015a3070dd17ULL,
+                                                              0x152fecd8f70e5939ULL,
+                                                              0x67332667ffc00b31ULL,
+                                                              0x8eb44a8768581511ULL,
+                                                              0xdb0c2e0d64f98fa7ULL,
+                                                              0x47b5481dbefa4fa4ULL};
+
+        static constexpr std::array<uint64_t, 8> sha512_h0 = {0x6a09e667f3bcc908ULL,
+                                                              0xbb67ae8584caa73bULL,
+                                                              0x3c6ef372fe94f82bULL,
+                                                              0xa54ff53a5f1d36f1ULL,
+                                                              0x510e527fade682d1ULL,
+                                                              0x9b05688c2b3e6c1fULL,
+                                                              0x1f83d9abfb41bd6bULL,
+                                                              0x5be0cd19137e2179ULL};
+
+        static constexpr std::array<uint64_t, 8> sha512_224_h0 = {0x8c3d37c819544da2ULL,
+                                                                  0x73e1996689dcd4d6ULL,
+                                                                  0x1dfab7ae32ff9c82ULL,
+                                                                  0x679dd514582f9fcfULL,
+                                                                  0x0f6d2b697bd44da8ULL,
+                                                                  0x77e36f7304c48942ULL,
+                                                                  0x3f9d85a86a1d36c8ULL,
+                                                                  0x1112e6ad91d692a1ULL};
+
+        static constexpr std::array<uint64_t, 8> sha512_256_h0 = {0x22312194fc2bf72cULL,
+                                                                  0x9f555fa3c84c64c2ULL,
+                                                                  0x2393b86b6f53b151ULL,
+                                                                  0x963877195940eabdULL,
+                                                                  0x96283ee2a88effe3ULL,
+                                                                  0xbe5e1e2553863992ULL,
+                                                                  0x2b0199fc2c85b8aaULL,
+                                                                  0x0eb72ddc81c52ca2ULL};
+
+        static constexpr std::array<uint32_t, 64> sha256_k =
+            {0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U,
+             0x923f82a4U, 0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U,
+             0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U,
+             0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+             0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U,
+             0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U,
+             0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
+             0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+             0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU,
+             0x5b9cca4fU, 0x682e6ff3U, 0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U,
+             0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U};
+
+        static constexpr std::array<uint64_t, 80> sha512_k =
+            {0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+             0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+             0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+             0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+             0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+             0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+             0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+             0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+             0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+             0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+             0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+             0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+             0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+             0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+             0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+             0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+             0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+             0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+             0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+             0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+             0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+             0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+             0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+             0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+             0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+             0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+             0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+        // ------------------------------------------------------------------
+        // --- logical functions --------------------------------------------
+
+        template<typename TWord>
+        constexpr TWord shfr(TWord x, unsigned n) noexcept
+        {
+            return x >> n;
+        }
+
+        template<typename TWord>
+        constexpr TWord rotr(TWord x, unsigned n) noexcept
+        {
+            return (x >> n) | (x << ((sizeof(TWord) << 3) - n));
+        }
+
+        template<typename TWord>
+        constexpr TWord ch(TWord x, TWord y, TWord z) noexcept
+        {
+            return (x & y) ^ (~x & z);
+        }
+
+        template<typename TWord>
+        constexpr TWord maj(TWord x, TWord y, TWord z) noexcept
+        {
+            return (x & y) ^ (x & z) ^ (y & z);
+        }
+
+        constexpr uint32_t sha256_f1(uint32_t x) noexcept
+        {
+            return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+        }
+
+        constexpr uint32_t sha256_f2(uint32_t x) noexcept
+        {
+            return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+        }
+
+        constexpr uint32_t sha256_f3(uint32_t x) noexcept
+        {
+            return rotr(x, 7) ^ rotr(x, 18) ^ shfr(x, 3);
+        }
+
+        constexpr uint32_t sha256_f4(uint32_t x) noexcept
+        {
+            return rotr(x, 17) ^ rotr(x, 19) ^ shfr(x, 10);
+        }
+
+        constexpr uint64_t sha512_f1(uint64_t x) noexcept
+        {
+            return rotr(x, 28) ^ rotr(x, 34) ^ rotr(x, 39);
+        }
+
+        constexpr uint64_t sha512_f2(uint64_t x) noexcept
+        {
+            return rotr(x, 14) ^ rotr(x, 18) ^ rotr(x, 41);
+        }
+
+        constexpr uint64_t sha512_f3(uint64_t x) noexcept
+        {
+            return rotr(x, 1) ^ rotr(x, 8) ^ shfr(x, 7);
+        }
+
+        constexpr uint64_t sha512_f4(uint64_t x) noexcept
+        {
+            return rotr(x, 19) ^ rotr(x, 61) ^ shfr(x, 6);
+        }
+
+        // ------------------------------------------------------------------
+        // --- traits -------------------------------------------------------
+
+        class sha224;
+        class sha256;
+        class sha384;
+        class sha512;
+        class sha512_224;
+        class sha512_256;
+
+        /**
+         * @brief Word type, block size, number of rounds and initial hash value of each algorithm.
+         */
+        template<class THash>
+        struct traits;
+
+        template<>
+        struct traits<sha224>
+        {
+            using word_t = uint32_t;
+            static constexpr size_t s_block_size{512 / 8};
+            static constexpr size_t s_rounds{64};
+            static constexpr const std::array<uint32_t, 8> & h0() noexcept { return sha224_h0; }
+        };
+
+        template<>
+        struct traits<sha256>
+        {
+            using word_t = uint32_t;
+            static constexpr size_t s_block_size{512 / 8};
+            static constexpr size_t s_rounds{64};
+            static constexpr const std::array<uint32_t, 8> & h0() noexcept { return sha256_h0; }
+        };
+
+        template<>
+        struct traits<sha384>
+        {
+            using word_t = uint64_t;
+            static constexpr size_t s_block_size{1024 / 8};
+            static constexpr size_t s_rounds{80};
+            static constexpr const std::array<uint64_t, 8> & h0() noexcept { return sha384_h0; }
+        };
+
+        template<>
+        struct traits<sha512>
+        {
+            using word_t = uint64_t;
+            static constexpr size_t s_block_size{1024 / 8};
+            static constexpr size_t s_rounds{80};
+            static constexpr const std::array<uint64_t, 8> & h0() noexcept { return sha512_h0; }
+        };
+
+        template<>
+        struct traits<sha512_224>
+        {
+            using word_t = uint64_t;
+            static constexpr size_t s_block_size{1024 / 8};
+            static constexpr size_t s_rounds{80};
+            static constexpr const std::array<uint64_t, 8> & h0() noexcept
+            {
+                return sha512_224_h0;
+            }
+        };
+
+        template<>
+        struct traits<sha512_256>
+        {
+            using word_t = uint64_t;
+            static constexpr size_t s_block_size{1024 / 8};
+            static constexpr size_t s_rounds{80};
+            static constexpr const std::array<uint64_t, 8> & h0() noexcept
+            {
+                return sha512_256_h0;
+            }
+        };
+
+    } // namespace sha2
+} // namespace hashkitcxx
@@ -0,0 +1,368 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_sha2_lanes.hpp"
+#include "hash_sha2_core.hpp"
+#include <cstring>
+#if defined(HASHLIBCXX_INSTRUMENTATION)
+#    include "hash_stats.hpp"
+#endif
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+// instrumentation counters, see hash_stats.hpp
+#if defined(HASHLIBCXX_COUNT)
+#    undef HASHLIBCXX_COUNT
+#endif
+#if defined(HASHLIBCXX_TIME)
+#    undef HASHLIBCXX_TIME
+#endif
+#if defined(HASHLIBCXX_INSTRUMENTATION)
+#    define HASHLIBCXX_COUNT(counter, value) stats::add(stats::counter, value)
+#    define HASHLIBCXX_TIME(counter) const stats::scoped_timer timer(stats::counter)
+#else
+#    define HASHLIBCXX_COUNT(counter, value)
+#    define HASHLIBCXX_TIME(counter)
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <immintrin.h>
+#    define HASHLIBCXX_LANES_AVX2
+#endif
+
+namespace hashkitcxx {
+    namespace sha2 {
+        namespace lanes {
+
+            HASHLIBCXX_INLINE void sha256_rounds_scalar(uint32_t (&vars)[8][s_sha256_lanes],
+                                                        const uint32_t (&words)[16][s_sha256_lanes],
+                                                        unsigned first_round) noexcept
+            {
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    uint32_t w[16];
+                    for (size_t t{0}; t < 16; ++t)
+                        w[t] = words[t][lane];
+
+                    uint32_t a{vars[0][lane]}, b{vars[1][lane]}, c{vars[2][lane]}, d{vars[3][lane]};
+                    uint32_t e{vars[4][lane]}, f{vars[5][lane]}, g{vars[6][lane]}, h{vars[7][lane]};
+                    for (unsigned t{0}; t < 64; ++t)
+                    {
+                        if (t >= 16)
+                        {
+                            w[t & 15] += sha256_f4(w[(t - 2) & 15]) + w[(t - 7) & 15] +
+                                         sha256_f3(w[(t - 15) & 15]);
+                        }
+                        if (t < first_round)
+                            continue;
+
+                        const uint32_t t1{h + sha256_f2(e) + ch(e, f, g) + sha256_k[t] + w[t & 15]};
+                        const uint32_t t2{sha256_f1(a) + maj(a, b, c)};
+                        h = g;
+                        g = f;
+                        f = e;
+                        e = d + t1;
+                        d = c;
+                        c = b;
+                        b = a;
+                        a = t1 + t2;
+                    }
+
+                    vars[0][lane] = a;
+                    vars[1][lane] = b;
+                    vars[2][lane] = c;
+                    vars[3][lane] = d;
+                    vars[4][lane] = e;
+                    vars[5][lane] = f;
+                    vars[6][lane] = g;
+                    vars[7][lane] = h;
+                }
+            }
+
+#if defined(HASHLIBCXX_LANES_AVX2)
+            HASHLIBCXX_INLINE bool has_avx2() noexcept
+            {
+                static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+                return avx2;
+            }
+
+            template<int N>
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE __m256i rotr_avx2(__m256i x) noexcept
+            {
+                return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+            }
+
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+            sha256_rounds_avx2(uint32_t (&vars)[8][s_sha256_lanes],
+                               const uint32_t (&words)[16][s_sha256_lanes],
+                               unsigned first_round) noexcept
+            {
+                __m256i w[16];
+                for (size_t t{0}; t < 16; ++t)
+                    w[t] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words[t]));
+
+                __m256i v[8];
+                for (size_t i{0}; i < 8; ++i)
+                    v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vars[i]));
+                __m256i a{v[0]}, b{v[1]}, c{v[2]}, d{v[3]}, e{v[4]}, f{v[5]}, g{v[6]}, h{v[7]};
+
+                for (unsigned t{0}; t < 64; ++t)
+                {
+                    if (t >= 16)
+                    {
+                        const __m256i w2{w[(t - 2) & 15]};
+                        const __m256i w15{w[(t - 15) & 15]};
+                        const __m256i s1{_mm256_xor_si256(
+                            _mm256_xor_si256(rotr_avx2<17>(w2), rotr_avx2<19>(w2)),
+                            _mm256_srli_epi32(w2, 10))};
+                        const __m256i s0{_mm256_xor_si256(
+                            _mm256_xor_si256(rotr_avx2<7>(w15), rotr_avx2<18>(w15)),
+                            _mm256_srli_epi32(w15, 3))};
+                        w[t & 15] = _mm256_add_epi32(
+                            _mm256_add_epi32(w[t & 15], s1), _mm256_add_epi32(w[(t - 7) & 15], s0));
+                    }
+                    if (t < first_round)
+                        continue;
+
+                    const __m256i big_s1{_mm256_xor_si256(
+                        _mm256_xor_si256(rotr_avx2<6>(e), rotr_avx2<11>(e)), rotr_avx2<25>(e))};
+                    const __m256i choose{
+                        _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g))};
+                    const __m256i t1{_mm256_add_epi32(
+                        _mm256_add_epi32(_mm256_add_epi32(h, big_s1), choose),
+                        _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(sha256_k[t])),
+                                         w[t & 15]))};
+                    const __m256i big_s0{_mm256_xor_si256(
+                        _mm256_xor_si256(rotr_avx2<2>(a), rotr_avx2<13>(a)), rotr_avx2<22>(a))};
+                    const __m256i majority{_mm256_xor_si256(
+                        _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)),
+                        _mm256_and_si256(b, c))};
+                    const __m256i t2{_mm256_add_epi32(big_s0, majority)};
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = _mm256_add_epi32(d, t1);
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = _mm256_add_epi32(t1, t2);
+                }
+
+                v[0] = a;
+                v[1] = b;
+                v[2] = c;
+                v[3] = d;
+                v[4] = e;
+                v[5] = f;
+                v[6] = g;
+                v[7] = h;
+                for (size_t i{0}; i < 8; ++i)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(vars[i]), v[i]);
+            }
+
+            /**
+             * @brief Transposes 8 rows of 8 words: the word i of the row r becomes the word r of
+             * the row i.
+             */
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+            transpose_avx2(__m256i (&rows)[8]) noexcept
+            {
+                __m256i t[8];
+                for (size_t i{0}; i < 8; i += 2)
+                {
+                    t[i] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+                    t[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+                }
+                __m256i u[8];
+                for (size_t i{0}; i < 8; i += 4)
+                {
+                    u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+                    u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+                    u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+                    u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+                }
+                for (size_t i{0}; i < 4; ++i)
+                {
+                    rows[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+                    rows[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+                }
+            }
+
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE __m256i
+            byte_swap_avx2(__m256i x) noexcept
+            {
+                const __m256i order{_mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+                                                     13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8,
+                                                     15, 14, 13, 12)};
+                return _mm256_shuffle_epi8(x, order);
+            }
+
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+            sha256_load_avx2(uint32_t (&words)[16][s_sha256_lanes],
+                             const unsigned char * const (&blocks)[s_sha256_lanes]) noexcept
+            {
+                for (size_t half{0}; half < 2; ++half)
+                {
+                    __m256i rows[8];
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                    {
+                        rows[lane] = byte_swap_avx2(_mm256_loadu_si256(
+                            reinterpret_cast<const __m256i *>(blocks[lane] + 32 * half)));
+                    }
+                    transpose_avx2(rows);
+                    for (size_t i{0}; i < 8; ++i)
+                    {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(words[8 * half + i]),
+                                            rows[i]);
+                    }
+                }
+            }
+
+            __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+            sha256_store_avx2(unsigned char * const (&digests)[s_sha256_lanes],
+                              size_t digest_size,
+                              const uint32_t (&h)[8][s_sha256_lanes]) noexcept
+            {
+                __m256i rows[8];
+                for (size_t i{0}; i < 8; ++i)
+                    rows[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(h[i]));
+                transpose_avx2(rows);
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    const __m256i digest{byte_swap_avx2(rows[lane])};
+                    if (digest_size == 32)
+                    {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(digests[lane]), digest);
+                        continue;
+                    }
+                    unsigned char bytes[32];
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(bytes), digest);
+                    std::memcpy(digests[lane], bytes, digest_size);
+                }
+            }
+#endif
+
+            HASHLIBCXX_INLINE void sha256_rounds(uint32_t (&vars)[8][s_sha256_lanes],
+                                                 const uint32_t (&words)[16][s_sha256_lanes],
+                                                 unsigned first_round) noexcept
+            {
+                HASHLIBCXX_COUNT(lanes_sha256_blocks, s_sha256_lanes);
+                HASHLIBCXX_TIME(lanes_sha256_nanoseconds);
+
+#if defined(HASHLIBCXX_LANES_AVX2)
+                if (has_avx2())
+                {
+                    sha256_rounds_avx2(vars, words, first_round);
+                    return;
+                }
+#endif
+                sha256_rounds_scalar(vars, words, first_round);
+            }
+
+            HASHLIBCXX_INLINE void
+            sha256_compress(uint32_t (&h)[8][s_sha256_lanes],
+                            const uint32_t (&words)[16][s_sha256_lanes]) noexcept
+            {
+                uint32_t vars[8][s_sha256_lanes];
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                        vars[i][lane] = h[i][lane];
+                }
+
+                sha256_rounds(vars, words, 0);
+
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                        h[i][lane] += vars[i][lane];
+                }
+            }
+
+            HASHLIBCXX_INLINE void
+            sha256_load(uint32_t (&words)[16][s_sha256_lanes],
+                        const unsigned char * const (&blocks)[s_sha256_lanes]) noexcept
+            {
+#if defined(HASHLIBCXX_LANES_AVX2)
+                if (has_avx2())
+                {
+                    sha256_load_avx2(words, blocks);
+                    return;
+                }
+#endif
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    for (size_t t{0}; t < 16; ++t)
+                    {
+                        const unsigned char * word{blocks[lane] + 4 * t};
+                        words[t][lane] = (static_cast<uint32_t>(word[0]) << 24) |
+                                         (static_cast<uint32_t>(word[1]) << 16) |
+                                         (static_cast<uint32_t>(word[2]) << 8) | word[3];
+                    }
+                }
+            }
+
+            HASHLIBCXX_INLINE void sha256_store(unsigned char * const (&digests)[s_sha256_lanes],
+                                                size_t digest_size,
+                                                const uint32_t (&h)[8][s_sha256_lanes]) noexcept
+            {
+#if defined(HASHLIBCXX_LANES_AVX2)
+                if (has_avx2())
+                {
+                    sha256_store_avx2(digests, digest_size, h);
+                    return;
+                }
+#endif
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    for (size_t i{0}; i < digest_size; ++i)
+                    {
+                        digests[lane][i] =
+                            static_cast<unsigned char>(h[i / 4][lane] >> (24 - 8 * (i % 4)));
+                    }
+                }
+            }
+
+        } // namespace lanes
+    } // namespace sha2
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_LANES_AVX2
+#undef HASHLIBCXX_COUNT
+#undef HASHLIBCXX_TIME
+#undef HASHLIBCXX_INLINE
@@ -0,0 +1,94 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace hashkitcxx {
+    namespace sha2 {
+        namespace lanes {
+
+            constexpr size_t s_sha256_lanes{8}; /**< Blocks processed together by the kernels */
+
+            /**
+             * @brief Runs the rounds `first_round` to 63 of sha-256 on 8 independent blocks, with
+             * AVX2 when the processor supports it. The data is transposed: the element [i][lane]
+             * belongs to the block of `lane`, so that a row fills a vector register.
+             *
+             * Starting after round 0 lets a caller skip the rounds that are the same for every
+             * lane: it runs them once and passes the resulting working variables. The feed-forward
+             * of the hash value (adding the hash value before the block) is left to the caller.
+             * @param vars the working variables a to h of each lane before `first_round`, updated
+             * to their values after round 63.
+             * @param words the 16 words of each block, in big endian order.
+             * @param first_round the first round to run, from 0 to 16.
+             */
+            HASHLIBCXX_DLL void sha256_rounds(uint32_t (&vars)[8][s_sha256_lanes],
+                                              const uint32_t (&words)[16][s_sha256_lanes],
+                                              unsigned first_round) noexcept;
+
+            /**
+             * @brief Compresses one block of each lane into its hash value, transposed as well:
+             * the element [i][lane] is the word i of the hash value of `lane`.
+             */
+            HASHLIBCXX_DLL void
+            sha256_compress(uint32_t (&h)[8][s_sha256_lanes],
+                            const uint32_t (&words)[16][s_sha256_lanes]) noexcept;
+
+            /**
+             * @brief Loads one block of each lane, transposed into the words expected by the
+             * kernels: the element [t][lane] is the big endian word t of `blocks[lane]`.
+             * @param words receives the words.
+             * @param blocks the block of each lane, 64 bytes.
+             */
+            HASHLIBCXX_DLL void
+            sha256_load(uint32_t (&words)[16][s_sha256_lanes],
+                        const unsigned char * const (&blocks)[s_sha256_lanes]) noexcept;
+
+            /**
+             * @brief Writes the digest of each lane from its transposed hash value, in big endian
+             * order.
+             * @param digests the digest of each lane.
+             * @param digest_size the bytes written to each digest, up to 32.
+             * @param h the hash value of each lane, as for sha256_compress().
+             */
+            HASHLIBCXX_DLL void sha256_store(unsigned char * const (&digests)[s_sha256_lanes],
+                                             size_t digest_size,
+                                             const uint32_t (&h)[8][s_sha256_lanes]) noexcept;
+
+        } // namespace lanes
+    } // namespace sha2
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_sha2_lanes.cpp"
+#endif
@@ -0,0 +1,408 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_core.hpp"
+#include "hash_sha2_lanes.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace hashkitcxx {
+    namespace sha2 {
+
+        /**
+         * @brief Pool of incremental hash computations of the same algorithm, for applications
+         * keeping a large number of hashes open at the same time (one per upload, connection...).
+         *
+         * The contexts are allocated at once in a contiguous arena and stored as a structure of
+         * arrays: the hash values, the pending blocks, the lengths each in their own array, every
+         * array aligned to the cache line. A context takes a single block of pending bytes, the
+         * padding is built on the stack by complete(), so it is about half the size of a hash
+         * object.
+         *
+         * A context whose pending block becomes full is not compressed right away but queued,
+         * then step() compresses all the queued contexts together: many independent blocks at a
+         * time are what a multi-buffer kernel needs, and sha224 and sha256 pools compress them 8
+         * at a time with the sha2::lanes kernel. A queued context given more data, or completed,
+         * before step() is compressed on its own.
+         */
+        template<class THash>
+        class context_pool final
+        {
+          public:
+            using handle_t = uint32_t; /**< Identifies a context of the pool */
+            using word_t = typename traits<THash>::word_t;
+
+            static constexpr handle_t s_invalid_handle{UINT32_MAX}; /**< No context available */
+
+          public:
+            /**
+             * @param capacity the maximum number of contexts used at the same time.
+             */
+            explicit context_pool(size_t capacity)
+                : m_capacity{capacity < s_invalid_handle ? capacity : s_invalid_handle - 1}
+            {
+                const size_t h_size{align(m_capacity * 8 * sizeof(word_t))};
+                const size_t blocks_size{align(m_capacity * s_block_size)};
+                const size_t total_size{align(m_capacity * sizeof(uint64_t))};
+                const size_t pending_size{align(m_capacity * sizeof(uint8_t))};
+                const size_t queued_size{align(m_capacity * sizeof(uint8_t))};
+                const size_t handles_size{align(m_capacity * sizeof(handle_t))};
+
+                m_arena.reset(new unsigned char[h_size + blocks_size + total_size + pending_size +
+                                                queued_size + 2 * handles_size + s_cache_line]);
+
+                unsigned char * arena{m_arena.get()};
+                arena += (s_cache_line - reinterpret_cast<uintptr_t>(arena) % s_cache_line) %
+                         s_cache_line;
+
+                m_h = reinterpret_cast<word_t *>(arena);
+                arena += h_size;
+                m_blocks = arena;
+                arena += blocks_size;
+                m_total = reinterpret_cast<uint64_t *>(arena);
+                arena += total_size;
+                m_pending = arena;
+                arena += pending_size;
+                m_queued = arena;
+                arena += queued_size;
+                m_free = reinterpret_cast<handle_t *>(arena);
+                arena += handles_size;
+                m_ready = reinterpret_cast<handle_t *>(arena);
+
+                std::memset(m_queued, 0, m_capacity);
+                for (size_t i{0}; i < m_capacity; ++i)
+                    m_free[i] = static_cast<handle_t>(m_capacity - 1 - i);
+                m_free_count = m_capacity;
+            }
+
+            context_pool(const context_pool &) = delete;
+            context_pool & operator=(const context_pool &) = delete;
+
+            /**
+             * @brief Returns the maximum number of contexts used at the same time.
+             */
+            size_t capacity() const noexcept
+            {
+                return m_capacity;
+            }
+
+            /**
+             * @brief Returns the number of contexts in use.
+             */
+            size_t size() const noexcept
+            {
+                return m_capacity - m_free_count;
+            }
+
+            /**
+             * @brief Returns the number of contexts queued for the next step().
+             */
+            size_t queued() const noexcept
+            {
+                return m_ready_count;
+            }
+
+            /**
+             * @brief Takes a context from the pool and starts a new hash computation in it.
+             * @return the context, or s_invalid_handle if all of them are in use.
+             */
+            handle_t acquire() noexcept
+            {
+                if (m_free_count == 0)
+                    return s_invalid_handle;
+
+                const handle_t handle{m_free[--m_free_count]};
+                init(handle);
+                return handle;
+            }
+
+            /**
+             * @brief Gives the context back to the pool, discarding its hash computation.
+             */
+            void release(handle_t handle) noexcept
+            {
+                m_pending[handle] = 0;
+                m_free[m_free_count++] = handle;
+            }
+
+            /**
+             * @brief Starts a new hash computation in the context.
+             */
+            void init(handle_t handle) noexcept
+            {
+                const std::array<word_t, 8> & h0{traits<THash>::h0()};
+                std::memcpy(hash_value(handle), h0.data(), sizeof(h0));
+                m_total[handle] = 0;
+                m_pending[handle] = 0;
+            }
+
+            /**
+             * @brief Adds the given part of the message to the hash computation of the context.
+             * Whole blocks are compressed directly from `message`, the last block is left pending.
+             * @param handle the context.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
+            void update(handle_t handle, const unsigned char * message, size_t len) noexcept
+            {
+                if (len == 0)
+                    return;
+
+                word_t * h{hash_value(handle)};
+                unsigned char * block{pending_block(handle)};
+                size_t pending{m_pending[handle]};
+
+                if (pending == s_block_size)
+                {
+                    THash::compress(h, block, 1);
+                    m_total[handle] += s_block_size;
+                    pending = 0;
+                }
+
+                const size_t head{len < s_block_size - pending ? len : s_block_size - pending};
+                std::memcpy(block + pending, message, head);
+                pending += head;
+                message += head;
+                len -= head;
+
+                if (len > 0)
+                {
+                    THash::compress(h, block, 1);
+
+                    // at least one byte is left for the pending block
+                    const size_t block_nb{(len - 1) / s_block_size};
+                    THash::compress(h, message, block_nb);
+                    m_total[handle] += (block_nb + 1) * s_block_size;
+                    message += block_nb * s_block_size;
+                    len -= block_nb * s_block_size;
+
+                    std::memcpy(block, message, len);
+                    pending = len;
+                }
+
+                m_pending[handle] = static_cast<uint8_t>(pending);
+                if (pending == s_block_size && m_queued[handle] == 0)
+                {
+                    m_queued[handle] = 1;
+                    m_ready[m_ready_count++] = handle;
+                }
+            }
+
+            /**
+             * @brief Completes the hash computation of the context, then starts a new one in it.
+             * @param handle the context.
+             * @param digest pointer to the memory location to store the hash.
+             */
+            void complete(handle_t handle, unsigned char * digest) noexcept
+            {
+                word_t * h{hash_value(handle)};
+                size_t pending{m_pending[handle]};
+
+                if (pending == s_block_size)
+                {
+                    THash::compress(h, pending_block(handle), 1);
+                    m_total[handle] += s_block_size;
+                    pending = 0;
+                }
+
+                // the message length is stored in the last 8 bytes of the padding, the bytes of
+                // the length field above them (sha-384 and sha-512) stay 0
+                const uint64_t len_b{(m_total[handle] + pending) << 3};
+                const size_t block_nb{pending + 1 + 2 * sizeof(word_t) > s_block_size ? 2U : 1U};
+
+                unsigned char padding[2 * s_block_size]{};
+                std::memcpy(padding, pending_block(handle), pending);
+                padding[pending] = 0x80;
+                unsigned char * last{padding + block_nb * s_block_size - 1};
+                for (size_t i{0}; i < 8; ++i)
+                    last[-static_cast<ptrdiff_t>(i)] = static_cast<uint8_t>(len_b >> (8 * i));
+
+                THash::compress(h, padding, block_nb);
+
+                for (size_t i{0}; i < THash::s_digest_size; ++i)
+                {
+                    const size_t shift{8 * (sizeof(word_t) - 1 - i % sizeof(word_t))};
+                    digest[i] = static_cast<uint8_t>(h[i / sizeof(word_t)] >> shift);
+                }
+
+                init(handle);
+            }
+
+            /**
+             * @brief Compresses the pending block of every queued context.
+             * @return the number of contexts compressed.
+             */
+            size_t step() noexcept
+            {
+                word_t * h[s_lanes];
+                const unsigned char * blocks[s_lanes];
+                size_t lanes{0};
+                size_t compressed{0};
+
+                for (size_t i{0}; i < m_ready_count; ++i)
+                {
+                    const handle_t handle{m_ready[i]};
+                    m_queued[handle] = 0;
+
+                    // skip the contexts compressed, completed or released since they were queued
+                    if (m_pending[handle] != s_block_size)
+                        continue;
+
+                    m_total[handle] += s_block_size;
+                    m_pending[handle] = 0;
+                    h[lanes] = hash_value(handle);
+                    blocks[lanes] = pending_block(handle);
+                    if (++lanes == s_lanes)
+                    {
+                        compress_lanes(h, blocks, lanes);
+                        compressed += lanes;
+                        lanes = 0;
+                    }
+                }
+
+                compress_lanes(h, blocks, lanes);
+                compressed += lanes;
+                m_ready_count = 0;
+                return compressed;
+            }
+
+          private:
+            static constexpr size_t s_block_size{traits<THash>::s_block_size};
+            static constexpr size_t s_cache_line{64};
+            static constexpr size_t s_lanes{8}; /**< Contexts compressed together by step() */
+
+            static constexpr size_t align(size_t size) noexcept
+            {
+                return (size + s_cache_line - 1) / s_cache_line * s_cache_line;
+            }
+
+            /**
+             * @brief Compresses one block for each of the given hash values, at most s_lanes. The
+             * blocks are independent, so that they can be processed in parallel by a multi-buffer
+             * kernel.
+             */
+            static void compress_lanes(word_t * const * h,
+                                       const unsigned char * const * blocks,
+                                       size_t lanes) noexcept
+            {
+                using lanes_t =
+                    std::integral_constant<bool, std::is_same<word_t, uint32_t>::value>;
+                compress_lanes(h, blocks, lanes, lanes_t{});
+            }
+
+            /**
+             * @brief Compresses the blocks together with the multi-buffer sha-256 kernel, the hash
+             * values transposed on the way in and out. The lanes past the last block compress
+             * the first one again, and their result is dropped.
+             */
+            static void compress_lanes(word_t * const * h,
+                                       const unsigned char * const * blocks,
+                                       size_t count,
+                                       std::true_type /*lanes*/) noexcept
+            {
+                using sha2::lanes::s_sha256_lanes;
+                if (count == 0)
+                    return;
+                static_assert(s_lanes == s_sha256_lanes, "a context per lane");
+
+                const unsigned char * block[s_sha256_lanes];
+                uint32_t h_lanes[8][s_sha256_lanes];
+                for (size_t lane{0}; lane < s_sha256_lanes; ++lane)
+                {
+                    const size_t used{lane < count ? lane : 0};
+                    block[lane] = blocks[used];
+                    for (size_t i{0}; i < 8; ++i)
+                        h_lanes[i][lane] = h[used][i];
+                }
+
+                uint32_t words[16][s_sha256_lanes];
+                sha2::lanes::sha256_load(words, block);
+                sha2::lanes::sha256_compress(h_lanes, words);
+
+                for (size_t lane{0}; lane < count; ++lane)
+                {
+                    for (size_t i{0}; i < 8; ++i)
+                        h[lane][i] = h_lanes[i][lane];
+                }
+            }
+
+            /**
+             * @brief Compresses the blocks one at a time with the compression function of THash.
+             */
+            static void compress_lanes(word_t * const * h,
+                                       const unsigned char * const * blocks,
+                                       size_t lanes,
+                                       std::false_type /*lanes*/) noexcept
+            {
+                for (size_t i{0}; i < lanes; ++i)
+                    THash::compress(h[i], blocks[i], 1);
+            }
+
+            word_t * hash_value(handle_t handle) const noexcept
+            {
+                return m_h + static_cast<size_t>(handle) * 8;
+            }
+
+            unsigned char * pending_block(handle_t handle) const noexcept
+            {
+                return m_blocks + static_cast<size_t>(handle) * s_block_size;
+            }
+
+          private:
+            std::unique_ptr<unsigned char[]> m_arena; /**< Memory of all the arrays below */
+            size_t m_capacity;                        /**< Number of contexts */
+            word_t * m_h{nullptr};                    /**< Hash value of each context */
+            unsigned char * m_blocks{nullptr};        /**< Pending block of each context */
+            uint64_t * m_total{nullptr};              /**< Bytes compressed by each context */
+            unsigned char * m_pending{nullptr};       /**< Bytes in the pending block */
+            unsigned char * m_queued{nullptr};        /**< Whether the context is in m_ready */
+            handle_t * m_free{nullptr};               /**< Stack of the contexts not in use */
+            size_t m_free_count{0};                   /**< Size of m_free */
+            handle_t * m_ready{nullptr};              /**< Contexts queued for step() */
+            size_t m_ready_count{0};                  /**< Size of m_ready */
+        };
+
+        template<class THash>
+        constexpr typename context_pool<THash>::handle_t context_pool<THash>::s_invalid_handle;
+        template<class THash>
+        constexpr size_t context_pool<THash>::s_block_size;
+        template<class THash>
+        constexpr size_t context_pool<THash>::s_cache_line;
+        template<class THash>
+        constexpr size_t context_pool<THash>::s_lanes;
+
+    } // namespace sha2
+} // namespace hashkitcxx
@@ -0,0 +1,812 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions
+ * (FIPS PUB 202)
+ * Category of Standard: Computer Security Standard, Cryptography
+ * Date Published: August 2015
+ * Author(s): National Institute of Standards and Technology
+ * Resource link: https://csrc.nist.gov/publications/detail/fips/202/final
+ *
+ * Lane complementing: Keccak implementation overview, section 2.2,
+ * https://keccak.team/files/Keccak-implementation-3.2.pdf
+ */
+
+#include "hash_sha3.hpp"
+#include <cstring>
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+#if defined(HASHLIBCXX_ASSERT)
+#    undef HASHLIBCXX_ASSERT
+#endif
+#if defined(HASHLIBCXX_STD_ASSERT)
+#    include <cassert>
+#    define HASHLIBCXX_ASSERT assert
+#else
+#    define HASHLIBCXX_ASSERT(x)
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define HASHLIBCXX_SHA3_SIMD
+#endif
+
+#if defined(SHA3_ROTL)
+#    undef SHA3_ROTL
+#endif
+#define SHA3_ROTL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+// A round of Keccak-f[1600] from the lanes A to the lanes E, rc being the round constant. The
+// lanes 1, 2, 8, 12, 17 and 20 are kept complemented, which turns 19 of the 25 `~x & y` of chi
+// into a single AND or OR: every row complements one operand at most.
+#if defined(SHA3_ROUND)
+#    undef SHA3_ROUND
+#endif
+#define SHA3_ROUND(A, E, rc)                                                                       \
+    {                                                                                              \
+        const uint64_t c0{A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20]};                                    \
+        const uint64_t c1{A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21]};                                    \
+        const uint64_t c2{A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22]};                                    \
+        const uint64_t c3{A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23]};                                    \
+        const uint64_t c4{A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24]};                                    \
+        const uint64_t d0{c4 ^ SHA3_ROTL(c1, 1)};                                                  \
+        const uint64_t d1{c0 ^ SHA3_ROTL(c2, 1)};                                                  \
+        const uint64_t d2{c1 ^ SHA3_ROTL(c3, 1)};                                                  \
+        const uint64_t d3{c2 ^ SHA3_ROTL(c4, 1)};                                                  \
+        const uint64_t d4{c3 ^ SHA3_ROTL(c0, 1)};                                                  \
+        uint64_t b0, b1, b2, b3, b4;                                                               \
+        b0 = A[0] ^ d0;                                                                            \
+        b1 = SHA3_ROTL(A[6] ^ d1, 44);                                                             \
+        b2 = SHA3_ROTL(A[12] ^ d2, 43);                                                            \
+        b3 = SHA3_ROTL(A[18] ^ d3, 21);                                                            \
+        b4 = SHA3_ROTL(A[24] ^ d4, 14);                                                            \
+        E[0] = b0 ^ (b1 | b2) ^ (rc);                                                              \
+        E[1] = b1 ^ (~b2 | b3);                                                                    \
+        E[2] = b2 ^ (b3 & b4);                                                                     \
+        E[3] = b3 ^ (b4 | b0);                                                                     \
+        E[4] = b4 ^ (b0 & b1);                                                                     \
+        b0 = SHA3_ROTL(A[3] ^ d3, 28);                                                             \
+        b1 = SHA3_ROTL(A[9] ^ d4, 20);                                                             \
+        b2 = SHA3_ROTL(A[10] ^ d0, 3);                                                             \
+        b3 = SHA3_ROTL(A[16] ^ d1, 45);                                                            \
+        b4 = SHA3_ROTL(A[22] ^ d2, 61);                                                            \
+        E[5] = b0 ^ (b1 | b2);                                                                     \
+        E[6] = b1 ^ (b2 & b3);                                                                     \
+        E[7] = b2 ^ (b3 | ~b4);                                                                    \
+        E[8] = b3 ^ (b4 | b0);                                                                     \
+        E[9] = b4 ^ (b0 & b1);                                                                     \
+        b0 = SHA3_ROTL(A[1] ^ d1, 1);                                                              \
+        b1 = SHA3_ROTL(A[7] ^ d2, 6);                                                              \
+        b2 = SHA3_ROTL(A[13] ^ d3, 25);                                                            \
+        b3 = SHA3_ROTL(A[19] ^ d4, 8);                                                             \
+        b4 = SHA3_ROTL(A[20] ^ d0, 18);                                                            \
+        E[10] = b0 ^ (b1 | b2);                                                                    \
+        E[11] = b1 ^ (b2 & b3);                                                                    \
+        E[12] = b2 ^ (~b3 & b4);                                                                   \
+        E[13] = ~b3 ^ (b4 | b0);                                                                   \
+        E[14] = b4 ^ (b0 & b1);                                                                    \
+        b0 = SHA3_ROTL(A[4] ^ d4, 27);                                                             \
+        b1 = SHA3_ROTL(A[5] ^ d0, 36);                                                             \
+        b2 = SHA3_ROTL(A[11] ^ d1, 10);                                                            \
+        b3 = SHA3_ROTL(A[17] ^ d2, 15);                                                            \
+        b4 = SHA3_ROTL(A[23] ^ d3, 56);                                                            \
+        E[15] = b0 ^ (b1 & b2);                                                                    \
+        E[16] = b1 ^ (b2 | b3);                                                                    \
+        E[17] = b2 ^ (~b3 | b4);                                                                   \
+        E[18] = ~b3 ^ (b4 & b0);                                                                   \
+        E[19] = b4 ^ (b0 | b1);                                                                    \
+        b0 = SHA3_ROTL(A[2] ^ d2, 62);                                                             \
+        b1 = SHA3_ROTL(A[8] ^ d3, 55);                                                             \
+        b2 = SHA3_ROTL(A[14] ^ d4, 39);                                                            \
+        b3 = SHA3_ROTL(A[15] ^ d0, 41);                                                            \
+        b4 = SHA3_ROTL(A[21] ^ d1, 2);                                                             \
+        E[20] = b0 ^ (~b1 & b2);                                                                   \
+        E[21] = ~b1 ^ (b2 | b3);                                                                   \
+        E[22] = b2 ^ (b3 & b4);                                                                    \
+        E[23] = b3 ^ (b4 | b0);                                                                    \
+        E[24] = b4 ^ (b0 & b1);                                                                    \
+    }
+
+namespace hashkitcxx {
+    namespace sha3_impl {
+
+        static constexpr uint64_t s_round_constants[24]{
+            0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+            0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+            0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+            0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+            0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+            0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+        static constexpr uint32_t s_complemented{0x121106}; /**< Bit i set if the lane i is */
+
+        HASHLIBCXX_INLINE uint64_t load64(const unsigned char * src) noexcept
+        {
+            return static_cast<uint64_t>(src[0]) | (static_cast<uint64_t>(src[1]) << 8) |
+                   (static_cast<uint64_t>(src[2]) << 16) | (static_cast<uint64_t>(src[3]) << 24) |
+                   (static_cast<uint64_t>(src[4]) << 32) | (static_cast<uint64_t>(src[5]) << 40) |
+                   (static_cast<uint64_t>(src[6]) << 48) | (static_cast<uint64_t>(src[7]) << 56);
+        }
+
+        /**
+         * @brief Writes the bytes [offset, offset + len) of the lanes, which must belong to the
+         * same block.
+         * @param mask the lanes complemented: they are complemented back.
+         */
+        HASHLIBCXX_INLINE void extract(const uint64_t * a,
+                                       uint32_t mask,
+                                       size_t offset,
+                                       unsigned char * output,
+                                       size_t len) noexcept
+        {
+            while (len > 0)
+            {
+                const size_t i{offset / 8};
+                const size_t shift{offset % 8};
+                const size_t n{8 - shift < len ? 8 - shift : len};
+                uint64_t lane{a[i] ^ (0 - static_cast<uint64_t>((mask >> i) & 1))};
+                lane >>= 8 * shift;
+                for (size_t j{0}; j < n; ++j, lane >>= 8)
+                    output[j] = static_cast<unsigned char>(lane);
+                offset += n;
+                output += n;
+                len -= n;
+            }
+        }
+
+        // ------------------------------------------------------------------
+        // --- scalar permutation -------------------------------------------
+
+        /**
+         * @brief Keccak-f[1600] on the lanes, complemented as SHA3_ROUND expects. Two rounds per
+         * iteration, from `s` to `e` and back, save the copy of the lanes after each round.
+         */
+        HASHLIBCXX_INLINE void permute(uint64_t (&a)[25]) noexcept
+        {
+            uint64_t s[25];
+            uint64_t e[25];
+            std::memcpy(s, a, sizeof(s));
+            for (size_t i{0}; i < 24; i += 2)
+            {
+                SHA3_ROUND(s, e, s_round_constants[i])
+                SHA3_ROUND(e, s, s_round_constants[i + 1])
+            }
+            std::memcpy(a, s, sizeof(s));
+        }
+
+        // ------------------------------------------------------------------
+        // --- sponge -------------------------------------------------------
+
+        HASHLIBCXX_INLINE void init(state_t & state) noexcept
+        {
+            state = state_t{};
+            for (size_t i{0}; i < 25; ++i)
+                state.a[i] = 0 - static_cast<uint64_t>((s_complemented >> i) & 1);
+        }
+
+        HASHLIBCXX_INLINE void absorb(state_t & state,
+                                      size_t rate,
+                                      const unsigned char * message,
+                                      size_t len) noexcept
+        {
+            state.tot_len += len;
+
+            while (len > 0)
+            {
+                if (state.len == 0 && len >= rate)
+                {
+                    // a whole block straight from the message
+                    for (size_t i{0}; i < rate / 8; ++i)
+                        state.a[i] ^= load64(message + 8 * i);
+                    message += rate;
+                    len -= rate;
+                    permute(state.a);
+                    continue;
+                }
+
+                const size_t n{rate - state.len < len ? rate - state.len : len};
+                for (size_t j{0}; j < n; ++j, ++state.len)
+                {
+                    const uint64_t byte{message[j]};
+                    state.a[state.len / 8] ^= byte << (8 * (state.len % 8));
+                }
+                message += n;
+                len -= n;
+                if (state.len == rate)
+                {
+                    permute(state.a);
+                    state.len = 0;
+                }
+            }
+        }
+
+        /**
+         * @brief Pads the message and starts the squeezing phase.
+         */
+        HASHLIBCXX_INLINE void pad(state_t & state, size_t rate, unsigned char suffix) noexcept
+        {
+            state.a[state.len / 8] ^= static_cast<uint64_t>(suffix) << (8 * (state.len % 8));
+            state.a[(rate - 1) / 8] ^= static_cast<uint64_t>(0x80) << (8 * ((rate - 1) % 8));
+            permute(state.a);
+            state.len = 0;
+            state.squeezing = true;
+        }
+
+        /**
+         * @brief Writes the next `len` bytes of the output straight from the lanes.
+         */
+        HASHLIBCXX_INLINE void squeeze(state_t & state,
+                                       size_t rate,
+                                       unsigned char * output,
+                                       size_t len) noexcept
+        {
+            while (len > 0)
+            {
+                if (state.len == rate)
+                {
+                    permute(state.a);
+                    state.len = 0;
+                }
+                const size_t n{rate - state.len < len ? rate - state.len : len};
+                extract(state.a, s_complemented, state.len, output, n);
+                state.len += n;
+                output += n;
+                len -= n;
+            }
+        }
+
+        // ------------------------------------------------------------------
+        // --- multi-buffer -------------------------------------------------
+
+#if defined(HASHLIBCXX_SHA3_SIMD)
+        // The batch states are transposed: s[i][lane] is the lane i of the state of the message
+        // hashed by `lane`, so that W states fill the W 64-bit elements of a register. As in
+        // hash_blake2.cpp the kernel is written with the vector extensions of the compiler, the
+        // AVX-512 build turning the rotations into vprolq. The lanes are not complemented: AVX2
+        // has an and-not and AVX-512 a ternary logic instruction.
+
+        typedef uint64_t vec4x64_t __attribute__((vector_size(32)));
+        typedef uint64_t vec8x64_t __attribute__((vector_size(64)));
+
+#    if defined(SHA3_ROUND_LANES)
+#        undef SHA3_ROUND_LANES
+#    endif
+#    define SHA3_ROUND_LANES(A, E, rc)                                                             \
+    {                                                                                              \
+        const TVec c0{A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20]};                                        \
+        const TVec c1{A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21]};                                        \
+        const TVec c2{A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22]};                                        \
+        const TVec c3{A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23]};                                        \
+        const TVec c4{A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24]};                                        \
+        const TVec d0{c4 ^ SHA3_ROTL(c1, 1)};                                                      \
+        const TVec d1{c0 ^ SHA3_ROTL(c2, 1)};                                                      \
+        const TVec d2{c1 ^ SHA3_ROTL(c3, 1)};                                                      \
+        const TVec d3{c2 ^ SHA3_ROTL(c4, 1)};                                                      \
+        const TVec d4{c3 ^ SHA3_ROTL(c0, 1)};                                                      \
+        TVec b0, b1, b2, b3, b4;                                                                   \
+        b0 = A[0] ^ d0;                                                                            \
+        b1 = SHA3_ROTL(A[6] ^ d1, 44);                                                             \
+        b2 = SHA3_ROTL(A[12] ^ d2, 43);                                                            \
+        b3 = SHA3_ROTL(A[18] ^ d3, 21);                                                            \
+        b4 = SHA3_ROTL(A[24] ^ d4, 14);                                                            \
+        E[0] = b0 ^ (~b1 & b2) ^ (rc);                                                             \
+        E[1] = b1 ^ (~b2 & b3);                                                                    \
+        E[2] = b2 ^ (~b3 & b4);                                                                    \
+        E[3] = b3 ^ (~b4 & b0);                                                                    \
+        E[4] = b4 ^ (~b0 & b1);                                                                    \
+        b0 = SHA3_ROTL(A[3] ^ d3, 28);                                                             \
+        b1 = SHA3_ROTL(A[9] ^ d4, 20);                                                             \
+        b2 = SHA3_ROTL(A[10] ^ d0, 3);                                                             \
+        b3 = SHA3_ROTL(A[16] ^ d1, 45);                                                            \
+        b4 = SHA3_ROTL(A[22] ^ d2, 61);                                                            \
+        E[5] = b0 ^ (~b1 & b2);                                                                    \
+        E[6] = b1 ^ (~b2 & b3);                                                                    \
+        E[7] = b2 ^ (~b3 & b4);                                                                    \
+        E[8] = b3 ^ (~b4 & b0);                                                                    \
+        E[9] = b4 ^ (~b0 & b1);                                                                    \
+        b0 = SHA3_ROTL(A[1] ^ d1, 1);                                                              \
+        b1 = SHA3_ROTL(A[7] ^ d2, 6);                                                              \
+        b2 = SHA3_ROTL(A[13] ^ d3, 25);                                                            \
+        b3 = SHA3_ROTL(A[19] ^ d4, 8);                                                             \
+        b4 = SHA3_ROTL(A[20] ^ d0, 18);                                                            \
+        E[10] = b0 ^ (~b1 & b2);                                                                   \
+        E[11] = b1 ^ (~b2 & b3);                                                                   \
+        E[12] = b2 ^ (~b3 & b4);                                                                   \
+        E[13] = b3 ^ (~b4 & b0);                                                                   \
+        E[14] = b4 ^ (~b0 & b1);                                                                   \
+        b0 = SHA3_ROTL(A[4] ^ d4, 27);                                                             \
+        b1 = SHA3_ROTL(A[5] ^ d0, 36);                                                             \
+        b2 = SHA3_ROTL(A[11] ^ d1, 10);                                                            \
+        b3 = SHA3_ROTL(A[17] ^ d2, 15);                                                            \
+        b4 = SHA3_ROTL(A[23] ^ d3, 56);                                                            \
+        E[15] = b0 ^ (~b1 & b2);                                                                   \
+        E[16] = b1 ^ (~b2 & b3);                                                                   \
+        E[17] = b2 ^ (~b3 & b4);                                                                   \
+        E[18] = b3 ^ (~b4 & b0);                                                                   \
+        E[19] = b4 ^ (~b0 & b1);                                                                   \
+        b0 = SHA3_ROTL(A[2] ^ d2, 62);                                                             \
+        b1 = SHA3_ROTL(A[8] ^ d3, 55);                                                             \
+        b2 = SHA3_ROTL(A[14] ^ d4, 39);                                                            \
+        b3 = SHA3_ROTL(A[15] ^ d0, 41);                                                            \
+        b4 = SHA3_ROTL(A[21] ^ d1, 2);                                                             \
+        E[20] = b0 ^ (~b1 & b2);                                                                   \
+        E[21] = b1 ^ (~b2 & b3);                                                                   \
+        E[22] = b2 ^ (~b3 & b4);                                                                   \
+        E[23] = b3 ^ (~b4 & b0);                                                                   \
+        E[24] = b4 ^ (~b0 & b1);                                                                   \
+    }
+
+        template<class TVec, size_t W>
+        __attribute__((always_inline)) inline void permute_lanes(uint64_t (&s)[25][W]) noexcept
+        {
+            static_assert(sizeof(TVec) == W * sizeof(uint64_t), "a state per element");
+
+            TVec a[25];
+            TVec e[25];
+            std::memcpy(a, s, sizeof(a));
+            for (size_t i{0}; i < 24; i += 2)
+            {
+                SHA3_ROUND_LANES(a, e, s_round_constants[i])
+                SHA3_ROUND_LANES(e, a, s_round_constants[i + 1])
+            }
+            std::memcpy(s, a, sizeof(a));
+        }
+
+        __attribute__((target("avx2"))) HASHLIBCXX_INLINE void
+        permute_4_avx2(uint64_t (&s)[25][4]) noexcept
+        {
+            permute_lanes<vec4x64_t, 4>(s);
+        }
+
+        __attribute__((target("avx512f"))) HASHLIBCXX_INLINE void
+        permute_8_avx512(uint64_t (&s)[25][8]) noexcept
+        {
+            permute_lanes<vec8x64_t, 8>(s);
+        }
+
+        HASHLIBCXX_INLINE bool has_avx2() noexcept
+        {
+            static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+            return avx2;
+        }
+
+        HASHLIBCXX_INLINE bool has_avx512() noexcept
+        {
+            static const bool avx512{__builtin_cpu_supports("avx512f") != 0};
+            return avx512;
+        }
+
+        /**
+         * @brief Hashes the messages W at a time. Each iteration absorbs a block of the message
+         * of every busy lane, its padded last block included, and permutes all the states at
+         * once; the lanes whose message is complete write its digest and take the next one.
+         */
+        template<size_t W>
+        HASHLIBCXX_INLINE void hash_lanes(void (*permute_w)(uint64_t (&)[25][W]),
+                                          const unsigned char * const * messages,
+                                          const size_t * sizes,
+                                          size_t count,
+                                          size_t rate,
+                                          unsigned char suffix,
+                                          unsigned char * digests,
+                                          size_t digest_size,
+                                          size_t stride) noexcept
+        {
+            uint64_t s[25][W]{};
+            size_t message[W]; // the index of the message of each lane, `count` if idle
+            size_t offset[W];  // the bytes of the message absorbed by each lane
+            size_t next{0};
+            size_t busy{0};
+            for (size_t lane{0}; lane < W; ++lane)
+            {
+                message[lane] = next < count ? next++ : count;
+                offset[lane] = 0;
+                busy += message[lane] < count ? 1 : 0;
+            }
+
+            while (busy > 0)
+            {
+                for (size_t lane{0}; lane < W; ++lane)
+                {
+                    if (message[lane] == count)
+                        continue;
+                    const unsigned char * data{messages[message[lane]] + offset[lane]};
+                    const size_t left{sizes[message[lane]] - offset[lane]};
+                    if (left >= rate)
+                    {
+                        for (size_t i{0}; i < rate / 8; ++i)
+                            s[i][lane] ^= load64(data + 8 * i);
+                    }
+                    else
+                    {
+                        unsigned char block[200]{};
+                        if (left > 0)
+                            std::memcpy(block, data, left);
+                        block[left] ^= suffix;
+                        block[rate - 1] ^= 0x80;
+                        for (size_t i{0}; i < rate / 8; ++i)
+                            s[i][lane] ^= load64(block + 8 * i);
+                    }
+                    // past the end of the message once the padded block is absorbed
+                    offset[lane] += rate;
+                }
+
+                permute_w(s);
+
+                for (size_t lane{0}; lane < W; ++lane)
+                {
+                    if (message[lane] == count || offset[lane] <= sizes[message[lane]])
+                        continue;
+                    uint64_t lanes[25];
+                    for (size_t i{0}; i < 25; ++i)
+                    {
+                        lanes[i] = s[i][lane];
+                        s[i][lane] = 0;
+                    }
+                    extract(lanes, 0, 0, digests + message[lane] * stride, digest_size);
+
+                    message[lane] = next < count ? next++ : count;
+                    offset[lane] = 0;
+                    busy -= message[lane] < count ? 0 : 1;
+                }
+            }
+        }
+#endif
+
+        HASHLIBCXX_INLINE void hash_batch(const unsigned char * const * messages,
+                                          const size_t * sizes,
+                                          size_t count,
+                                          size_t rate,
+                                          unsigned char suffix,
+                                          unsigned char * digests,
+                                          size_t digest_size,
+                                          size_t stride) noexcept
+        {
+            HASHLIBCXX_ASSERT(count == 0 || (messages && sizes && digests));
+            HASHLIBCXX_ASSERT(rate % 8 == 0 && rate < 200 && digest_size <= rate);
+
+#if defined(HASHLIBCXX_SHA3_SIMD)
+            if (count > 1 && has_avx512())
+            {
+                return hash_lanes<8>(permute_8_avx512, messages, sizes, count, rate, suffix,
+                                     digests, digest_size, stride);
+            }
+            if (count > 1 && has_avx2())
+            {
+                return hash_lanes<4>(permute_4_avx2, messages, sizes, count, rate, suffix,
+                                     digests, digest_size, stride);
+            }
+#endif
+            for (size_t n{0}; n < count; ++n)
+            {
+                state_t state;
+                init(state);
+                absorb(state, rate, messages[n], sizes[n]);
+                pad(state, rate, suffix);
+                squeeze(state, rate, digests + n * stride, digest_size);
+            }
+        }
+
+        /**
+         * @brief Writes the `size` bytes of a hash in hex, followed by \0.
+         */
+        HASHLIBCXX_INLINE void to_printable(const unsigned char * digest,
+                                            size_t size,
+                                            char * digest_printable) noexcept
+        {
+            static constexpr char digits[]{"0123456789abcdef"};
+            for (size_t i{0}; i < size; ++i)
+            {
+                digest_printable[2 * i] = digits[digest[i] >> 4];
+                digest_printable[2 * i + 1] = digits[digest[i] & 0x0f];
+            }
+            digest_printable[2 * size] = '\0';
+        }
+
+    } // namespace sha3_impl
+
+    // ------------------------------------------------------------------
+    // --- sha3_224 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void sha3_224::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void sha3_224::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void sha3_224::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void sha3_224::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE uint64_t sha3_224::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+    // ------------------------------------------------------------------
+    // --- sha3_256 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void sha3_256::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void sha3_256::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void sha3_256::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void sha3_256::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE uint64_t sha3_256::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+    // ------------------------------------------------------------------
+    // --- sha3_384 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void sha3_384::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void sha3_384::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void sha3_384::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void sha3_384::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE uint64_t sha3_384::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+    // ------------------------------------------------------------------
+    // --- sha3_512 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void sha3_512::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void sha3_512::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void sha3_512::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void sha3_512::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE uint64_t sha3_512::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+    // ------------------------------------------------------------------
+    // --- shake128 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void shake128::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void shake128::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void shake128::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+        HASHLIBCXX_ASSERT(!m_state.squeezing);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void shake128::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+        HASHLIBCXX_ASSERT(!m_state.squeezing);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE void shake128::squeeze(unsigned char * output, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(output || len == 0);
+
+        if (!m_state.squeezing)
+            sha3_impl::pad(m_state, s_block_size, s_suffix);
+        sha3_impl::squeeze(m_state, s_block_size, output, len);
+    }
+
+    HASHLIBCXX_INLINE uint64_t shake128::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+    // ------------------------------------------------------------------
+    // --- shake256 -----------------------------------------------------
+
+    HASHLIBCXX_INLINE void shake256::hash_printable(const unsigned char * message,
+                                                        size_t len,
+                                                        char * digest_printable) noexcept
+    {
+        HASHLIBCXX_ASSERT(digest_printable);
+
+        unsigned char digest[s_digest_size]{};
+        hash(message, len, digest);
+        sha3_impl::to_printable(digest, s_digest_size, digest_printable);
+    }
+
+    HASHLIBCXX_INLINE void shake256::init() noexcept
+    {
+        sha3_impl::init(m_state);
+    }
+
+    HASHLIBCXX_INLINE void shake256::update(const unsigned char * message, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(message);
+        HASHLIBCXX_ASSERT(!m_state.squeezing);
+
+        sha3_impl::absorb(m_state, s_block_size, message, len);
+    }
+
+    HASHLIBCXX_INLINE void shake256::complete(unsigned char * digest) const noexcept
+    {
+        HASHLIBCXX_ASSERT(digest);
+        HASHLIBCXX_ASSERT(!m_state.squeezing);
+
+        sha3_impl::state_t state{m_state};
+        sha3_impl::pad(state, s_block_size, s_suffix);
+        sha3_impl::squeeze(state, s_block_size, digest, s_digest_size);
+    }
+
+    HASHLIBCXX_INLINE void shake256::squeeze(unsigned char * output, size_t len) noexcept
+    {
+        HASHLIBCXX_ASSERT(output || len == 0);
+
+        if (!m_state.squeezing)
+            sha3_impl::pad(m_state, s_block_size, s_suffix);
+        sha3_impl::squeeze(m_state, s_block_size, output, len);
+    }
+
+    HASHLIBCXX_INLINE uint64_t shake256::processed_size() const noexcept
+    {
+        return m_state.tot_len;
+    }
+
+} // namespace hashkitcxx
+
+// in header-only mode this file is included by hash_sha3.hpp: do not leak the macros to the user
+#undef HASHLIBCXX_SHA3_SIMD
+#undef HASHLIBCXX_ASSERT
+#undef HASHLIBCXX_INLINE
+#undef SHA3_ROTL
+#undef SHA3_ROUND
+#undef SHA3_ROUND_LANES
@@ -0,0 +1,1493 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions
+ * (FIPS PUB 202)
+ * Category of Standard: Computer Security Standard, Cryptography
+ * Date Published: August 2015
+ * Author(s): National Institute of Standards and Technology
+ * Resource link: https://csrc.nist.gov/publications/detail/fips/202/final
+ *
+ * Lane complementing: Keccak implementation overview, section 2.2,
+ * https://keccak.team/files/Keccak-implementation-3.2.pdf
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#if defined(HASHLIBCXX_STD_STRING)
+#    include <string>
+#endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
+
+// The algorithm does not depend on sha2, so this header does not include hash_sha2.hpp
+#if defined(HASHLIBCXX_DLL)
+#    undef HASHLIBCXX_DLL
+#endif
+#if defined(hashlibcxx_library_EXPORTS)
+#    define HASHLIBCXX_DLL __declspec(dllexport)
+#else
+#    define HASHLIBCXX_DLL
+#endif
+
+namespace hashkitcxx {
+    namespace sha3_impl {
+
+        /**
+         * @brief The state of a sponge: the 25 lanes of Keccak-f[1600], 6 of them stored
+         * complemented (see hash_sha3.cpp), and the position in the current block.
+         */
+        struct state_t
+        {
+            uint64_t a[25]{};      /**< The lanes, a[x + 5 * y] */
+            uint64_t tot_len{0};   /**< Bytes absorbed */
+            size_t len{0};         /**< Bytes absorbed in, or squeezed from, the current block */
+            bool squeezing{false}; /**< Whether the output is being squeezed */
+        };
+
+        /**
+         * @brief The core of sha3_hash_batch(), see there.
+         * @param rate the size of a block of the sponge.
+         * @param suffix the domain separation bits followed by the first padding bit.
+         * @param digests receives the `digest_size` bytes of each digest, one every `stride`
+         * bytes.
+         */
+        HASHLIBCXX_DLL void hash_batch(const unsigned char * const * messages,
+                                       const size_t * sizes,
+                                       size_t count,
+                                       size_t rate,
+                                       unsigned char suffix,
+                                       unsigned char * digests,
+                                       size_t digest_size,
+                                       size_t stride) noexcept;
+
+    } // namespace sha3_impl
+
+    // ------------------------------------------------------------------
+    // --- sha3_224 -----------------------------------------------------
+
+    /**
+     * @brief SHA3-224, whose sponge absorbs the message 144 bytes at a time.
+     */
+    class HASHLIBCXX_DLL sha3_224 final
+    {
+      public:
+        static constexpr size_t s_block_size{144};     /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x06}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            224 / 8}; /**< Size expressed in byte of the resulting hash */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        sha3_224() = default;
+        ~sha3_224() {}
+        sha3_224(sha3_224 &&) = default;
+        sha3_224(const sha3_224 &) = default;
+        sha3_224 & operator=(sha3_224 &&) = default;
+        sha3_224 & operator=(const sha3_224 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the `s_digest_size` bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    // ------------------------------------------------------------------
+    // --- sha3_256 -----------------------------------------------------
+
+    /**
+     * @brief SHA3-256, whose sponge absorbs the message 136 bytes at a time.
+     */
+    class HASHLIBCXX_DLL sha3_256 final
+    {
+      public:
+        static constexpr size_t s_block_size{136};     /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x06}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            256 / 8}; /**< Size expressed in byte of the resulting hash */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        sha3_256() = default;
+        ~sha3_256() {}
+        sha3_256(sha3_256 &&) = default;
+        sha3_256(const sha3_256 &) = default;
+        sha3_256 & operator=(sha3_256 &&) = default;
+        sha3_256 & operator=(const sha3_256 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the `s_digest_size` bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    // ------------------------------------------------------------------
+    // --- sha3_384 -----------------------------------------------------
+
+    /**
+     * @brief SHA3-384, whose sponge absorbs the message 104 bytes at a time.
+     */
+    class HASHLIBCXX_DLL sha3_384 final
+    {
+      public:
+        static constexpr size_t s_block_size{104};     /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x06}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            384 / 8}; /**< Size expressed in byte of the resulting hash */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        sha3_384() = default;
+        ~sha3_384() {}
+        sha3_384(sha3_384 &&) = default;
+        sha3_384(const sha3_384 &) = default;
+        sha3_384 & operator=(sha3_384 &&) = default;
+        sha3_384 & operator=(const sha3_384 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the `s_digest_size` bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    // ------------------------------------------------------------------
+    // --- sha3_512 -----------------------------------------------------
+
+    /**
+     * @brief SHA3-512, whose sponge absorbs the message 72 bytes at a time.
+     */
+    class HASHLIBCXX_DLL sha3_512 final
+    {
+      public:
+        static constexpr size_t s_block_size{72};      /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x06}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            512 / 8}; /**< Size expressed in byte of the resulting hash */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        sha3_512() = default;
+        ~sha3_512() {}
+        sha3_512(sha3_512 &&) = default;
+        sha3_512(const sha3_512 &) = default;
+        sha3_512 & operator=(sha3_512 &&) = default;
+        sha3_512 & operator=(const sha3_512 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(). The state is
+         * not modified: more parts can be added and complete() called again.
+         * @param digest pointer to the memory location to store the `s_digest_size` bytes of the
+         * hash.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    // ------------------------------------------------------------------
+    // --- shake128 -----------------------------------------------------
+
+    /**
+     * @brief SHAKE128, the extendable-output function of security strength 128 bits: complete()
+     * returns the first 32 bytes of the output, squeeze() any number of bytes.
+     */
+    class HASHLIBCXX_DLL shake128 final
+    {
+      public:
+        static constexpr size_t s_block_size{168};     /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x1f}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            256 / 8}; /**< Size expressed in byte of the default output, see squeeze() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        shake128() = default;
+        ~shake128() {}
+        shake128(shake128 &&) = default;
+        shake128(const shake128 &) = default;
+        shake128 & operator=(shake128 &&) = default;
+        shake128 & operator=(const shake128 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(), writing the
+         * first `s_digest_size` bytes of the output. The state is not modified: more parts can be
+         * added and complete() called again.
+         * @param digest pointer to the memory location to store the output.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Writes the next `len` bytes of the output, which is as long as needed: the
+         * first call completes the hash computation, the next ones continue the output where the
+         * previous one stopped. No part can be added by update() after it.
+         * @param output pointer to the memory location to store the output.
+         * @param len the length of `output` expressed in bytes.
+         */
+        void squeeze(unsigned char * output, size_t len) noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    // ------------------------------------------------------------------
+    // --- shake256 -----------------------------------------------------
+
+    /**
+     * @brief SHAKE256, the extendable-output function of security strength 256 bits: complete()
+     * returns the first 64 bytes of the output, squeeze() any number of bytes.
+     */
+    class HASHLIBCXX_DLL shake256 final
+    {
+      public:
+        static constexpr size_t s_block_size{136};     /**< Size expressed in byte of a block */
+        static constexpr unsigned char s_suffix{0x1f}; /**< Domain and first padding bits */
+        static constexpr size_t s_digest_size{
+            512 / 8}; /**< Size expressed in byte of the default output, see squeeze() for more */
+
+        using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+        using digest_printable_t =
+            std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+      public:
+        shake256() = default;
+        ~shake256() {}
+        shake256(shake256 &&) = default;
+        shake256(const shake256 &) = default;
+        shake256 & operator=(shake256 &&) = default;
+        shake256 & operator=(const shake256 &) = default;
+
+#if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string_view message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.data()),
+                                  message.size());
+        }
+#    else
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(std::string && message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash. The string is not copied.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const std::string & message)
+        {
+            return hash_printable(reinterpret_cast<const unsigned char *>(message.c_str()),
+                                  message.size());
+        }
+#    endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a string containing the hash of `message` in hex.
+         */
+        inline std::string hash_printable(const unsigned char * message, size_t len)
+        {
+            char digest_printable[2 * s_digest_size + 1]{};
+            hash_printable(message, len, digest_printable);
+            return std::string(digest_printable);
+        }
+
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. This function takes a string in input so the message
+         * cannot contain \0 characters in the middle.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string && message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash. The string is not copied.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const std::string & message, unsigned char * digest)
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.c_str()),
+                 message.size(),
+                 digest);
+        }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message the text to hash.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(std::string_view message) noexcept
+        {
+            return hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                        message.size());
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(std::string_view message, unsigned char * digest) noexcept
+        {
+            hash(reinterpret_cast<const unsigned char *>(message.data()),
+                 message.size(),
+                 digest);
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message the text to hash.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(std::string_view message) noexcept
+        {
+            return hash(reinterpret_cast<const unsigned char *>(message.data()),
+                        message.size());
+        }
+#endif
+
+        /**
+         * @brief Returns the hash of the given input in hex format without allocating memory.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return a \0 terminated array containing the hash of `message` in hex.
+         */
+        inline digest_printable_t hash_printable_array(const unsigned char * message,
+                                                       size_t len) noexcept
+        {
+            digest_printable_t digest_printable;
+            hash_printable(message, len, digest_printable.data());
+            digest_printable[2 * s_digest_size] = '\0';
+            return digest_printable;
+        }
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @return an array containing the hash of `message`.
+         */
+        inline digest_t hash(const unsigned char * message, size_t len) noexcept
+        {
+            digest_t digest;
+            hash(message, len, digest.data());
+            return digest;
+        }
+
+        /**
+         * @brief Returns the hash of the given input in hex format.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest_printable pointer to the memory location to store the hash of `message`
+         * in hex.
+         */
+        void hash_printable(const unsigned char * message,
+                            size_t len,
+                            char * digest_printable) noexcept;
+
+        /**
+         * @brief Returns the hash of the given input.
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the total length of `message` expressed in bytes.
+         * @param digest pointer to the memory location to store the hash of `message`.
+         */
+        inline void hash(const unsigned char * message,
+                         size_t len,
+                         unsigned char * digest) noexcept
+        {
+            init();
+            update(message, len);
+            complete(digest);
+        }
+
+        /**
+         * @brief Starts a new hash computation, discarding any data given to update() so far.
+         * Together with update() and complete() it allows to hash a message provided in parts.
+         */
+        void init() noexcept;
+
+        /**
+         * @brief Adds the given part of the message to the hash computation started by init().
+         * @param message pointer to the memory location containing the byte-array to hash.
+         * @param len the length of `message` expressed in bytes.
+         */
+        void update(const unsigned char * message, size_t len) noexcept;
+
+        /**
+         * @brief Completes the hash computation of all the parts given to update(), writing the
+         * first `s_digest_size` bytes of the output. The state is not modified: more parts can be
+         * added and complete() called again.
+         * @param digest pointer to the memory location to store the output.
+         */
+        void complete(unsigned char * digest) const noexcept;
+
+        /**
+         * @brief Writes the next `len` bytes of the output, which is as long as needed: the
+         * first call completes the hash computation, the next ones continue the output where the
+         * previous one stopped. No part can be added by update() after it.
+         * @param output pointer to the memory location to store the output.
+         * @param len the length of `output` expressed in bytes.
+         */
+        void squeeze(unsigned char * output, size_t len) noexcept;
+
+        /**
+         * @brief Returns the number of bytes given to update() since init().
+         */
+        uint64_t processed_size() const noexcept;
+
+      private:
+        sha3_impl::state_t m_state; /**< The sponge */
+    };
+
+    /**
+     * @brief Hashes many independent messages with a sha3 or shake class. With AVX-512 the
+     * permutation runs on 8 states at a time, with AVX2 on 4, a message per lane: each lane takes
+     * the next message as soon as its own is complete, so the messages can have any length.
+     * Without them, the messages are hashed one at a time.
+     * @tparam THash one of the sha3 or shake classes (e.g. `sha3_256`).
+     * @param messages the messages.
+     * @param sizes the length of each message expressed in bytes.
+     * @param count the number of messages.
+     * @param digests receives the hash of each message.
+     */
+    template<class THash>
+    void sha3_hash_batch(const unsigned char * const * messages,
+                         const size_t * sizes,
+                         size_t count,
+                         typename THash::digest_t * digests) noexcept
+    {
+        if (count == 0)
+            return;
+        sha3_impl::hash_batch(messages,
+                              sizes,
+                              count,
+                              THash::s_block_size,
+                              THash::s_suffix,
+                              digests[0].data(),
+                              THash::s_digest_size,
+                              sizeof(typename THash::digest_t));
+    }
+
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_sha3.cpp"
+#endif
@@ -0,0 +1,256 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ----------------------------------------------------------------------------------
+ *
+ * Name of Standard: Secure Hash Standard (SHS) (FIPS PUB 180-4)
+ * Category of Standard: Computer Security Standard, Cryptography
+ * Date Published: August 2015
+ * Author(s): National Institute of Standards and Technology
+ * Resource link: https://csrc.nist.gov/publications/detail/fips/180/4/final
+ */
+
+#pragma once
+#include "hash_sha2.hpp"
+#include "hash_sha2_constexpr.hpp"
+#include "hash_sha2_core.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// This header requires C++14, as hash_sha2_constexpr.hpp: the initial hash value is computed by
+// the compiler.
+
+namespace hashkitcxx {
+    namespace sha2 {
+
+        namespace constexpr_impl {
+
+            /**
+             * @brief The SHA-512/t IV generation function of FIPS 180-4 (5.3.6): the sha-512 of
+             * the string "SHA-512/t", starting from the sha-512 h0 xored with 0xa5a5...
+             */
+            template<size_t T>
+            constexpr std::array<uint64_t, 8> sha512_t_h0() noexcept
+            {
+                uint64_t h[8]{};
+                for (size_t i{0}; i < 8; ++i)
+                {
+                    h[i] = sha512_h0[i] ^ 0xa5a5a5a5a5a5a5a5ULL;
+                }
+
+                // the name fits in a single block: 8 characters and at most 3 digits
+                uint8_t block[traits<sha512>::s_block_size]{'S', 'H', 'A', '-', '5', '1', '2', '/'};
+                size_t len{8};
+                for (size_t t{T}; t > 0; t /= 10)
+                {
+                    ++len;
+                }
+                size_t t{T};
+                for (size_t i{len}; i > 8; --i, t /= 10)
+                {
+                    block[i - 1] = static_cast<uint8_t>('0' + t % 10);
+                }
+                block[len] = 0x80;
+                block[sizeof(block) - 1] = static_cast<uint8_t>(len * 8);
+
+                transform<sha512>(h, block);
+                return to_array(h, std::make_index_sequence<8>{});
+            }
+
+        } // namespace constexpr_impl
+
+        /**
+         * @brief SHA-512/t, the sha-512 computation truncated to `T` bits, for any truncation
+         * besides the sha512_224 and sha512_256 classes (e.g. `sha512_t<160>` for short keys).
+         *
+         * The initial hash value is derived from `T` at compile time, and complete() writes the
+         * `T / 8` bytes of the digest directly from the hash value: a truncation costs the same as
+         * a sha-512. The state cannot be saved, load() and save() are only available in the
+         * classes of the standard algorithms.
+         * @tparam T the size of the digest in bits, a multiple of 8 lower than 512 and different
+         * from 384, as required by FIPS 180-4.
+         */
+        template<size_t T>
+        class sha512_t final
+        {
+            static_assert(T > 0 && T < 512 && T % 8 == 0 && T != 384,
+                          "SHA-512/t is defined for t < 512, t != 384, and t is a number of bytes");
+
+          public:
+            static constexpr size_t s_digest_size{
+                T / 8}; /**< Size expressed in byte of the resulting hash */
+            static constexpr std::array<uint64_t, 8> s_h0{
+                constexpr_impl::sha512_t_h0<T>()}; /**< Initial hash value, derived from T */
+
+            using digest_t = std::array<unsigned char, s_digest_size>; /**< The resulting hash */
+            using digest_printable_t =
+                std::array<char, 2 * s_digest_size + 1>; /**< The resulting hash in hex */
+
+          public:
+            sha512_t() : m_sha512{s_h0} {}
+
+            /**
+             * @brief Returns the hash of the given input in hex format without allocating memory.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return a \0 terminated array containing the hash of `message` in hex.
+             */
+            digest_printable_t hash_printable_array(const unsigned char * message,
+                                                    size_t len) noexcept
+            {
+                digest_printable_t digest_printable;
+                hash_printable(message, len, digest_printable.data());
+                return digest_printable;
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @return an array containing the hash of `message`.
+             */
+            digest_t hash(const unsigned char * message, size_t len) noexcept
+            {
+                digest_t digest;
+                hash(message, len, digest.data());
+                return digest;
+            }
+
+            /**
+             * @brief Returns the hash of the given input in hex format.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @param digest_printable pointer to the memory location to store the hash of `message`
+             * in hex, followed by \0.
+             */
+            void hash_printable(const unsigned char * message,
+                                size_t len,
+                                char * digest_printable) noexcept
+            {
+                constexpr char digits[]{"0123456789abcdef"};
+
+                unsigned char digest[s_digest_size];
+                hash(message, len, digest);
+                for (size_t i{0}; i < s_digest_size; ++i)
+                {
+                    digest_printable[2 * i] = digits[digest[i] >> 4];
+                    digest_printable[2 * i + 1] = digits[digest[i] & 0x0f];
+                }
+                digest_printable[2 * s_digest_size] = '\0';
+            }
+
+            /**
+             * @brief Returns the hash of the given input.
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the total length of `message` expressed in bytes.
+             * @param digest pointer to the memory location to store the hash of `message`.
+             */
+            void hash(const unsigned char * message, size_t len, unsigned char * digest) noexcept
+            {
+                init();
+                update(message, len);
+                complete(digest);
+            }
+
+            /**
+             * @brief Starts a new hash computation, discarding any data given to update() so far.
+             * Together with update() and complete() it allows to hash a message provided in parts.
+             */
+            void init() noexcept { m_sha512.init(probe_sha512_t); }
+
+            /**
+             * @brief Adds the given part of the message to the hash computation started by init().
+             * @param message pointer to the memory location containing the byte-array to hash.
+             * @param len the length of `message` expressed in bytes.
+             */
+            void update(const unsigned char * message, size_t len) noexcept
+            {
+                m_sha512.update(message, len, probe_sha512_t);
+            }
+
+            /**
+             * @brief Completes the hash computation of all the parts given to update().
+             * @param digest pointer to the memory location to store the `s_digest_size` bytes of
+             * the hash.
+             */
+            void complete(unsigned char * digest) noexcept
+            {
+                m_sha512.complete_truncated(digest, s_digest_size, probe_sha512_t);
+            }
+
+            /**
+             * @brief Returns the number of bytes given to update() since init().
+             */
+            uint64_t processed_size() const noexcept { return m_sha512.processed_size(); }
+
+            /**
+             * @brief Applies the compression function to consecutive blocks, updating the hash
+             * value: the core of update(), for the engines keeping the state of many hashes outside
+             * of the class (see hash_sha2_pool.hpp).
+             * @param h the 8 words of the hash value.
+             * @param blocks pointer to the memory location containing the blocks.
+             * @param block_nb the number of blocks.
+             */
+            static void compress(uint64_t * h,
+                                 const unsigned char * blocks,
+                                 size_t block_nb) noexcept
+            {
+                sha512::compress(h, blocks, block_nb, probe_sha512_t);
+            }
+
+          private:
+            sha512 m_sha512; /**< Computes the sha-512 hash, started from the sha-512/t h0 */
+        };
+
+        template<size_t T>
+        constexpr size_t sha512_t<T>::s_digest_size;
+        template<size_t T>
+        constexpr std::array<uint64_t, 8> sha512_t<T>::s_h0;
+
+        template<size_t T>
+        struct traits<sha512_t<T>>
+        {
+            using word_t = uint64_t;
+            static constexpr size_t s_block_size{1024 / 8};
+            static constexpr size_t s_rounds{80};
+            static constexpr const std::array<uint64_t, 8> & h0() noexcept
+            {
+                return sha512_t<T>::s_h0;
+            }
+        };
+
+        template<size_t T>
+        constexpr size_t traits<sha512_t<T>>::s_block_size;
+        template<size_t T>
+        constexpr size_t traits<sha512_t<T>>::s_rounds;
+
+    } // namespace sha2
+} // namespace hashkitcxx
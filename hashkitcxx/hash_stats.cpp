@@ -0,0 +1,202 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hash_stats.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#if defined(HASHLIBCXX_INLINE)
+#    undef HASHLIBCXX_INLINE
+#endif
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    define HASHLIBCXX_INLINE inline
+#else
+#    define HASHLIBCXX_INLINE
+#endif
+
+namespace hashkitcxx {
+    namespace stats {
+        namespace stats_impl {
+
+            struct thread_counters;
+
+            /**
+             * @brief The counters of the running threads, and the sum of the counters of the
+             * threads already terminated.
+             */
+            struct registry_t
+            {
+                std::mutex mutex;
+                std::vector<thread_counters *> threads;
+                uint64_t terminated[counter_count]{};
+                std::atomic<callback_t> callback{nullptr};
+                std::atomic<void *> context{nullptr};
+                std::atomic<uint64_t> interval{0};
+            };
+
+            HASHLIBCXX_INLINE registry_t & registry() noexcept
+            {
+                static registry_t r;
+                return r;
+            }
+
+            /**
+             * @brief The counters of a thread, registered while the thread runs.
+             */
+            struct thread_counters
+            {
+                std::atomic<uint64_t> values[counter_count];
+
+                thread_counters()
+                {
+                    for (std::atomic<uint64_t> & value : values)
+                        value.store(0, std::memory_order_relaxed);
+
+                    registry_t & r{registry()};
+                    std::lock_guard<std::mutex> lock{r.mutex};
+                    r.threads.push_back(this);
+                }
+
+                ~thread_counters()
+                {
+                    registry_t & r{registry()};
+                    std::lock_guard<std::mutex> lock{r.mutex};
+                    for (size_t i{0}; i < counter_count; ++i)
+                        r.terminated[i] += values[i].load(std::memory_order_relaxed);
+                    for (size_t i{0}; i < r.threads.size(); ++i)
+                    {
+                        if (r.threads[i] == this)
+                        {
+                            r.threads[i] = r.threads.back();
+                            r.threads.pop_back();
+                            break;
+                        }
+                    }
+                }
+
+                thread_counters(const thread_counters &) = delete;
+                thread_counters & operator=(const thread_counters &) = delete;
+            };
+
+            HASHLIBCXX_INLINE thread_counters & local() noexcept
+            {
+                thread_local thread_counters counters;
+                return counters;
+            }
+
+        } // namespace stats_impl
+
+        HASHLIBCXX_INLINE bool enabled() noexcept
+        {
+#if defined(HASHLIBCXX_INSTRUMENTATION)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        HASHLIBCXX_INLINE const char * name(counter c) noexcept
+        {
+            static constexpr const char * names[counter_count]{"sha256_blocks",
+                                                              "sha256_nanoseconds",
+                                                              "sha512_blocks",
+                                                              "sha512_nanoseconds",
+                                                              "lanes_sha256_blocks",
+                                                              "lanes_sha256_nanoseconds",
+                                                              "update_calls",
+                                                              "partial_updates",
+                                                              "staged_bytes",
+                                                              "complete_calls",
+                                                              "two_block_paddings"};
+            return c < counter_count ? names[c] : "";
+        }
+
+        HASHLIBCXX_INLINE snapshot_t snapshot() noexcept
+        {
+            stats_impl::registry_t & r{stats_impl::registry()};
+            snapshot_t s;
+            std::lock_guard<std::mutex> lock{r.mutex};
+            for (size_t i{0}; i < counter_count; ++i)
+                s.values[i] = r.terminated[i];
+            for (const stats_impl::thread_counters * thread : r.threads)
+            {
+                for (size_t i{0}; i < counter_count; ++i)
+                    s.values[i] += thread->values[i].load(std::memory_order_relaxed);
+            }
+            return s;
+        }
+
+        HASHLIBCXX_INLINE void reset() noexcept
+        {
+            stats_impl::registry_t & r{stats_impl::registry()};
+            std::lock_guard<std::mutex> lock{r.mutex};
+            for (size_t i{0}; i < counter_count; ++i)
+                r.terminated[i] = 0;
+            for (stats_impl::thread_counters * thread : r.threads)
+            {
+                // a concurrent add() of the thread may be lost, as any increment racing a reset
+                for (std::atomic<uint64_t> & value : thread->values)
+                    value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        HASHLIBCXX_INLINE void set_callback(callback_t callback,
+                                            void * context,
+                                            uint64_t interval) noexcept
+        {
+            stats_impl::registry_t & r{stats_impl::registry()};
+            r.callback.store(nullptr);
+            r.context.store(context);
+            r.interval.store(interval);
+            r.callback.store(interval > 0 ? callback : nullptr);
+        }
+
+        HASHLIBCXX_INLINE void add(counter c, uint64_t value) noexcept
+        {
+            std::atomic<uint64_t> & slot{stats_impl::local().values[c]};
+            const uint64_t total{slot.load(std::memory_order_relaxed) + value};
+            slot.store(total, std::memory_order_relaxed);
+
+            if (c != complete_calls)
+                return;
+            stats_impl::registry_t & r{stats_impl::registry()};
+            const callback_t callback{r.callback.load(std::memory_order_acquire)};
+            if (callback == nullptr)
+                return;
+            const uint64_t interval{r.interval.load(std::memory_order_relaxed)};
+            if (interval > 0 && total % interval == 0)
+                callback(snapshot(), r.context.load(std::memory_order_relaxed));
+        }
+
+    } // namespace stats
+} // namespace hashkitcxx
+
+#undef HASHLIBCXX_INLINE
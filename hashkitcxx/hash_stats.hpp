@@ -0,0 +1,161 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// This header is included by hash_sha2.cpp, so it does not include hash_sha2.hpp
+#if defined(HASHLIBCXX_DLL)
+#    undef HASHLIBCXX_DLL
+#endif
+#if defined(hashlibcxx_library_EXPORTS)
+#    define HASHLIBCXX_DLL __declspec(dllexport)
+#else
+#    define HASHLIBCXX_DLL
+#endif
+
+namespace hashkitcxx {
+    namespace stats {
+
+        /**
+         * @brief The counters of the instrumentation. The times are the wall-clock time spent in
+         * the compression functions, expressed in nanoseconds.
+         */
+        enum counter : unsigned
+        {
+            sha256_blocks,            /**< Blocks compressed by the sha-224/256 kernel */
+            sha256_nanoseconds,       /**< Time spent in the sha-224/256 kernel */
+            sha512_blocks,            /**< Blocks compressed by the sha-384/512 kernel */
+            sha512_nanoseconds,       /**< Time spent in the sha-384/512 kernel */
+            lanes_sha256_blocks,      /**< Blocks compressed by the 8-lane sha-256 kernel */
+            lanes_sha256_nanoseconds, /**< Time spent in the 8-lane sha-256 kernel */
+            update_calls,             /**< Calls of update() */
+            partial_updates,          /**< Calls of update() not filling the pending block */
+            staged_bytes,             /**< Bytes copied to the pending block by update() */
+            complete_calls,           /**< Calls of complete() */
+            two_block_paddings,       /**< Calls of complete() padding two blocks */
+            counter_count             /**< Number of counters */
+        };
+
+        /**
+         * @brief The value of every counter, summed over all the threads.
+         */
+        struct snapshot_t
+        {
+            uint64_t values[counter_count]{};
+
+            uint64_t operator[](counter c) const noexcept { return values[c]; }
+        };
+
+        /**
+         * @brief Function receiving the counters, see set_callback().
+         * @param snapshot the counters of all the threads.
+         * @param context the pointer given to set_callback().
+         */
+        using callback_t = void (*)(const snapshot_t & snapshot, void * context);
+
+        /**
+         * @brief Returns true if the library was built with the instrumentation
+         * (HASHLIBCXX_INSTRUMENTATION). Otherwise the hashing functions do not count anything and
+         * the counters stay at 0.
+         */
+        HASHLIBCXX_DLL bool enabled() noexcept;
+
+        /**
+         * @brief Returns the name of a counter, e.g. "sha256_blocks", to export it.
+         */
+        HASHLIBCXX_DLL const char * name(counter c) noexcept;
+
+        /**
+         * @brief Returns the counters summed over the running threads and the threads already
+         * terminated. The counters of a thread are read while it is running, so the sum is not
+         * taken at a single instant.
+         */
+        HASHLIBCXX_DLL snapshot_t snapshot() noexcept;
+
+        /**
+         * @brief Sets all the counters, of every thread, to 0.
+         */
+        HASHLIBCXX_DLL void reset() noexcept;
+
+        /**
+         * @brief Registers a function receiving snapshot() periodically, to export the counters
+         * to a metrics system: a thread calls it after every `interval` calls of complete() it
+         * makes. The function runs on the hashing thread, so it should only publish the values.
+         * @param callback the function, nullptr to remove it.
+         * @param context a pointer passed back to `callback`.
+         * @param interval the number of complete() between two calls, by each thread.
+         */
+        HASHLIBCXX_DLL void set_callback(callback_t callback,
+                                         void * context,
+                                         uint64_t interval) noexcept;
+
+        /**
+         * @brief Adds to a counter of the calling thread. The counters of a thread are only
+         * written by that thread, so this is a relaxed load and store, without locked instruction.
+         * The hashing functions call it when the library is built with the instrumentation.
+         */
+        HASHLIBCXX_DLL void add(counter c, uint64_t value) noexcept;
+
+        /**
+         * @brief Adds the time elapsed from its construction to its destruction to a counter.
+         */
+        class scoped_timer final
+        {
+          public:
+            explicit scoped_timer(counter c) noexcept
+                : m_counter{c}, m_start{std::chrono::steady_clock::now()}
+            {
+            }
+
+            ~scoped_timer()
+            {
+                const auto elapsed{std::chrono::steady_clock::now() - m_start};
+                add(m_counter,
+                    static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+
+            scoped_timer(const scoped_timer &) = delete;
+            scoped_timer & operator=(const scoped_timer &) = delete;
+
+          private:
+            counter m_counter;                                /**< Counter of the time */
+            std::chrono::steady_clock::time_point m_start;    /**< Construction time */
+        };
+
+    } // namespace stats
+} // namespace hashkitcxx
+
+#if defined(HASHLIBCXX_HEADER_ONLY)
+#    include "hash_stats.cpp"
+#endif
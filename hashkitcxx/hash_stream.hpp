@@ -0,0 +1,309 @@
+/*
+ * HashKitCXX
+ *
+ * Copyright (c) 2018, Simone Angeloni
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Thomas J Bradley nor the names of its contributors may
+ *   be used to endorse or promote products derived from this software without
+ *   specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace hashkitcxx {
+
+    /**
+     * @brief Stream buffer hashing the bytes going through it, while reading them from or writing
+     * them to another stream buffer: the digest is computed in the same pass over memory as the
+     * copy, compression, etc. the data is read or written for. A buffer is used either to read or
+     * to write.
+     *
+     * The bytes are given to the incremental update() of THash in large blocks: bulk reads and
+     * writes (xsgetn(), xsputn()) larger than the internal buffer go straight between the caller
+     * and the wrapped buffer and are hashed in place, any other access is gathered in the internal
+     * buffer first.
+     */
+    template<class THash>
+    class hashing_streambuf final : public std::streambuf
+    {
+      public:
+        /**
+         * @param wrapped the stream buffer the bytes are read from or written to.
+         * @param buffer_size the size of the internal buffer expressed in bytes.
+         */
+        explicit hashing_streambuf(std::streambuf * wrapped, size_t buffer_size = 64 * 1024)
+            : m_wrapped{wrapped}, m_buffer_size{buffer_size > 0 ? buffer_size : 1}
+        {
+            m_hash.init();
+        }
+
+        ~hashing_streambuf() override
+        {
+            flush();
+        }
+
+        hashing_streambuf(const hashing_streambuf &) = delete;
+        hashing_streambuf & operator=(const hashing_streambuf &) = delete;
+
+        /**
+         * @brief Returns the hash of the bytes read so far by the user of the buffer, or written
+         * so far to the wrapped buffer (the pending bytes are flushed), then starts a new hash.
+         * @return an array containing the hash.
+         */
+        typename THash::digest_t digest()
+        {
+            hash_consumed();
+            flush();
+
+            typename THash::digest_t digest;
+            m_hash.complete(digest.data());
+            m_hash.init();
+            return digest;
+        }
+
+      protected:
+        std::streamsize xsgetn(char * s, std::streamsize n) override
+        {
+            std::streamsize done{0};
+            while (done < n)
+            {
+                const std::streamsize available{egptr() - gptr()};
+                if (available > 0)
+                {
+                    const std::streamsize len{std::min(available, n - done)};
+                    std::memcpy(s + done, gptr(), static_cast<size_t>(len));
+                    gbump(static_cast<int>(len));
+                    done += len;
+                }
+                else if (static_cast<size_t>(n - done) >= m_buffer_size)
+                {
+                    hash_consumed();
+                    const std::streamsize len{m_wrapped->sgetn(s + done, n - done)};
+                    if (len <= 0)
+                        break;
+                    update(s + done, len);
+                    done += len;
+                }
+                else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+                {
+                    break;
+                }
+            }
+            return done;
+        }
+
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+
+            hash_consumed();
+            if (m_get_buffer.empty())
+                m_get_buffer.resize(m_buffer_size);
+
+            char * begin{m_get_buffer.data()};
+            const std::streamsize len{
+                m_wrapped->sgetn(begin, static_cast<std::streamsize>(m_get_buffer.size()))};
+            setg(begin, begin, begin + (len > 0 ? len : 0));
+            m_hashed = begin;
+
+            return len > 0 ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+        }
+
+        std::streamsize xsputn(const char * s, std::streamsize n) override
+        {
+            if (n < epptr() - pptr())
+            {
+                std::memcpy(pptr(), s, static_cast<size_t>(n));
+                pbump(static_cast<int>(n));
+                return n;
+            }
+
+            if (!flush_or_allocate())
+                return 0;
+
+            if (static_cast<size_t>(n) >= m_buffer_size)
+                return write(s, n);
+
+            std::memcpy(pptr(), s, static_cast<size_t>(n));
+            pbump(static_cast<int>(n));
+            return n;
+        }
+
+        int_type overflow(int_type ch) override
+        {
+            if (!flush_or_allocate())
+                return traits_type::eof();
+
+            if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override
+        {
+            if (!flush())
+                return -1;
+            return m_wrapped->pubsync();
+        }
+
+      private:
+        void update(const char * s, std::streamsize len) noexcept
+        {
+            m_hash.update(reinterpret_cast<const unsigned char *>(s), static_cast<size_t>(len));
+        }
+
+        /**
+         * @brief Hashes the bytes of the get area taken by the user since the last call. Bytes
+         * put back and taken again are hashed once.
+         */
+        void hash_consumed() noexcept
+        {
+            if (gptr() > m_hashed)
+            {
+                update(m_hashed, gptr() - m_hashed);
+                m_hashed = gptr();
+            }
+        }
+
+        /**
+         * @brief Writes the bytes to the wrapped buffer, hashing the ones it accepted.
+         * @return the number of bytes written.
+         */
+        std::streamsize write(const char * s, std::streamsize n)
+        {
+            const std::streamsize len{m_wrapped->sputn(s, n)};
+            if (len > 0)
+                update(s, len);
+            return len;
+        }
+
+        /**
+         * @brief Writes the put area to the wrapped buffer and empties it.
+         * @return false if the wrapped buffer did not accept all the bytes.
+         */
+        bool flush()
+        {
+            const std::streamsize len{pptr() - pbase()};
+            const bool written{len == 0 || write(pbase(), len) == len};
+            setp(pbase(), epptr());
+            return written;
+        }
+
+        /**
+         * @brief Writes the put area to the wrapped buffer, as flush(), allocating the put area
+         * the first time.
+         * @return false if the wrapped buffer did not accept all the bytes.
+         */
+        bool flush_or_allocate()
+        {
+            if (m_put_buffer.empty())
+            {
+                m_put_buffer.resize(m_buffer_size);
+                setp(m_put_buffer.data(), m_put_buffer.data() + m_put_buffer.size());
+                return true;
+            }
+            return flush();
+        }
+
+      private:
+        THash m_hash;                    /**< Hash of the bytes gone through */
+        std::streambuf * m_wrapped;      /**< Buffer the bytes are read from or written to */
+        size_t m_buffer_size;            /**< Size of the internal buffers */
+        std::vector<char> m_get_buffer;  /**< Get area, allocated by the first read */
+        std::vector<char> m_put_buffer;  /**< Put area, allocated by the first write */
+        char * m_hashed{nullptr};        /**< End of the bytes of the get area already hashed */
+    };
+
+    /**
+     * @brief Input stream hashing the bytes read from another stream.
+     */
+    template<class THash>
+    class ihashstream final : public std::istream
+    {
+      public:
+        explicit ihashstream(std::streambuf * source, size_t buffer_size = 64 * 1024)
+            : std::istream{nullptr}, m_buffer{source, buffer_size}
+        {
+            rdbuf(&m_buffer);
+        }
+
+        explicit ihashstream(std::istream & source, size_t buffer_size = 64 * 1024)
+            : ihashstream{source.rdbuf(), buffer_size}
+        {
+        }
+
+        /**
+         * @brief Returns the hash of the bytes read so far, then starts a new hash.
+         */
+        typename THash::digest_t digest()
+        {
+            return m_buffer.digest();
+        }
+
+      private:
+        hashing_streambuf<THash> m_buffer; /**< Buffer hashing the bytes read */
+    };
+
+    /**
+     * @brief Output stream hashing the bytes written to another stream.
+     */
+    template<class THash>
+    class ohashstream final : public std::ostream
+    {
+      public:
+        explicit ohashstream(std::streambuf * sink, size_t buffer_size = 64 * 1024)
+            : std::ostream{nullptr}, m_buffer{sink, buffer_size}
+        {
+            rdbuf(&m_buffer);
+        }
+
+        explicit ohashstream(std::ostream & sink, size_t buffer_size = 64 * 1024)
+            : ohashstream{sink.rdbuf(), buffer_size}
+        {
+        }
+
+        /**
+         * @brief Returns the hash of the bytes written so far, flushing them to the other stream,
+         * then starts a new hash.
+         */
+        typename THash::digest_t digest()
+        {
+            return m_buffer.digest();
+        }
+
+      private:
+        hashing_streambuf<THash> m_buffer; /**< Buffer hashing the bytes written */
+    };
+
+} // namespace hashkitcxx
@@ -29,14 +29,33 @@
  */
 
 #pragma once
+#include <cstddef>
 #include <utility>
 #if defined(HASHLIBCXX_STD_STRING)
 #    include <string>
 #endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
 
 namespace hashkitcxx {
 
 #if defined(HASHLIBCXX_STD_STRING)
+#    if defined(HASHLIBCXX_STD_STRING_VIEW)
+    /**
+     * @brief Returns the hash of the given input in hex format.
+     * @tparam THash a default constructible object containing an accessible function
+     * `hash_printable` with the same signature of this one.
+     * @param message the text to hash.
+     * @return a string containing the hash of `message` in hex.
+     */
+    template<class THash>
+    std::string hash_printable(std::string_view message)
+    {
+        THash s;
+        return s.hash_printable(message);
+    }
+#    else
     /**
      * @brief Returns the hash of the given input in hex format.
      * @tparam THash a default constructible object containing an accessible function
@@ -52,6 +71,21 @@ namespace hashkitcxx {
         return s.hash_printable(std::forward<std::string>(message));
     }
 
+    /**
+     * @brief Returns the hash of the given input in hex format.
+     * @tparam THash a default constructible object containing an accessible function
+     * `hash_printable` with the same signature of this one.
+     * @param message the text to hash. The string is not copied.
+     * @return a string containing the hash of `message` in hex.
+     */
+    template<class THash>
+    std::string hash_printable(const std::string & message)
+    {
+        THash s;
+        return s.hash_printable(message);
+    }
+#    endif
+
     /**
      * @brief Returns the hash of the given input in hex format.
      * @tparam THash a default constructible object containing an accessible function
@@ -67,6 +101,7 @@ namespace hashkitcxx {
         return s.hash_printable(message, len);
     }
 
+#    if !defined(HASHLIBCXX_STD_STRING_VIEW)
     /**
      * @brief Returns the hash of the given input.
      * @tparam THash a default constructible object containing an accessible function `hash` with
@@ -81,8 +116,98 @@ namespace hashkitcxx {
         THash s;
         s.hash(std::forward<std::string>(message), digest);
     }
+
+    /**
+     * @brief Returns the hash of the given input.
+     * @tparam THash a default constructible object containing an accessible function `hash` with
+     * the same signature of this one.
+     * @param message the text to hash. The string is not copied.
+     * @param digest pointer to the memory location to store the hash of `message`.
+     */
+    template<class THash>
+    void hash(const std::string & message, unsigned char * digest)
+    {
+        THash s;
+        s.hash(message, digest);
+    }
+#    endif
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+    /**
+     * @brief Returns the hash of the given input in hex format.
+     * @tparam THash a default constructible object containing an accessible function
+     * `hash_printable_array` with the same signature of this one.
+     * @param message the text to hash.
+     * @return a \0 terminated array containing the hash of `message` in hex.
+     */
+    template<class THash>
+    typename THash::digest_printable_t hash_printable_array(std::string_view message) noexcept
+    {
+        THash s;
+        return s.hash_printable_array(message);
+    }
+
+    /**
+     * @brief Returns the hash of the given input.
+     * @tparam THash a default constructible object containing an accessible function `hash` with
+     * the same signature of this one.
+     * @param message the text to hash.
+     * @param digest pointer to the memory location to store the hash of `message`.
+     */
+    template<class THash>
+    void hash(std::string_view message, unsigned char * digest) noexcept
+    {
+        THash s;
+        s.hash(message, digest);
+    }
+
+    /**
+     * @brief Returns the hash of the given input.
+     * @tparam THash a default constructible object containing an accessible function `hash` with
+     * the same signature of this one.
+     * @param message the text to hash.
+     * @return an array containing the hash of `message`.
+     */
+    template<class THash>
+    typename THash::digest_t hash(std::string_view message) noexcept
+    {
+        THash s;
+        return s.hash(message);
+    }
 #endif
 
+    /**
+     * @brief Returns the hash of the given input in hex format without allocating memory.
+     * @tparam THash a default constructible object containing an accessible function
+     * `hash_printable_array` with the same signature of this one.
+     * @param message pointer to the memory location containing the byte-array to hash.
+     * @param len the total length of `message` expressed in bytes.
+     * @return a \0 terminated array containing the hash of `message` in hex.
+     */
+    template<class THash>
+    typename THash::digest_printable_t hash_printable_array(const unsigned char * message,
+                                                            size_t len) noexcept
+    {
+        THash s;
+        return s.hash_printable_array(message, len);
+    }
+
+    /**
+     * @brief Returns the hash of the given input.
+     * @tparam THash a default constructible object containing an accessible function `hash` with
+     * the same signature of this one.
+     * @param message pointer to the memory location containing the byte-array to hash.
+     * @param len the total length of `message` expressed in bytes.
+     * @return an array containing the hash of `message`.
+     */
+    template<class THash>
+    typename THash::digest_t hash(const unsigned char * message, size_t len) noexcept
+    {
+        THash s;
+        return s.hash(message, len);
+    }
+
     /**
      * @brief Returns the hash of the given input in hex format.
      * @tparam THash a default constructible object containing an accessible function
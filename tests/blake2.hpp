@@ -0,0 +1,338 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_blake2.hpp>
+#include <string>
+#include <vector>
+
+namespace blake2_vectors {
+
+    /**
+     * @brief The input of each length repeats the bytes 0 to 255 and the key is made of the bytes
+     * 0 to s_key_size - 1, as in the official known answer tests. Only the first 32 bytes of the
+     * hashes are checked here.
+     */
+    struct vector_t
+    {
+        size_t len;
+        const char * hash;
+        const char * keyed_hash;
+    };
+
+    const vector_t blake2b[]{
+        {0,
+         "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419",
+         "10ebb67700b1868efb4417987acf4690ae9d972fb7a590c2f02871799aaa4786"},
+        {1,
+         "2fa3f686df876995167e7c2e5d74c4c7b6e48f8068fe0e44208344d480f7904c",
+         "961f6dd1e4dd30f63901690c512e78e4b45e4742ed197c3c5e45c549fd25f2e4"},
+        {63,
+         "d10bf9a15b1c9fc8d41f89bb140bf0be08d2f3666176d13baac4d381358ad074",
+         "bd965bf31e87d70327536f2a341cebc4768eca275fa05ef98f7f1b71a0351298"},
+        {64,
+         "2fc6e69fa26a89a5ed269092cb9b2a449a4409a7a44011eecad13d7c4b045660",
+         "65676d800617972fbd87e4b9514e1c67402b7a331096d3bfac22f1abb95374ab"},
+        {65,
+         "fcbe8be7dcb49a32dbdf239459e26308b84dff1ea480df8d104eeff34b46fae9",
+         "939fa189699c5d2c81ddd1ffc1fa207c970b6a3685bb29ce1d3e99d42f2f7442"},
+        {128,
+         "2319e3789c47e2daa5fe807f61bec2a1a6537fa03f19ff32e87eecbfd64b7e0e",
+         "72065ee4dd91c2d8509fa1fc28a37c7fc9fa7d5b3f8ad3d0d7a25626b57b1b44"},
+        {129,
+         "f59711d44a031d5f97a9413c065d1e614c417ede998590325f49bad2fd444d3e",
+         "64475dfe7600d7171bea0b394e27c9b00d8e74dd1e416a79473682ad3dfdbb70"},
+        {255,
+         "5b21c5fd8868367612474fa2e70e9cfa2201ffeee8fafab5797ad58fefa17c9b",
+         "142709d62e28fcccd0af97fad0f8465b971e82201dc51070faa0372aa43e9248"},
+        {511,
+         "13168377cc369541f6819b436d22a260d3e824ec54a1ae69d97b57072715e54f",
+         "5f3afe9b469d8209615329f9b0cd997d8a46af5f5d883948e472aa720b063d15"},
+        {512,
+         "c59ab1095ca4579525338b6b74689ff234bc3fe9765fe26dfb04ddceaee0ab84",
+         "31952478e1b6229b6bca296c643a3fdbe4aa2c2f7fea466675453d5f7f094270"},
+        {513,
+         "68812f695bbb6bded5e12bb37c08a99fbab6e71b18b045223082791b120d8588",
+         "69bb57dd43a60511767cd602008424be71265950ef5921884d7706f3683e7513"},
+        {1023,
+         "7f091aafd3d5fa549239f2e1b382e947fb7f136e0c0437043cbbb641315ad15c",
+         "16820e5204a7acf11ab1fa857b8a58303843dd87f279aeeae6b79f4518f02efc"},
+        {1024,
+         "6b490f42e902f61b1ee12d3c85e34152e37c94d07ab9ea577cad6a6eb4690fad",
+         "199c1d5b4f38a954adcaf5f29e2a4792ee3107b813f9a198ae373498690bc93b"},
+        {1025,
+         "4ce7bad73d5ca6e76c99364489dca5be09c66e655ba2cdad3efe44530c43bebf",
+         "513df7241e29598fe2cc0706d40a551f21e7ba7afcdb66ba9d5ebce35ba147f9"},
+        {2048,
+         "9a2e9eaf5241bfd316591ffc8255e8442b3047483c7fabec18f30bfe9636f645",
+         "6c257b479fc02a3c1192973ec7b3e3f005d8de9f05a1bef32f7ac470a5d82684"},
+        {2049,
+         "8222abfc82faac1d225ef7be509f29561fd449c4e10f99c8662fb76c28a94d48",
+         "96936e62fbbc621ce6cb8255c7ca3580107554220cec3d0e3e094796e9f60185"},
+        {3000,
+         "8cce9ccaaa80bdfe5d479aabb9f39fa6174ca1c18a8e434cf9d900049239349d",
+         "c39801cf53574f526f08de0c2765deddc4a8ff56c76774c9c94acc2a4cce0acf"}};
+
+    const vector_t blake2s[]{
+        {0,
+         "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9",
+         "48a8997da407876b3d79c0d92325ad3b89cbb754d86ab71aee047ad345fd2c49"},
+        {1,
+         "e34d74dbaf4ff4c6abd871cc220451d2ea2648846c7757fbaac82fe51ad64bea",
+         "40d15fee7c328830166ac3f918650f807e7e01e177258cdc0a39b11f598066f1"},
+        {63,
+         "e57cb79487dd57902432b250733813bd96a84efce59f650fac26e6696aefafc3",
+         "c65382513f07460da39833cb666c5ed82e61b9e998f4b0c4287cee56c3cc9bcd"},
+        {64,
+         "56f34e8b96557e90c1f24b52d0c89d51086acf1b00f634cf1dde9233b8eaaa3e",
+         "8975b0577fd35566d750b362b0897a26c399136df07bababbde6203ff2954ed4"},
+        {65,
+         "1b53ee94aaf34e4b159d48de352c7f0661d0a40edff95a0b1639b4090e974472",
+         "21fe0ceb0052be7fb0f004187cacd7de67fa6eb0938d927677f2398c132317a8"},
+        {128,
+         "1fa877de67259d19863a2a34bcc6962a2b25fcbf5cbecd7ede8f1fa36688a796",
+         "0c311f38c35a4fb90d651c289d486856cd1413df9b0677f53ece2cd9e477c60a"},
+        {129,
+         "5bd169e67c82c2c2e98ef7008bdf261f2ddf30b1c00f9e7f275bb3e8a28dc9a2",
+         "46a73a8dd3e70f59d3942c01df599def783c9da82fd83222cd662b53dce7dbdf"},
+        {255,
+         "f03f5789d3336b80d002d59fdf918bdb775b00956ed5528e86aa994acb38fe2d",
+         "3fb735061abc519dfe979e54c1ee5bfad0a9d858b3315bad34bde999efd724dd"},
+        {511,
+         "a1d67024ce9d19b1918db53732a801fc46b969c47f2daa3ac9dbe55618629749",
+         "e0fa0eef269a8ad270da9954eefca8861fbb70c8cee65687af7644a1fe89a7ec"},
+        {512,
+         "aeb5499d81f14cb10c2539411cbe3e71167293458543bfa4ca1f9584625fd4c6",
+         "9c2f5c0b2815d34e737034f9219326e6896242912e348ffb509e805d6fda9f8b"},
+        {513,
+         "e360b1f29691ac674793c97e51c1071b50e76e6a11ccde36b5ed84f3b88196c7",
+         "b2a0f38b9f4eaa8680f146ea90e0cb233fe537f841e2ef66bd3cde239c410df6"},
+        {1023,
+         "d4feddc2ac181249fde3daa731f66794b6812610cf99c916db50cdc71eb3230e",
+         "3364ff2688262addec945dc70d1fcce988af78bd9422d2d8ebcacb9cc620d2b4"},
+        {1024,
+         "a049455add68f38d48845e25a52ba3100c4d0899178c202aec07364fecacf650",
+         "9ad228e0f38ae8e2f5ab6b1c668d6cd863e3e27244e6d52d4f14e3038aecf426"},
+        {1025,
+         "20c61d1cf0895c12ce9bf570f93b2c10fe9b010a884ccd8eb83f05ce05de0005",
+         "cea6a552ede677f744ec15a6bc2531d55d4ad3616199700b206c7290947aa6e2"},
+        {2048,
+         "2f468225d850273bf95418f2b22b773be32e32c0127ed548943e0defbe0632f6",
+         "31a3f12135e5813c0e17f1ccbd28dc880af3fcee774063f00b0a54547b92e4da"},
+        {2049,
+         "5216f03a0ebf006bf7995dca72aa6d88f988052cfab03c9134d9978b52bafc15",
+         "64098e3099272513b99a05afd9a884abaecffd6708062f5d26d5c8f76f036bed"},
+        {3000,
+         "785093f0716936b05bc5f6f0bcf88790b474de4540a1816caf2053390c9ff2d5",
+         "0beb5bbb62c3a1ce192f80a0f4920104b2bfeca644471a2ac1a02b486a077b29"}};
+
+    const vector_t blake2bp[]{
+        {0,
+         "b5ef811a8038f70b628fa8b294daae7492b1ebe343a80eaabbf1f6ae664dd67b",
+         "9d9461073e4eb640a255357b839f394b838c6ff57c9b686a3f76107c1066728f"},
+        {1,
+         "a139280e72757b723e6473d5be59f36e9d50fc5cd7d4585cbc09804895a36c52",
+         "ff8e90a37b94623932c59f7559f26035029c376732cb14d41602001cbb73adb7"},
+        {63,
+         "0425caaa923b47b35045eb50829c048bc890444afeefc0afc9d1877b821e043c",
+         "714ad185f1eec43f46b67e992d2d38bc3149e37da7b44748d4d14c161e087802"},
+        {64,
+         "6b9d86f15c090a00fc3d907f906c5eb79265e58b88eb64294b4cc4e2b89b1a7c",
+         "22b8249eaf722964ce424f71a74d038ff9b615fba5c7c22cb62797f5398224c3"},
+        {65,
+         "146a187a99e8a2d233e0eb373d437b02bfa8d6515b3ca1de48a6b6acf7437eb7",
+         "b8e903e691b992782528f8db964d08e3baafbd08ba60c72aec0c28ec6bfeca4b"},
+        {128,
+         "05ad0f271faf7e361320518452813ff9fb9976ac378050b6eefb05f7867b577b",
+         "9280f4d1157032ab315c100d636283fbf4fba2fbad0f8bc020721d76bc1c8973"},
+        {129,
+         "b545880294afa153f8b9f49c73d952b5d1228f1a1ab5ebcb05ff79e560c030f7",
+         "5530c2d59f144872e987e4e258a7d8c38ce844e2cc2eed940ffc683b498815e5"},
+        {255,
+         "3f35c45d24fcfb4acca651076c08000e279ebbff37a1333ce19fd577202dbd24",
+         "96fbcbb60bd313b8845033e5bc058a38027438572d7e7957f3684f6268aadd3a"},
+        {511,
+         "fa14897433dd69321b1933a1fe101fdd463dc15fffe3f572c0b489bb607edff8",
+         "eb7b7bb4d5217025705e949d98db93ee62e64f6fb9e6f45108a5f7ebe2908161"},
+        {512,
+         "5b3a0e990c4e8c6e5463e763a6686551a129a81ab48c49cd8dc10519dfe2d02d",
+         "14ba32c1c80bb32c8282aa53f341f45daabda12bda41f7ad8ec75baa743a41ad"},
+        {513,
+         "cd79fbbded91823272abb7a97a5530608f0583bd5405c7765156c4d8754ddf43",
+         "2d9af8503c1b107aece8ecc73f2c2a6ecfe3def943ab277bb3323643b8bbd336"},
+        {1023,
+         "a384fb09f2346cca44b00af29fb491fe01011fc7200780243bade58cb337227f",
+         "f8902562400af0a16874e0ab432d5442dfa82439a220f927c8c654076cdb1fd8"},
+        {1024,
+         "98b6de75c42e1e5cdd6623aca47a1a359e9aef84f10d6bf125093331d9f5c63f",
+         "868a4be429bfe126796f528004b99bb79b3cb149771e8d9f0d962e39d58db1c2"},
+        {1025,
+         "922470cb5ae0fe54810587de238bc407f597ef6b519b1607515a2b467b9592c9",
+         "b1042aeddf0f6e6fd7449c7423587eadf441eb36f792826a94a4d347cd5d78d6"},
+        {2048,
+         "6390c1edda24c198efc734c68dafde65e6db2fd01ec6faa4bd4c142ea6e29ec1",
+         "3dec51ff2957f5e7293fa63606014da873c31982813cde562755fa17d547d386"},
+        {2049,
+         "67c9e065513f30f5eecdb93f384d93d9bab10790b565ac586ba87942702171d3",
+         "8f9d23fe78af91f8d6a7aec605c3090aa9b096a0708dbb63c6b59f2e49de121b"},
+        {3000,
+         "8d43675910c0e39c56f7bf07a5794989873d455bd492de58f393fa3ccdcd6398",
+         "7c1cb7730b08294b0b5c9f6a421a76809cff8562c9798a02201f50426578a443"}};
+
+    const vector_t blake2sp[]{
+        {0,
+         "dd0e891776933f43c7d032b08a917e25741f8aa9a12c12e1cac8801500f2ca4f",
+         "715cb13895aeb678f6124160bff21465b30f4f6874193fc851b4621043f09cc6"},
+        {1,
+         "a6b9eecc25227ad788c99d3f236debc8da408849e9a5178978727a81457f7239",
+         "40578ffa52bf51ae1866f4284d3a157fc1bcd36ac13cbdcb0377e4d0cd0b6603"},
+        {63,
+         "1024c940be7341449b5010522b509f65bbdc1287b455c2bb7f72b2c92fd0d189",
+         "e85594700e3922a1e8e41eb8b064e7ac6d949d13b5a34523e5a6beac03c8ab29"},
+        {64,
+         "52603b6cbfad4966cb044cb267568385cf35f21e6c45cf30aed19832cb51e9f5",
+         "1d3701a5661bd31ab20562bd07b74dd19ac8f3524b73ce7bc996b788afd2f317"},
+        {65,
+         "fff24d3cc729d395daf978b0157306cb495797e6c8dca1731d2f6f81b849baae",
+         "874e1938033d7d383597a2a65f58b554e41106f6d1d50e9ba0eb685f6b6da071"},
+        {128,
+         "05cf3a90049116dc60efc31536aaa3d167762994892876dcb7ef3fbecd7449c0",
+         "0c6ce32a3ea05612c5f8090f6a7e87f5ab30e41b707dcbe54155620ad770a340"},
+        {129,
+         "ccd61c926cc1e5e9128c021c0c6e92aefc4ffbde394dd6f3b7d87a8ced896014",
+         "c65938dd3a053c729cf5b7c89f390bfebb5112766bb00aa5fa3164dfdf3b5647"},
+        {255,
+         "25059f10605e67adfe681350666e15ae976a5a571c13cf5bc8053f430e120a52",
+         "0c8a36597d7461c63a94732821c941856c668376606c86a52de0ee4104c615db"},
+        {511,
+         "50285271956932d39b0967202b56006cbb6d738ee29e5a867edf72c8c4386f1b",
+         "3e3948f0b6602348b699dab0ea15c0781fd694183531142fb5bc88477cacbe76"},
+        {512,
+         "322ce06cc141a0b3d89bcdcfcb385975dbca56e5719a78c34000fcec2e15b55d",
+         "3246bc18b42253f58d3bc21dd51c14290c0b78d4d9d5274087bff2ca297c51fc"},
+        {513,
+         "1336628c7f1541c7815fc0ff1fb5dfb07a85cf5a17a2872a3ce4b322d4a03d0b",
+         "583dc2f1f106e8b85fab4795371576d75eca0fad5a0cc5ede81ad54bd405d873"},
+        {1023,
+         "13bc5720de247edd4dc087a08a1e44388bf2047b102c5d878a86c8aa10e50019",
+         "3fe462aacf52587ca8ae0baa0d65571a9672caabab05fb90dd11b18fc1de2d0a"},
+        {1024,
+         "c9f79171d19c3703b7ebf9f762ce3fd24b302e2281f72da31a65014ff923c859",
+         "70f461c5066494b5eb28a959efa3a9191a5e52642e6f5b5f22c751927239d460"},
+        {1025,
+         "1cf65560deef7dad5282fa8b42e289d71a43b972b24eb3c8ed4d6e725e5f14ad",
+         "95b9c345aa7e1791df0209064837221717b009dd90816a06ae4a83f6e6c12f8d"},
+        {2048,
+         "2f2446d594620c85b60de83a27275f6145fc45cbfc2f4483a8592fdcc66111c3",
+         "3716ea85124b51557d265eba26c3cbe1bc4a03530bd7aa4d3c10038ac9e82ccf"},
+        {2049,
+         "e49a04e1acbb4b17a75a1a77434baae49650b6c8dbf0670a5cedcd29e3bb45df",
+         "d3a1ab2f4a46798aa1153a3317a14946c9ee2e7a5ef81e4047cb657664075039"},
+        {3000,
+         "539f9a8b1033f12bd6b7b60c9a306acad05a9699b736df38d11db4b4d62ea91d",
+         "1cf02f5bb58545a9851aedf853b9be8853221dcd15f5d64922ff59e2c8f4b9fc"}};
+
+    template<class THash>
+    std::string output(const THash & h, size_t len = 32)
+    {
+        unsigned char digest[THash::s_digest_size]{};
+        h.complete(digest);
+        return common::to_hex(digest, len);
+    }
+
+    template<class THash, size_t N>
+    void check(const vector_t (&vectors)[N])
+    {
+        unsigned char key[THash::s_key_size];
+        for (size_t i{0}; i < THash::s_key_size; ++i)
+            key[i] = static_cast<unsigned char>(i);
+
+        for (const vector_t & vector : vectors)
+        {
+            const std::vector<unsigned char> message{common::input(vector.len)};
+            THash h;
+
+            h.init();
+            h.update(message.data(), vector.len);
+            BOOST_TEST(output(h) == vector.hash);
+
+            h.init_keyed(key, sizeof(key));
+            h.update(message.data(), vector.len);
+            BOOST_TEST(output(h) == vector.keyed_hash);
+            BOOST_TEST(h.processed_size() == vector.len);
+
+            // some parts end in the middle of a group of blocks
+            h.init_keyed(key, sizeof(key));
+            common::update_in_parts(h, message.data(), vector.len);
+            BOOST_TEST(output(h) == vector.keyed_hash);
+            BOOST_TEST(h.processed_size() == vector.len);
+        }
+    }
+
+} // namespace blake2_vectors
+
+BOOST_AUTO_TEST_SUITE(test_blake2)
+BOOST_AUTO_TEST_CASE(test_vectors)
+{
+    blake2_vectors::check<hashkitcxx::blake2b>(blake2_vectors::blake2b);
+    blake2_vectors::check<hashkitcxx::blake2s>(blake2_vectors::blake2s);
+    blake2_vectors::check<hashkitcxx::blake2bp>(blake2_vectors::blake2bp);
+    blake2_vectors::check<hashkitcxx::blake2sp>(blake2_vectors::blake2sp);
+}
+
+BOOST_AUTO_TEST_CASE(test_digest_size)
+{
+    const unsigned char * abc{reinterpret_cast<const unsigned char *>("abc")};
+    const unsigned char key[]{0, 1, 2, 3, 4, 5, 6};
+
+    hashkitcxx::blake2b b;
+    b.init(32);
+    b.update(abc, 3);
+    BOOST_TEST(b.digest_size() == 32U);
+    BOOST_TEST(blake2_vectors::output(b) ==
+               "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319");
+    b.init_keyed(key, sizeof(key), 20);
+    b.update(abc, 3);
+    BOOST_TEST(blake2_vectors::output(b, 20) == "bdee83cda7eda9c3cccc74091d42b2f9c3dad2be");
+
+    hashkitcxx::blake2s s;
+    s.init(16);
+    s.update(abc, 3);
+    BOOST_TEST(blake2_vectors::output(s, 16) == "aa4938119b1dc7b87cbad0ffd200d0ae");
+
+    hashkitcxx::blake2bp bp;
+    bp.init(32);
+    bp.update(abc, 3);
+    BOOST_TEST(blake2_vectors::output(bp) ==
+               "4792f00c05827a437fc55481e447eea1c9a39add28087733b3e53f1c04430dc7");
+
+    hashkitcxx::blake2sp sp;
+    sp.init_keyed(key, sizeof(key), 20);
+    sp.update(abc, 3);
+    BOOST_TEST(sp.digest_size() == 20U);
+    BOOST_TEST(blake2_vectors::output(sp, 20) == "783675b23ca840d7c9c84fd19dbb1c1b42e43bf6");
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_overloads)
+{
+    // RFC 7693, appendices A and B
+    const unsigned char * abc{reinterpret_cast<const unsigned char *>("abc")};
+    const std::string blake2b_abc{
+        "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+        "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923"};
+    const std::string blake2s_abc{
+        "508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982"};
+
+    hashkitcxx::blake2b b;
+    const hashkitcxx::blake2b::digest_t digest{b.hash(abc, 3)};
+    BOOST_TEST(common::to_hex(digest.data(), digest.size()) == blake2b_abc);
+    BOOST_TEST(std::string(b.hash_printable_array(abc, 3).data()) == blake2b_abc);
+
+    hashkitcxx::blake2s s;
+    BOOST_TEST(std::string(s.hash_printable_array(abc, 3).data()) == blake2s_abc);
+#if defined(HASHLIBCXX_STD_STRING)
+    BOOST_TEST(b.hash_printable(std::string("abc")) == blake2b_abc);
+    BOOST_TEST(s.hash_printable(std::string("abc")) == blake2s_abc);
+#endif
+}
+BOOST_AUTO_TEST_SUITE_END() // test_blake2
@@ -0,0 +1,222 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_blake3.hpp>
+#include <string>
+#include <vector>
+
+namespace blake3_vectors {
+
+    /**
+     * @brief The official test vectors: the input of each length repeats the bytes 0 to 250, the
+     * key is "whats the Elvish word for friend" and the context is "BLAKE3 2019-12-27 16:29:52
+     * test vectors context". Only the first 32 bytes of the outputs are checked here.
+     */
+    struct vector_t
+    {
+        size_t len;
+        const char * hash;
+        const char * keyed_hash;
+        const char * derive_key;
+    };
+
+    const vector_t vectors[]{
+        {0,
+         "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262",
+         "92b2b75604ed3c761f9d6f62392c8a9227ad0ea3f09573e783f1498a4ed60d26",
+         "2cc39783c223154fea8dfb7c1b1660f2ac2dcbd1c1de8277b0b0dd39b7e50d7d"},
+        {1,
+         "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213",
+         "6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b",
+         "b3e2e340a117a499c6cf2398a19ee0d29cca2bb7404c73063382693bf66cb06c"},
+        {63,
+         "e9bc37a594daad83be9470df7f7b3798297c3d834ce80ba85d6e207627b7db7b",
+         "bb1eb5d4afa793c1ebdd9fb08def6c36d10096986ae0cfe148cd101170ce37ae",
+         "b6451e30b953c206e34644c6803724e9d2725e0893039cfc49584f991f451af3"},
+        {64,
+         "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98",
+         "ba8ced36f327700d213f120b1a207a3b8c04330528586f414d09f2f7d9ccb7e6",
+         "a5c4a7053fa86b64746d4bb688d06ad1f02a18fce9afd3e818fefaa7126bf73e"},
+        {65,
+         "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee",
+         "c0a4edefa2d2accb9277c371ac12fcdbb52988a86edc54f0716e1591b4326e72",
+         "51fd05c3c1cfbc8ed67d139ad76f5cf8236cd2acd26627a30c104dfd9d3ff8a8"},
+        {1023,
+         "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11",
+         "c951ecdf03288d0fcc96ee3413563d8a6d3589547f2c2fb36d9786470f1b9d6e",
+         "74a16c1c3d44368a86e1ca6df64be6a2f64cce8f09220787450722d85725dea5"},
+        {1024,
+         "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7",
+         "75c46f6f3d9eb4f55ecaaee480db732e6c2105546f1e675003687c31719c7ba4",
+         "7356cd7720d5b66b6d0697eb3177d9f8d73a4a5c5e968896eb6a689684302706"},
+        {1025,
+         "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444",
+         "357dc55de0c7e382c900fd6e320acc04146be01db6a8ce7210b7189bd664ea69",
+         "effaa245f065fbf82ac186839a249707c3bddf6d3fdda22d1b95a3c970379bcb"},
+        {2048,
+         "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a",
+         "879cf1fa2ea0e79126cb1063617a05b6ad9d0b696d0d757cf053439f60a99dd1",
+         "7b2945cb4fef70885cc5d78a87bf6f6207dd901ff239201351ffac04e1088a23"},
+        {2049,
+         "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030",
+         "9f29700902f7c86e514ddc4df1e3049f258b2472b6dd5267f61bf13983b78dd5",
+         "2ea477c5515cc3dd606512ee72bb3e0e758cfae7232826f35fb98ca1bcbdf273"},
+        {3072,
+         "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2",
+         "044a0e7b172a312dc02a4c9a818c036ffa2776368d7f528268d2e6b5df191770",
+         "050df97f8c2ead654d9bb3ab8c9178edcd902a32f8495949feadcc1e0480c46b"},
+        {3073,
+         "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3",
+         "68dede9bef00ba89e43f31a6825f4cf433389fedae75c04ee9f0cf16a427c95a",
+         "72613c9ec9ff7e40f8f5c173784c532ad852e827dba2bf85b2ab4b76f7079081"},
+        {4096,
+         "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969",
+         "befc660aea2f1718884cd8deb9902811d332f4fc4a38cf7c7300d597a081bfc0",
+         "1e0d7f3db8c414c97c6307cbda6cd27ac3b030949da8e23be1a1a924ad2f25b9"},
+        {4097,
+         "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995",
+         "00df940cd36bb9fa7cbbc3556744e0dbc8191401afe70520ba292ee3ca80abbc",
+         "aca51029626b55fda7117b42a7c211f8c6e9ba4fe5b7a8ca922f34299500ead8"},
+        {5120,
+         "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833",
+         "2c493e48e9b9bf31e0553a22b23503c0a3388f035cece68eb438d22fa1943e20",
+         "7a7acac8a02adcf3038d74cdd1d34527de8a0fcc0ee3399d1262397ce5817f60"},
+        {5121,
+         "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff",
+         "6ccf1c34753e7a044db80798ecd0782a8f76f33563accaddbfbb2e0ea4b2d024",
+         "b07f01e518e702f7ccb44a267e9e112d403a7b3f4883a47ffbed4b48339b3c34"},
+        {8192,
+         "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63",
+         "dc9637c8845a770b4cbf76b8daec0eebf7dc2eac11498517f08d44c8fc00d58a",
+         "ad01d7ae4ad059b0d33baa3c01319dcf8088094d0359e5fd45d6aeaa8b2d0c3d"},
+        {8193,
+         "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b",
+         "954a2a75420c8d6547e3ba5b98d963e6fa6491addc8c023189cc519821b4a1f5",
+         "af1e0346e389b17c23200270a64aa4e1ead98c61695d917de7d5b00491c9b0f1"},
+        {16384,
+         "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4",
+         "9e9fc4eb7cf081ea7c47d1807790ed211bfec56aa25bb7037784c13c4b707b0d",
+         "160e18b5878cd0df1c3af85eb25a0db5344d43a6fbd7a8ef4ed98d0714c3f7e1"},
+        {31744,
+         "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47",
+         "efa53b389ab67c593dba624d898d0f7353ab99e4ac9d42302ee64cbf9939a419",
+         "39772aef80e0ebe60596361e45b061e8f417429d529171b6764468c22928e28e"},
+        {102400,
+         "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085",
+         "1c35d1a5811083fd7119f5d5d1ba027b4d01c0c6c49fb6ff2cf75393ea5db4a7",
+         "4652cff7a3f385a6103b5c260fc1593e13c778dbe608efb092fe7ee69df6e9c6"},
+    };
+
+    const char * key{"whats the Elvish word for friend"};
+    const char * context{"BLAKE3 2019-12-27 16:29:52 test vectors context"};
+
+    std::string output(const hashkitcxx::blake3 & h, size_t len, uint64_t offset = 0)
+    {
+        std::vector<unsigned char> bytes(len + 1);
+        h.complete(bytes.data(), len, offset);
+        return common::to_hex(bytes.data(), len);
+    }
+
+} // namespace blake3_vectors
+
+BOOST_AUTO_TEST_SUITE(test_blake3)
+BOOST_AUTO_TEST_CASE(test_vectors)
+{
+    for (const blake3_vectors::vector_t & vector : blake3_vectors::vectors)
+    {
+        const std::vector<unsigned char> message{common::input(vector.len, 251)};
+        hashkitcxx::blake3 h;
+
+        h.init();
+        h.update(message.data(), vector.len);
+        BOOST_TEST(blake3_vectors::output(h, 32) == vector.hash);
+
+        h.init_keyed(reinterpret_cast<const unsigned char *>(blake3_vectors::key));
+        h.update(message.data(), vector.len);
+        BOOST_TEST(blake3_vectors::output(h, 32) == vector.keyed_hash);
+
+        h.init_derive_key(blake3_vectors::context, strlen(blake3_vectors::context));
+        h.update(message.data(), vector.len);
+        BOOST_TEST(blake3_vectors::output(h, 32) == vector.derive_key);
+
+        // some parts end in the middle of a chunk
+        h.init();
+        common::update_in_parts(h, message.data(), vector.len);
+        BOOST_TEST(blake3_vectors::output(h, 32) == vector.hash);
+        BOOST_TEST(h.processed_size() == vector.len);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_extendable_output)
+{
+    const std::string empty{"af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"
+                            "e00f03e7b69af26b7faaf09fcd333050338ddfe085b8cc869ca98b206c08243a"
+                            "26f5487789e8f660afe6c99ef9e0c52b92e7393024a80459cf91f476f9ffdbda"
+                            "7001c22e159b402631f277ca96f2defdf1078282314e763699a31c5363165421"
+                            "cce14d"};
+    const std::string chunk_and_byte{
+        "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"
+        "f4c4a22b4b399155358a994e52bf255de60035742ec71bd08ac275a1b51cc6bf"
+        "e332b0ef84b409108cda080e6269ed4b3e2c3f7d722aa4cdc98d16deb554e562"
+        "7be8f955c98e1d5f9565a9194cad0c4285f93700062d9595adb992ae68ff1280"
+        "0ab67a"};
+
+    const std::vector<unsigned char> message{common::input(1025, 251)};
+    hashkitcxx::blake3 h;
+    h.init();
+    BOOST_TEST(blake3_vectors::output(h, 131) == empty);
+    h.update(message.data(), 1025);
+    BOOST_TEST(blake3_vectors::output(h, 131) == chunk_and_byte);
+
+    // the outputs are prefixes of each other, and can be read from any offset
+    BOOST_TEST(blake3_vectors::output(h, 7) == chunk_and_byte.substr(0, 14));
+    BOOST_TEST(blake3_vectors::output(h, 60, 64) == chunk_and_byte.substr(128, 120));
+    BOOST_TEST(blake3_vectors::output(h, 100, 31) == chunk_and_byte.substr(62, 200));
+    BOOST_TEST(blake3_vectors::output(h, 0) == "");
+
+    unsigned char digest[hashkitcxx::blake3::s_digest_size];
+    h.complete(digest);
+    BOOST_TEST(common::to_hex(digest, sizeof(digest)) == chunk_and_byte.substr(0, 64));
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_overloads)
+{
+    const unsigned char * abc{reinterpret_cast<const unsigned char *>("abc")};
+    hashkitcxx::blake3 h;
+    const hashkitcxx::blake3::digest_t digest{h.hash(abc, 3)};
+    BOOST_TEST(common::to_hex(digest.data(), digest.size()) ==
+               "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+    BOOST_TEST(std::string(h.hash_printable_array(abc, 3).data()) ==
+               "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+#if defined(HASHLIBCXX_STD_STRING)
+    BOOST_TEST(h.hash_printable(std::string("abc")) ==
+               "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_update_parallel)
+{
+    // more chunks than the kernels hash together, not a power of 2, and after a partial chunk
+    const size_t len{(3 << 20) + 777};
+    const std::vector<unsigned char> message{common::input(len, 251)};
+    hashkitcxx::blake3 h;
+    h.init();
+    h.update(message.data(), len);
+    const std::string expected{blake3_vectors::output(h, 32)};
+    BOOST_TEST(expected == "af47dfe5284779cecdf26b7bb8209b1a4ca1e24bb168adff9f9ee4294a9e52e9");
+
+    for (unsigned threads : {0U, 1U, 2U, 5U})
+    {
+        h.init();
+        h.update_parallel(message.data(), len, threads);
+        BOOST_TEST(blake3_vectors::output(h, 32) == expected);
+
+        h.init();
+        h.update(message.data(), 100);
+        h.update_parallel(message.data() + 100, len - 100, threads);
+        BOOST_TEST(blake3_vectors::output(h, 32) == expected);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END() // test_blake3
@@ -1,6 +1,9 @@
 #pragma once
 #include <cassert>
+#include <cstddef>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 namespace common {
 
@@ -13,4 +16,41 @@ namespace common {
             sprintf(out + i * 2, "%02x", digest[i]);
     }
 
+    inline std::string to_hex(const unsigned char * bytes, size_t len)
+    {
+        std::vector<char> hex(2 * len + 1);
+        to_hex(bytes, len, hex.data());
+        return hex.data();
+    }
+
+    inline std::vector<unsigned char> message(size_t len)
+    {
+        std::vector<unsigned char> bytes(len);
+        for (size_t i{0}; i < len; ++i)
+            bytes[i] = static_cast<unsigned char>(i * 7 + 3);
+        return bytes;
+    }
+
+    // the input of the published test vectors: the bytes 0, 1, 2... repeating every `period`
+    // bytes, plus one more byte so that the empty input is not null
+    inline std::vector<unsigned char> input(size_t len, size_t period = 256)
+    {
+        std::vector<unsigned char> bytes(len + 1);
+        for (size_t i{0}; i < len; ++i)
+            bytes[i] = static_cast<unsigned char>(i % period);
+        return bytes;
+    }
+
+    // hashes `message` in parts of every size, some ending in the middle of a block
+    template<class THash>
+    void update_in_parts(THash & h, const unsigned char * message, size_t len)
+    {
+        for (size_t position{0}, part{1}; position < len; part = part * 3 % 1031 + 1)
+        {
+            const size_t size{part < len - position ? part : len - position};
+            h.update(message + position, size);
+            position += size;
+        }
+    }
+
 } // namespace common
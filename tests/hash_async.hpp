@@ -0,0 +1,153 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#if defined(HASHLIBCXX_COROUTINES)
+#    include <coroutine>
+#    include <exception>
+#    include <functional>
+#    include <future>
+#    include <hashkitcxx/hash_async.hpp>
+#    include <hashkitcxx/hash_sha2.hpp>
+#    include <vector>
+
+namespace hash_async {
+
+    /**
+     * @brief A coroutine started immediately, setting a future when it returns.
+     */
+    struct task
+    {
+        struct promise_type
+        {
+            std::promise<void> done;
+
+            task get_return_object()
+            {
+                return {done.get_future()};
+            }
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+            void return_void()
+            {
+                done.set_value();
+            }
+            void unhandled_exception()
+            {
+                done.set_exception(std::current_exception());
+            }
+        };
+
+        std::future<void> done;
+    };
+
+    /**
+     * @brief Counts the tasks and runs them on the pool of the library.
+     */
+    struct counting_executor
+    {
+        size_t tasks{0};
+
+        void execute(std::function<void()> task)
+        {
+            ++tasks;
+            hashkitcxx::default_thread_pool().execute(std::move(task));
+        }
+    };
+
+    std::vector<unsigned char> message(size_t len)
+    {
+        std::vector<unsigned char> bytes(len);
+        for (size_t i{0}; i < len; ++i)
+            bytes[i] = static_cast<unsigned char>(i * 13 + 5);
+        return bytes;
+    }
+
+    task hash_one(counting_executor & executor,
+                  const std::vector<unsigned char> & bytes,
+                  hashkitcxx::sha2::sha256::digest_t & digest)
+    {
+        digest = co_await hashkitcxx::async_hash<hashkitcxx::sha2::sha256>(
+            executor, bytes.data(), bytes.size(), 1000);
+    }
+
+    task hash_default(const std::vector<unsigned char> & bytes,
+                      hashkitcxx::sha2::sha512::digest_t & digest)
+    {
+        digest = co_await hashkitcxx::async_hash<hashkitcxx::sha2::sha512>(bytes);
+    }
+
+    /**
+     * @brief Hashes the message in chunks of the given sizes, repeated.
+     */
+    template<class TContext>
+    task hash_chunks(TContext & context,
+                     const std::vector<unsigned char> & bytes,
+                     const std::vector<size_t> & chunks,
+                     typename TContext::digest_t & digest)
+    {
+        size_t offset{0};
+        for (size_t i{0}; offset < bytes.size(); ++i)
+        {
+            const size_t len{std::min(chunks[i % chunks.size()], bytes.size() - offset)};
+            co_await context.update(bytes.data() + offset, len);
+            offset += len;
+        }
+        digest = context.complete();
+    }
+
+} // namespace hash_async
+
+BOOST_AUTO_TEST_SUITE(test_hash_async)
+BOOST_AUTO_TEST_CASE(test_async_hash)
+{
+    for (size_t len : {1, 999, 1000, 300000})
+    {
+        const std::vector<unsigned char> bytes{hash_async::message(len)};
+        hash_async::counting_executor executor;
+        hashkitcxx::sha2::sha256::digest_t digest{};
+        hash_async::task task{hash_async::hash_one(executor, bytes, digest)};
+        task.done.get();
+        BOOST_TEST((digest == hashkitcxx::sha2::sha256().hash(bytes.data(), bytes.size())));
+        BOOST_TEST(executor.tasks == (len < 1000 ? 0U : 1U));
+    }
+
+    const std::vector<unsigned char> bytes{hash_async::message(1 << 20)};
+    hashkitcxx::sha2::sha512::digest_t digest{};
+    hash_async::hash_default(bytes, digest).done.get();
+    BOOST_TEST((digest == hashkitcxx::sha2::sha512().hash(bytes.data(), bytes.size())));
+}
+
+BOOST_AUTO_TEST_CASE(test_async_context)
+{
+    const std::vector<unsigned char> bytes{hash_async::message(500000)};
+    const hashkitcxx::sha2::sha256::digest_t expected{
+        hashkitcxx::sha2::sha256().hash(bytes.data(), bytes.size())};
+
+    // small chunks hashed inline, the large ones on the executor
+    hash_async::counting_executor executor;
+    hashkitcxx::async_context<hashkitcxx::sha2::sha256, hash_async::counting_executor> context{
+        executor, 4096};
+    hashkitcxx::sha2::sha256::digest_t digest{};
+    hash_async::hash_chunks(context, bytes, {1, 63, 4096, 100000, 7}, digest).done.get();
+    BOOST_TEST((digest == expected));
+    BOOST_TEST(executor.tasks == 10U);
+
+    // the context is reused after init()
+    context.init();
+    hash_async::hash_chunks(context, bytes, {4095}, digest).done.get();
+    BOOST_TEST((digest == expected));
+    BOOST_TEST(executor.tasks == 10U);
+
+    hashkitcxx::async_context<hashkitcxx::sha2::sha384> pool_context;
+    hashkitcxx::sha2::sha384::digest_t digest384{};
+    hash_async::hash_chunks(pool_context, bytes, {200000, 3}, digest384).done.get();
+    BOOST_TEST((digest384 == hashkitcxx::sha2::sha384().hash(bytes.data(), bytes.size())));
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_async
+#endif
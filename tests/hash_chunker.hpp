@@ -0,0 +1,141 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_chunker.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+#include <set>
+#include <vector>
+
+namespace hash_chunker {
+
+    std::vector<unsigned char> make_content(size_t size, uint64_t seed)
+    {
+        std::vector<unsigned char> content(size);
+        uint64_t state{seed};
+        for (size_t i{0}; i < size; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            content[i] = static_cast<unsigned char>(state >> 56);
+        }
+        return content;
+    }
+
+    template<class THash>
+    std::vector<typename hashkitcxx::cdc::chunker<THash>::chunk_t>
+    split(const std::vector<unsigned char> & content,
+          size_t part_size,
+          const hashkitcxx::cdc::chunker_params & params = hashkitcxx::cdc::chunker_params{})
+    {
+        using chunk_t = typename hashkitcxx::cdc::chunker<THash>::chunk_t;
+
+        std::vector<chunk_t> chunks;
+        auto on_chunk = [&chunks](const chunk_t & chunk) { chunks.push_back(chunk); };
+
+        hashkitcxx::cdc::chunker<THash> chunker{params};
+        for (size_t offset{0}; offset < content.size(); offset += part_size)
+            chunker.update(&content[offset],
+                           std::min(part_size, content.size() - offset),
+                           on_chunk);
+        chunker.complete(on_chunk);
+        return chunks;
+    }
+
+    template<class THash>
+    void test_chunks(const std::vector<unsigned char> & content,
+                     const hashkitcxx::cdc::chunker_params & params)
+    {
+        const auto chunks = split<THash>(content, content.size() + 1, params);
+
+        uint64_t offset{0};
+        for (size_t i{0}; i < chunks.size(); ++i)
+        {
+            BOOST_TEST(chunks[i].offset == offset);
+            BOOST_TEST(chunks[i].size <= params.max_size);
+            if (i + 1 < chunks.size())
+                BOOST_TEST(chunks[i].size >= params.min_size);
+
+            const typename THash::digest_t expected{
+                hashkitcxx::hash<THash>(&content[offset], chunks[i].size)};
+            BOOST_TEST(std::memcmp(expected.data(), chunks[i].digest.data(), expected.size()) ==
+                       0);
+            offset += chunks[i].size;
+        }
+        BOOST_TEST(offset == content.size());
+    }
+
+} // namespace hash_chunker
+
+BOOST_AUTO_TEST_SUITE(test_hash_chunker)
+BOOST_AUTO_TEST_CASE(test_chunks)
+{
+    using namespace hashkitcxx::sha2;
+
+    const std::vector<unsigned char> content{hash_chunker::make_content(1024 * 1024, 1)};
+    hash_chunker::test_chunks<sha256>(content, hashkitcxx::cdc::chunker_params{});
+    hash_chunker::test_chunks<sha512_256>(content, hashkitcxx::cdc::chunker_params{});
+
+    hashkitcxx::cdc::chunker_params params;
+    params.min_size = 256;
+    params.avg_size = 1024;
+    params.max_size = 4096;
+    hash_chunker::test_chunks<sha256>(content, params);
+
+    // the average size is respected, within a reasonable margin
+    const auto chunks = hash_chunker::split<sha256>(content, content.size());
+    const size_t average{content.size() / chunks.size()};
+    BOOST_TEST(average >= 6 * 1024);
+    BOOST_TEST(average <= 12 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    size_t count{0};
+    hashkitcxx::cdc::chunker<hashkitcxx::sha2::sha256> chunker;
+    chunker.complete([&count](const hashkitcxx::cdc::chunker<hashkitcxx::sha2::sha256>::chunk_t &) {
+        ++count;
+    });
+    BOOST_TEST(count == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_streaming)
+{
+    using hashkitcxx::sha2::sha256;
+
+    // the boundaries do not depend on how the stream is split in parts
+    const std::vector<unsigned char> content{hash_chunker::make_content(300 * 1024, 2)};
+    const auto reference = hash_chunker::split<sha256>(content, content.size());
+    const size_t part_sizes[]{1, 63, 4096, 65537};
+    for (size_t part_size : part_sizes)
+    {
+        const auto chunks = hash_chunker::split<sha256>(content, part_size);
+        BOOST_REQUIRE(chunks.size() == reference.size());
+        for (size_t i{0}; i < chunks.size(); ++i)
+        {
+            BOOST_TEST(chunks[i].size == reference[i].size);
+            BOOST_TEST(chunks[i].digest == reference[i].digest);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_boundaries_shift)
+{
+    using hashkitcxx::sha2::sha256;
+
+    // inserting bytes at the beginning changes the first chunks only
+    const std::vector<unsigned char> content{hash_chunker::make_content(1024 * 1024, 3)};
+    std::vector<unsigned char> edited{content};
+    edited.insert(edited.begin() + 1000, 17, 0x5a);
+
+    std::set<sha256::digest_t> digests;
+    for (const auto & chunk : hash_chunker::split<sha256>(content, content.size()))
+        digests.insert(chunk.digest);
+
+    const auto chunks = hash_chunker::split<sha256>(edited, edited.size());
+    size_t shared{0};
+    for (const auto & chunk : chunks)
+        shared += digests.count(chunk.digest);
+    BOOST_TEST(shared + 3 >= chunks.size());
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_chunker
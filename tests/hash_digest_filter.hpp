@@ -0,0 +1,114 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <cstring>
+#include <hashkitcxx/hash_digest_filter.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <memory>
+#include <vector>
+
+namespace hash_digest_filter {
+
+    const char * const s_path{"hashkitcxx_test_digest_filter.bin"};
+
+    template<class THash>
+    typename THash::digest_t key(uint32_t i)
+    {
+        unsigned char message[4];
+        std::memcpy(message, &i, sizeof(message));
+        return THash().hash(message, sizeof(message));
+    }
+
+    /**
+     * @brief Checks that the inserted digests are all found, and that the others are rarely.
+     */
+    template<class THash>
+    void test_false_positives(const hashkitcxx::digest_filter & filter, uint32_t count)
+    {
+        std::vector<unsigned char> digests;
+        for (uint32_t i{0}; i < 2 * count; ++i)
+        {
+            const typename THash::digest_t digest{key<THash>(i)};
+            digests.insert(digests.end(), digest.begin(), digest.end());
+        }
+
+        std::unique_ptr<bool[]> found{new bool[2 * count]};
+        filter.contains(digests.data(), THash::s_digest_size, 2 * count, found.get());
+
+        size_t false_positives{0};
+        for (uint32_t i{0}; i < 2 * count; ++i)
+        {
+            BOOST_REQUIRE(found[i] == filter.contains(key<THash>(i)));
+            if (i < count)
+                BOOST_REQUIRE(found[i]);
+            else
+                false_positives += found[i] ? 1 : 0;
+        }
+        BOOST_TEST(false_positives < count / 100);
+    }
+
+    template<class THash>
+    void test_insert(uint32_t count)
+    {
+        hashkitcxx::digest_filter filter{count};
+        for (uint32_t i{0}; i < count; ++i)
+            filter.insert(key<THash>(i));
+        test_false_positives<THash>(filter, count);
+    }
+
+} // namespace hash_digest_filter
+
+BOOST_AUTO_TEST_SUITE(test_hash_digest_filter)
+BOOST_AUTO_TEST_CASE(test_insert)
+{
+    using namespace hashkitcxx::sha2;
+
+    hash_digest_filter::test_insert<sha256>(20000);
+    hash_digest_filter::test_insert<sha512_256>(20000);
+    hash_digest_filter::test_insert<sha224>(3000);
+    hash_digest_filter::test_insert<sha512>(3000);
+}
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    hashkitcxx::digest_filter filter;
+    BOOST_TEST(filter.block_count() == 1U);
+    BOOST_TEST(!filter.contains(hash_digest_filter::key<hashkitcxx::sha2::sha256>(0)));
+}
+
+BOOST_AUTO_TEST_CASE(test_save_open)
+{
+    using hashkitcxx::sha2::sha256;
+
+    {
+        hashkitcxx::digest_filter filter{10000, 16};
+        for (uint32_t i{0}; i < 10000; ++i)
+            filter.insert(hash_digest_filter::key<sha256>(i));
+        BOOST_REQUIRE(filter.save(hash_digest_filter::s_path));
+    }
+
+    {
+        hashkitcxx::digest_filter mapped;
+        BOOST_REQUIRE(mapped.open(hash_digest_filter::s_path));
+        BOOST_TEST(mapped.is_mapped());
+        BOOST_TEST(mapped.block_count() == 512U);
+        hash_digest_filter::test_false_positives<sha256>(mapped, 10000);
+    }
+
+    // the file is edited once it is no longer mapped, Windows refuses to write it otherwise
+    std::FILE * file{std::fopen(hash_digest_filter::s_path, "r+b")};
+    BOOST_REQUIRE(file != nullptr);
+    const unsigned char header[64]{'H', 'K', 'B', 'F', 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2};
+    std::fwrite(header, 1, sizeof(header), file);
+    std::fclose(file);
+
+    // a header not matching the size of the file is rejected and leaves the filter empty
+    hashkitcxx::digest_filter rejected{100, 16};
+    rejected.insert(hash_digest_filter::key<sha256>(0));
+    BOOST_TEST(!rejected.open(hash_digest_filter::s_path));
+    BOOST_TEST(!rejected.is_mapped());
+    BOOST_TEST(!rejected.contains(hash_digest_filter::key<sha256>(0)));
+    std::remove(hash_digest_filter::s_path);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_digest_filter
@@ -0,0 +1,179 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <cstring>
+#include <hashkitcxx/hash_digest_index.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <map>
+#include <vector>
+
+namespace hash_digest_index {
+
+    const char * const s_path{"hashkitcxx_test_digest_index.bin"};
+
+    using digest_t = hashkitcxx::sha2::sha256::digest_t;
+
+    digest_t key(uint32_t i)
+    {
+        unsigned char message[4];
+        std::memcpy(message, &i, sizeof(message));
+        return hashkitcxx::sha2::sha256().hash(message, sizeof(message));
+    }
+
+    /**
+     * @brief Builds an index of the given entries, 4 bytes payloads, and checks every lookup.
+     */
+    void test_build(const std::vector<digest_t> & digests, size_t memory_limit)
+    {
+        std::map<digest_t, uint32_t> expected;
+        {
+            hashkitcxx::digest_index_builder builder{s_path, 32, 4, memory_limit};
+            for (uint32_t i{0}; i < digests.size(); ++i)
+            {
+                unsigned char payload[4];
+                std::memcpy(payload, &i, sizeof(payload));
+                BOOST_REQUIRE(builder.add(digests[i].data(), payload));
+                expected.insert(std::make_pair(digests[i], i)); // the first payload is kept
+            }
+            BOOST_REQUIRE(builder.finish());
+        }
+
+        hashkitcxx::digest_index index;
+        BOOST_REQUIRE(index.open(s_path));
+        BOOST_TEST(index.size() == expected.size());
+        BOOST_TEST(index.digest_size() == 32U);
+        BOOST_TEST(index.payload_size() == 4U);
+
+        uint64_t position{0};
+        for (const auto & entry : expected)
+        {
+            BOOST_REQUIRE(std::memcmp(index.digest(position++), entry.first.data(), 32) == 0);
+
+            const unsigned char * payload{index.find(entry.first.data())};
+            BOOST_REQUIRE(payload != nullptr);
+            uint32_t value;
+            std::memcpy(&value, payload, sizeof(value));
+            BOOST_REQUIRE(value == entry.second);
+        }
+
+        // absent digests, around and between the present ones
+        for (const auto & entry : expected)
+        {
+            digest_t absent{entry.first};
+            absent[31] ^= 1;
+            BOOST_REQUIRE((index.find(absent.data()) != nullptr) == (expected.count(absent) == 1));
+        }
+    }
+
+} // namespace hash_digest_index
+
+BOOST_AUTO_TEST_SUITE(test_hash_digest_index)
+BOOST_AUTO_TEST_CASE(test_in_memory)
+{
+    std::vector<hash_digest_index::digest_t> digests;
+    for (uint32_t i{0}; i < 5000; ++i)
+        digests.push_back(hash_digest_index::key(i % 4000));
+
+    hash_digest_index::test_build(digests, 64 * 1024 * 1024);
+    std::remove(hash_digest_index::s_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_external)
+{
+    // a few entries per run, with duplicates spread across the runs
+    std::vector<hash_digest_index::digest_t> digests;
+    for (uint32_t i{0}; i < 5000; ++i)
+        digests.push_back(hash_digest_index::key(i * 7 % 3001));
+
+    hash_digest_index::test_build(digests, 36 * 100);
+    std::FILE * run{std::fopen("hashkitcxx_test_digest_index.bin.run0", "rb")};
+    BOOST_TEST(run == nullptr);
+    if (run != nullptr)
+        std::fclose(run);
+    std::remove(hash_digest_index::s_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_skewed)
+{
+    // digests far from uniform make the interpolation fall back to the binary search
+    std::vector<hash_digest_index::digest_t> digests(3000);
+    for (uint32_t i{0}; i < digests.size(); ++i)
+    {
+        digests[i].fill(0);
+        digests[i][0] = static_cast<uint8_t>(i % 3);
+        digests[i][1] = i < 2990 ? 0 : 0xff;
+        digests[i][2] = static_cast<uint8_t>(i * i >> 16);
+        digests[i][31] = static_cast<uint8_t>(i);
+        digests[i][30] = static_cast<uint8_t>(i >> 8);
+    }
+
+    hash_digest_index::test_build(digests, 64 * 1024 * 1024);
+    std::remove(hash_digest_index::s_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch)
+{
+    {
+        hashkitcxx::digest_index_builder builder{hash_digest_index::s_path, 32, 1};
+        for (uint32_t i{0}; i < 1000; i += 2)
+        {
+            const unsigned char payload{static_cast<unsigned char>(i)};
+            BOOST_REQUIRE(builder.add(hash_digest_index::key(i).data(), &payload));
+        }
+        BOOST_REQUIRE(builder.finish());
+    }
+
+    std::vector<unsigned char> digests;
+    for (uint32_t i{0}; i < 1000; ++i)
+    {
+        const hash_digest_index::digest_t digest{hash_digest_index::key(i)};
+        digests.insert(digests.end(), digest.begin(), digest.end());
+    }
+
+    hashkitcxx::digest_index index;
+    BOOST_REQUIRE(index.open(hash_digest_index::s_path));
+    std::vector<const unsigned char *> payloads(1000);
+    BOOST_TEST(index.find(digests.data(), 1000, payloads.data()) == 500U);
+    for (uint32_t i{0}; i < 1000; ++i)
+    {
+        if (i % 2 == 0)
+            BOOST_REQUIRE(payloads[i] != nullptr && *payloads[i] == static_cast<uint8_t>(i));
+        else
+            BOOST_REQUIRE(payloads[i] == nullptr);
+    }
+
+    index.close();
+    std::remove(hash_digest_index::s_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid)
+{
+    hashkitcxx::digest_index index;
+    BOOST_TEST(!index.open("hashkitcxx_test_missing_index.bin"));
+
+    {
+        hashkitcxx::digest_index_builder builder{hash_digest_index::s_path, 32, 8};
+        BOOST_REQUIRE(builder.finish());
+    }
+    BOOST_REQUIRE(index.open(hash_digest_index::s_path));
+    BOOST_TEST(index.size() == 0U);
+    const hash_digest_index::digest_t digest{hash_digest_index::key(0)};
+    BOOST_TEST(index.find(digest.data()) == nullptr);
+    index.close();
+
+    // a truncated file is rejected
+    std::FILE * file{std::fopen(hash_digest_index::s_path, "wb")};
+    BOOST_REQUIRE(file != nullptr);
+    const unsigned char header[100]{'H', 'K', 'D', 'I', 0, 0, 0, 1};
+    std::fwrite(header, 1, sizeof(header), file);
+    std::fclose(file);
+    BOOST_TEST(!index.open(hash_digest_index::s_path));
+    BOOST_TEST(!index.is_open());
+    std::remove(hash_digest_index::s_path);
+
+    hashkitcxx::digest_index_builder builder{hash_digest_index::s_path, 0, 8};
+    BOOST_TEST(!builder.add(digest.data(), digest.data()));
+    BOOST_TEST(!builder.finish());
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_digest_index
@@ -0,0 +1,118 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_digest_map.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <map>
+#include <vector>
+
+namespace hash_digest_map {
+
+    using map_t = hashkitcxx::digest_map<hashkitcxx::sha2::sha256, uint64_t>;
+
+    map_t::key_type key(uint64_t i)
+    {
+        unsigned char message[8];
+        std::memcpy(message, &i, sizeof(message));
+        return hashkitcxx::sha2::sha256().hash(message, sizeof(message));
+    }
+
+} // namespace hash_digest_map
+
+BOOST_AUTO_TEST_SUITE(test_hash_digest_map)
+BOOST_AUTO_TEST_CASE(test_insert_find_erase)
+{
+    using hash_digest_map::key;
+
+    // the map is compared with std::map while growing, erasing and reusing the tombstones
+    hash_digest_map::map_t map;
+    std::map<hash_digest_map::map_t::key_type, uint64_t> expected;
+    for (uint64_t i{0}; i < 20000; ++i)
+    {
+        BOOST_REQUIRE(map.insert(key(i), i));
+        expected[key(i)] = i;
+        if (i % 3 == 0)
+        {
+            BOOST_REQUIRE(map.erase(key(i / 2)) == (expected.erase(key(i / 2)) == 1));
+        }
+    }
+    BOOST_TEST(!map.insert(key(15000), 0));
+    BOOST_TEST(map.size() == expected.size());
+    BOOST_TEST(map.capacity() >= map.size());
+
+    for (uint64_t i{0}; i < 21000; ++i)
+    {
+        const uint64_t * value{map.find(key(i))};
+        const auto it = expected.find(key(i));
+        BOOST_REQUIRE((value != nullptr) == (it != expected.end()));
+        if (value != nullptr)
+            BOOST_REQUIRE(*value == it->second);
+    }
+
+    size_t count{0};
+    map.for_each([&](const hash_digest_map::map_t::key_type & k, uint64_t v) {
+        BOOST_REQUIRE(expected.at(k) == v);
+        ++count;
+    });
+    BOOST_TEST(count == expected.size());
+
+    map[key(15000)] = 42;
+    BOOST_TEST(*map.find(key(15000)) == 42U);
+    BOOST_TEST(map[key(30000)] == 0U);
+    BOOST_TEST(map.contains(key(30000)));
+
+    map.clear();
+    BOOST_TEST(map.empty());
+    BOOST_TEST(!map.contains(key(15000)));
+}
+
+BOOST_AUTO_TEST_CASE(test_same_prefix)
+{
+    // keys sharing their first 8 bytes start in the same group with the same tag, so they fill
+    // several groups and are told apart by the full comparison
+    hash_digest_map::map_t map;
+    std::vector<hash_digest_map::map_t::key_type> keys(100);
+    for (size_t i{0}; i < keys.size(); ++i)
+    {
+        keys[i].fill(0x5a);
+        keys[i][31] = static_cast<uint8_t>(i);
+        BOOST_REQUIRE(map.insert(keys[i], i));
+    }
+    for (size_t i{0}; i < keys.size(); i += 2)
+        BOOST_REQUIRE(map.erase(keys[i]));
+    for (size_t i{0}; i < keys.size(); ++i)
+    {
+        const uint64_t * value{map.find(keys[i])};
+        BOOST_REQUIRE((value != nullptr) == (i % 2 == 1));
+        if (value != nullptr)
+            BOOST_REQUIRE(*value == i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk)
+{
+    std::vector<hash_digest_map::map_t::key_type> keys;
+    std::vector<uint64_t> values;
+    for (uint64_t i{0}; i < 1000; ++i)
+    {
+        keys.push_back(hash_digest_map::key(i));
+        values.push_back(i * 10);
+    }
+
+    hash_digest_map::map_t map;
+    BOOST_TEST(map.insert(keys.data(), values.data(), 600) == 600U);
+    BOOST_TEST(map.insert(keys.data(), values.data(), keys.size()) == 400U);
+
+    map.erase(keys[7]);
+    std::vector<const uint64_t *> found(keys.size());
+    BOOST_TEST(map.find(keys.data(), keys.size(), found.data()) == 999U);
+    for (size_t i{0}; i < keys.size(); ++i)
+    {
+        if (i == 7)
+            BOOST_TEST(found[i] == nullptr);
+        else
+            BOOST_REQUIRE(*found[i] == values[i]);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_digest_map
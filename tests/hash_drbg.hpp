@@ -0,0 +1,155 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_drbg.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <string>
+#include <vector>
+
+namespace hash_drbg {
+
+    std::vector<unsigned char> from_hex(const std::string & hex)
+    {
+        std::vector<unsigned char> bytes;
+        for (size_t i{0}; i + 1 < hex.size(); i += 2)
+            bytes.push_back(static_cast<unsigned char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+        return bytes;
+    }
+
+    std::vector<unsigned char> sequence(unsigned char first, size_t len)
+    {
+        std::vector<unsigned char> bytes(len);
+        for (size_t i{0}; i < len; ++i)
+            bytes[i] = static_cast<unsigned char>(first + i);
+        return bytes;
+    }
+
+    /**
+     * @brief Instantiates with a personalization string, generates with and without additional
+     * input, reseeds and generates again. The expected values come from a direct implementation
+     * of SP 800-90A in Python with hashlib.
+     */
+    template<class THash>
+    void test_sequence(const char * first, const char * second_sha256, const char * third)
+    {
+        const std::vector<unsigned char> entropy{sequence(0, 32)};
+        const std::vector<unsigned char> nonce{sequence(100, 16)};
+        const std::string personalization{"personalization"};
+        const std::string additional{"additional"};
+        const std::string reseed_additional{"reseed"};
+
+        hashkitcxx::hash_drbg<THash> drbg;
+        BOOST_TEST(drbg.reseed_counter() == 0U);
+        BOOST_REQUIRE(drbg.instantiate(entropy.data(),
+                                       entropy.size(),
+                                       nonce.data(),
+                                       nonce.size(),
+                                       reinterpret_cast<const unsigned char *>(
+                                           personalization.data()),
+                                       personalization.size()));
+
+        unsigned char output[1000];
+        BOOST_REQUIRE(drbg.generate(output, 100));
+        BOOST_TEST(common::to_hex(output, 32) == first);
+
+        BOOST_REQUIRE(drbg.generate(output,
+                                    1000,
+                                    reinterpret_cast<const unsigned char *>(additional.data()),
+                                    additional.size()));
+        BOOST_TEST(common::to_hex(hashkitcxx::sha2::sha256().hash(output, 1000).data(), 32) ==
+                   second_sha256);
+        BOOST_TEST(drbg.reseed_counter() == 3U);
+
+        const std::vector<unsigned char> reseed_entropy{sequence(64, 32)};
+        BOOST_REQUIRE(drbg.reseed(reseed_entropy.data(),
+                                  reseed_entropy.size(),
+                                  reinterpret_cast<const unsigned char *>(
+                                      reseed_additional.data()),
+                                  reseed_additional.size()));
+        BOOST_TEST(drbg.reseed_counter() == 1U);
+        BOOST_REQUIRE(drbg.generate(output, 64));
+        BOOST_TEST(common::to_hex(output, 32) == third);
+    }
+
+} // namespace hash_drbg
+
+BOOST_AUTO_TEST_SUITE(test_hash_drbg)
+BOOST_AUTO_TEST_CASE(test_nist)
+{
+    // CAVP Hash_DRBG SHA-256, no prediction resistance, no personalization or additional input:
+    // the second 1024 bits generated after instantiation
+    const std::vector<unsigned char> entropy{hash_drbg::from_hex(
+        "a65ad0f345db4e0effe875c3a2e71f42c7129d620ff5c119a9ef55f05185e0fb")};
+    const std::vector<unsigned char> nonce{
+        hash_drbg::from_hex("8581f9317517276e06e9607ddbcbcc2e")};
+
+    hashkitcxx::hash_drbg<hashkitcxx::sha2::sha256> drbg;
+    BOOST_REQUIRE(drbg.instantiate(entropy.data(), entropy.size(), nonce.data(), nonce.size()));
+    unsigned char output[128];
+    BOOST_REQUIRE(drbg.generate(output, sizeof(output)));
+    BOOST_REQUIRE(drbg.generate(output, sizeof(output)));
+    BOOST_TEST(common::to_hex(output, sizeof(output)) ==
+               "d3e160c35b99f340b2628264d1751060e0045da383ff57a57d73a673d2b8d80d"
+               "aaf6a6c35a91bb4579d73fd0c8fed111b0391306828adfed528f018121b3febd"
+               "c343e797b87dbb63db1333ded9d1ece177cfa6b71fe8ab1da46624ed6415e51c"
+               "cde2c7ca86e283990eeaeb91120415528b2295910281b02dd431f4c9f70427df");
+}
+
+BOOST_AUTO_TEST_CASE(test_algorithms)
+{
+    using namespace hashkitcxx::sha2;
+
+    hash_drbg::test_sequence<sha224>(
+        "fd4824473f45b6c0d18d51f4318b21ee9b9c0c38421cfc13280f2a913f58ffce",
+        "0520c0b21ef1bb615ae44b90663ca6f600bc6e3258309fbcbc42b231280f34e8",
+        "eb823fe01420eb718f509c6406b427f4ef6efc97e24e46ed8ffe4f66f0aeef03");
+    hash_drbg::test_sequence<sha256>(
+        "19854d0c029310c5fc84c6a40f4df718e8d01587f40f6c7001a3cf06a037e041",
+        "5b8304c88e7eeba786fc445113c109fd6b7a7180d2249920c240d25a19befc5f",
+        "68be48496d81be2e8f0771f7d825011d3214469f0dd41055bd6a927fbc3f8e1f");
+    hash_drbg::test_sequence<sha384>(
+        "d59caa2ed9170c26d4cf9e486acabe80f0ef52cfd90441774a69fe1b4f0cc9db",
+        "a4dfcc9ad8a5c5fdd64b9267b71f3d438ce14a0b025bfb949a9d1d8b9807edb9",
+        "f0fbd8eb4eafb6a2dd82af3b479dcdd129f59680e77e8d26cdd9961a13f585dd");
+    hash_drbg::test_sequence<sha512>(
+        "b86b1148a0eb4875ea6542cc322356db6991a470246041215096447ee08a262e",
+        "aa4f54ad07b713622ade0b1c29d22a38731de2a8347f385be88641d7a0aa438a",
+        "7657260ae74ecf29d1ebcd36d11a2bfab83643db4e3ed78cbb4808d63f45a507");
+    hash_drbg::test_sequence<sha512_224>(
+        "31202244dd134945fa11c3aed46c91c5048b5fdc00bf241660f104a33654fb28",
+        "e01e4df47e368d910c331f413c4387947d316aacc23a0531da29c66c2d70c64d",
+        "34ac4b8ba955aee6e61634c812b83a29fd34c31135c5b1a1dfcf7f5e6d594eb4");
+    hash_drbg::test_sequence<sha512_256>(
+        "603bb3e7d55bf19cf99fada41a0c13d8a32089874c1493c6be41a08471813305",
+        "14a94825c0c852a2e5badbf1a37772fab31d2f0ca29d4449dde5101a2d6623fe",
+        "f0810e712d25280f9125bdf185483ed759c4689f6d7b7e29ebf326b090a94d8d");
+}
+
+BOOST_AUTO_TEST_CASE(test_limits)
+{
+    using drbg_t = hashkitcxx::hash_drbg<hashkitcxx::sha2::sha256>;
+
+    const std::vector<unsigned char> entropy{hash_drbg::sequence(0, 32)};
+    std::vector<unsigned char> output(3 * drbg_t::s_max_request_size + 10);
+
+    drbg_t drbg;
+    BOOST_TEST(!drbg.generate(output.data(), 1));
+    BOOST_TEST(!drbg.instantiate(entropy.data(), 31, entropy.data(), 16));
+    BOOST_TEST(!drbg.instantiate(entropy.data(), 32, entropy.data(), 15));
+    BOOST_REQUIRE(drbg.instantiate(entropy.data(), 32, entropy.data(), 16));
+    BOOST_TEST(!drbg.generate(output.data(), drbg_t::s_max_request_size + 1));
+
+    // fill() splits the buffer in requests of the maximum size
+    drbg_t same;
+    BOOST_REQUIRE(same.instantiate(entropy.data(), 32, entropy.data(), 16));
+    BOOST_REQUIRE(drbg.fill(output.data(), output.size()));
+    BOOST_TEST(drbg.reseed_counter() == 5U);
+    std::vector<unsigned char> expected(drbg_t::s_max_request_size);
+    BOOST_REQUIRE(same.generate(expected.data(), expected.size()));
+    BOOST_REQUIRE(same.generate(expected.data(), expected.size()));
+    BOOST_TEST(std::memcmp(output.data() + expected.size(), expected.data(), expected.size()) ==
+               0);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_drbg
@@ -0,0 +1,173 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <cstring>
+#include <hashkitcxx/hash_file.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <vector>
+
+namespace hash_file {
+
+    const char * const s_path{"hashkitcxx_test_hash_file.bin"};
+
+    std::vector<unsigned char> make_content(size_t size)
+    {
+        std::vector<unsigned char> content(size);
+        for (size_t i{0}; i < size; ++i)
+            content[i] = static_cast<unsigned char>(i * 131 + (i >> 11));
+        return content;
+    }
+
+    bool exists(const char * path)
+    {
+        std::FILE * file{std::fopen(path, "rb")};
+        if (file == nullptr)
+            return false;
+        std::fclose(file);
+        return true;
+    }
+
+    void write_file(const std::vector<unsigned char> & content)
+    {
+        std::FILE * file{std::fopen(s_path, "wb")};
+        BOOST_REQUIRE(file != nullptr);
+        BOOST_REQUIRE(std::fwrite(content.data(), 1, content.size(), file) == content.size());
+        std::fclose(file);
+    }
+
+    template<class THash>
+    void test_backends(const std::vector<unsigned char> & content)
+    {
+        // the library asserts a valid pointer even for an empty message
+        const unsigned char empty{0};
+        THash h;
+        unsigned char expected[THash::s_digest_size];
+        h.hash(content.empty() ? &empty : content.data(), content.size(), expected);
+
+        const hashkitcxx::file_backend backends[]{hashkitcxx::file_backend::automatic,
+                                                  hashkitcxx::file_backend::library,
+                                                  hashkitcxx::file_backend::kernel};
+        for (hashkitcxx::file_backend backend : backends)
+        {
+            hashkitcxx::hash_file_options options;
+            options.backend = backend;
+            options.kernel_threshold = 4096;
+
+            unsigned char digest[THash::s_digest_size]{};
+            BOOST_TEST(hashkitcxx::hash_file<THash>(s_path, digest, options));
+            BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+        }
+    }
+
+    void test_all(size_t size)
+    {
+        using namespace hashkitcxx::sha2;
+
+        const std::vector<unsigned char> content{make_content(size)};
+        write_file(content);
+
+        test_backends<sha224>(content);
+        test_backends<sha256>(content);
+        test_backends<sha384>(content);
+        test_backends<sha512>(content);
+        test_backends<sha512_224>(content);
+        test_backends<sha512_256>(content);
+
+        std::remove(s_path);
+    }
+
+} // namespace hash_file
+
+BOOST_AUTO_TEST_SUITE(test_hash_file)
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    hash_file::test_all(0);
+}
+
+BOOST_AUTO_TEST_CASE(test_small)
+{
+    hash_file::test_all(1);
+    hash_file::test_all(111);
+}
+
+BOOST_AUTO_TEST_CASE(test_large)
+{
+    // larger than the kernel threshold, the buffer of the library and the pipe of the kernel
+    hash_file::test_all(64 * 1024 + 3);
+    hash_file::test_all(3 * 1024 * 1024 + 17);
+}
+
+BOOST_AUTO_TEST_CASE(test_missing_file)
+{
+    unsigned char digest[hashkitcxx::sha2::sha256::s_digest_size]{};
+    hashkitcxx::hash_file_options options;
+    options.backend = hashkitcxx::file_backend::kernel;
+    BOOST_TEST(!hashkitcxx::hash_file<hashkitcxx::sha2::sha256>(
+        "hashkitcxx_test_missing_file.bin", digest, options));
+    BOOST_TEST(!hashkitcxx::hash_file<hashkitcxx::sha2::sha256>(
+        "hashkitcxx_test_missing_file.bin", digest));
+}
+
+BOOST_AUTO_TEST_CASE(test_checkpoint)
+{
+    using hashkitcxx::sha2::sha256;
+
+    const char * checkpoint_path{"hashkitcxx_test_hash_file.checkpoint"};
+    const std::vector<unsigned char> content{hash_file::make_content(3 * 1024 * 1024 + 5)};
+    hash_file::write_file(content);
+
+    const sha256::digest_t expected{sha256().hash(content.data(), content.size())};
+
+    hashkitcxx::hash_file_options options;
+    options.checkpoint_interval = 1024 * 1024;
+    options.checkpoint_path = checkpoint_path;
+
+    // no checkpoint yet: the whole file is hashed, then the checkpoint is removed
+    sha256::digest_t digest{};
+    BOOST_TEST(hashkitcxx::hash_file<sha256>(hash_file::s_path, digest.data(), options));
+    BOOST_TEST(digest == expected);
+    BOOST_TEST(!hash_file::exists(checkpoint_path));
+
+    // interrupted after 1 MB and some bytes
+    const size_t interrupted{1024 * 1024 + 100};
+    sha256 h;
+    h.init();
+    h.update(content.data(), interrupted);
+    unsigned char state[sha256::s_state_size];
+    h.save(state);
+    BOOST_TEST(hashkitcxx::checkpoint::save(checkpoint_path, state, sizeof(state)));
+
+    BOOST_TEST(hashkitcxx::hash_file<sha256>(hash_file::s_path, digest.data(), options));
+    BOOST_TEST(digest == expected);
+    BOOST_TEST(!hash_file::exists(checkpoint_path));
+
+    // the checkpoint is really used: a state with a different beginning changes the hash
+    std::vector<unsigned char> other{content};
+    other[0] ^= 1;
+    h.init();
+    h.update(other.data(), interrupted);
+    h.save(state);
+    BOOST_TEST(hashkitcxx::checkpoint::save(checkpoint_path, state, sizeof(state)));
+    BOOST_TEST(hashkitcxx::hash_file<sha256>(hash_file::s_path, digest.data(), options));
+    BOOST_TEST(digest == sha256().hash(other.data(), other.size()));
+
+    // a checkpoint beyond the end of the file is ignored
+    h.init();
+    for (size_t i{0}; i < 4; ++i)
+        h.update(content.data(), content.size());
+    h.save(state);
+    BOOST_TEST(hashkitcxx::checkpoint::save(checkpoint_path, state, sizeof(state)));
+    BOOST_TEST(hashkitcxx::hash_file<sha256>(hash_file::s_path, digest.data(), options));
+    BOOST_TEST(digest == expected);
+
+    std::remove(hash_file::s_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_kernel_available)
+{
+    // the answer depends on the kernel, but it must be consistent with the algorithms it supports
+    BOOST_TEST(!hashkitcxx::afalg::available("not-a-hash-algorithm"));
+    BOOST_TEST(hashkitcxx::afalg::algorithm<hashkitcxx::sha2::sha512_224>::name() == nullptr);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_file
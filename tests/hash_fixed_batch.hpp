@@ -0,0 +1,90 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_fixed_batch.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha512_t.hpp>
+#include <vector>
+
+namespace hash_fixed_batch {
+
+    /**
+     * @brief Compares each digest of the batch with the hash of its key, for batches filling the
+     * lanes or not.
+     */
+    template<class THash, size_t Len>
+    void test_batch()
+    {
+        for (size_t count : {0, 1, 7, 8, 9, 17, 100})
+        {
+            // one more byte, so that the keys are not null when empty
+            std::vector<unsigned char> keys(count * Len + 1);
+            for (size_t i{0}; i < keys.size(); ++i)
+                keys[i] = static_cast<unsigned char>(i * 11 + count);
+            std::vector<unsigned char> digests(count * THash::s_digest_size + 1, 0xee);
+
+            hashkitcxx::hash_fixed_batch<THash, Len>(keys.data(), count, digests.data());
+            for (size_t k{0}; k < count; ++k)
+            {
+                const typename THash::digest_t expected{THash().hash(keys.data() + k * Len, Len)};
+                BOOST_TEST(std::memcmp(digests.data() + k * THash::s_digest_size, expected.data(),
+                                       expected.size()) == 0);
+            }
+            BOOST_TEST(digests.back() == 0xee);
+        }
+    }
+
+    /**
+     * @brief The lengths around the boundaries of the padding.
+     */
+    template<class THash>
+    void test_lengths()
+    {
+        test_batch<THash, 0>();
+        test_batch<THash, 1>();
+        test_batch<THash, 20>();
+        test_batch<THash, 32>();
+        test_batch<THash, 55>();
+        test_batch<THash, 56>();
+        test_batch<THash, 64>();
+        test_batch<THash, 100>();
+        test_batch<THash, 111>();
+        test_batch<THash, 112>();
+        test_batch<THash, 128>();
+        test_batch<THash, 300>();
+    }
+
+} // namespace hash_fixed_batch
+
+BOOST_AUTO_TEST_SUITE(test_hash_fixed_batch)
+BOOST_AUTO_TEST_CASE(test_sha256)
+{
+    hash_fixed_batch::test_lengths<hashkitcxx::sha2::sha224>();
+    hash_fixed_batch::test_lengths<hashkitcxx::sha2::sha256>();
+}
+
+BOOST_AUTO_TEST_CASE(test_sha512)
+{
+    hash_fixed_batch::test_lengths<hashkitcxx::sha2::sha384>();
+    hash_fixed_batch::test_lengths<hashkitcxx::sha2::sha512>();
+    hash_fixed_batch::test_lengths<hashkitcxx::sha2::sha512_256>();
+    hash_fixed_batch::test_batch<hashkitcxx::sha2::sha512_t<160>, 32>();
+}
+
+BOOST_AUTO_TEST_CASE(test_padding)
+{
+    using pad56 = hashkitcxx::fixed_batch_impl::padding<hashkitcxx::sha2::sha256, 56>;
+    BOOST_TEST(pad56::s_full_blocks == 0U);
+    BOOST_TEST(pad56::s_tail_blocks == 2U);
+    BOOST_TEST(pad56::s_constant_blocks == 1U);
+    BOOST_TEST(pad56::s_tail[56] == 0x80);
+    BOOST_TEST(pad56::s_tail[126] == 0x01);
+    BOOST_TEST(pad56::s_tail[127] == 0xc0);
+
+    using pad128 = hashkitcxx::fixed_batch_impl::padding<hashkitcxx::sha2::sha512, 128>;
+    BOOST_TEST(pad128::s_full_blocks == 1U);
+    BOOST_TEST(pad128::s_tail_blocks == 1U);
+    BOOST_TEST(pad128::s_constant_blocks == 1U);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_fixed_batch
@@ -0,0 +1,159 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_merkle.hpp>
+#include <string>
+#include <vector>
+
+namespace hash_merkle {
+
+    using hashkitcxx::merkle::digest_t;
+
+    /**
+     * @brief The leaves of the test vectors of the Certificate Transparency implementations.
+     */
+    const std::vector<std::vector<unsigned char>> s_leaves{
+        {},
+        {0x00},
+        {0x10},
+        {0x20, 0x21},
+        {0x30, 0x31},
+        {0x40, 0x41, 0x42, 0x43},
+        {0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57},
+        {0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,
+         0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f}};
+
+    std::string to_hex(const digest_t & digest)
+    {
+        char hex[2 * 32 + 1]{};
+        common::to_hex(digest.data(), digest.size(), hex);
+        return hex;
+    }
+
+    std::vector<unsigned char> make_leaf(size_t i)
+    {
+        return std::vector<unsigned char>(i % 50, static_cast<unsigned char>(i));
+    }
+
+    const unsigned char * data(const std::vector<unsigned char> & leaf)
+    {
+        static const unsigned char empty{0};
+        return leaf.empty() ? &empty : leaf.data();
+    }
+
+} // namespace hash_merkle
+
+BOOST_AUTO_TEST_SUITE(test_hash_merkle)
+BOOST_AUTO_TEST_CASE(test_roots)
+{
+    using namespace hashkitcxx::merkle;
+
+    const char * const expected[]{
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+        "6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d",
+        "fac54203e7cc696cf0dfcb42c92a1d9dbaf70ad9e621f4bd8d98662f00e3c125",
+        "aeb6bcfe274b70a14fb067a5e5578264db0fa9b51af5e0ba159158f329e06e77",
+        "d37ee418976dd95753c1c73862b9398fa2a2cf9b4ff0fdfe8b30cd95209614b7",
+        "4e3bbb1f7b478dcfe71fb631631519a3bca12c9aefca1612bfce4c13a86264d4",
+        "76e67dadbcdf1e10e1b74ddc608abd2f98dfb16fbce75277b5232a127f2087ef",
+        "ddb89be403809e325750d3d263cd78929c2942b7942a34b77e122c9594a74c8c",
+        "5dc9da79a70659a9ad559cb701ded9a2ab9d823aad2f4960cfe370eff4604328"};
+
+    accumulator acc;
+    tree log;
+    BOOST_TEST(hash_merkle::to_hex(acc.root()) == expected[0]);
+    BOOST_TEST(hash_merkle::to_hex(log.root()) == expected[0]);
+    for (size_t i{0}; i < hash_merkle::s_leaves.size(); ++i)
+    {
+        const std::vector<unsigned char> & leaf{hash_merkle::s_leaves[i]};
+        acc.append(hash_merkle::data(leaf), leaf.size());
+        log.append(hash_merkle::data(leaf), leaf.size());
+        BOOST_TEST(acc.size() == i + 1);
+        BOOST_TEST(hash_merkle::to_hex(acc.root()) == expected[i + 1]);
+        BOOST_TEST(hash_merkle::to_hex(log.root()) == expected[i + 1]);
+    }
+
+    // the tree keeps the roots of the previous versions
+    for (uint64_t size{0}; size <= log.size(); ++size)
+        BOOST_TEST(hash_merkle::to_hex(log.root(size)) == expected[size]);
+}
+
+BOOST_AUTO_TEST_CASE(test_proofs)
+{
+    using namespace hashkitcxx::merkle;
+
+    tree log;
+    std::vector<digest_t> roots{log.root()};
+    for (size_t i{0}; i < 70; ++i)
+    {
+        const std::vector<unsigned char> leaf{hash_merkle::make_leaf(i)};
+        log.append(hash_merkle::data(leaf), leaf.size());
+        roots.push_back(log.root());
+    }
+
+    for (uint64_t size{1}; size <= log.size(); ++size)
+    {
+        for (uint64_t index{0}; index < size; ++index)
+        {
+            std::vector<digest_t> proof{log.inclusion_proof(index, size)};
+            BOOST_REQUIRE(verify_inclusion(
+                index, size, log.leaf(index), proof.data(), proof.size(), roots[size]));
+            BOOST_REQUIRE(!verify_inclusion(
+                index, size, log.leaf(index), proof.data(), proof.size(), roots[size - 1]));
+            if (!proof.empty())
+            {
+                proof.back()[0] ^= 1;
+                BOOST_REQUIRE(!verify_inclusion(
+                    index, size, log.leaf(index), proof.data(), proof.size(), roots[size]));
+            }
+        }
+
+        for (uint64_t first{1}; first <= size; ++first)
+        {
+            std::vector<digest_t> proof{log.consistency_proof(first, size)};
+            BOOST_REQUIRE(verify_consistency(
+                first, size, roots[first], roots[size], proof.data(), proof.size()));
+            if (!proof.empty())
+            {
+                BOOST_REQUIRE(!verify_consistency(
+                    first, size, roots[first - 1], roots[size], proof.data(), proof.size()));
+                proof.front()[31] ^= 1;
+                BOOST_REQUIRE(!verify_consistency(
+                    first, size, roots[first], roots[size], proof.data(), proof.size()));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk)
+{
+    using namespace hashkitcxx::merkle;
+
+    std::vector<std::vector<unsigned char>> leaves;
+    std::vector<const unsigned char *> pointers;
+    std::vector<size_t> sizes;
+    for (size_t i{0}; i < 5000; ++i)
+        leaves.push_back(hash_merkle::make_leaf(i));
+    for (const std::vector<unsigned char> & leaf : leaves)
+    {
+        pointers.push_back(hash_merkle::data(leaf));
+        sizes.push_back(leaf.size());
+    }
+
+    accumulator sequential;
+    for (size_t i{0}; i < leaves.size(); ++i)
+        sequential.append(pointers[i], sizes[i]);
+
+    accumulator acc;
+    tree log;
+    acc.append(pointers.data(), sizes.data(), 1000, 1);
+    acc.append(pointers.data() + 1000, sizes.data() + 1000, leaves.size() - 1000, 4);
+    log.append(pointers.data(), sizes.data(), leaves.size(), 4);
+
+    BOOST_TEST(acc.size() == leaves.size());
+    BOOST_TEST(log.size() == leaves.size());
+    BOOST_TEST(acc.root() == sequential.root());
+    BOOST_TEST(log.root() == sequential.root());
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_merkle
@@ -0,0 +1,191 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_nonce_search.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha2_core.hpp>
+#include <hashkitcxx/hash_sha2_lanes.hpp>
+#include <vector>
+
+namespace hash_nonce_search {
+
+    /**
+     * @brief The lowest nonce reaching the target, hashing the whole message for each nonce.
+     */
+    bool brute_force(const hashkitcxx::nonce_search_params & params, uint64_t & nonce)
+    {
+        std::vector<unsigned char> bytes(params.message, params.message + params.len);
+        for (uint64_t n{params.first}; n - params.first < params.count; ++n)
+        {
+            for (size_t i{0}; i < params.nonce_size; ++i)
+            {
+                const size_t shift{8 * (params.little_endian ? i : params.nonce_size - 1 - i)};
+                bytes[params.nonce_offset + i] = static_cast<unsigned char>(n >> shift);
+            }
+            const hashkitcxx::sha2::sha256::digest_t digest{
+                hashkitcxx::sha2::sha256().hash(bytes.data(), bytes.size())};
+            if (std::memcmp(digest.data(), params.target.data(), digest.size()) <= 0)
+            {
+                nonce = n;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void test_search(size_t len, size_t nonce_offset, size_t nonce_size, bool little_endian)
+    {
+        const std::vector<unsigned char> bytes{common::message(len)};
+        hashkitcxx::nonce_search_params params;
+        params.message = bytes.data();
+        params.len = bytes.size();
+        params.nonce_offset = nonce_offset;
+        params.nonce_size = nonce_size;
+        params.little_endian = little_endian;
+        params.target.fill(0xff);
+        params.target[0] = 0x03;
+        params.first = 1000;
+        params.count = 3000;
+
+        uint64_t expected{0};
+        BOOST_REQUIRE(brute_force(params, expected));
+        for (unsigned threads : {1U, 4U})
+        {
+            params.threads = threads;
+            uint64_t nonce{0};
+            unsigned char digest[32];
+            BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce, digest));
+            BOOST_TEST(nonce == expected);
+            BOOST_TEST(digest[0] <= 0x03);
+            BOOST_TEST(hashkitcxx::check_nonce(params, nonce));
+        }
+
+        // a range ending just before the nonce found
+        params.count = expected - params.first;
+        uint64_t nonce{0};
+        BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    }
+
+} // namespace hash_nonce_search
+
+BOOST_AUTO_TEST_SUITE(test_hash_nonce_search)
+BOOST_AUTO_TEST_CASE(test_lanes)
+{
+    const std::vector<unsigned char> blocks{common::message(8 * 64)};
+    uint32_t h[8][8];
+    uint32_t words[16][8];
+    for (size_t lane{0}; lane < 8; ++lane)
+    {
+        for (size_t i{0}; i < 8; ++i)
+            h[i][lane] = hashkitcxx::sha2::sha256_h0[i];
+        for (size_t t{0}; t < 16; ++t)
+        {
+            const unsigned char * word{blocks.data() + lane * 64 + 4 * t};
+            words[t][lane] = (static_cast<uint32_t>(word[0]) << 24) |
+                             (static_cast<uint32_t>(word[1]) << 16) |
+                             (static_cast<uint32_t>(word[2]) << 8) | word[3];
+        }
+    }
+    hashkitcxx::sha2::lanes::sha256_compress(h, words);
+
+    for (size_t lane{0}; lane < 8; ++lane)
+    {
+        uint32_t expected[8];
+        std::memcpy(expected, hashkitcxx::sha2::sha256_h0.data(), sizeof(expected));
+        hashkitcxx::sha2::sha256::compress(expected, blocks.data() + lane * 64, 1);
+        for (size_t i{0}; i < 8; ++i)
+            BOOST_TEST(h[i][lane] == expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_positions)
+{
+    // nonce in the only block, in a later block, across two blocks, and in a last block whose
+    // padding needs one more block
+    hash_nonce_search::test_search(40, 0, 8, false);
+    hash_nonce_search::test_search(40, 13, 4, true);
+    hash_nonce_search::test_search(200, 150, 8, false);
+    hash_nonce_search::test_search(200, 60, 8, true);
+    hash_nonce_search::test_search(120, 114, 3, false);
+    hash_nonce_search::test_search(64, 56, 8, false);
+}
+
+BOOST_AUTO_TEST_CASE(test_parameters)
+{
+    const std::vector<unsigned char> bytes{common::message(80)};
+    hashkitcxx::nonce_search_params params;
+    params.message = bytes.data();
+    params.len = bytes.size();
+    params.nonce_offset = 72;
+    params.target.fill(0xff);
+    params.count = 10;
+
+    uint64_t nonce{1};
+    BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(nonce == 0U);
+
+    params.count = 0;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    params.count = 10;
+    params.nonce_offset = 73;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    params.nonce_offset = 72;
+    params.nonce_size = 0;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    params.nonce_size = 9;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+
+    // the range stops at the largest nonce fitting in nonce_size bytes
+    params.nonce_size = 1;
+    params.first = 256;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(!hashkitcxx::check_nonce(params, 256));
+    params.first = 250;
+    params.count = UINT64_MAX;
+    params.target.fill(0);
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    params.target.fill(0xff);
+    BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(nonce == 250U);
+
+    params.nonce_size = 8;
+    params.first = UINT64_MAX;
+    params.count = 1;
+    BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(nonce == UINT64_MAX);
+
+    // ranges ending at or near UINT64_MAX, whose last batch and chunk must not wrap to 0
+    params.first = UINT64_MAX - 20;
+    params.count = 21;
+    BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(nonce == UINT64_MAX - 20);
+    params.count = UINT64_MAX;
+    BOOST_REQUIRE(hashkitcxx::find_nonce(params, nonce));
+    BOOST_TEST(nonce == UINT64_MAX - 20);
+
+    params.target.fill(0);
+    params.first = UINT64_MAX - 10;
+    params.count = 10;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+    params.count = 11;
+    BOOST_TEST(!hashkitcxx::find_nonce(params, nonce));
+
+    params.target.fill(0xff);
+    params.target[0] = 0x03;
+    for (uint64_t first : {UINT64_MAX - 300, UINT64_MAX - (1 << 14) - 5})
+    {
+        for (uint64_t count : {UINT64_MAX - first + 1, UINT64_MAX - first - 3})
+        {
+            params.first = first;
+            params.count = count;
+            uint64_t expected{0};
+            const bool reachable{hash_nonce_search::brute_force(params, expected)};
+            BOOST_TEST(hashkitcxx::find_nonce(params, nonce) == reachable);
+            if (reachable)
+                BOOST_TEST(nonce == expected);
+        }
+    }
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_nonce_search
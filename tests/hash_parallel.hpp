@@ -0,0 +1,138 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <functional>
+#include <hashkitcxx/hash_parallel.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <vector>
+
+namespace hash_parallel {
+
+    /**
+     * @brief Runs the tasks on the calling thread.
+     */
+    struct inline_executor
+    {
+        size_t tasks{0};
+
+        void execute(std::function<void()> task)
+        {
+            ++tasks;
+            task();
+        }
+
+        unsigned concurrency() const noexcept
+        {
+            return 4;
+        }
+    };
+
+    /**
+     * @brief Messages of the given sizes, with different contents.
+     */
+    struct messages_t
+    {
+        explicit messages_t(const std::vector<size_t> & sizes) : sizes{sizes}
+        {
+            // one more byte, so that the empty messages are not null
+            for (size_t i{0}; i < sizes.size(); ++i)
+            {
+                bytes.emplace_back(sizes[i] + 1);
+                for (size_t j{0}; j < sizes[i]; ++j)
+                    bytes[i][j] = static_cast<unsigned char>(i * 31 + j * 7 + 1);
+            }
+            for (const std::vector<unsigned char> & message : bytes)
+                pointers.push_back(message.data());
+        }
+
+        std::vector<size_t> sizes;
+        std::vector<std::vector<unsigned char>> bytes;
+        std::vector<const unsigned char *> pointers;
+    };
+
+    template<class THash, class TExecutor>
+    void test_messages(TExecutor & executor, const std::vector<size_t> & sizes)
+    {
+        const messages_t messages{sizes};
+        std::vector<typename THash::digest_t> digests(sizes.size());
+        hashkitcxx::parallel_hash<THash>(
+            executor, messages.pointers.data(), sizes.data(), sizes.size(), digests.data());
+        for (size_t i{0}; i < sizes.size(); ++i)
+            BOOST_TEST((digests[i] == THash().hash(messages.pointers[i], sizes[i])));
+    }
+
+    /**
+     * @brief Every length around the block and padding boundaries, a large message among small
+     * ones and many tiny messages.
+     */
+    template<class THash, class TExecutor>
+    void test_sizes(TExecutor & executor)
+    {
+        std::vector<size_t> sizes;
+        for (size_t size{0}; size < 300; ++size)
+            sizes.push_back(size);
+        test_messages<THash>(executor, sizes);
+
+        sizes.assign(200, 3);
+        sizes[17] = 3 << 20;
+        test_messages<THash>(executor, sizes);
+
+        sizes.assign(50000, 1);
+        test_messages<THash>(executor, sizes);
+    }
+
+} // namespace hash_parallel
+
+BOOST_AUTO_TEST_SUITE(test_hash_parallel)
+BOOST_AUTO_TEST_CASE(test_default_pool)
+{
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha224>(hashkitcxx::default_thread_pool());
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha256>(hashkitcxx::default_thread_pool());
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha384>(hashkitcxx::default_thread_pool());
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha512>(hashkitcxx::default_thread_pool());
+
+    const hash_parallel::messages_t messages{{5, 64, 1000}};
+    std::vector<hashkitcxx::sha2::sha256::digest_t> digests(3);
+    hashkitcxx::parallel_hash<hashkitcxx::sha2::sha256>(
+        messages.pointers.data(), messages.sizes.data(), 3, digests.data());
+    for (size_t i{0}; i < 3; ++i)
+        BOOST_TEST((digests[i] ==
+                    hashkitcxx::sha2::sha256().hash(messages.pointers[i], messages.sizes[i])));
+    hashkitcxx::parallel_hash<hashkitcxx::sha2::sha256>(nullptr, nullptr, 0, nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_executors)
+{
+    hashkitcxx::thread_pool pool{3};
+    BOOST_TEST(pool.concurrency() == 3U);
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha256>(pool);
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha512_256>(pool);
+
+    // the messages are split by bytes: the large message is alone in its task
+    hash_parallel::inline_executor executor;
+    std::vector<size_t> sizes(1000, 100);
+    sizes[0] = 4 << 20;
+    hash_parallel::test_messages<hashkitcxx::sha2::sha256>(executor, sizes);
+    BOOST_TEST(executor.tasks == 1U);
+    hash_parallel::test_sizes<hashkitcxx::sha2::sha256>(executor);
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_pool)
+{
+    // tasks submitting tasks, all run before the pool is destroyed
+    std::atomic<unsigned> count{0};
+    {
+        hashkitcxx::thread_pool pool{2};
+        for (unsigned i{0}; i < 100; ++i)
+        {
+            pool.execute([&pool, &count]() {
+                for (unsigned j{0}; j < 10; ++j)
+                    pool.execute([&count]() { ++count; });
+                ++count;
+            });
+        }
+    }
+    BOOST_TEST(count.load() == 1100U);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_parallel
@@ -0,0 +1,88 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_stats.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hash_stats {
+
+    void count_calls(const hashkitcxx::stats::snapshot_t & snapshot, void * context)
+    {
+        BOOST_TEST(snapshot[hashkitcxx::stats::complete_calls] > 0U);
+        ++*static_cast<unsigned *>(context);
+    }
+
+} // namespace hash_stats
+
+BOOST_AUTO_TEST_SUITE(test_hash_stats)
+BOOST_AUTO_TEST_CASE(test_counters)
+{
+    using namespace hashkitcxx::stats;
+
+    const std::vector<unsigned char> message(100, 'a');
+    unsigned char digest[hashkitcxx::sha2::sha256::s_digest_size];
+
+    reset();
+    hashkitcxx::sha2::sha256 h;
+    h.init();
+    for (size_t offset{0}; offset < message.size(); offset += 10)
+        h.update(message.data() + offset, 10);
+    h.complete(digest);
+
+    snapshot_t s{snapshot()};
+    if (!enabled())
+    {
+        for (unsigned c{0}; c < counter_count; ++c)
+            BOOST_TEST(s[static_cast<counter>(c)] == 0U, name(static_cast<counter>(c)));
+        return;
+    }
+
+    // 10 updates of 10 bytes: only the 7th fills the pending block, every byte goes through it,
+    // and the 36 bytes left need a single padding block
+    BOOST_TEST(s[update_calls] == 10U);
+    BOOST_TEST(s[partial_updates] == 9U);
+    BOOST_TEST(s[staged_bytes] == 100U);
+    BOOST_TEST(s[sha256_blocks] == 2U);
+    BOOST_TEST(s[complete_calls] == 1U);
+    BOOST_TEST(s[two_block_paddings] == 0U);
+    BOOST_TEST(s[sha512_blocks] == 0U);
+
+    // 60 bytes leave no room for the length in the last sha-256 block, 100 bytes fit in the
+    // last sha-512 block
+    reset();
+    h.hash(message.data(), 60, digest);
+    hashkitcxx::sha2::sha512().hash(message.data(), 100, digest);
+    s = snapshot();
+    BOOST_TEST(s[two_block_paddings] == 1U);
+    BOOST_TEST(s[sha256_blocks] == 2U);
+    BOOST_TEST(s[sha512_blocks] == 1U);
+    BOOST_TEST(s[staged_bytes] == 160U);
+
+    // the counters of the terminated threads are kept
+    std::thread thread{[&message]() {
+        unsigned char thread_digest[hashkitcxx::sha2::sha256::s_digest_size];
+        hashkitcxx::sha2::sha256().hash(message.data(), message.size(), thread_digest);
+    }};
+    thread.join();
+    BOOST_TEST(snapshot()[complete_calls] == 3U);
+    BOOST_TEST(std::string(name(two_block_paddings)) == "two_block_paddings");
+}
+
+BOOST_AUTO_TEST_CASE(test_callback)
+{
+    using namespace hashkitcxx::stats;
+
+    unsigned calls{0};
+    set_callback(hash_stats::count_calls, &calls, 2);
+    reset();
+    unsigned char digest[hashkitcxx::sha2::sha256::s_digest_size];
+    for (unsigned i{0}; i < 5; ++i)
+        hashkitcxx::sha2::sha256().hash(digest, 0, digest);
+    set_callback(nullptr, nullptr, 0);
+    hashkitcxx::sha2::sha256().hash(digest, 0, digest);
+    BOOST_TEST(calls == (enabled() ? 2U : 0U));
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_stats
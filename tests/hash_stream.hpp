@@ -0,0 +1,140 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_stream.hpp>
+#include <sstream>
+#include <string>
+
+namespace hash_stream {
+
+    std::string make_content(size_t size)
+    {
+        std::string content(size, '\0');
+        for (size_t i{0}; i < size; ++i)
+            content[i] = static_cast<char>(i % 10 == 9 ? '\n' : 'a' + (i * 7) % 26);
+        return content;
+    }
+
+    template<class THash>
+    typename THash::digest_t hash(const std::string & text, size_t len)
+    {
+        THash h;
+        return h.hash(reinterpret_cast<const unsigned char *>(text.data()), len);
+    }
+
+} // namespace hash_stream
+
+BOOST_AUTO_TEST_SUITE(test_hash_stream)
+BOOST_AUTO_TEST_CASE(test_read)
+{
+    using hashkitcxx::sha2::sha256;
+
+    const std::string content{hash_stream::make_content(1024 * 1024 + 7)};
+    const sha256::digest_t expected{hash_stream::hash<sha256>(content, content.size())};
+
+    // bulk reads, smaller and larger than the internal buffer
+    const size_t read_sizes[]{1, 1000, 4096, 200000};
+    for (size_t read_size : read_sizes)
+    {
+        std::istringstream source{content};
+        hashkitcxx::ihashstream<sha256> in{source, 4096};
+        std::string copy;
+        std::string part(read_size, '\0');
+        while (in.read(&part[0], static_cast<std::streamsize>(part.size())) || in.gcount() > 0)
+            copy.append(part, 0, static_cast<size_t>(in.gcount()));
+
+        BOOST_TEST(copy == content);
+        BOOST_TEST(in.digest() == expected);
+    }
+
+    // a character and a line at a time
+    {
+        std::istringstream source{content};
+        hashkitcxx::ihashstream<sha256> in{source};
+        std::string copy;
+        char c{0};
+        while (in.get(c))
+            copy.push_back(c);
+        BOOST_TEST(copy == content);
+        BOOST_TEST(in.digest() == expected);
+    }
+
+    {
+        std::istringstream source{content};
+        hashkitcxx::ihashstream<sha256> in{source};
+        std::string line;
+        size_t lines{0};
+        while (std::getline(in, line))
+            ++lines;
+        BOOST_TEST(lines == content.size() / 10 + 1);
+        BOOST_TEST(in.digest() == expected);
+    }
+
+    // only the bytes taken by the reader are hashed, not the ones buffered ahead
+    {
+        std::istringstream source{content};
+        hashkitcxx::ihashstream<sha256> in{source};
+        char part[100];
+        in.read(part, sizeof(part));
+        BOOST_TEST(in.digest() == hash_stream::hash<sha256>(content, sizeof(part)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_write)
+{
+    using hashkitcxx::sha2::sha512_256;
+
+    const std::string content{hash_stream::make_content(1024 * 1024 + 7)};
+    const sha512_256::digest_t expected{hash_stream::hash<sha512_256>(content, content.size())};
+
+    const size_t write_sizes[]{1, 1000, 4096, 200000};
+    for (size_t write_size : write_sizes)
+    {
+        std::ostringstream sink;
+        hashkitcxx::ohashstream<sha512_256> out{sink, 4096};
+        for (size_t offset{0}; offset < content.size(); offset += write_size)
+            out.write(&content[offset],
+                      static_cast<std::streamsize>(std::min(write_size, content.size() - offset)));
+
+        BOOST_TEST(out.digest() == expected);
+        BOOST_TEST(sink.str() == content);
+    }
+
+    {
+        std::ostringstream sink;
+        hashkitcxx::ohashstream<sha512_256> out{sink};
+        for (char c : content)
+            out.put(c);
+        BOOST_TEST(out.digest() == expected);
+        BOOST_TEST(sink.str() == content);
+    }
+
+    // pending bytes are flushed when the stream is destroyed
+    std::ostringstream sink;
+    {
+        hashkitcxx::ohashstream<sha512_256> out{sink};
+        out << "abc";
+    }
+    BOOST_TEST(sink.str() == "abc");
+}
+
+BOOST_AUTO_TEST_CASE(test_copy)
+{
+    using hashkitcxx::sha2::sha256;
+
+    // copying a stream hashes it on the way, at both ends
+    const std::string content{hash_stream::make_content(300 * 1024)};
+    const sha256::digest_t expected{hash_stream::hash<sha256>(content, content.size())};
+
+    std::istringstream source{content};
+    std::ostringstream sink;
+    hashkitcxx::ihashstream<sha256> in{source};
+    hashkitcxx::ohashstream<sha256> out{sink};
+    out << in.rdbuf();
+
+    BOOST_TEST(in.digest() == expected);
+    BOOST_TEST(out.digest() == expected);
+    BOOST_TEST(sink.str() == content);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_hash_stream
@@ -0,0 +1,38 @@
+// Second translation unit of the header-only tests: it includes the implementation again, so the
+// tests fail to link if anything in it is not inline. Every header with a .cpp behind it is
+// included here, as test.cpp does through the tests.
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_blake2.hpp>
+#include <hashkitcxx/hash_blake3.hpp>
+#include <hashkitcxx/hash_digest_filter.hpp>
+#include <hashkitcxx/hash_digest_index.hpp>
+#include <hashkitcxx/hash_file.hpp>
+#include <hashkitcxx/hash_mapped_file.hpp>
+#include <hashkitcxx/hash_merkle.hpp>
+#include <hashkitcxx/hash_nonce_search.hpp>
+#include <hashkitcxx/hash_parallel.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha2_lanes.hpp>
+#include <hashkitcxx/hash_sha3.hpp>
+#include <hashkitcxx/hash_stats.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+
+BOOST_AUTO_TEST_SUITE(test_header_only)
+BOOST_AUTO_TEST_CASE(test_second_translation_unit)
+{
+    const char * message{"abc"};
+    const size_t message_size{3};
+
+    unsigned char digest[hashkitcxx::sha2::sha256::s_digest_size];
+    hashkitcxx::hash<hashkitcxx::sha2::sha256>(reinterpret_cast<const unsigned char *>(message),
+                                               message_size,
+                                               digest);
+
+    char output[2 * sizeof(digest) + 1]{};
+    common::to_hex(digest, sizeof(digest), output);
+    BOOST_TEST("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" == output);
+    BOOST_TEST(!hashkitcxx::hash_file<hashkitcxx::sha2::sha256>("hashkitcxx_missing.bin", digest));
+}
+BOOST_AUTO_TEST_SUITE_END() // test_header_only
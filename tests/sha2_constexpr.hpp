@@ -0,0 +1,113 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha2_constexpr.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+#include <vector>
+
+namespace sha2_constexpr {
+
+    template<size_t N>
+    constexpr bool equals(const std::array<char, N> & lhs, const char (&rhs)[N]) noexcept
+    {
+        for (size_t i{0}; i < N; ++i)
+        {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    template<class THash>
+    void test_against_runtime()
+    {
+        const std::vector<unsigned char> message{common::message(300)};
+
+        for (size_t len{0}; len <= message.size(); ++len)
+        {
+            unsigned char digest[THash::s_digest_size];
+            hashkitcxx::hash<THash>(message.data(), len, digest);
+
+            const std::array<uint8_t, THash::s_digest_size> digest_constexpr{
+                hashkitcxx::sha2::hash_constexpr<THash>(message.data(), len)};
+            BOOST_TEST(std::memcmp(digest, digest_constexpr.data(), sizeof(digest)) == 0,
+                       "length " << len);
+        }
+    }
+
+} // namespace sha2_constexpr
+
+BOOST_AUTO_TEST_SUITE(test_sha2_constexpr)
+BOOST_AUTO_TEST_CASE(test_abc)
+{
+    using namespace hashkitcxx::sha2;
+
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha224>("abc"),
+                      "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"),
+                  "sha224(abc) evaluated at compile time");
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha256>("abc"),
+                      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"),
+                  "sha256(abc) evaluated at compile time");
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha384>("abc"),
+                      "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+                      "8086072ba1e7cc2358baeca134c825a7"),
+                  "sha384(abc) evaluated at compile time");
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha512>("abc"),
+                      "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                      "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"),
+                  "sha512(abc) evaluated at compile time");
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha512_224>("abc"),
+                      "4634270f707b6a54daae7530460842e20e37ed265ceee9a43e8924aa"),
+                  "sha512_224(abc) evaluated at compile time");
+    static_assert(sha2_constexpr::equals(hash_printable_constexpr<sha512_256>("abc"),
+                      "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23"),
+                  "sha512_256(abc) evaluated at compile time");
+}
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+    using namespace hashkitcxx::sha2;
+
+    constexpr std::array<uint8_t, sha256::s_digest_size> digest{hash_constexpr<sha256>("")};
+    static_assert(digest[0] == 0xe3 && digest[31] == 0x55, "sha256() evaluated at compile time");
+
+    char output[2 * sha256::s_digest_size + 1]{};
+    common::to_hex(digest.data(), digest.size(), output);
+    BOOST_TEST("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" == output);
+}
+BOOST_AUTO_TEST_CASE(test_blob)
+{
+    using namespace hashkitcxx::sha2;
+
+    constexpr std::array<uint8_t, 3> blob{{'a', 'b', 'c'}};
+    constexpr std::array<uint8_t, sha512::s_digest_size> digest{hash_constexpr<sha512>(blob)};
+
+    char output[2 * sha512::s_digest_size + 1]{};
+    common::to_hex(digest.data(), digest.size(), output);
+    BOOST_TEST("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836b"
+               "a3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f" == output);
+}
+BOOST_AUTO_TEST_CASE(test_empty_blob)
+{
+    using namespace hashkitcxx::sha2;
+
+    constexpr std::array<uint8_t, 0> blob{};
+    constexpr std::array<uint8_t, sha256::s_digest_size> digest{hash_constexpr<sha256>(blob)};
+
+    char output[2 * sha256::s_digest_size + 1]{};
+    common::to_hex(digest.data(), digest.size(), output);
+    BOOST_TEST("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" == output);
+}
+BOOST_AUTO_TEST_CASE(test_against_runtime)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_constexpr::test_against_runtime<sha224>();
+    sha2_constexpr::test_against_runtime<sha256>();
+    sha2_constexpr::test_against_runtime<sha384>();
+    sha2_constexpr::test_against_runtime<sha512>();
+    sha2_constexpr::test_against_runtime<sha512_224>();
+    sha2_constexpr::test_against_runtime<sha512_256>();
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha2_constexpr
@@ -0,0 +1,153 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstring>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_utils.hpp>
+#if defined(HASHLIBCXX_STD_STRING)
+#    include <string>
+#endif
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+#    include <string_view>
+#endif
+#include <vector>
+
+namespace sha2_overloads {
+
+    template<class THash>
+    void test_non_allocating_overloads(const char * expected)
+    {
+        const char * message{"abc"};
+        const size_t message_size{3};
+        const unsigned char * bytes{reinterpret_cast<const unsigned char *>(message)};
+
+        {
+            THash h;
+            const typename THash::digest_t digest{h.hash(bytes, message_size)};
+            char output[2 * THash::s_digest_size + 1]{};
+            common::to_hex(digest.data(), digest.size(), output);
+            BOOST_TEST(expected == output);
+        }
+
+        {
+            const typename THash::digest_t digest{hashkitcxx::hash<THash>(bytes, message_size)};
+            char output[2 * THash::s_digest_size + 1]{};
+            common::to_hex(digest.data(), digest.size(), output);
+            BOOST_TEST(expected == output);
+        }
+
+        {
+            THash h;
+            const typename THash::digest_printable_t output{
+                h.hash_printable_array(bytes, message_size)};
+            BOOST_TEST(expected == output.data());
+        }
+
+        {
+            const typename THash::digest_printable_t output{
+                hashkitcxx::hash_printable_array<THash>(bytes, message_size)};
+            BOOST_TEST(expected == output.data());
+        }
+
+#if defined(HASHLIBCXX_STD_STRING)
+        {
+            const std::string text{message};
+            THash h;
+            unsigned char digest[THash::s_digest_size];
+            h.hash(text, digest);
+            char output[2 * THash::s_digest_size + 1]{};
+            common::to_hex(digest, sizeof(digest), output);
+            BOOST_TEST(expected == output);
+            BOOST_TEST(expected == h.hash_printable(text).c_str());
+            BOOST_TEST(text == message);
+        }
+
+        {
+            const std::string text{message};
+            unsigned char digest[THash::s_digest_size];
+            hashkitcxx::hash<THash>(text, digest);
+            char output[2 * THash::s_digest_size + 1]{};
+            common::to_hex(digest, sizeof(digest), output);
+            BOOST_TEST(expected == output);
+            BOOST_TEST(expected == hashkitcxx::hash_printable<THash>(text).c_str());
+        }
+#endif
+
+#if defined(HASHLIBCXX_STD_STRING_VIEW)
+        {
+            // only the first 3 characters are part of the view
+            const std::string_view text{"abcdef", message_size};
+            THash h;
+            unsigned char digest[THash::s_digest_size];
+            h.hash(text, digest);
+            char output[2 * THash::s_digest_size + 1]{};
+            common::to_hex(digest, sizeof(digest), output);
+            BOOST_TEST(expected == output);
+            BOOST_TEST(expected == h.hash_printable_array(text).data());
+            BOOST_TEST(expected == hashkitcxx::hash_printable_array<THash>(text).data());
+
+            const typename THash::digest_t array_digest{hashkitcxx::hash<THash>(text)};
+            BOOST_TEST(std::memcmp(digest, array_digest.data(), sizeof(digest)) == 0);
+        }
+#endif
+    }
+
+    template<class THash>
+    void test_incremental()
+    {
+        const std::vector<unsigned char> message{common::message(1000)};
+
+        THash h;
+        unsigned char expected[THash::s_digest_size];
+        h.hash(message.data(), message.size(), expected);
+
+        // every split in parts crossing the block boundaries in a different way
+        for (size_t part_size{1}; part_size <= 300; part_size += 37)
+        {
+            h.init();
+            for (size_t offset{0}; offset < message.size(); offset += part_size)
+                h.update(&message[offset], std::min(part_size, message.size() - offset));
+
+            unsigned char digest[THash::s_digest_size];
+            h.complete(digest);
+            BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+        }
+    }
+
+} // namespace sha2_overloads
+
+BOOST_AUTO_TEST_SUITE(test_sha2_overloads)
+BOOST_AUTO_TEST_CASE(test_non_allocating_overloads)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_overloads::test_non_allocating_overloads<sha224>(
+        "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+    sha2_overloads::test_non_allocating_overloads<sha256>(
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    sha2_overloads::test_non_allocating_overloads<sha384>(
+        "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca1"
+        "34c825a7");
+    sha2_overloads::test_non_allocating_overloads<sha512>(
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23"
+        "a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    sha2_overloads::test_non_allocating_overloads<sha512_224>(
+        "4634270f707b6a54daae7530460842e20e37ed265ceee9a43e8924aa");
+    sha2_overloads::test_non_allocating_overloads<sha512_256>(
+        "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23");
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_overloads::test_incremental<sha224>();
+    sha2_overloads::test_incremental<sha256>();
+    sha2_overloads::test_incremental<sha384>();
+    sha2_overloads::test_incremental<sha512>();
+    sha2_overloads::test_incremental<sha512_224>();
+    sha2_overloads::test_incremental<sha512_256>();
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha2_overloads
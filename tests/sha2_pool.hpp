@@ -0,0 +1,133 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_sha2_pool.hpp>
+#include <vector>
+
+namespace sha2_pool {
+
+    template<class THash>
+    void test_interleaved()
+    {
+        using pool_t = hashkitcxx::sha2::context_pool<THash>;
+
+        // each stream gets its own message, split in chunks of various sizes
+        const size_t streams{37};
+        std::vector<std::vector<unsigned char>> messages(streams);
+        for (size_t i{0}; i < streams; ++i)
+        {
+            messages[i].resize(i * 61 + 1);
+            for (size_t j{0}; j < messages[i].size(); ++j)
+                messages[i][j] = static_cast<unsigned char>(i * 31 + j * 7);
+        }
+
+        pool_t pool{streams};
+        std::vector<typename pool_t::handle_t> handles(streams);
+        std::vector<size_t> offsets(streams);
+        for (size_t i{0}; i < streams; ++i)
+        {
+            handles[i] = pool.acquire();
+            BOOST_TEST(handles[i] != pool_t::s_invalid_handle);
+        }
+        BOOST_TEST(pool.size() == streams);
+
+        size_t done{0};
+        for (size_t round{0}; done < streams; ++round)
+        {
+            done = 0;
+            for (size_t i{0}; i < streams; ++i)
+            {
+                const size_t chunk{(round * 13 + i * 5) % 150 + 1};
+                const size_t len{std::min(chunk, messages[i].size() - offsets[i])};
+                if (len > 0)
+                    pool.update(handles[i], messages[i].data() + offsets[i], len);
+                offsets[i] += len;
+                done += offsets[i] == messages[i].size() ? 1 : 0;
+            }
+            if (round % 3 == 0)
+                pool.step();
+        }
+
+        for (size_t i{0}; i < streams; ++i)
+        {
+            unsigned char expected[THash::s_digest_size];
+            THash().hash(messages[i].data(), messages[i].size(), expected);
+
+            unsigned char digest[THash::s_digest_size];
+            pool.complete(handles[i], digest);
+            BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+            pool.release(handles[i]);
+        }
+        BOOST_TEST(pool.size() == 0);
+        BOOST_TEST(pool.step() == 0);
+    }
+
+} // namespace sha2_pool
+
+BOOST_AUTO_TEST_SUITE(test_sha2_pool)
+BOOST_AUTO_TEST_CASE(test_interleaved)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_pool::test_interleaved<sha224>();
+    sha2_pool::test_interleaved<sha256>();
+    sha2_pool::test_interleaved<sha384>();
+    sha2_pool::test_interleaved<sha512>();
+    sha2_pool::test_interleaved<sha512_224>();
+    sha2_pool::test_interleaved<sha512_256>();
+}
+
+BOOST_AUTO_TEST_CASE(test_step)
+{
+    using pool_t = hashkitcxx::sha2::context_pool<hashkitcxx::sha2::sha256>;
+
+    pool_t pool{20};
+    std::vector<pool_t::handle_t> handles;
+    for (size_t i{0}; i < 20; ++i)
+        handles.push_back(pool.acquire());
+
+    // full pending blocks are queued once, until step() compresses them
+    const std::vector<unsigned char> block(64, 'a');
+    for (const pool_t::handle_t handle : handles)
+        pool.update(handle, block.data(), block.size());
+    BOOST_TEST(pool.queued() == 20);
+
+    // a queued context given more data is compressed on its own
+    pool.update(handles[0], block.data(), 1);
+    BOOST_TEST(pool.step() == 19);
+    BOOST_TEST(pool.queued() == 0);
+
+    unsigned char expected[32];
+    hashkitcxx::sha2::sha256().hash(block.data(), block.size(), expected);
+    unsigned char digest[32];
+    pool.complete(handles[1], digest);
+    BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_capacity)
+{
+    using pool_t = hashkitcxx::sha2::context_pool<hashkitcxx::sha2::sha512>;
+
+    pool_t pool{2};
+    BOOST_TEST(pool.capacity() == 2);
+    const pool_t::handle_t first{pool.acquire()};
+    const pool_t::handle_t second{pool.acquire()};
+    BOOST_TEST(first != second);
+    BOOST_TEST(pool.acquire() == pool_t::s_invalid_handle);
+
+    // a released context is reused, and starts from an empty message
+    pool.update(first, reinterpret_cast<const unsigned char *>("abc"), 3);
+    pool.release(first);
+    const pool_t::handle_t third{pool.acquire()};
+    BOOST_TEST(third == first);
+
+    unsigned char digest[64];
+    pool.complete(third, digest);
+    unsigned char expected[64];
+    const unsigned char empty{0};
+    hashkitcxx::sha2::sha512().hash(&empty, 0, expected);
+    BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha2_pool
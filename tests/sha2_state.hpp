@@ -0,0 +1,128 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <vector>
+
+namespace sha2_state {
+
+    template<class THash>
+    void test_resume()
+    {
+        const std::vector<unsigned char> message{common::message(1000)};
+
+        THash h;
+        unsigned char expected[THash::s_digest_size];
+        h.hash(message.data(), message.size(), expected);
+
+        // the state is saved at every position, with the block empty, partial or full
+        for (size_t split{0}; split <= 300; split += 29)
+        {
+            THash first;
+            first.init();
+            first.update(message.data(), split);
+            unsigned char state[THash::s_state_size];
+            first.save(state);
+
+            THash second;
+            BOOST_TEST(second.load(state, sizeof(state)));
+            BOOST_TEST(second.processed_size() == split);
+            second.update(message.data() + split, message.size() - split);
+
+            unsigned char digest[THash::s_digest_size];
+            second.complete(digest);
+            BOOST_TEST(std::memcmp(expected, digest, sizeof(digest)) == 0);
+        }
+    }
+
+    template<class THash, class TOther>
+    void test_invalid()
+    {
+        THash h;
+        h.init();
+        h.update(reinterpret_cast<const unsigned char *>("abc"), 3);
+        unsigned char state[THash::s_state_size];
+        h.save(state);
+
+        TOther other;
+        unsigned char other_state[TOther::s_state_size];
+        other.init();
+        other.save(other_state);
+        BOOST_TEST(!h.load(other_state, sizeof(other_state)));
+
+        BOOST_TEST(!h.load(state, sizeof(state) - 1));
+        BOOST_TEST(!h.load(nullptr, sizeof(state)));
+
+        unsigned char corrupted[THash::s_state_size];
+        std::memcpy(corrupted, state, sizeof(state));
+        corrupted[0] ^= 1; // magic
+        BOOST_TEST(!h.load(corrupted, sizeof(corrupted)));
+
+        std::memcpy(corrupted, state, sizeof(state));
+        corrupted[4] = 2; // version
+        BOOST_TEST(!h.load(corrupted, sizeof(corrupted)));
+
+        std::memcpy(corrupted, state, sizeof(state));
+        corrupted[23] = 0xff; // pending bytes larger than a block
+        BOOST_TEST(!h.load(corrupted, sizeof(corrupted)));
+
+        std::memcpy(corrupted, state, sizeof(state));
+        corrupted[15] = 1; // transformed bytes not a multiple of the block
+        BOOST_TEST(!h.load(corrupted, sizeof(corrupted)));
+
+        // a failed load leaves the state unchanged
+        BOOST_TEST(h.processed_size() == 3);
+        BOOST_TEST(h.load(state, sizeof(state)));
+    }
+
+} // namespace sha2_state
+
+BOOST_AUTO_TEST_SUITE(test_sha2_state)
+BOOST_AUTO_TEST_CASE(test_resume)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_state::test_resume<sha224>();
+    sha2_state::test_resume<sha256>();
+    sha2_state::test_resume<sha384>();
+    sha2_state::test_resume<sha512>();
+    sha2_state::test_resume<sha512_224>();
+    sha2_state::test_resume<sha512_256>();
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid)
+{
+    using namespace hashkitcxx::sha2;
+
+    sha2_state::test_invalid<sha224, sha256>();
+    sha2_state::test_invalid<sha256, sha224>();
+    sha2_state::test_invalid<sha384, sha512>();
+    sha2_state::test_invalid<sha512, sha512_256>();
+    sha2_state::test_invalid<sha512_224, sha512_256>();
+    sha2_state::test_invalid<sha512_256, sha512_224>();
+}
+
+BOOST_AUTO_TEST_CASE(test_format)
+{
+    // the format does not depend on the platform: sha-256 after "abc"
+    hashkitcxx::sha2::sha256 h;
+    h.init();
+    h.update(reinterpret_cast<const unsigned char *>("abc"), 3);
+    unsigned char state[hashkitcxx::sha2::sha256::s_state_size];
+    h.save(state);
+
+    BOOST_TEST(sizeof(state) == 24 + 32 + 64);
+
+    char header[2 * 56 + 1]{};
+    common::to_hex(state, 56, header);
+    BOOST_TEST("484b435801020000"
+               "0000000000000000"
+               "0000000000000003"
+               "6a09e667bb67ae853c6ef372a54ff53a510e527f9b05688c1f83d9ab5be0cd19" == header);
+    BOOST_TEST(std::memcmp(state + 56, "abc", 3) == 0);
+    for (size_t i{59}; i < sizeof(state); ++i)
+        BOOST_TEST(state[i] == 0);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha2_state
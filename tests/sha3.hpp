@@ -0,0 +1,270 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_sha3.hpp>
+#include <string>
+#include <vector>
+
+namespace sha3_vectors {
+
+    /**
+     * @brief The input of each length repeats the bytes 0 to 255; the lengths surround the block
+     * sizes. Only the first 32 bytes of the hashes are checked here.
+     */
+    struct vector_t
+    {
+        size_t len;
+        const char * hash;
+    };
+
+    const vector_t sha3_224[]{
+        {0, "6b4e03423667dbb73b6e15454f0eb1abd4597f9a1b078e3f5b5a6bc7"},
+        {1, "bdd5167212d2dc69665f5a8875ab87f23d5ce7849132f56371a19096"},
+        {71, "5e31d4bc8904e6e77531e6b975d3dcdd4330c03620e5204bc047ce2e"},
+        {72, "0fdd8265d5382246a4eb6580df2452ffc3918cf04edd9fed88f566aa"},
+        {73, "b1d7edc8a77c2457dd67597772ef2eb3360d6f2c48ce599cbd81f2cb"},
+        {104, "2027bb84e1a588623f3f5dded0663bbff3b93d46c65578ca892f6d91"},
+        {135, "3174e5126280625ecdfdb238d6a10d1c8b071031870ed197640cad90"},
+        {136, "5d633f7e245e4338fa2698ef8b0cf98b129b5cc99622f770e3ba0cb6"},
+        {137, "7098ddcff44c0ae3e0802d8d60fe7bea8d0d3219ce28660af1aee40c"},
+        {144, "5be75e6a08f19913a1d8036c056cc4556b98dc90aeca3f2a0664dedc"},
+        {167, "3e78e02f6bcd8cf59d7f633f1a9fd522fbe6cc8914247b6171694b69"},
+        {168, "58e2d8551f4cb53e9ce8cdfba50a81fd14e0b112a42007b03737372c"},
+        {169, "44c06523fcd275b5cefce7d0fad88ed27f984ef8baa6c58e6bbfae73"},
+        {1000, "449b2acbbc0d2d133fd7a11157aafd2118a253f7a91091e5d3092efa"},
+        {3000, "1ca159a498093749f0fc599f851e9eabd93d06bde782161998b7184d"}};
+
+    const vector_t sha3_256[]{
+        {0, "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a"},
+        {1, "5d53469f20fef4f8eab52b88044ede69c77a6a68a60728609fc4a65ff531e7d0"},
+        {71, "881ad9ffbd7f090efa51cbdfe93da23a0401f4446f7adf150d1c226851cbfff2"},
+        {72, "fe58866b2893c6c40ee832ce40fb6eb4c70ff7c4794380d95c2ebeec62decd31"},
+        {73, "797061b3aad8e724740c79dc697ef3de4c96c4db4483dba4e56f852222c72474"},
+        {104, "22892ec826b20680c8462ed416e15d402e567ff4e084b08274d702fd2411f40a"},
+        {135, "fded8fd9d6551c601eeb3b7c6bc5e5cfd8aad1d015b7e9aaa9c9b9475231d5e2"},
+        {136, "cf3ccff92480a29160c2d38317c430e14749bfee1788106957dfe73f8c4930e5"},
+        {137, "ce9d7dc90913ee5d92745019479a5352c6d6279bef18ed07dc0a83ee8084daca"},
+        {144, "a32aeb728cd50069f906559158f1d0a9df3a8c6795e5cbafde00c632f08bade3"},
+        {167, "cac5458d48e6163cc843d5f18e263e3ce03290cbd5a866bd3b7d02dff2da413e"},
+        {168, "369a33badfa618d58d16aaddeaff98d66b30a70c2deee42fc809b9721dc1c524"},
+        {169, "6d9ef22b871f8518d91fe5fd48baf514f1165eca0a145f8975eb4b40898dab7c"},
+        {1000, "14e5de35911194ddad95ac1572e2b6ce054ed2146cd0562280fcab04ccfecbd8"},
+        {3000, "cd20a7c36afa16d07a0920270cece0b1b6a5651ac3358d49c4fed9473c900bdc"}};
+
+    const vector_t sha3_384[]{
+        {0, "0c63a75b845e4f7d01107d852e4c2485c51a50aaaa94fc61995e71bbee983a2a"},
+        {1, "127677f8b66725bbcb7c3eae9698351ca41e0eb6d66c784bd28dcdb3b5fb12d0"},
+        {71, "4bb4db01ac1c1d1a5de657436aca5275e4cae772bd6ab9b358e0ed094202be96"},
+        {72, "240914a09175ad5bed4cc2486f1cb2160ee182e3b71e17efe5b82dfc0c8f0a8a"},
+        {73, "8f8ead15c47cd6f89ed7110d454759903df4e1ff3e2229597893776cff5195de"},
+        {104, "5b8d0d5cf8b41be507be8fcbfcbdbac3a28eb368d430fed6780aaa78a93a8da4"},
+        {135, "25d2be1f5a681f8135992e0cc18a7b0758d1a880eb3c64d9c722f80d68b744bb"},
+        {136, "ced899b993a69f66251a7872fbb87f8be5967857b2693e3feb032b3440dd94b7"},
+        {137, "ef446c45f31f98fe3aa92392ee4198d8c797128cb87da84ad008aad1e1d972d0"},
+        {144, "2fe2a7ab6dfd014f013c662e4d669ac595f7d80bf8056d156bbd0135de841c17"},
+        {167, "12442ec232a21da5fb424e8c51416feb6e1edcff3476875a80f7f2237cc873bf"},
+        {168, "a4f7bac5adf27c96bfcb084091d93c51b4e6e8442a7a1d473171c2d5a73f97ea"},
+        {169, "6858babfdd40fb2890e6efd2d32a06c5c9579c1ed70aca8796bd1b512e61233b"},
+        {1000, "78361036d2bcf7cfc0d8004dd9f618ba2f1580022bd3127f639489776f1d11e3"},
+        {3000, "ea6b2ccf8facb84daaaf35c558527cd9e994f1cd30f7df672ca60d31d07814b8"}};
+
+    const vector_t sha3_512[]{
+        {0, "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a6"},
+        {1, "7127aab211f82a18d06cf7578ff49d5089017944139aa60d8bee057811a15fb5"},
+        {71, "3ccc850d53a1287af7b4560b2ef0d43eb5d9a80d62a0e9cf1dbc040135921104"},
+        {72, "5d63f2bbe971a983ac6847480106e4e1264ee3a0befd79954914e1d86e795b2e"},
+        {73, "921d9b7b2b0f3066a1646dbb058c979cb3925dec0f8c269faaa7f9648e73465a"},
+        {104, "d29281937684621d1473a7e7edb80b7c9d80b0842e9d801b718a13b847b9ec4f"},
+        {135, "d942df0df09ac042cd3b641144c98d8fda0980bb037fc5c0e7f2e9a073b073dc"},
+        {136, "ad8edff4f1b7aa1c63bbe49728ab9b165f7245b3d7102e6f99c261fc15d2d0bf"},
+        {137, "3f827e5d7ddbd54ea1dba28cae0154eb5ff8d8d973770865861b7cdf5f091040"},
+        {144, "e1951b8bcb58ca75a34af80a7a2b765cad4257fe383a79b55bf21f180b75f6e5"},
+        {167, "77aeb7615194d38076e9cd4c4f7361d76e96d7856ff6cc8c0d88e198cb62445d"},
+        {168, "9567f47a24e5c3b934777516554d4875de4b1d8a59e18b6983827dd9bf394414"},
+        {169, "90334a76f71e06e0be572822109e7595f5ebcedbc668a863e50667aa79f372ec"},
+        {1000, "0a96e7c099e956287a7d6c2516befb5089714c38f7c01ab158bcd131b50dd10c"},
+        {3000, "1dd1452e54ae065b3875085e6d12db7dcb716825ce6c92e054185dc82c5e4f4f"}};
+
+    const vector_t shake128[]{
+        {0, "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26"},
+        {1, "0b784469a0628e03861cd8a196dfafa0e9e8056d04cddcc49f0746b9ad43ccb2"},
+        {71, "87495b03cd07a1624df24a4dec4019d6e014094b334a33c53344feb7931464e9"},
+        {72, "29cbc126c6e6ba6a53c0b6d2a556fcd13eddb6ebfff551b2405c51b4f0aaa45c"},
+        {73, "05876deccc921922e3555320777779e6510935e9babb6d9b9eabe52fd9246f51"},
+        {104, "f7687986587914614951aeb538ec87289afa6d1285e1facdf8860d0c6d98bd4f"},
+        {135, "d11fafa27f42a8162b8ae013535771de81722c0abc8aa2bca01825462e2f8971"},
+        {136, "30bdfd69382cab028173fba7c6d53878ec18081358e52c955dc6f5d52b60b029"},
+        {137, "047a94427406b3ac81270fe1c3aafe1594f121bdca236dcb2c01cd977b41ee02"},
+        {144, "d8a845597faa65fbb3e62a8cfd042511b456e9158e9c260dd1699fd28e3cdbb4"},
+        {167, "1e552791cc4e93a0d4a8dc47ae49228c2faa869e40e628f6ace477aec3f1ca7a"},
+        {168, "f15277eb61c4908d44a2853f3cde071ae2ed7a23461fbe162a1a98cf6875059c"},
+        {169, "015be3338c986d9846affa0f94b4afc2a76bc289c709e1a596ec9eccf090a773"},
+        {1000, "39414e9af7fae8cafe10e160cbfadd54e883fdab9a5686e1330451a277359edd"},
+        {3000, "c435866e1ddf834c0e134c1e3a47b0ad788927c0723348eabf0aaf46ab9bf11e"}};
+
+    const vector_t shake256[]{
+        {0, "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762f"},
+        {1, "b8d01df855f7075882c636f6ddeacf41e5de0bbf30042ef0a86e36f4b8600d54"},
+        {71, "10b3b7dea36eb47f49a380bd01b0278e6a2ac94c9e13b4826bc77dfa558ca157"},
+        {72, "2bb9aade91b40cfced14ad1fd7e26aa839b5140227fad20311d24db1578a8a55"},
+        {73, "1e0e36cd5d88fac489d6b411ed5e8d1fc969a2f73e1919b6bd2cb62b3a86191d"},
+        {104, "c520492ba073679d445df807892cd7900ae5187ea59421f7bf9c4738b4212b13"},
+        {135, "c45dae624ad8a2f5aa7bac9d7557737fd91c96eedb70a6be5574d57a844eade0"},
+        {136, "b7ff4073b3f5a8eabd6e17705ca7f6761a31058f9df781a6a47e3a3063b9d67a"},
+        {137, "01d90952c642a5eb2a8fc9d713f843a45d7ac05132dddcb2efc9bebc27e37bcb"},
+        {144, "29d1318a772c0ad4506f7805489d2c967d8662c786d59994879c1fa1c10c675f"},
+        {167, "989a61fbdb26d1695f841faaef850de4e5ca0095ea4c7511c54f0b0a098e8fad"},
+        {168, "1687771440dbcdaa8af7049dd319414a12a702caa4809a0ded089cb659219ea4"},
+        {169, "d639f47fb6b6836625c047a8240313bba11e3b7e479595b43b48ecd35cc89e9e"},
+        {1000, "7ea3adcc3e3b46adcdc481d1309cf131c8703d484e33dcb78d13363324e2972d"},
+        {3000, "a797e0151a518704bf53caa05109aae29e6713190ef094482a27741d5d1319a6"}};
+
+    template<class THash>
+    std::string output(const THash & h)
+    {
+        unsigned char digest[THash::s_digest_size];
+        h.complete(digest);
+        return common::to_hex(digest, sizeof(digest) < 32 ? sizeof(digest) : 32);
+    }
+
+    template<class THash, size_t N>
+    void check(const vector_t (&vectors)[N])
+    {
+        for (const vector_t & vector : vectors)
+        {
+            const std::vector<unsigned char> message{common::input(vector.len)};
+            THash h;
+
+            h.init();
+            h.update(message.data(), vector.len);
+            BOOST_TEST(output(h) == vector.hash);
+            BOOST_TEST(h.processed_size() == vector.len);
+
+            h.init();
+            common::update_in_parts(h, message.data(), vector.len);
+            BOOST_TEST(output(h) == vector.hash);
+            BOOST_TEST(h.processed_size() == vector.len);
+        }
+    }
+
+    /**
+     * @brief Checks sha3_hash_batch() against hashing the messages one at a time, with a count
+     * that is not a multiple of the lanes and lengths that keep the lanes out of step.
+     */
+    template<class THash>
+    void check_batch()
+    {
+        const size_t count{19};
+        const std::vector<unsigned char> bytes{common::input(3000)};
+        std::vector<const unsigned char *> messages(count);
+        std::vector<size_t> sizes(count);
+        for (size_t i{0}; i < count; ++i)
+        {
+            messages[i] = bytes.data() + i;
+            sizes[i] = i * i * 7 % 701;
+        }
+
+        std::vector<typename THash::digest_t> digests(count);
+        hashkitcxx::sha3_hash_batch<THash>(messages.data(), sizes.data(), count, digests.data());
+        for (size_t i{0}; i < count; ++i)
+        {
+            THash h;
+            BOOST_TEST((digests[i] == h.hash(messages[i], sizes[i])));
+        }
+    }
+
+} // namespace sha3_vectors
+
+BOOST_AUTO_TEST_SUITE(test_sha3)
+BOOST_AUTO_TEST_CASE(test_vectors)
+{
+    sha3_vectors::check<hashkitcxx::sha3_224>(sha3_vectors::sha3_224);
+    sha3_vectors::check<hashkitcxx::sha3_256>(sha3_vectors::sha3_256);
+    sha3_vectors::check<hashkitcxx::sha3_384>(sha3_vectors::sha3_384);
+    sha3_vectors::check<hashkitcxx::sha3_512>(sha3_vectors::sha3_512);
+    sha3_vectors::check<hashkitcxx::shake128>(sha3_vectors::shake128);
+    sha3_vectors::check<hashkitcxx::shake256>(sha3_vectors::shake256);
+}
+
+BOOST_AUTO_TEST_CASE(test_extendable_output)
+{
+    const std::string shake128_1000{
+        "39414e9af7fae8cafe10e160cbfadd54e883fdab9a5686e1330451a277359edd"
+        "8849f92bd83e0a89430c3c9aedab21454216147c8d95a12abc7462a65fce7b5a"
+        "6c665da96856e4036b13ebb2768b1fc5426b44980e54d3f8e027869a45e60322"
+        "253aa3e8e77643fb3abe066295fb457080793042e3585f842e4bf1462c78fab5"
+        "2960f2b96c173874c79e9d3d878919b9759d0a09d03c24bc57c0104372de41f4"
+        "1a15a493dc7be9babe9464db167a63b8cdcca4574e7b051f65e930bf00cb7c6c"
+        "52c4e165fed4ab61b07d1a2cab9f3fb4570aca2801219a184bcc61e1e427a37a"
+        "c365eacc0da6d718411db0653389e08ef96e798a39c15679467f8ff763e44965"
+        "72de241ce7894b97af5cab34b56132a7bb4cdd0a3c3a7e6ec8213093635aec99"
+        "520e8ebae0134de74222a65c2c9d820f8d3b28a61976b123d30635cb39eaa246"
+        "8eddf55989dcf71c1814d2ed0d35db459c8d4ebb4d845a702d5a6c9c2cc08c22"
+        "71fe438691dc09e0166f05fbcb0b06ff3bb6ca5d71ebe8e5bd9407aaebfb3188"
+        "d31241bbca4b71cd17daa3a1742ac775"};
+    const std::string shake256_empty{
+        "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762f"
+        "d75dc4ddd8c0f200cb05019d67b592f6fc821c49479ab48640292eacb3b7c4be"
+        "141e96616fb13957692cc7edd0b45ae3dc07223c8e92937bef84bc0eab862853"
+        "349ec75546f58fb7c2775c38462c5010d846c185c15111e595522a6bcd16cf86"
+        "f3d122109e3b1fdd943b6aec468a2d621a7c06c6a957c62b54dafc3be87567d6"
+        "77231395f6147293b68ceab7a9e0c58d864e8efde4e1b9a46cbe854713672f5c"
+        "aaae314ed9083dab"};
+
+    // in parts crossing the blocks of 168 bytes, straight after the first one and at their end
+    const std::vector<unsigned char> message{common::input(1000)};
+    hashkitcxx::shake128 h;
+    h.init();
+    h.update(message.data(), 1000);
+    BOOST_TEST(sha3_vectors::output(h) == shake128_1000.substr(0, 64));
+    std::vector<unsigned char> output(400);
+    size_t position{0};
+    for (size_t part : {1U, 7U, 0U, 160U, 168U, 64U})
+    {
+        h.squeeze(output.data() + position, part);
+        position += part;
+    }
+    BOOST_TEST(common::to_hex(output.data(), position) == shake128_1000);
+
+    hashkitcxx::shake256 e;
+    e.init();
+    e.squeeze(output.data(), 200);
+    BOOST_TEST(common::to_hex(output.data(), 200) == shake256_empty);
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_batch)
+{
+    sha3_vectors::check_batch<hashkitcxx::sha3_224>();
+    sha3_vectors::check_batch<hashkitcxx::sha3_256>();
+    sha3_vectors::check_batch<hashkitcxx::sha3_512>();
+    sha3_vectors::check_batch<hashkitcxx::shake128>();
+
+    hashkitcxx::sha3_256::digest_t digest{};
+    hashkitcxx::sha3_hash_batch<hashkitcxx::sha3_256>(nullptr, nullptr, 0, &digest);
+    BOOST_TEST((digest == hashkitcxx::sha3_256::digest_t{}));
+}
+
+BOOST_AUTO_TEST_CASE(test_hash_overloads)
+{
+    // FIPS 202 examples
+    const unsigned char * abc{reinterpret_cast<const unsigned char *>("abc")};
+    const std::string sha3_256_abc{
+        "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532"};
+    const std::string sha3_512_abc{
+        "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+        "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0"};
+
+    hashkitcxx::sha3_256 h;
+    const hashkitcxx::sha3_256::digest_t digest{h.hash(abc, 3)};
+    BOOST_TEST(common::to_hex(digest.data(), digest.size()) == sha3_256_abc);
+    BOOST_TEST(std::string(h.hash_printable_array(abc, 3).data()) == sha3_256_abc);
+
+    hashkitcxx::sha3_512 l;
+    BOOST_TEST(std::string(l.hash_printable_array(abc, 3).data()) == sha3_512_abc);
+#if defined(HASHLIBCXX_STD_STRING)
+    BOOST_TEST(h.hash_printable(std::string("abc")) == sha3_256_abc);
+    BOOST_TEST(l.hash_printable(std::string("abc")) == sha3_512_abc);
+#endif
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha3
@@ -0,0 +1,117 @@
+#pragma once
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha2_constexpr.hpp>
+#include <hashkitcxx/hash_sha2_pool.hpp>
+#include <hashkitcxx/hash_sha512_t.hpp>
+#include <string>
+#include <vector>
+
+namespace sha512_truncated {
+
+    constexpr bool equals(const std::array<uint64_t, 8> & lhs,
+                          const std::array<uint64_t, 8> & rhs) noexcept
+    {
+        for (size_t i{0}; i < 8; ++i)
+        {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    template<size_t T>
+    std::string hash_printable(const std::string & message)
+    {
+        hashkitcxx::sha2::sha512_t<T> h;
+        return h.hash_printable_array(reinterpret_cast<const unsigned char *>(message.data()),
+                                      message.size())
+            .data();
+    }
+
+} // namespace sha512_truncated
+
+BOOST_AUTO_TEST_SUITE(test_sha512_t)
+BOOST_AUTO_TEST_CASE(test_iv)
+{
+    using namespace hashkitcxx::sha2;
+
+    // the IV generation function gives back the IVs published in FIPS 180-4
+    static_assert(sha512_truncated::equals(sha512_t<224>::s_h0, sha512_224_h0),
+                  "SHA-512/224 IV computed at compile time");
+    static_assert(sha512_truncated::equals(sha512_t<256>::s_h0, sha512_256_h0),
+                  "SHA-512/256 IV computed at compile time");
+}
+
+BOOST_AUTO_TEST_CASE(test_vectors)
+{
+    // reference values computed with a direct implementation of FIPS 180-4 in Python, checked
+    // against hashlib for t = 224 and t = 256
+    BOOST_TEST(sha512_truncated::hash_printable<8>("abc") == "c5");
+    BOOST_TEST(sha512_truncated::hash_printable<8>("") == "79");
+    BOOST_TEST(sha512_truncated::hash_printable<160>("abc") ==
+               "0a74fe1b43eecbea62182658da8a68b8acef25bf");
+    BOOST_TEST(sha512_truncated::hash_printable<160>("") ==
+               "4cc04bc7087617e98d7da7443d79fb481cf169bf");
+    BOOST_TEST(sha512_truncated::hash_printable<392>("abc") ==
+               "87092ff1cb2f6510ef2b6c9482be5fca81ad56f1dfbd483744a1f1f65f4f8293ad92f370a4209c74"
+               "f0a1dafea2a7680410");
+    BOOST_TEST(sha512_truncated::hash_printable<504>("") ==
+               "6c46fed4cb277417c5f2d88b19a88a9a010e9e81a24d4a38d818c84a1aa3b88dd115f9550869eb09"
+               "7001fe0e8315b1d6f04124215f095e0be7ca94f99cdc6a");
+
+    const std::vector<unsigned char> message{common::message(1000)};
+    char digest_printable[2 * 20 + 1];
+    hashkitcxx::sha2::sha512_t<160>().hash_printable(message.data(),
+                                                     message.size(),
+                                                     digest_printable);
+    BOOST_TEST(std::string(digest_printable) == "a0663f7ace58d5046eb69c64cb971f0173372024");
+}
+
+BOOST_AUTO_TEST_CASE(test_standard_truncations)
+{
+    using namespace hashkitcxx::sha2;
+
+    const std::vector<unsigned char> message{common::message(300)};
+    for (size_t len{0}; len <= message.size(); len += 7)
+    {
+        BOOST_TEST(sha512_t<224>().hash(message.data(), len) ==
+                   sha512_224().hash(message.data(), len));
+        BOOST_TEST(sha512_t<256>().hash(message.data(), len) ==
+                   sha512_256().hash(message.data(), len));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parts)
+{
+    using sha512_160 = hashkitcxx::sha2::sha512_t<160>;
+
+    const std::vector<unsigned char> message{common::message(1000)};
+    const sha512_160::digest_t expected{sha512_160().hash(message.data(), message.size())};
+
+    sha512_160 h;
+    h.init();
+    for (size_t offset{0}; offset < message.size(); offset += 77)
+        h.update(message.data() + offset, std::min<size_t>(77, message.size() - offset));
+    BOOST_TEST(h.processed_size() == message.size());
+    sha512_160::digest_t digest;
+    h.complete(digest.data());
+    BOOST_TEST(digest == expected);
+
+    // the generic engines work from the traits
+    const std::array<uint8_t, sha512_160::s_digest_size> digest_constexpr{
+        hashkitcxx::sha2::hash_constexpr<sha512_160>(message.data(), message.size())};
+    BOOST_TEST(std::memcmp(digest_constexpr.data(), expected.data(), expected.size()) == 0);
+
+    hashkitcxx::sha2::context_pool<sha512_160> pool{1};
+    const auto handle = pool.acquire();
+    pool.init(handle);
+    pool.update(handle, message.data(), message.size());
+    pool.complete(handle, digest.data());
+    BOOST_TEST(digest == expected);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_sha512_t
@@ -1,4 +1,25 @@
 #define BOOST_TEST_MODULE hashkitcxx
 #define BOOST_TEST_DYN_LINK
+#include "blake2.hpp"
+#include "blake3.hpp"
+#include "hash_async.hpp"
+#include "hash_chunker.hpp"
+#include "hash_digest_filter.hpp"
+#include "hash_digest_index.hpp"
+#include "hash_digest_map.hpp"
+#include "hash_drbg.hpp"
+#include "hash_file.hpp"
+#include "hash_fixed_batch.hpp"
+#include "hash_merkle.hpp"
+#include "hash_nonce_search.hpp"
+#include "hash_parallel.hpp"
+#include "hash_stats.hpp"
+#include "hash_stream.hpp"
 #include "sha2.hpp"
+#include "sha2_constexpr.hpp"
+#include "sha2_overloads.hpp"
+#include "sha2_pool.hpp"
+#include "sha2_state.hpp"
+#include "sha3.hpp"
+#include "sha512_t.hpp"
 #include <boost/test/unit_test.hpp>
@@ -0,0 +1,70 @@
+// Tests of the tracepoints, built in header-only mode with HASHLIBCXX_USDT: the stub <sys/sdt.h>
+// of the usdt directory records the probes, so their arguments can be checked without systemtap.
+#define BOOST_TEST_MODULE hashkitcxx_usdt
+#define BOOST_TEST_DYN_LINK
+#include "common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <hashkitcxx/hash_sha2.hpp>
+#include <hashkitcxx/hash_sha512_t.hpp>
+#include <string>
+#include <sys/sdt.h>
+#include <vector>
+
+namespace usdt {
+
+    std::string recorded()
+    {
+        std::string probes;
+        for (const usdt_stub::probe_t & probe : usdt_stub::probes())
+            probes += probe.name + ' ' + std::to_string(probe.arg0) + ' ' +
+                      std::to_string(probe.arg1) + ';';
+        return probes;
+    }
+
+    /**
+     * @brief Checks the probes of a hash in two parts: the first one stays in the block, the
+     * second one fills it and adds 2 blocks, and the padding takes one more.
+     */
+    template<class THash, typename TWord>
+    void check(hashkitcxx::sha2::probe_algorithm algorithm, size_t block_size)
+    {
+        const std::vector<unsigned char> message{common::message(3 * block_size + 5)};
+        const std::string id{std::to_string(static_cast<unsigned>(algorithm))};
+
+        usdt_stub::probes().clear();
+        THash h;
+        h.init();
+        h.update(message.data(), 10);
+        h.update(message.data() + 10, message.size() - 10);
+        unsigned char digest[THash::s_digest_size];
+        h.complete(digest);
+
+        TWord words[8]{};
+        THash::compress(words, message.data(), 2);
+
+        BOOST_TEST(recorded() == "init " + id + " 0;" +
+                                     "update " + id + " 10;" +
+                                     "update " + id + ' ' + std::to_string(message.size() - 10) +
+                                     ';' + "transform " + id + " 1;" +
+                                     "transform " + id + " 2;" +
+                                     "transform " + id + " 1;" +
+                                     "complete " + id + ' ' + std::to_string(message.size()) +
+                                     ';' + "transform " + id + " 2;");
+    }
+
+} // namespace usdt
+
+BOOST_AUTO_TEST_SUITE(test_usdt)
+BOOST_AUTO_TEST_CASE(test_probe_arguments)
+{
+    using namespace hashkitcxx::sha2;
+
+    usdt::check<sha224, uint32_t>(probe_sha224, 64);
+    usdt::check<sha256, uint32_t>(probe_sha256, 64);
+    usdt::check<sha384, uint64_t>(probe_sha384, 128);
+    usdt::check<sha512, uint64_t>(probe_sha512, 128);
+    usdt::check<sha512_224, uint64_t>(probe_sha512_224, 128);
+    usdt::check<sha512_256, uint64_t>(probe_sha512_256, 128);
+    usdt::check<sha512_t<160>, uint64_t>(probe_sha512_t, 128);
+}
+BOOST_AUTO_TEST_SUITE_END() // test_usdt
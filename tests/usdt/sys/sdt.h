@@ -0,0 +1,28 @@
+#pragma once
+// Stand-in for the <sys/sdt.h> of systemtap, found first by the usdt tests: instead of a nop, each
+// tracepoint appends its name and arguments to usdt_stub::probes().
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace usdt_stub {
+
+    struct probe_t
+    {
+        std::string name;
+        uint64_t arg0;
+        uint64_t arg1;
+    };
+
+    inline std::vector<probe_t> & probes()
+    {
+        static std::vector<probe_t> recorded;
+        return recorded;
+    }
+
+} // namespace usdt_stub
+
+#define DTRACE_PROBE1(provider, name, a) \
+    usdt_stub::probes().push_back({#name, static_cast<uint64_t>(a), 0})
+#define DTRACE_PROBE2(provider, name, a, b) \
+    usdt_stub::probes().push_back({#name, static_cast<uint64_t>(a), static_cast<uint64_t>(b)})
@@ -16,9 +16,13 @@ set BUILD_INSTALL_PATH="..\install"
 set HASHLIBCXX_SHARED_LIBS=OFF
 set HASHLIBCXX_BUILD_TESTS=OFF
 set HASHLIBCXX_BUILD_SAMPLES=OFF
+set HASHLIBCXX_BUILD_BENCHMARKS=OFF
 set HASHLIBCXX_STD_ASSERT=ON
 set HASHLIBCXX_STD_STRING=ON
+set HASHLIBCXX_STD_STRING_VIEW=OFF
 set HASHLIBCXX_USE_LOOPS_UNROLLING=OFF
+set HASHLIBCXX_ENABLE_LTO=OFF
+set HASHLIBCXX_LINUX_AF_ALG=OFF
 
 set BOOST_ROOT_DIR=E:\boost\1_68_0
 
@@ -75,9 +79,13 @@ pushd "..\..\"
 		-DBUILD_SHARED_LIBS=%HASHLIBCXX_SHARED_LIBS% ^
 		-DHASHLIBCXX_BUILD_TESTS=%HASHLIBCXX_BUILD_TESTS% ^
 		-DHASHLIBCXX_BUILD_SAMPLES=%HASHLIBCXX_BUILD_SAMPLES% ^
+		-DHASHLIBCXX_BUILD_BENCHMARKS=%HASHLIBCXX_BUILD_BENCHMARKS% ^
 		-DHASHLIBCXX_STD_ASSERT=%HASHLIBCXX_STD_ASSERT% ^
 		-DHASHLIBCXX_STD_STRING=%HASHLIBCXX_STD_STRING% ^
-		-DHASHLIBCXX_USE_LOOPS_UNROLLING=%HASHLIBCXX_USE_LOOPS_UNROLLING%
+		-DHASHLIBCXX_STD_STRING_VIEW=%HASHLIBCXX_STD_STRING_VIEW% ^
+		-DHASHLIBCXX_USE_LOOPS_UNROLLING=%HASHLIBCXX_USE_LOOPS_UNROLLING% ^
+		-DHASHLIBCXX_ENABLE_LTO=%HASHLIBCXX_ENABLE_LTO% ^
+		-DHASHLIBCXX_LINUX_AF_ALG=%HASHLIBCXX_LINUX_AF_ALG%
 		
 		if %errorlevel% NEQ 0 (
 			echo Failed to configure project
@@ -19,9 +19,13 @@ BUILD_INSTALL_PATH="..\install"
 HASHLIBCXX_SHARED_LIBS=OFF
 HASHLIBCXX_BUILD_TESTS=OFF
 HASHLIBCXX_BUILD_SAMPLES=OFF
+HASHLIBCXX_BUILD_BENCHMARKS=OFF
 HASHLIBCXX_STD_ASSERT=ON
 HASHLIBCXX_STD_STRING=ON
+HASHLIBCXX_STD_STRING_VIEW=OFF
 HASHLIBCXX_USE_LOOPS_UNROLLING=OFF
+HASHLIBCXX_ENABLE_LTO=OFF
+HASHLIBCXX_LINUX_AF_ALG=OFF
 
 # =========================================================================================
 # =========================================================================================
@@ -54,6 +58,10 @@ cmake .. -G "$BUILD_GENERATOR" -DCMAKE_BUILD_TYPE=$BUILD_TYPE -DCMAKE_INSTALL_PR
 -DBUILD_SHARED_LIBS=$HASHLIBCXX_SHARED_LIBS \
 -DHASHLIBCXX_BUILD_TESTS=$HASHLIBCXX_BUILD_TESTS \
 -DHASHLIBCXX_BUILD_SAMPLES=$HASHLIBCXX_BUILD_SAMPLES \
+-DHASHLIBCXX_BUILD_BENCHMARKS=$HASHLIBCXX_BUILD_BENCHMARKS \
 -DHASHLIBCXX_STD_ASSERT=$HASHLIBCXX_STD_ASSERT \
 -DHASHLIBCXX_STD_STRING=$HASHLIBCXX_STD_STRING \
--DHASHLIBCXX_USE_LOOPS_UNROLLING=$HASHLIBCXX_USE_LOOPS_UNROLLING
+-DHASHLIBCXX_STD_STRING_VIEW=$HASHLIBCXX_STD_STRING_VIEW \
+-DHASHLIBCXX_USE_LOOPS_UNROLLING=$HASHLIBCXX_USE_LOOPS_UNROLLING \
+-DHASHLIBCXX_ENABLE_LTO=$HASHLIBCXX_ENABLE_LTO \
+-DHASHLIBCXX_LINUX_AF_ALG=$HASHLIBCXX_LINUX_AF_ALG
@@ -0,0 +1,121 @@
+#!/bin/sh
+
+# =========================================================================================
+# This script builds the library with profile guided optimization, in two stages, using the
+# benchmarks as training workload, then reports the gain of each algorithm against a build
+# with the same options but without profiles.
+# Works under linux as well as Unix-like OS such as OpenBSD
+# =========================================================================================
+
+BUILD_GENERATOR="Unix Makefiles"
+
+BUILD_COMPILER_C=gcc
+BUILD_COMPILER_CXX=g++
+#BUILD_COMPILER_C=clang
+#BUILD_COMPILER_CXX=clang++
+
+HASHLIBCXX_ENABLE_LTO=ON
+HASHLIBCXX_USE_LOOPS_UNROLLING=OFF
+
+# Iterations of the latency benchmark and megabytes per size of the throughput benchmark,
+# used both to train and to measure
+LATENCY_ITERATIONS=100000
+THROUGHPUT_MEGABYTES=64
+
+# =========================================================================================
+# =========================================================================================
+
+COMPILER_BIN_C=$(eval command -v $BUILD_COMPILER_C)
+COMPILER_BIN_CXX=$(eval command -v $BUILD_COMPILER_CXX)
+
+if [ -z "$COMPILER_BIN_C" ] || [ -z "$COMPILER_BIN_CXX" ]; then 
+	echo >&2 "Cannot locate $BUILD_COMPILER_CXX. Please install $BUILD_COMPILER_CXX and run again this batch.";
+	exit 1; 
+fi
+
+command -v cmake >/dev/null 2>&1 || { 
+	echo >&2 "Cannot locate CMake. Please install CMake and run again this batch.";
+	exit 1; 
+}
+
+case "$BUILD_COMPILER_CXX" in
+	clang*)
+		command -v llvm-profdata >/dev/null 2>&1 || { 
+			echo >&2 "Cannot locate llvm-profdata. Please install LLVM and run again this batch.";
+			exit 1; 
+		}
+		;;
+esac
+
+BUILD_NAME=build-pgo-$BUILD_COMPILER_C
+
+cd ..
+cd ..
+
+if [ ! -d "$BUILD_NAME" ]; then	mkdir "$BUILD_NAME"; fi
+
+cd "$BUILD_NAME"
+export CC=$COMPILER_BIN_C
+export CXX=$COMPILER_BIN_CXX
+
+PGO_DIR="$(pwd)/pgo"
+REPORT_DIR="$(pwd)/report"
+if [ -d "$PGO_DIR" ]; then rm -rf "$PGO_DIR"; fi
+if [ ! -d "$REPORT_DIR" ]; then mkdir "$REPORT_DIR"; fi
+
+# All the stages share the build directory: gcc names the profiles after the object files
+configure() {
+	cmake .. -G "$BUILD_GENERATOR" -DCMAKE_BUILD_TYPE=Release \
+	-DHASHLIBCXX_BUILD_BENCHMARKS=ON \
+	-DHASHLIBCXX_ENABLE_LTO=$HASHLIBCXX_ENABLE_LTO \
+	-DHASHLIBCXX_USE_LOOPS_UNROLLING=$HASHLIBCXX_USE_LOOPS_UNROLLING \
+	-DHASHLIBCXX_PGO=$1 \
+	-DHASHLIBCXX_PGO_DIR="$PGO_DIR" > /dev/null || exit 1
+	cmake --build . --target benchmarks || exit 1
+}
+
+run_benchmarks() {
+	./benchmarks/latency $LATENCY_ITERATIONS > "$REPORT_DIR/latency_$1.txt" || exit 1
+	./benchmarks/throughput $THROUGHPUT_MEGABYTES > "$REPORT_DIR/throughput_$1.txt" || exit 1
+}
+
+echo "==> Stage 0: reference build without profiles"
+configure OFF
+run_benchmarks reference
+
+echo "==> Stage 1: instrumented build and training"
+configure GENERATE
+run_benchmarks training
+
+case "$BUILD_COMPILER_CXX" in
+	clang*) llvm-profdata merge -output="$PGO_DIR/hashkitcxx.profdata" "$PGO_DIR"/*.profraw || exit 1 ;;
+esac
+
+echo "==> Stage 2: build optimized with the profiles"
+configure USE
+run_benchmarks optimized
+
+# Gain per algorithm: throughput (higher is better) and p50 latency of hash() (lower is better)
+echo
+echo "==> Gain of the profile guided build (positive is faster)"
+echo
+awk '
+	FNR == 1 { file++ }
+	file == 1 && $3 ~ /^[0-9.]+$/ { reference[$1 " " $2] = $3 }
+	file == 2 && $3 ~ /^[0-9.]+$/ && ($1 " " $2) in reference {
+		key = $1 " " $2
+		printf "%-12s throughput %8s bytes %10.1f -> %10.1f MB/s %+7.1f%%\n", $1, $2, reference[key], $3, 100 * ($3 - reference[key]) / reference[key]
+	}
+' "$REPORT_DIR/throughput_reference.txt" "$REPORT_DIR/throughput_optimized.txt"
+echo
+awk '
+	FNR == 1 { file++ }
+	file == 1 && $2 == "hash" { reference[$1 " " $3] = $4 }
+	file == 2 && $2 == "hash" && ($1 " " $3) in reference {
+		key = $1 " " $3
+		gain = reference[key] > 0 ? 100 * (reference[key] - $4) / reference[key] : 0
+		printf "%-12s p50 latency %5s bytes %8d -> %8d ns %+7.1f%%\n", $1, $3, reference[key], $4, gain
+	}
+' "$REPORT_DIR/latency_reference.txt" "$REPORT_DIR/latency_optimized.txt"
+echo
+echo "Full reports in $REPORT_DIR"